@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+// Benchmark: capture file write and read throughput, raw and gzip.
+//
+//   BM_dumper_write  dump N synthetic events; bytes_per_second is the size
+//                    of the file written (includes the synthetic generation)
+//   BM_dumper_read   read back a file of N events with the savefile engine;
+//                    bytes_per_second is the size of the file read
+//
+// Files are written to the system temporary directory and removed at the end.
+
+#include "synthetic_workload.h"
+
+#include <libsinsp/dumper.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+#ifdef HAS_ENGINE_SYNTHETIC
+
+namespace {
+
+constexpr uint64_t N_EVTS = 100000;
+
+std::string temp_capture_path() {
+	char path[] = "/tmp/libsinsp-bench-XXXXXX";
+	int fd = mkstemp(path);
+	if(fd >= 0) {
+		close(fd);
+	}
+	return path;
+}
+
+// Write N_EVTS synthetic events to `path`, return the size of the file.
+uint64_t write_capture(const std::string& path, bool compress, benchmark::State& state) {
+	sinsp inspector;
+	inspector.open_synthetic(
+	        synthetic_workload::params(synthetic_workload::MIX_DEFAULT, 256, 8, N_EVTS));
+	sinsp_dumper dumper;
+	dumper.open(&inspector, path, compress);
+	sinsp_evt* evt;
+	while((evt = synthetic_workload::next(inspector, state)) != nullptr) {
+		dumper.dump(evt);
+	}
+	dumper.close();
+	inspector.close();
+
+	FILE* f = fopen(path.c_str(), "rb");
+	if(f == nullptr) {
+		return 0;
+	}
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fclose(f);
+	return size > 0 ? size : 0;
+}
+
+}  // namespace
+
+static void BM_dumper_write(benchmark::State& state) {
+	const bool compress = state.range(0) != 0;
+	const std::string path = temp_capture_path();
+	uint64_t bytes = 0;
+	for(auto _ : state) {
+		bytes += write_capture(path, compress, state);
+	}
+	state.SetBytesProcessed(bytes);
+	state.SetItemsProcessed(state.iterations() * N_EVTS);
+	state.SetLabel(compress ? "gzip" : "raw");
+	std::remove(path.c_str());
+}
+BENCHMARK(BM_dumper_write)->ArgName("gzip")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_dumper_read(benchmark::State& state) {
+	const bool compress = state.range(0) != 0;
+	const std::string path = temp_capture_path();
+	const uint64_t size = write_capture(path, compress, state);
+
+	uint64_t n_evts = 0;
+	for(auto _ : state) {
+		sinsp inspector;
+		inspector.open_savefile(path);
+		while(synthetic_workload::next(inspector, state) != nullptr) {
+			n_evts++;
+		}
+		inspector.close();
+	}
+	state.SetBytesProcessed(state.iterations() * size);
+	state.SetItemsProcessed(n_evts);
+	state.SetLabel(compress ? "gzip" : "raw");
+	std::remove(path.c_str());
+}
+BENCHMARK(BM_dumper_read)->ArgName("gzip")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+#endif
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+// Benchmark: sinsp_evt_formatter throughput.
+//
+// Formats every event of the default synthetic mix with an output string
+// similar to the ones of common rules, both as text and as JSON. The numbers
+// include the cost of sinsp::next(), which can be read from
+// BM_sinsp_next_synthetic.
+//
+// BM_formatter_after_filter runs a filter using some of the output fields
+// before formatting each event, with the extraction caches of the two either
+// separated or shared through the same cache factory.
+
+#include "synthetic_workload.h"
+
+#include <libsinsp/eventformatter.h>
+#include <libsinsp/filter.h>
+#include <libsinsp/filter_check_list.h>
+
+#include <memory>
+#include <string>
+
+#ifdef HAS_ENGINE_SYNTHETIC
+
+static const char* s_output_format =
+        "%evt.time %evt.type user=%user.name proc=%proc.name pid=%proc.pid ppid=%proc.ppid "
+        "exe=%proc.exe cmdline=%proc.cmdline fd=%fd.name dir=%evt.dir res=%evt.res";
+
+static void BM_formatter_tostring(benchmark::State& state) {
+	sinsp inspector;
+	sinsp_filter_check_list filterlist;
+	inspector.open_synthetic(synthetic_workload::params(synthetic_workload::MIX_DEFAULT));
+	sinsp_evt_formatter formatter(&inspector, s_output_format, filterlist);
+	auto output_format = state.range(0) ? sinsp_evt_formatter::OF_JSON
+	                                    : sinsp_evt_formatter::OF_NORMAL;
+	synthetic_workload::warmup(inspector, state);
+
+	std::string output;
+	uint64_t bytes = 0;
+	for(auto _ : state) {
+		sinsp_evt* evt = synthetic_workload::next(inspector, state);
+		if(evt == nullptr) {
+			break;
+		}
+		formatter.tostring_withformat(evt, output, output_format);
+		bytes += output.size();
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(bytes);
+	state.SetLabel(state.range(0) ? "json" : "text");
+	inspector.close();
+}
+BENCHMARK(BM_formatter_tostring)->ArgName("json")->Arg(0)->Arg(1);
+
+static void BM_formatter_after_filter(benchmark::State& state) {
+	sinsp inspector;
+	sinsp_filter_check_list filterlist;
+	inspector.open_synthetic(synthetic_workload::params(synthetic_workload::MIX_DEFAULT));
+	auto filter_cache = std::make_shared<exprstr_sinsp_filter_cache_factory>();
+	auto factory = std::make_shared<sinsp_filter_factory>(&inspector, filterlist);
+	auto filter = sinsp_filter_compiler(factory,
+	                                    "user.name != nobody and proc.name != x and "
+	                                    "proc.cmdline != x and fd.name != x",
+	                                    filter_cache)
+	                      .compile();
+	sinsp_evt_formatter formatter(&inspector,
+	                              s_output_format,
+	                              filterlist,
+	                              state.range(0) ? filter_cache : nullptr);
+	synthetic_workload::warmup(inspector, state);
+
+	std::string output;
+	for(auto _ : state) {
+		sinsp_evt* evt = synthetic_workload::next(inspector, state);
+		if(evt == nullptr) {
+			break;
+		}
+		if(filter->run(evt)) {
+			formatter.tostring(evt, output);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel(state.range(0) ? "shared" : "separate");
+	inspector.close();
+}
+BENCHMARK(BM_formatter_after_filter)->ArgName("shared")->Arg(0)->Arg(1);
+
+#endif
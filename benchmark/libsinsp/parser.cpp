@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+// Benchmark: sinsp parser throughput per syscall family.
+//
+// Every run feeds a single syscall family through sinsp::next(), so that the
+// parsing and state update cost of each family can be compared. Some families
+// need companion events to stay consistent (e.g. a read on a closed fd is
+// preceded by an open, a clone replaces a live process with procexit), so the
+// label reports the family and items_per_second counts all the events.
+
+#include "synthetic_workload.h"
+
+#ifdef HAS_ENGINE_SYNTHETIC
+
+static void BM_sinsp_parse_family(benchmark::State& state) {
+	const int64_t family = state.range(0);
+	sinsp inspector;
+	inspector.open_synthetic(synthetic_workload::params(family));
+	synthetic_workload::warmup(inspector, state);
+
+	for(auto _ : state) {
+		benchmark::DoNotOptimize(synthetic_workload::next(inspector, state));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.SetLabel(synthetic_workload::mix_name(family));
+	inspector.close();
+}
+BENCHMARK(BM_sinsp_parse_family)
+        ->ArgName("family")
+        ->DenseRange(synthetic_workload::MIX_CLONE, synthetic_workload::MIX_CLOSE);
+
+#endif
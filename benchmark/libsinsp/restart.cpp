@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+// Benchmark: inspector restart time on the host the benchmark runs on.
+//
+//   BM_restart_full_scan      open with a full /proc scan, as after a cold start
+//   BM_restart_from_snapshot  open restoring a state snapshot taken right before,
+//                             as after an agent restart
+//   BM_state_snapshot_save    write the state snapshot on the way out
+//
+// The "threads" counter reports the size of the thread table after the open,
+// the results scale with the number of processes running on the host.
+
+#include <libscap/scap_config.h>
+#include <libsinsp/sinsp.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+#ifdef HAS_ENGINE_NODRIVER
+
+namespace {
+
+std::string snapshot_path() {
+	return "/tmp/sinsp_bench_state_" + std::to_string(getpid()) + ".scap";
+}
+
+void write_snapshot(const std::string& path) {
+	sinsp inspector;
+	inspector.open_nodriver(true);
+	inspector.save_state_snapshot(path);
+}
+
+}  // namespace
+
+static void BM_restart_full_scan(benchmark::State& state) {
+	uint64_t threads = 0;
+	for(auto _ : state) {
+		sinsp inspector;
+		inspector.open_nodriver(true);
+		threads = inspector.m_thread_manager->get_thread_count();
+	}
+	state.counters["threads"] = threads;
+}
+BENCHMARK(BM_restart_full_scan)->Unit(benchmark::kMillisecond);
+
+static void BM_restart_from_snapshot(benchmark::State& state) {
+	const auto path = snapshot_path();
+	write_snapshot(path);
+
+	uint64_t threads = 0;
+	for(auto _ : state) {
+		sinsp inspector;
+		inspector.set_state_snapshot_path(path);
+		inspector.open_nodriver(true);
+		threads = inspector.m_thread_manager->get_thread_count();
+	}
+	state.counters["threads"] = threads;
+	std::remove(path.c_str());
+}
+BENCHMARK(BM_restart_from_snapshot)->Unit(benchmark::kMillisecond);
+
+static void BM_state_snapshot_save(benchmark::State& state) {
+	const auto path = snapshot_path();
+	sinsp inspector;
+	inspector.open_nodriver(true);
+
+	for(auto _ : state) {
+		inspector.save_state_snapshot(path);
+	}
+	state.counters["threads"] = inspector.m_thread_manager->get_thread_count();
+	std::remove(path.c_str());
+}
+BENCHMARK(BM_state_snapshot_save)->Unit(benchmark::kMillisecond);
+
+#endif
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+// Benchmark: compile and evaluate a generated, realistic ruleset.
+//
+// Rules are built from a handful of templates modeled on common detection
+// rules (sensitive file opens, shell spawns, outbound connections, log
+// tampering, ...). Each template is instantiated with different constants so
+// that no two rules are identical, like in a real ruleset.
+//
+//   BM_ruleset_compile  time to compile N rules
+//   BM_ruleset_compile_cached
+//                       same, with the ASTs loaded from an ast_cache file
+//                       saved by a previous run
+//   BM_ruleset_compile_parallel
+//                       same, with the rules split among T threads sharing
+//                       the same filter factory
+//   BM_filtercheck_from_fldname
+//                       resolution of every known field name to a new check
+//   BM_ruleset_eval     sinsp::next() + evaluation of all N rules on every
+//                       event of the default synthetic mix
+
+#include "synthetic_workload.h"
+
+#include <libsinsp/filter.h>
+#include <libsinsp/filter/ast_cache.h>
+#include <libsinsp/filter_check_list.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef HAS_ENGINE_SYNTHETIC
+
+// The constants are picked from the same vocabulary used by the synthetic engine,
+// so that a small fraction of the rules matches some events.
+static std::vector<std::string> make_ruleset(int n) {
+	static const char* const dirs[] = {"/etc", "/var/log", "/tmp", "/usr/lib", "/home/user"};
+	static const char* const comms[] = {"bash", "python3", "nginx", "java", "node", "curl"};
+	std::vector<std::string> rules;
+	rules.reserve(n);
+	for(int i = 0; i < n; i++) {
+		std::string dir = dirs[i % 5];
+		std::string comm = comms[i % 6];
+		std::string file = dir + "/file-" + std::to_string(i % 1024) + ".dat";
+		switch(i % 6) {
+		case 0:
+			rules.push_back("evt.type in (open, openat, openat2) and fd.name = " + file +
+			                " and not proc.name in (sshd, cron, systemd)");
+			break;
+		case 1:
+			rules.push_back("evt.type = execve and evt.dir = < and proc.name = " + comm +
+			                " and proc.pname in (bash, sh, zsh, dash)");
+			break;
+		case 2:
+			rules.push_back("evt.type = connect and fd.sport in (80, 443) and not fd.sip = 10.1." +
+			                std::to_string(i % 4) + "." + std::to_string(i % 254 + 1));
+			break;
+		case 3:
+			rules.push_back("evt.type in (read, write) and fd.directory = " + dir +
+			                " and proc.exe endswith /" + comm);
+			break;
+		case 4:
+			rules.push_back("evt.type = close and fd.typechar = 4 and proc.cmdline contains " +
+			                comm);
+			break;
+		default:
+			rules.push_back("proc.name = " + comm + " and fd.name glob " + dir + "/file-" +
+			                std::to_string(i % 100) + "*");
+			break;
+		}
+	}
+	return rules;
+}
+
+static void BM_ruleset_compile(benchmark::State& state) {
+	sinsp inspector;
+	sinsp_filter_check_list filterlist;
+	auto factory = std::make_shared<sinsp_filter_factory>(&inspector, filterlist);
+	const auto rules = make_ruleset(static_cast<int>(state.range(0)));
+
+	for(auto _ : state) {
+		for(const auto& rule : rules) {
+			sinsp_filter_compiler compiler(factory, rule);
+			benchmark::DoNotOptimize(compiler.compile());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * rules.size());
+}
+BENCHMARK(BM_ruleset_compile)->ArgName("rules")->RangeMultiplier(10)->Range(10, 1000);
+
+static void BM_ruleset_compile_cached(benchmark::State& state) {
+	sinsp inspector;
+	sinsp_filter_check_list filterlist;
+	auto factory = std::make_shared<sinsp_filter_factory>(&inspector, filterlist);
+	const auto rules = make_ruleset(static_cast<int>(state.range(0)));
+	const std::string path = "/tmp/bench_ruleset_ast_cache";
+	const std::string version = "bench";
+
+	libsinsp::filter::ast_cache warm(version);
+	for(const auto& rule : rules) {
+		warm.get(rule);
+	}
+	if(!warm.save(path)) {
+		state.SkipWithError("can't write the ast cache file");
+		return;
+	}
+
+	for(auto _ : state) {
+		libsinsp::filter::ast_cache cache(version);
+		cache.load(path);
+		for(const auto& rule : rules) {
+			sinsp_filter_compiler compiler(factory, cache.get(rule));
+			benchmark::DoNotOptimize(compiler.compile());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * rules.size());
+	std::remove(path.c_str());
+}
+BENCHMARK(BM_ruleset_compile_cached)->ArgName("rules")->Arg(1000);
+
+static void BM_ruleset_compile_parallel(benchmark::State& state) {
+	sinsp inspector;
+	sinsp_filter_check_list filterlist;
+	auto factory = std::make_shared<sinsp_filter_factory>(&inspector, filterlist);
+	const auto rules = make_ruleset(static_cast<int>(state.range(0)));
+	const auto n_threads = static_cast<size_t>(state.range(1));
+
+	for(auto _ : state) {
+		std::vector<std::thread> threads;
+		for(size_t t = 0; t < n_threads; t++) {
+			threads.emplace_back([&, t]() {
+				for(size_t i = t; i < rules.size(); i += n_threads) {
+					sinsp_filter_compiler compiler(factory, rules[i]);
+					benchmark::DoNotOptimize(compiler.compile());
+				}
+			});
+		}
+		for(auto& thread : threads) {
+			thread.join();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * rules.size());
+}
+BENCHMARK(BM_ruleset_compile_parallel)
+        ->ArgNames({"rules", "threads"})
+        ->ArgsProduct({{1000}, {1, 2, 4}})
+        ->UseRealTime();
+
+static void BM_filtercheck_from_fldname(benchmark::State& state) {
+	sinsp inspector;
+	sinsp_filter_check_list filterlist;
+	std::vector<const filter_check_info*> infos;
+	filterlist.get_all_fields(infos);
+	std::vector<std::string> names;
+	for(const auto* info : infos) {
+		for(int32_t i = 0; i < info->m_nfields; i++) {
+			if(!(info->m_fields[i].m_flags & (EPF_ARG_REQUIRED | EPF_DEPRECATED))) {
+				names.emplace_back(info->m_fields[i].m_name);
+			}
+		}
+	}
+
+	for(auto _ : state) {
+		for(const auto& name : names) {
+			benchmark::DoNotOptimize(
+			        filterlist.new_filter_check_from_fldname(name, &inspector, true));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK(BM_filtercheck_from_fldname);
+
+static void BM_ruleset_eval(benchmark::State& state) {
+	sinsp inspector;
+	sinsp_filter_check_list filterlist;
+	auto factory = std::make_shared<sinsp_filter_factory>(&inspector, filterlist);
+	std::vector<std::unique_ptr<sinsp_filter>> filters;
+	for(const auto& rule : make_ruleset(static_cast<int>(state.range(0)))) {
+		sinsp_filter_compiler compiler(factory, rule);
+		filters.push_back(compiler.compile());
+	}
+
+	inspector.open_synthetic(synthetic_workload::params(synthetic_workload::MIX_DEFAULT));
+	synthetic_workload::warmup(inspector, state);
+
+	uint64_t matches = 0;
+	for(auto _ : state) {
+		sinsp_evt* evt = synthetic_workload::next(inspector, state);
+		if(evt == nullptr) {
+			break;
+		}
+		for(auto& filter : filters) {
+			matches += filter->run(evt) ? 1 : 0;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["matches"] = matches;
+	inspector.close();
+}
+BENCHMARK(BM_ruleset_eval)->ArgName("rules")->RangeMultiplier(10)->Range(10, 1000);
+
+#endif
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+// Helpers shared by the benchmarks that drive sinsp with the synthetic engine,
+// so that every suite works on locally generated, reproducible inputs.
+
+#pragma once
+
+#include <libsinsp/sinsp.h>
+#include <libscap/scap_config.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#ifdef HAS_ENGINE_SYNTHETIC
+
+namespace synthetic_workload {
+
+constexpr uint64_t SEED = 42;
+
+enum mix_id : int64_t {
+	MIX_DEFAULT = 0,  // I/O dominated, like a typical production host
+	MIX_IO,           // read/write only
+	MIX_PROC,         // process lifecycle heavy (fork/exec storms)
+	MIX_NET,          // connect/close heavy
+	MIX_CLONE,        // single syscall families, used to compare parser costs
+	MIX_EXECVE,
+	MIX_OPEN,
+	MIX_READ,
+	MIX_WRITE,
+	MIX_CONNECT,
+	MIX_CLOSE,
+};
+
+inline const char* mix_name(int64_t id) {
+	switch(id) {
+	case MIX_IO:
+		return "io";
+	case MIX_PROC:
+		return "proc";
+	case MIX_NET:
+		return "net";
+	case MIX_CLONE:
+		return "clone";
+	case MIX_EXECVE:
+		return "execve";
+	case MIX_OPEN:
+		return "open";
+	case MIX_READ:
+		return "read";
+	case MIX_WRITE:
+		return "write";
+	case MIX_CONNECT:
+		return "connect";
+	case MIX_CLOSE:
+		return "close";
+	default:
+		return "default";
+	}
+}
+
+inline scap_synthetic_mix mix(int64_t id) {
+	// clone, execve, open, read, write, connect, close
+	switch(id) {
+	case MIX_IO:
+		return {0, 0, 0, 50, 50, 0, 0};
+	case MIX_PROC:
+		return {20, 20, 10, 20, 20, 0, 10};
+	case MIX_NET:
+		return {0, 0, 5, 10, 10, 40, 35};
+	case MIX_CLONE:
+		return {1, 0, 0, 0, 0, 0, 0};
+	case MIX_EXECVE:
+		return {0, 1, 0, 0, 0, 0, 0};
+	case MIX_OPEN:
+		return {0, 0, 1, 0, 0, 0, 0};
+	case MIX_READ:
+		return {0, 0, 0, 1, 0, 0, 0};
+	case MIX_WRITE:
+		return {0, 0, 0, 0, 1, 0, 0};
+	case MIX_CONNECT:
+		return {0, 0, 0, 0, 0, 1, 0};
+	case MIX_CLOSE:
+		return {0, 0, 0, 0, 0, 0, 1};
+	default:
+		return {};
+	}
+}
+
+inline scap_synthetic_engine_params params(int64_t mix_id,
+                                           uint32_t n_procs = 256,
+                                           uint32_t n_containers = 8,
+                                           uint64_t max_evts = 0) {
+	scap_synthetic_engine_params p{};
+	p.seed = SEED;
+	p.max_evts = max_evts;
+	p.n_procs = n_procs;
+	p.n_fds = 32;
+	p.n_containers = n_containers;
+	p.mix = mix(mix_id);
+	return p;
+}
+
+// Return the next event that made it through sinsp, or nullptr on error/EOF.
+inline sinsp_evt* next(sinsp& inspector, benchmark::State& state) {
+	sinsp_evt* evt = nullptr;
+	int32_t res;
+	do {
+		res = inspector.next(&evt);
+	} while(res == SCAP_FILTERED_EVENT);
+	if(res != SCAP_SUCCESS) {
+		if(res != SCAP_EOF) {
+			state.SkipWithError(inspector.getlasterr().c_str());
+		}
+		return nullptr;
+	}
+	return evt;
+}
+
+// Consume the first events of the stream, so that the thread table is fully
+// populated and the measurements reflect steady state.
+inline void warmup(sinsp& inspector, benchmark::State& state, uint64_t n_evts = 10000) {
+	for(uint64_t i = 0; i < n_evts; i++) {
+		if(next(inspector, state) == nullptr) {
+			return;
+		}
+	}
+}
+
+}  // namespace synthetic_workload
+
+#endif
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+// Benchmark: thread table operations at scale.
+//
+// The table is prepopulated with N processes, each one child of the previous
+// one modulo a fan-out of 16, to get a realistic process tree instead of a
+// flat list.
+//
+//   BM_thread_table_find        lookup of a random existing tid
+//   BM_thread_table_clone_exit  add a child of a random process and remove it,
+//                               like a short-lived fork/exit
+//   BM_thread_table_wide_clone_exit
+//                               same, but all the N processes are children of
+//                               init, like a fork bomb or a busy supervisor
+//   BM_thread_table_thread_churn
+//                               add and remove a thread of a process that
+//                               already has N threads
+//   BM_thread_table_group_exit  remove a process with N threads, each one with
+//                               a child, like a JVM shutdown; the group is
+//                               removed thread by thread or as a whole
+
+#include <libsinsp/sinsp.h>
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+namespace {
+
+constexpr int64_t FIRST_TID = 1000;
+constexpr int64_t FANOUT = 16;
+
+void add_process(sinsp& inspector, int64_t tid, int64_t ptid) {
+	auto tinfo = inspector.get_threadinfo_factory().create();
+	tinfo->m_tid = tid;
+	tinfo->m_pid = tid;
+	tinfo->m_ptid = ptid;
+	tinfo->m_comm = "bench";
+	tinfo->m_exe = "/usr/bin/bench";
+	inspector.m_thread_manager->add_thread(std::move(tinfo), true);
+}
+
+void add_thread(sinsp& inspector, int64_t tid, int64_t pid) {
+	auto tinfo = inspector.get_threadinfo_factory().create();
+	tinfo->m_tid = tid;
+	tinfo->m_pid = pid;
+	tinfo->m_ptid = 1;
+	tinfo->m_flags |= PPM_CL_CLONE_THREAD;
+	tinfo->m_comm = "bench";
+	tinfo->m_exe = "/usr/bin/bench";
+	inspector.m_thread_manager->add_thread(std::move(tinfo), true);
+}
+
+void populate(sinsp& inspector, int64_t n) {
+	inspector.m_thread_manager->set_max_thread_table_size(static_cast<uint32_t>(n * 2 + 1024));
+	add_process(inspector, 1, 0);
+	for(int64_t i = 0; i < n; i++) {
+		int64_t ptid = i < FANOUT ? 1 : FIRST_TID + (i / FANOUT) - 1;
+		add_process(inspector, FIRST_TID + i, ptid);
+	}
+}
+
+}  // namespace
+
+static void BM_thread_table_find(benchmark::State& state) {
+	const int64_t n = state.range(0);
+	sinsp inspector;
+	populate(inspector, n);
+	std::mt19937_64 rng(42);
+
+	for(auto _ : state) {
+		int64_t tid = FIRST_TID + static_cast<int64_t>(rng() % n);
+		benchmark::DoNotOptimize(inspector.m_thread_manager->find_thread(tid, true));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_thread_table_find)->ArgName("threads")->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BM_thread_table_clone_exit(benchmark::State& state) {
+	const int64_t n = state.range(0);
+	sinsp inspector;
+	populate(inspector, n);
+	std::mt19937_64 rng(42);
+	int64_t next_tid = FIRST_TID + n;
+
+	for(auto _ : state) {
+		int64_t ptid = FIRST_TID + static_cast<int64_t>(rng() % n);
+		int64_t tid = next_tid++;
+		add_process(inspector, tid, ptid);
+		inspector.m_thread_manager->remove_thread(tid);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_thread_table_clone_exit)
+        ->ArgName("threads")
+        ->RangeMultiplier(10)
+        ->Range(1000, 100000);
+
+static void BM_thread_table_wide_clone_exit(benchmark::State& state) {
+	const int64_t n = state.range(0);
+	sinsp inspector;
+	inspector.m_thread_manager->set_max_thread_table_size(static_cast<uint32_t>(n * 2 + 1024));
+	add_process(inspector, 1, 0);
+	for(int64_t i = 0; i < n; i++) {
+		add_process(inspector, FIRST_TID + i, 1);
+	}
+	int64_t next_tid = FIRST_TID + n;
+
+	for(auto _ : state) {
+		int64_t tid = next_tid++;
+		add_process(inspector, tid, 1);
+		inspector.m_thread_manager->remove_thread(tid);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_thread_table_wide_clone_exit)
+        ->ArgName("children")
+        ->RangeMultiplier(10)
+        ->Range(1000, 100000);
+
+static void BM_thread_table_thread_churn(benchmark::State& state) {
+	const int64_t n = state.range(0);
+	sinsp inspector;
+	inspector.m_thread_manager->set_max_thread_table_size(static_cast<uint32_t>(n * 2 + 1024));
+	add_process(inspector, 1, 0);
+	add_process(inspector, FIRST_TID, 1);
+	for(int64_t i = 1; i < n; i++) {
+		add_thread(inspector, FIRST_TID + i, FIRST_TID);
+	}
+	int64_t next_tid = FIRST_TID + n;
+
+	for(auto _ : state) {
+		int64_t tid = next_tid++;
+		add_thread(inspector, tid, FIRST_TID);
+		inspector.m_thread_manager->remove_thread(tid);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_thread_table_thread_churn)
+        ->ArgName("threads")
+        ->RangeMultiplier(10)
+        ->Range(1000, 100000);
+
+static void BM_thread_table_group_exit(benchmark::State& state) {
+	const int64_t n = state.range(0);
+	const bool whole_group = state.range(1) != 0;
+	sinsp inspector;
+	inspector.m_thread_manager->set_max_thread_table_size(static_cast<uint32_t>(n * 4 + 1024));
+	add_process(inspector, 1, 0);
+
+	for(auto _ : state) {
+		state.PauseTiming();
+		add_process(inspector, FIRST_TID, 1);
+		for(int64_t i = 1; i < n; i++) {
+			add_thread(inspector, FIRST_TID + i, FIRST_TID);
+		}
+		for(int64_t i = 0; i < n; i++) {
+			add_process(inspector, FIRST_TID + n + i, FIRST_TID + i);
+		}
+		state.ResumeTiming();
+
+		if(whole_group) {
+			inspector.m_thread_manager->remove_thread_group(FIRST_TID);
+		} else {
+			for(int64_t i = 0; i < n; i++) {
+				inspector.m_thread_manager->remove_thread(FIRST_TID + i);
+			}
+		}
+
+		state.PauseTiming();
+		for(int64_t i = 0; i < n; i++) {
+			inspector.m_thread_manager->remove_thread(FIRST_TID + n + i);
+		}
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_thread_table_group_exit)
+        ->ArgNames({"threads", "whole_group"})
+        ->ArgsProduct({{1000, 10000}, {0, 1}});
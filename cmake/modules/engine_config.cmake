@@ -9,7 +9,15 @@ set(HAS_ENGINE_NODRIVER On)
 set(HAS_ENGINE_SAVEFILE On)
 set(HAS_ENGINE_SOURCE_PLUGIN On)
 
+if(NOT WIN32)
+	option(ENABLE_ENGINE_SYNTHETIC "Enable synthetic workload engine" ON)
+	set(HAS_ENGINE_SYNTHETIC ${ENABLE_ENGINE_SYNTHETIC})
+endif()
+
 if(CMAKE_SYSTEM_NAME MATCHES "Linux")
+	option(ENABLE_ENGINE_SHM "Enable shared memory fan-out engine" ON)
+	set(HAS_ENGINE_SHM ${ENABLE_ENGINE_SHM})
+
 	option(ENABLE_ENGINE_KMOD "Enable kernel module engine" ON)
 
 	set(HAS_ENGINE_KMOD ${ENABLE_ENGINE_KMOD})
@@ -2952,6 +2952,23 @@ const struct ppm_event_info g_event_info[] = {
                   {"arg3", PT_DYN, PF_DEC, keyctl_dynamic_param, PPM_KEYCTL_IDX_MAX},
                   {"arg4", PT_DYN, PF_DEC, keyctl_dynamic_param, PPM_KEYCTL_IDX_MAX},
                   {"arg5", PT_DYN, PF_DEC, keyctl_dynamic_param, PPM_KEYCTL_IDX_MAX}}},
+        [PPME_RATE_LIMIT_E] = {"rate_limit",
+                               EC_INTERNAL | EC_METAEVENT,
+                               EF_SKIPPARSERESET,
+                               2,
+                               {{"skipped", PT_UINT64, PF_DEC}, {"duration", PT_RELTIME, PF_DEC}}},
+        [PPME_RATE_LIMIT_X] = {"NA", EC_UNKNOWN, EF_UNUSED, 0},
+        [PPME_IO_SUMMARY_E] = {"io_summary",
+                               EC_IO_OTHER | EC_METAEVENT,
+                               EF_USES_FD,
+                               6,
+                               {{"fd", PT_FD, PF_DEC},
+                                {"direction", PT_ENUMFLAGS8, PF_DEC, io_summary_directions},
+                                {"count", PT_UINT64, PF_DEC},
+                                {"bytes", PT_UINT64, PF_DEC},
+                                {"first_ts", PT_ABSTIME, PF_DEC},
+                                {"last_ts", PT_ABSTIME, PF_DEC}}},
+        [PPME_IO_SUMMARY_X] = {"NA", EC_UNKNOWN, EF_UNUSED, 0},
 };
 #pragma GCC diagnostic pop
 
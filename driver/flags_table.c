@@ -840,3 +840,9 @@ const struct ppm_name_value anon_inode_fd_types[] = {
         {"ANON_INODE_FD_TYPE_PERF_EVENT", ANON_INODE_FD_TYPE_PERF_EVENT},
         {0, 0},
 };
+
+const struct ppm_name_value io_summary_directions[] = {
+        {"OUT", PPM_IO_SUMMARY_OUT},
+        {"IN", PPM_IO_SUMMARY_IN},
+        {0, 0},
+};
@@ -330,6 +330,336 @@ static struct ppm_consumer_t *ppm_find_consumer(struct task_struct *consumer_id)
 	return NULL;
 }
 
+/*
+ * Suppression of thread groups and comms, the in-driver counterpart of the
+ * userspace `sinsp_suppress`.
+ */
+struct ppm_suppressed_tgid {
+	pid_t tgid;
+	struct hlist_node node;
+	struct rcu_head rcu;
+};
+
+/* Must be called under RCU read lock or with `suppress_lock` held. */
+static bool consumer_is_suppressed_tgid(struct ppm_consumer_t *consumer, pid_t tgid) {
+	struct ppm_suppressed_tgid *entry;
+
+	hash_for_each_possible_rcu(consumer->suppressed_tgids, entry, node, tgid) {
+		if(entry->tgid == tgid)
+			return true;
+	}
+	return false;
+}
+
+static int consumer_suppress_tgid(struct ppm_consumer_t *consumer, pid_t tgid, gfp_t gfp) {
+	struct ppm_suppressed_tgid *entry = kmalloc(sizeof(*entry), gfp);
+	if(!entry)
+		return -ENOMEM;
+	entry->tgid = tgid;
+
+	spin_lock(&consumer->suppress_lock);
+	if(consumer_is_suppressed_tgid(consumer, tgid) ||
+	   atomic_read(&consumer->n_suppressed_tgids) >= PPM_MAX_SUPPRESSED_TGIDS) {
+		/* When the table is full userspace still suppresses the events. */
+		spin_unlock(&consumer->suppress_lock);
+		kfree(entry);
+		return 0;
+	}
+	hash_add_rcu(consumer->suppressed_tgids, &entry->node, tgid);
+	atomic_inc(&consumer->n_suppressed_tgids);
+	spin_unlock(&consumer->suppress_lock);
+	return 0;
+}
+
+static void consumer_unsuppress_tgid(struct ppm_consumer_t *consumer, pid_t tgid) {
+	struct ppm_suppressed_tgid *entry;
+
+	spin_lock(&consumer->suppress_lock);
+	hash_for_each_possible(consumer->suppressed_tgids, entry, node, tgid) {
+		if(entry->tgid == tgid) {
+			hash_del_rcu(&entry->node);
+			kfree_rcu(entry, rcu);
+			atomic_dec(&consumer->n_suppressed_tgids);
+			break;
+		}
+	}
+	spin_unlock(&consumer->suppress_lock);
+}
+
+static bool consumer_is_suppressed_comm(struct ppm_consumer_t *consumer, const char *comm) {
+	uint32_t j;
+	bool found = false;
+
+	spin_lock(&consumer->suppress_lock);
+	for(j = 0; j < consumer->n_suppressed_comms; j++) {
+		if(strncmp(consumer->suppressed_comms[j], comm, TASK_COMM_LEN) == 0) {
+			found = true;
+			break;
+		}
+	}
+	spin_unlock(&consumer->suppress_lock);
+	return found;
+}
+
+static int consumer_suppress_comm(struct ppm_consumer_t *consumer,
+                                  const char *comm,
+                                  bool suppress) {
+	uint32_t j;
+	int ret = 0;
+
+	spin_lock(&consumer->suppress_lock);
+	for(j = 0; j < consumer->n_suppressed_comms; j++) {
+		if(strncmp(consumer->suppressed_comms[j], comm, TASK_COMM_LEN) == 0)
+			break;
+	}
+	if(suppress && j == consumer->n_suppressed_comms) {
+		if(j < PPM_MAX_SUPPRESSED_COMMS) {
+			strscpy(consumer->suppressed_comms[j], comm, TASK_COMM_LEN);
+			WRITE_ONCE(consumer->n_suppressed_comms, j + 1);
+		} else {
+			ret = -ENOSPC;
+		}
+	} else if(!suppress && j < consumer->n_suppressed_comms) {
+		/* Keep the array packed. */
+		memcpy(consumer->suppressed_comms[j],
+		       consumer->suppressed_comms[consumer->n_suppressed_comms - 1],
+		       TASK_COMM_LEN);
+		WRITE_ONCE(consumer->n_suppressed_comms, consumer->n_suppressed_comms - 1);
+	}
+	spin_unlock(&consumer->suppress_lock);
+	return ret;
+}
+
+static void consumer_clear_suppressed(struct ppm_consumer_t *consumer) {
+	struct ppm_suppressed_tgid *entry;
+	struct hlist_node *tmp;
+	int bkt;
+
+	spin_lock(&consumer->suppress_lock);
+	hash_for_each_safe(consumer->suppressed_tgids, bkt, tmp, entry, node) {
+		hash_del_rcu(&entry->node);
+		kfree_rcu(entry, rcu);
+	}
+	atomic_set(&consumer->n_suppressed_tgids, 0);
+	WRITE_ONCE(consumer->n_suppressed_comms, 0);
+	spin_unlock(&consumer->suppress_lock);
+}
+
+/*
+ * Returns true if the event must be dropped because its thread group is
+ * suppressed. Like the modern probe, the events that make a thread group
+ * suppressed (the clone child and execve exits) are still sent so that
+ * userspace can track the suppressed tids, and the proc exit event is never
+ * suppressed, otherwise userspace would keep stale threads.
+ * Called under RCU read lock.
+ */
+static bool consumer_is_suppressed_event(struct ppm_consumer_t *consumer,
+                                         ppm_event_code event_type,
+                                         struct event_data_t *event_datap,
+                                         kmod_prog_codes tp_type) {
+	pid_t tgid;
+
+	if(likely(atomic_read(&consumer->n_suppressed_tgids) == 0 &&
+	          READ_ONCE(consumer->n_suppressed_comms) == 0))
+		return false;
+
+	tgid = task_tgid_nr(current);
+
+	if(event_type == PPME_PROCEXIT_1_E) {
+		/* Forget the thread group once its last thread exits. */
+		if(atomic_read(&current->signal->live) == 0)
+			consumer_unsuppress_tgid(consumer, tgid);
+		return false;
+	}
+
+	if(consumer_is_suppressed_tgid(consumer, tgid)) {
+		/* Here we are the parent, the child inherits the suppression. */
+		if(event_datap->category == PPMC_SCHED_PROC_FORK) {
+			struct task_struct *child = event_datap->event_info.sched_proc_fork_data.child;
+			consumer_suppress_tgid(consumer, task_tgid_nr(child), GFP_ATOMIC);
+			return false;
+		}
+		return true;
+	}
+
+	switch(event_type) {
+	case PPME_SYSCALL_CLONE_20_X:
+	case PPME_SYSCALL_FORK_20_X:
+	case PPME_SYSCALL_VFORK_20_X:
+	case PPME_SYSCALL_CLONE3_X:
+		/* Only the child of a new process, threads share the tgid checked above. */
+		if(tp_type == KMOD_PROG_SYS_EXIT && current->pid == current->tgid &&
+		   syscall_get_return_value(current, event_datap->event_info.syscall_data.regs) == 0 &&
+		   consumer_is_suppressed_tgid(consumer,
+		                               task_tgid_nr(rcu_dereference(current->real_parent)))) {
+			consumer_suppress_tgid(consumer, tgid, GFP_ATOMIC);
+		}
+		break;
+	case PPME_SYSCALL_EXECVE_19_X:
+	case PPME_SYSCALL_EXECVEAT_X: {
+		char comm[TASK_COMM_LEN];
+		bool success = event_datap->category == PPMC_SCHED_PROC_EXEC ||
+		               (tp_type == KMOD_PROG_SYS_EXIT &&
+		                syscall_get_return_value(current,
+		                                         event_datap->event_info.syscall_data.regs) == 0);
+		if(!success)
+			break;
+		get_task_comm(comm, current);
+		if(consumer_is_suppressed_comm(consumer, comm))
+			consumer_suppress_tgid(consumer, tgid, GFP_ATOMIC);
+		break;
+	}
+	default:
+		break;
+	}
+
+	return false;
+}
+
+static void consumer_count_suppressed(struct ppm_consumer_t *consumer) {
+	struct ppm_ring_buffer_context *ring;
+	int cpu = get_cpu();
+
+	ring = per_cpu_ptr(consumer->ring_buffers, cpu);
+	if(ring && ring->info)
+		ring->info->n_suppressed++;
+	put_cpu();
+}
+
+#ifndef ANON_INODE_FS_MAGIC
+#define ANON_INODE_FS_MAGIC 0x09041934
+#endif
+
+/*
+ * Classify an fd of the current task as one of the `PPM_FD_TYPE_*` values,
+ * the same way the modern probe does. Return 0 if the fd can't be resolved.
+ */
+static uint32_t ppm_get_fd_type(int64_t fd) {
+	struct files_struct *files;
+	struct fdtable *fdt;
+	struct inode *inode;
+	struct file *file;
+	uint32_t type = 0;
+
+	if(fd < 0)
+		return 0;
+
+	files = current->files;
+	if(unlikely(!files))
+		return 0;
+
+	spin_lock(&files->file_lock);
+	fdt = files_fdtable(files);
+	if(unlikely(fd >= fdt->max_fds))
+		goto out_unlock;
+
+	file = fdt->fd[fd];
+	if(unlikely(!file))
+		goto out_unlock;
+
+	inode = file_inode(file);
+	if(unlikely(!inode))
+		goto out_unlock;
+
+	switch(inode->i_mode & S_IFMT) {
+	case S_IFREG:
+	case S_IFLNK:
+		type = PPM_FD_TYPE_FILE;
+		break;
+	case S_IFDIR:
+		type = PPM_FD_TYPE_DIRECTORY;
+		break;
+	case S_IFSOCK:
+		type = PPM_FD_TYPE_SOCKET;
+		break;
+	case S_IFIFO:
+		type = PPM_FD_TYPE_PIPE;
+		break;
+	case S_IFCHR:
+	case S_IFBLK:
+		type = PPM_FD_TYPE_DEVICE;
+		break;
+	default:
+		if(inode->i_sb && inode->i_sb->s_magic == ANON_INODE_FS_MAGIC)
+			type = PPM_FD_TYPE_ANON_INODE;
+		else
+			type = PPM_FD_TYPE_OTHER;
+		break;
+	}
+
+out_unlock:
+	spin_unlock(&files->file_lock);
+	return type;
+}
+
+/*
+ * Return true if `event_type` is an I/O event whose fd type is not in the
+ * consumer mask. The fd is the first syscall argument for all of them, the
+ * output one for sendfile. Events on fds that can't be resolved are kept.
+ */
+static bool consumer_is_fd_type_filtered(struct ppm_consumer_t *consumer,
+                                         ppm_event_code event_type,
+                                         struct event_filler_arguments *args) {
+	uint32_t mask = READ_ONCE(consumer->io_fd_type_mask);
+	uint32_t type;
+
+	if(likely(mask == 0))
+		return false;
+
+	switch(event_type) {
+	case PPME_SYSCALL_READ_E:
+	case PPME_SYSCALL_READ_X:
+	case PPME_SYSCALL_WRITE_E:
+	case PPME_SYSCALL_WRITE_X:
+	case PPME_SYSCALL_PREAD_E:
+	case PPME_SYSCALL_PREAD_X:
+	case PPME_SYSCALL_PWRITE_E:
+	case PPME_SYSCALL_PWRITE_X:
+	case PPME_SYSCALL_READV_E:
+	case PPME_SYSCALL_READV_X:
+	case PPME_SYSCALL_WRITEV_E:
+	case PPME_SYSCALL_WRITEV_X:
+	case PPME_SYSCALL_PREADV_E:
+	case PPME_SYSCALL_PREADV_X:
+	case PPME_SYSCALL_PWRITEV_E:
+	case PPME_SYSCALL_PWRITEV_X:
+	case PPME_SYSCALL_SENDFILE_E:
+	case PPME_SYSCALL_SENDFILE_X:
+	case PPME_SOCKET_RECV_E:
+	case PPME_SOCKET_RECV_X:
+	case PPME_SOCKET_RECVFROM_E:
+	case PPME_SOCKET_RECVFROM_X:
+	case PPME_SOCKET_RECVMSG_E:
+	case PPME_SOCKET_RECVMSG_X:
+	case PPME_SOCKET_RECVMMSG_E:
+	case PPME_SOCKET_RECVMMSG_X:
+	case PPME_SOCKET_SEND_E:
+	case PPME_SOCKET_SEND_X:
+	case PPME_SOCKET_SENDTO_E:
+	case PPME_SOCKET_SENDTO_X:
+	case PPME_SOCKET_SENDMSG_E:
+	case PPME_SOCKET_SENDMSG_X:
+	case PPME_SOCKET_SENDMMSG_E:
+	case PPME_SOCKET_SENDMMSG_X:
+		break;
+	default:
+		return false;
+	}
+
+	type = ppm_get_fd_type((int32_t)args->args[0]);
+	return type != 0 && !(type & mask);
+}
+
+static void consumer_count_fd_type_filtered(struct ppm_consumer_t *consumer) {
+	struct ppm_ring_buffer_context *ring;
+	int cpu = get_cpu();
+
+	ring = per_cpu_ptr(consumer->ring_buffers, cpu);
+	if(ring && ring->info)
+		ring->info->n_fd_type_filtered++;
+	put_cpu();
+}
+
 static void check_remove_consumer(struct ppm_consumer_t *consumer, int remove_from_list) {
 	int cpu;
 	int open_rings = 0;
@@ -359,6 +689,10 @@ static void check_remove_consumer(struct ppm_consumer_t *consumer, int remove_fr
 
 		free_percpu(consumer->ring_buffers);
 
+		consumer_clear_suppressed(consumer);
+		/* Wait for the suppressed tgids to be freed before the consumer. */
+		rcu_barrier();
+
 		vfree(consumer);
 	}
 }
@@ -414,6 +748,11 @@ static int ppm_open(struct inode *inode, struct file *filp) {
 		consumer->buffer_bytes_dim = g_buffer_bytes_dim;
 		consumer->tracepoints_attached = 0; /* Start with no tracepoints */
 		consumer->hotplug_cpu = -1;
+		hash_init(consumer->suppressed_tgids);
+		atomic_set(&consumer->n_suppressed_tgids, 0);
+		consumer->n_suppressed_comms = 0;
+		spin_lock_init(&consumer->suppress_lock);
+		consumer->io_fd_type_mask = 0;
 
 		/*
 		 * Initialize the ring buffers array
@@ -1101,6 +1440,40 @@ static long ppm_ioctl(struct file *filp, unsigned int cmd, unsigned long arg) {
 		ret = 0;
 		goto cleanup_ioctl;
 	}
+	case PPM_IOCTL_SUPPRESS_TGID: {
+		ret = consumer_suppress_tgid(consumer, (pid_t)arg, GFP_KERNEL);
+		goto cleanup_ioctl;
+	}
+	case PPM_IOCTL_UNSUPPRESS_TGID: {
+		consumer_unsuppress_tgid(consumer, (pid_t)arg);
+		ret = 0;
+		goto cleanup_ioctl;
+	}
+	case PPM_IOCTL_SUPPRESS_COMM:
+	case PPM_IOCTL_UNSUPPRESS_COMM: {
+		char comm[PPM_COMM_LEN];
+
+		if(copy_from_user(comm, (void __user *)arg, sizeof(comm))) {
+			ret = -EINVAL;
+			goto cleanup_ioctl;
+		}
+		comm[PPM_COMM_LEN - 1] = '\0';
+		ret = consumer_suppress_comm(consumer, comm, cmd == PPM_IOCTL_SUPPRESS_COMM);
+		goto cleanup_ioctl;
+	}
+	case PPM_IOCTL_CLEAR_SUPPRESSED: {
+		consumer_clear_suppressed(consumer);
+		ret = 0;
+		goto cleanup_ioctl;
+	}
+	case PPM_IOCTL_SET_IO_FD_TYPE_MASK: {
+		WRITE_ONCE(consumer->io_fd_type_mask, (uint32_t)arg);
+		vpr_info("PPM_IOCTL_SET_IO_FD_TYPE_MASK (0x%x), consumer %p\n",
+		         (uint32_t)arg,
+		         consumer_id);
+		ret = 0;
+		goto cleanup_ioctl;
+	}
 	default:
 		ret = -ENOTTY;
 		goto cleanup_ioctl;
@@ -1628,6 +2001,16 @@ static int record_event_consumer(struct ppm_consumer_t *consumer,
 		if(event_type == PPME_SOCKET_SENDMMSG_X || event_type == PPME_SOCKET_RECVMMSG_X) {
 			args.mmsg.index = event_datap->event_info.syscall_data.mmsg.index;
 		}
+
+		if(consumer_is_fd_type_filtered(consumer, event_type, &args)) {
+			consumer_count_fd_type_filtered(consumer);
+			return res;
+		}
+	}
+
+	if(consumer_is_suppressed_event(consumer, event_type, event_datap, tp_type)) {
+		consumer_count_suppressed(consumer);
+		return res;
 	}
 
 	if(event_type != PPME_DROP_E && event_type != PPME_DROP_X) {
@@ -2501,6 +2884,8 @@ static void reset_ring_buffer(struct ppm_ring_buffer_context *ring) {
 	ring->info->n_drops_pf = 0;
 	ring->info->n_preemptions = 0;
 	ring->info->n_context_switches = 0;
+	ring->info->n_suppressed = 0;
+	ring->info->n_fd_type_filtered = 0;
 	ring->last_print_time = ppm_nsecs();
 }
 
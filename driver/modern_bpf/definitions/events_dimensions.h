@@ -119,5 +119,7 @@
 #define TASK_FILE_SOCKET_INET6_E_SIZE HEADER_LEN + 16 * 2 + sizeof(int32_t) + sizeof(uint16_t) * 4 + sizeof(uint64_t) + PARAM_LEN * 8
 #define TASK_FILE_SOCKET_NETLINK_E_SIZE HEADER_LEN + sizeof(int32_t) + sizeof(uint16_t) * 2 + sizeof(uint64_t) + PARAM_LEN * 4
 #define CLOSE_RANGE_X_SIZE HEADER_LEN + sizeof(int64_t) + sizeof(uint32_t) * 3 + PARAM_LEN * 4
+#define RATE_LIMIT_E_SIZE HEADER_LEN + sizeof(uint64_t) * 2 + PARAM_LEN * 2
+#define IO_SUMMARY_E_SIZE HEADER_LEN + sizeof(int64_t) + sizeof(uint8_t) + sizeof(uint64_t) * 4 + PARAM_LEN * 6
 
 #endif /* __EVENT_DIMENSIONS_H__ */
@@ -112,6 +112,42 @@ static __always_inline int32_t maps__get_scap_tid() {
 	return settings->scap_tid;
 }
 
+static __always_inline bool maps__get_suppression_enabled() {
+	struct capture_settings *settings = maps__get_capture_settings();
+	if(settings == NULL) {
+		return false;
+	}
+
+	return settings->suppression_enabled;
+}
+
+static __always_inline uint8_t maps__get_cgroup_filter_mode() {
+	struct capture_settings *settings = maps__get_capture_settings();
+	if(settings == NULL) {
+		return CGROUP_FILTER_DISABLED;
+	}
+
+	return settings->cgroup_filter_mode;
+}
+
+static __always_inline uint64_t maps__get_io_aggregation_interval() {
+	struct capture_settings *settings = maps__get_capture_settings();
+	if(settings == NULL) {
+		return 0;
+	}
+
+	return settings->io_aggregation_interval;
+}
+
+static __always_inline uint32_t maps__get_io_fd_type_mask() {
+	struct capture_settings *settings = maps__get_capture_settings();
+	if(settings == NULL) {
+		return 0;
+	}
+
+	return settings->io_fd_type_mask;
+}
+
 /*=============================== SETTINGS ===========================*/
 
 /*=============================== KERNEL CONFIGS ===========================*/
@@ -134,6 +170,38 @@ static __always_inline void maps__set_socket_file_ops(void *value) {
 
 /*=============================== KERNEL CONFIGS ===========================*/
 
+/*=============================== SUPPRESSION ===========================*/
+
+static __always_inline bool maps__is_suppressed_tgid(uint32_t tgid) {
+	return bpf_map_lookup_elem(&suppressed_tgids, &tgid) != NULL;
+}
+
+static __always_inline void maps__suppress_tgid(uint32_t tgid) {
+	uint8_t one = 1;
+	/* If the map is full the events of the thread group are still
+	 * suppressed in userspace.
+	 */
+	bpf_map_update_elem(&suppressed_tgids, &tgid, &one, BPF_ANY);
+}
+
+static __always_inline void maps__unsuppress_tgid(uint32_t tgid) {
+	bpf_map_delete_elem(&suppressed_tgids, &tgid);
+}
+
+static __always_inline bool maps__is_suppressed_comm(struct suppressed_comm *comm) {
+	return bpf_map_lookup_elem(&suppressed_comms, comm) != NULL;
+}
+
+/*=============================== SUPPRESSION ===========================*/
+
+/*=============================== CGROUP FILTER ===========================*/
+
+static __always_inline bool maps__is_in_cgroup_filter(uint64_t cgroup_id) {
+	return bpf_map_lookup_elem(&cgroup_filter, &cgroup_id) != NULL;
+}
+
+/*=============================== CGROUP FILTER ===========================*/
+
 /*=============================== SAMPLING TABLES ===========================*/
 
 static __always_inline uint8_t maps__64bit_sampling_syscall_table(uint32_t syscall_id) {
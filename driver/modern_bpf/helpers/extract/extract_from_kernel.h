@@ -1144,6 +1144,52 @@ static __always_inline struct socket *extract__socket_from_file(struct file *fil
 	return (struct socket *)BPF_CORE_READ(file, private_data);
 }
 
+/**
+ * @brief Classify a file like the `task_file` iterator does.
+ * @param file pointer to the file struct.
+ * @return one of the `PPM_FD_TYPE_*` values, 0 if `file` is NULL.
+ */
+static __always_inline uint32_t extract__fd_type_from_file(struct file *file) {
+	if(file == NULL) {
+		return 0;
+	}
+
+	/* Sockets are the most common case of the I/O prefilter, check them without
+	 * dereferencing the inode.
+	 */
+	if(BPF_CORE_READ(file, f_op) == maps__get_socket_file_ops()) {
+		return PPM_FD_TYPE_SOCKET;
+	}
+
+	struct inode *inode = BPF_CORE_READ(file, f_inode);
+	if(inode == NULL) {
+		return PPM_FD_TYPE_OTHER;
+	}
+
+	umode_t i_mode = BPF_CORE_READ(inode, i_mode);
+	switch(i_mode & S_IFMT) {
+	case S_IFREG:
+	case S_IFLNK:
+		return PPM_FD_TYPE_FILE;
+	case S_IFDIR:
+		return PPM_FD_TYPE_DIRECTORY;
+	case S_IFSOCK:
+		return PPM_FD_TYPE_SOCKET;
+	case S_IFIFO:
+		return PPM_FD_TYPE_PIPE;
+	case S_IFBLK:
+	case S_IFCHR:
+		return PPM_FD_TYPE_DEVICE;
+	default:
+		break;
+	}
+
+	if(extract__fs_magic_from_inode(inode) == ANON_INODE_FS_MAGIC) {
+		return PPM_FD_TYPE_ANON_INODE;
+	}
+	return PPM_FD_TYPE_OTHER;
+}
+
 ///////////////////////////
 // EXTRACT FROM MSGHDR
 ///////////////////////////
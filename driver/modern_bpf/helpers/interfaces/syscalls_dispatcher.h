@@ -17,6 +17,237 @@ static __always_inline bool syscalls_dispatcher__64bit_interesting_syscall(uint3
 	return maps__interesting_syscall_64bit(syscall_id);
 }
 
+static __always_inline bool syscalls_dispatcher__is_process_creation(uint32_t syscall_id) {
+	switch(syscall_id) {
+#ifdef __NR_clone
+	case __NR_clone:
+#endif
+#ifdef __NR_clone3
+	case __NR_clone3:
+#endif
+#ifdef __NR_fork
+	case __NR_fork:
+#endif
+#ifdef __NR_vfork
+	case __NR_vfork:
+#endif
+		return true;
+	default:
+		return false;
+	}
+}
+
+static __always_inline bool syscalls_dispatcher__is_execve(uint32_t syscall_id) {
+	switch(syscall_id) {
+#ifdef __NR_execve
+	case __NR_execve:
+#endif
+#ifdef __NR_execveat
+	case __NR_execveat:
+#endif
+		return true;
+	default:
+		return false;
+	}
+}
+
+static __always_inline bool syscalls_dispatcher__is_close(uint32_t syscall_id) {
+#ifdef __NR_close
+	return syscall_id == __NR_close;
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Return the direction of the I/O syscalls folded by the I/O
+ * aggregation, `-1` for all the other syscalls.
+ *
+ * Only the syscalls returning the number of transferred bytes are folded,
+ * so `sendmmsg`/`recvmmsg`, `sendfile` and `splice` always send their events.
+ *
+ * @param syscall_id 64-bit syscall id.
+ * @return `PPM_IO_SUMMARY_IN`, `PPM_IO_SUMMARY_OUT` or `-1`.
+ */
+static __always_inline int syscalls_dispatcher__io_direction(uint32_t syscall_id) {
+	switch(syscall_id) {
+#ifdef __NR_read
+	case __NR_read:
+#endif
+#ifdef __NR_readv
+	case __NR_readv:
+#endif
+#ifdef __NR_pread64
+	case __NR_pread64:
+#endif
+#ifdef __NR_preadv
+	case __NR_preadv:
+#endif
+#ifdef __NR_recv
+	case __NR_recv:
+#endif
+#ifdef __NR_recvfrom
+	case __NR_recvfrom:
+#endif
+#ifdef __NR_recvmsg
+	case __NR_recvmsg:
+#endif
+		return PPM_IO_SUMMARY_IN;
+#ifdef __NR_write
+	case __NR_write:
+#endif
+#ifdef __NR_writev
+	case __NR_writev:
+#endif
+#ifdef __NR_pwrite64
+	case __NR_pwrite64:
+#endif
+#ifdef __NR_pwritev
+	case __NR_pwritev:
+#endif
+#ifdef __NR_send
+	case __NR_send:
+#endif
+#ifdef __NR_sendto
+	case __NR_sendto:
+#endif
+#ifdef __NR_sendmsg
+	case __NR_sendmsg:
+#endif
+		return PPM_IO_SUMMARY_OUT;
+	default:
+		return -1;
+	}
+}
+
+/**
+ * @brief Check whether the current syscall is an I/O one whose fd type is not
+ * in the `io_fd_type_mask` capture setting.
+ *
+ * The I/O syscalls are the ones folded by the I/O aggregation plus
+ * `sendmmsg`/`recvmmsg` and `sendfile`, all having the fd as first argument
+ * (the output one for `sendfile`). Events on fds that can't be resolved, e.g.
+ * closed by another thread meanwhile, are kept.
+ *
+ * @param regs syscall registers.
+ * @param syscall_id 64-bit syscall id.
+ * @return true if the event must be dropped.
+ */
+static __always_inline bool syscalls_dispatcher__is_fd_type_filtered(struct pt_regs *regs,
+                                                                     uint32_t syscall_id) {
+	uint32_t mask = maps__get_io_fd_type_mask();
+	if(mask == 0) {
+		return false;
+	}
+
+	switch(syscall_id) {
+#ifdef __NR_sendfile
+	case __NR_sendfile:
+#endif
+#ifdef __NR_sendmmsg
+	case __NR_sendmmsg:
+#endif
+#ifdef __NR_recvmmsg
+	case __NR_recvmmsg:
+#endif
+		break;
+	default:
+		if(syscalls_dispatcher__io_direction(syscall_id) < 0) {
+			return false;
+		}
+		break;
+	}
+
+	unsigned long fd = 0;
+	extract__network_args(&fd, 1, regs);
+	uint32_t type = extract__fd_type_from_file(extract__file_struct_from_fd((int32_t)fd));
+	return type != 0 && !(type & mask);
+}
+
+/**
+ * @brief Check whether the events of the current task are filtered out by its
+ * cgroup, according to the `cgroup_filter` map and mode.
+ *
+ * Process creation and execve events always pass, otherwise userspace would
+ * miss the new threads (e.g. the ones moving to an allowed cgroup) and their
+ * executables. The proc exit event is sent by a tracepoint not affected by the
+ * filter.
+ *
+ * @param syscall_id 64-bit syscall id.
+ * @return true if the event must be dropped.
+ */
+static __always_inline bool syscalls_dispatcher__is_cgroup_filtered(uint32_t syscall_id) {
+	uint8_t mode = maps__get_cgroup_filter_mode();
+	if(mode == CGROUP_FILTER_DISABLED) {
+		return false;
+	}
+
+	if(syscalls_dispatcher__is_process_creation(syscall_id) ||
+	   syscalls_dispatcher__is_execve(syscall_id)) {
+		return false;
+	}
+
+	bool found = maps__is_in_cgroup_filter(bpf_get_current_cgroup_id());
+	return mode == CGROUP_FILTER_ALLOW ? !found : found;
+}
+
+/**
+ * @brief Check whether the events of the current task are suppressed, mirroring
+ * the userspace logic of `sinsp_suppress`:
+ * - the events of the suppressed thread groups are dropped;
+ * - a new process whose parent is suppressed is suppressed as well;
+ * - a process calling execve is suppressed if its new comm is suppressed.
+ *
+ * The event that makes a thread group suppressed (clone child or execve) is
+ * still sent, so that userspace can keep its own set of suppressed tids in
+ * sync, while all the following ones are dropped here.
+ *
+ * @param syscall_id 64-bit syscall id.
+ * @param ret syscall return value.
+ * @return true if the event must be dropped.
+ */
+static __always_inline bool syscalls_dispatcher__is_suppressed(uint32_t syscall_id, long ret) {
+	if(!maps__get_suppression_enabled()) {
+		return false;
+	}
+
+	uint64_t pid_tgid = bpf_get_current_pid_tgid();
+	uint32_t tgid = pid_tgid >> 32;
+	if(maps__is_suppressed_tgid(tgid)) {
+		return true;
+	}
+
+	/* Both the clone child and a successful execve return 0. */
+	if(ret != 0) {
+		return false;
+	}
+
+	if(syscalls_dispatcher__is_process_creation(syscall_id)) {
+		/* Threads share the tgid of their creator, already checked above. */
+		if((uint32_t)pid_tgid != tgid) {
+			return false;
+		}
+		struct task_struct *task = get_current_task();
+		uint32_t parent_tgid = 0;
+		READ_TASK_FIELD_INTO(&parent_tgid, task, real_parent, tgid);
+		if(maps__is_suppressed_tgid(parent_tgid)) {
+			maps__suppress_tgid(tgid);
+		}
+		return false;
+	}
+
+	if(syscalls_dispatcher__is_execve(syscall_id)) {
+		struct suppressed_comm comm = {};
+		bpf_get_current_comm(comm.comm, sizeof(comm.comm));
+		if(maps__is_suppressed_comm(&comm)) {
+			maps__suppress_tgid(tgid);
+		}
+		return false;
+	}
+
+	return false;
+}
+
 /**
  * @brief Check whether the current syscall is a SYS_ACCEPT socketcall routed
  * to the accept4 handler.
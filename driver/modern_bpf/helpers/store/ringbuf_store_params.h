@@ -13,21 +13,24 @@
 #include <helpers/extract/extract_from_kernel.h>
 #include <helpers/base/stats.h>
 
-/* `reserved_size - sizeof(uint64_t)` free space is enough because this is the max dimension
- * we put in the ring buffer in one atomic operation.
+/* Bound `pos` so that the verifier knows there are always `size` free bytes after it. Writes
+ * inside the reserved space are left untouched: this matters when `pos` is not known at
+ * compile time, e.g. for the params that follow a bytebuf, see
+ * `ringbuf__reserve_bytebuf_event_space`.
  */
-#define CHECK_RINGBUF_SPACE(pos, reserved_size) \
-	pos >= reserved_size ? reserved_size - sizeof(uint64_t) : pos
-
-#define PUSH_FIXED_SIZE_TO_RINGBUF(ringbuf, param, size)                                         \
-	__builtin_memcpy(&ringbuf->data[CHECK_RINGBUF_SPACE(ringbuf->payload_pos,                    \
-	                                                    ringbuf->reserved_event_size)],          \
-	                 &param,                                                                     \
-	                 size);                                                                      \
-	ringbuf->payload_pos += size;                                                                \
-	*((uint16_t *)&ringbuf                                                                       \
-	          ->data[CHECK_RINGBUF_SPACE(ringbuf->lengths_pos, ringbuf->reserved_event_size)]) = \
-	        size;                                                                                \
+#define CHECK_RINGBUF_SPACE(pos, reserved_size, size) \
+	pos > reserved_size - size ? reserved_size - size : pos
+
+#define PUSH_FIXED_SIZE_TO_RINGBUF(ringbuf, param, size)                                 \
+	__builtin_memcpy(&ringbuf->data[CHECK_RINGBUF_SPACE(ringbuf->payload_pos,            \
+	                                                    ringbuf->reserved_event_size,    \
+	                                                    size)],                          \
+	                 &param,                                                             \
+	                 size);                                                              \
+	ringbuf->payload_pos += size;                                                        \
+	*((uint16_t *)&ringbuf->data[CHECK_RINGBUF_SPACE(ringbuf->lengths_pos,               \
+	                                                 ringbuf->reserved_event_size,       \
+	                                                 sizeof(uint16_t))]) = size;         \
 	ringbuf->lengths_pos += sizeof(uint16_t);
 
 /* Concept of ringbuf(ring buffer):
@@ -129,6 +132,67 @@ static __always_inline uint32_t ringbuf__reserve_space(struct ringbuf_struct *ri
 	return 1;
 }
 
+/* Variable-size events with a single bytebuf param (read, write...) can be
+ * written straight into the ringbuf, reading the user data just once, instead
+ * of being assembled in the auxmap and then copied with `bpf_ringbuf_output`.
+ *
+ * Since `bpf_ringbuf_reserve` needs a size known at compile time, we reserve
+ * the smallest size class that fits the event, and the record keeps the whole
+ * reserved size even if the event (`hdr->len`) is shorter: userspace moves on
+ * using the ringbuf record length. To bound the wasted space, only bytebufs of
+ * at least `DIRECT_EVENT_MIN_BYTEBUF` bytes take this path, smaller events are
+ * cheap to copy and keep using the auxmap.
+ *
+ * All the other params of these events must fit in `DIRECT_EVENT_MAX_FIXED_PART`
+ * bytes, header and lengths array included.
+ */
+#define DIRECT_EVENT_MAX_FIXED_PART 128
+#define DIRECT_EVENT_MIN_BYTEBUF 512
+#define DIRECT_EVENT_MAX_SIZE 32 * 1024
+
+enum direct_reserve_result {
+	DIRECT_RESERVED = 0, /* the space is reserved, the event must be submitted. */
+	DIRECT_DROPPED = 1,  /* the ringbuf is full, the event is already accounted as dropped. */
+	DIRECT_FALLBACK = 2, /* the event must be collected in the auxmap. */
+};
+
+/**
+ * @brief Reserve the ringbuf space for a variable-size event whose only
+ * variable param is a bytebuf of `bytebuf_len` bytes, see the comment above.
+ *
+ * @param ringbuf pointer to the `ringbuf_struct`
+ * @param bytebuf_len bytes of the bytebuf param.
+ * @param event_type event type.
+ * @return a `direct_reserve_result`.
+ */
+static __always_inline enum direct_reserve_result ringbuf__reserve_bytebuf_event_space(
+        struct ringbuf_struct *ringbuf,
+        uint16_t bytebuf_len,
+        uint16_t event_type) {
+	uint32_t needed = DIRECT_EVENT_MAX_FIXED_PART + bytebuf_len;
+	uint32_t reserved = 0;
+
+	if(bytebuf_len < DIRECT_EVENT_MIN_BYTEBUF || needed > DIRECT_EVENT_MAX_SIZE) {
+		return DIRECT_FALLBACK;
+	}
+
+	/* Every branch passes a constant size, as required by `bpf_ringbuf_reserve`. */
+	if(needed <= 1024) {
+		reserved = ringbuf__reserve_space(ringbuf, 1024, event_type);
+	} else if(needed <= 2 * 1024) {
+		reserved = ringbuf__reserve_space(ringbuf, 2 * 1024, event_type);
+	} else if(needed <= 4 * 1024) {
+		reserved = ringbuf__reserve_space(ringbuf, 4 * 1024, event_type);
+	} else if(needed <= 8 * 1024) {
+		reserved = ringbuf__reserve_space(ringbuf, 8 * 1024, event_type);
+	} else if(needed <= 16 * 1024) {
+		reserved = ringbuf__reserve_space(ringbuf, 16 * 1024, event_type);
+	} else {
+		reserved = ringbuf__reserve_space(ringbuf, DIRECT_EVENT_MAX_SIZE, event_type);
+	}
+	return reserved ? DIRECT_RESERVED : DIRECT_DROPPED;
+}
+
 /////////////////////////////////
 // STORE EVENT HEADER IN THE RINGBUF
 ////////////////////////////////
@@ -151,6 +215,18 @@ static __always_inline void ringbuf__store_event_header(struct ringbuf_struct *r
 	ringbuf->lengths_pos = sizeof(struct ppm_evt_hdr);
 }
 
+/**
+ * @brief Write the actual event len in the header of an event reserved with
+ * `ringbuf__reserve_bytebuf_event_space`, that can be shorter than the
+ * reserved space.
+ *
+ * @param ringbuf pointer to the `ringbuf_struct`.
+ */
+static __always_inline void ringbuf__finalize_event_header(struct ringbuf_struct *ringbuf) {
+	struct ppm_evt_hdr *hdr = (struct ppm_evt_hdr *)ringbuf->data;
+	hdr->len = ringbuf->payload_pos;
+}
+
 static __always_inline void ringbuf__rewrite_header_for_calibration(struct ringbuf_struct *ringbuf,
                                                                     pid_t vtid) {
 	struct ppm_evt_hdr *hdr = (struct ppm_evt_hdr *)ringbuf->data;
@@ -291,6 +367,51 @@ static __always_inline void ringbuf__store_u64(struct ringbuf_struct *ringbuf, u
 	PUSH_FIXED_SIZE_TO_RINGBUF(ringbuf, param, sizeof(uint64_t));
 }
 
+/**
+ * @brief This helper stores the bytebuf pointed by `bytebuf_pointer` into the
+ * space reserved with `ringbuf__reserve_bytebuf_event_space`. It mirrors
+ * `auxmap__store_bytebuf_param`: if we are not able to read exactly
+ * `len_to_read` bytes we push an empty param, so param_len=0.
+ *
+ * @param ringbuf pointer to the `ringbuf_struct`.
+ * @param bytebuf_pointer pointer to the bytebuf.
+ * @param len_to_read bytes that we need to read from the pointer.
+ * @param mem from which memory we need to read: user-space or kernel-space.
+ * @return number of bytes read.
+ */
+static __always_inline uint16_t ringbuf__store_bytebuf_param(struct ringbuf_struct *ringbuf,
+                                                             unsigned long bytebuf_pointer,
+                                                             uint16_t len_to_read,
+                                                             enum read_memory mem) {
+	uint16_t bytebuf_len = 0;
+	uint64_t pos = ringbuf->payload_pos;
+	uint32_t max_len = ringbuf->reserved_event_size - DIRECT_EVENT_MAX_FIXED_PART;
+
+	/* The two bounds let the verifier know that `pos + len_to_read` never
+	 * exceeds the reserved space.
+	 */
+	if(bytebuf_pointer && len_to_read > 0 && pos < DIRECT_EVENT_MAX_FIXED_PART &&
+	   len_to_read <= max_len) {
+		pos &= DIRECT_EVENT_MAX_FIXED_PART - 1;
+		long err;
+		if(mem == KERNEL) {
+			err = bpf_probe_read_kernel(&ringbuf->data[pos], len_to_read, (void *)bytebuf_pointer);
+		} else {
+			err = bpf_probe_read_user(&ringbuf->data[pos], len_to_read, (void *)bytebuf_pointer);
+		}
+		if(err == 0) {
+			bytebuf_len = len_to_read;
+			ringbuf->payload_pos += len_to_read;
+		}
+	}
+
+	*((uint16_t *)&ringbuf->data[CHECK_RINGBUF_SPACE(ringbuf->lengths_pos,
+	                                                 ringbuf->reserved_event_size,
+	                                                 sizeof(uint16_t))]) = bytebuf_len;
+	ringbuf->lengths_pos += sizeof(uint16_t);
+	return bytebuf_len;
+}
+
 /**
  * @brief Store the size of a message extracted from an `iovec` struct array.
  *
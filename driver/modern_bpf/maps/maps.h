@@ -205,6 +205,75 @@ struct {
 
 /*=============================== BPF_MAP_TYPE_ARRAY ===============================*/
 
+/*=============================== BPF_MAP_TYPE_HASH ===============================*/
+
+/**
+ * @brief Thread groups whose events are suppressed. Filled by userspace and
+ * by the BPF programs when a suppressed thread group forks or when a task
+ * with a suppressed comm calls execve. Entries are removed when the thread
+ * group leader exits.
+ */
+struct {
+	__uint(type, BPF_MAP_TYPE_HASH);
+	__uint(max_entries, MAX_SUPPRESSED_TGIDS);
+	__type(key, uint32_t);
+	__type(value, uint8_t);
+} suppressed_tgids __weak SEC(".maps");
+
+/**
+ * @brief Comms whose events are suppressed. Filled only by userspace.
+ */
+struct {
+	__uint(type, BPF_MAP_TYPE_HASH);
+	__uint(max_entries, MAX_SUPPRESSED_COMMS);
+	__type(key, struct suppressed_comm);
+	__type(value, uint8_t);
+} suppressed_comms __weak SEC(".maps");
+
+/**
+ * @brief Cgroup ids (as returned by `bpf_get_current_cgroup_id`) allowed or
+ * denied depending on `capture_settings.cgroup_filter_mode`. Filled only by
+ * userspace.
+ */
+struct {
+	__uint(type, BPF_MAP_TYPE_HASH);
+	__uint(max_entries, MAX_CGROUP_FILTER_IDS);
+	__type(key, uint64_t);
+	__type(value, uint8_t);
+} cgroup_filter __weak SEC(".maps");
+
+/*=============================== BPF_MAP_TYPE_HASH ===============================*/
+
+/*=============================== BPF_MAP_TYPE_LRU_HASH ===============================*/
+
+/**
+ * @brief Token buckets of the rate limiter, one for each thread group. The
+ * entries are never removed by the BPF programs so that userspace can read the
+ * per-process drop counters even after the process exits: the least recently
+ * used ones are evicted when the map is full.
+ */
+struct {
+	__uint(type, BPF_MAP_TYPE_LRU_HASH);
+	__uint(max_entries, MAX_RATE_LIMITED_TGIDS);
+	__type(key, uint32_t);
+	__type(value, struct rate_limit_bucket);
+} rate_limit_buckets __weak SEC(".maps");
+
+/**
+ * @brief I/O syscalls folded by the I/O aggregation, one entry for each
+ * (thread, fd, direction). The entries are removed when the fd is closed by
+ * the same thread, otherwise the least recently used ones are evicted, and
+ * the syscalls folded since their last `io_summary` event are lost.
+ */
+struct {
+	__uint(type, BPF_MAP_TYPE_LRU_HASH);
+	__uint(max_entries, MAX_IO_AGGREGATION_ENTRIES);
+	__type(key, struct io_aggregation_key);
+	__type(value, struct io_aggregation_entry);
+} io_aggregation __weak SEC(".maps");
+
+/*=============================== BPF_MAP_TYPE_LRU_HASH ===============================*/
+
 /*=============================== RINGBUF MAP ===============================*/
 
 /**
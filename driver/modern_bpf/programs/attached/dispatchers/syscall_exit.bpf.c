@@ -172,6 +172,229 @@ static __always_inline bool sampling_logic_exit(void *ctx, uint32_t id) {
 	return false;
 }
 
+static __always_inline void rate_limit__send_summary(struct rate_limit_bucket *bucket,
+                                                    uint64_t now) {
+	struct ringbuf_struct ringbuf;
+	if(!ringbuf__reserve_space(&ringbuf, RATE_LIMIT_E_SIZE, PPME_RATE_LIMIT_E)) {
+		/* We will try again with the next event. */
+		return;
+	}
+
+	ringbuf__store_event_header(&ringbuf);
+
+	/*=============================== COLLECT PARAMETERS ===========================*/
+
+	/* Parameter 1: skipped (type: PT_UINT64) */
+	ringbuf__store_u64(&ringbuf, bucket->n_skipped);
+
+	/* Parameter 2: duration (type: PT_RELTIME) */
+	ringbuf__store_u64(&ringbuf, now - bucket->throttle_start);
+
+	/*=============================== COLLECT PARAMETERS ===========================*/
+
+	ringbuf__submit_event(&ringbuf);
+	bucket->n_skipped = 0;
+}
+
+/* Per-process token bucket: each event of a thread group consumes a token, and
+ * tokens are refilled at `rate_limit_rate` per second up to `rate_limit_burst`.
+ * When a thread group runs out of tokens its events are skipped, and the first
+ * event sent afterwards is preceded by a `PPME_RATE_LIMIT_E` event reporting
+ * how many were skipped. Unlike the sampling logic, a noisy process doesn't
+ * cost the visibility on the other ones.
+ * PLEASE NOTE: buckets are shared among CPUs without locking so it is best effort!
+ */
+static __always_inline bool rate_limit_logic_exit(uint32_t id) {
+	struct capture_settings *settings = maps__get_capture_settings();
+	if(settings == NULL || settings->rate_limit_rate == 0) {
+		return false;
+	}
+
+	/* The syscalls we never drop in the sampling logic keep the userspace state consistent. */
+	if(maps__64bit_sampling_syscall_table(id) == UF_NEVER_DROP) {
+		return false;
+	}
+
+	uint64_t rate = settings->rate_limit_rate;
+	uint64_t burst = settings->rate_limit_burst;
+	uint64_t now = bpf_ktime_get_boot_ns();
+	uint32_t tgid = bpf_get_current_pid_tgid() >> 32;
+
+	struct rate_limit_bucket *bucket = bpf_map_lookup_elem(&rate_limit_buckets, &tgid);
+	if(bucket == NULL) {
+		struct rate_limit_bucket new_bucket = {
+		        .tokens = burst > 0 ? burst - 1 : 0,
+		        .last_refill = now,
+		};
+		bpf_map_update_elem(&rate_limit_buckets, &tgid, &new_bucket, BPF_NOEXIST);
+		return false;
+	}
+
+	/* Only whole tokens are added, and `last_refill` moves forward just by the time they
+	 * account for, so that no fraction of a token is lost between two events.
+	 * `rate` and `burst` are 32-bit values so `burst * SECOND_TO_NS` can't overflow.
+	 */
+	if(now > bucket->last_refill) {
+		uint64_t elapsed = now - bucket->last_refill;
+		if(elapsed >= burst * SECOND_TO_NS / rate) {
+			bucket->tokens = burst;
+			bucket->last_refill = now;
+		} else {
+			uint64_t new_tokens = elapsed * rate / SECOND_TO_NS;
+			if(new_tokens > 0) {
+				bucket->tokens += new_tokens;
+				if(bucket->tokens > burst) {
+					bucket->tokens = burst;
+				}
+				bucket->last_refill += new_tokens * SECOND_TO_NS / rate;
+			}
+		}
+	}
+
+	if(bucket->tokens > 0) {
+		bucket->tokens--;
+		if(bucket->n_skipped > 0) {
+			rate_limit__send_summary(bucket, now);
+		}
+		return false;
+	}
+
+	if(bucket->n_skipped == 0) {
+		bucket->throttle_start = now;
+	}
+	bucket->n_skipped++;
+	bucket->n_drops++;
+
+	struct counter_map *counter = maps__get_counter_map();
+	if(counter != NULL) {
+		counter->n_drops_rate_limit++;
+	}
+	return true;
+}
+
+static __always_inline bool io_aggregation__send_summary(struct io_aggregation_key *key,
+                                                        struct io_aggregation_entry *entry) {
+	struct ringbuf_struct ringbuf;
+	if(!ringbuf__reserve_space(&ringbuf, IO_SUMMARY_E_SIZE, PPME_IO_SUMMARY_E)) {
+		/* The counters are kept, we will try again with the next event. */
+		return false;
+	}
+
+	ringbuf__store_event_header(&ringbuf);
+
+	/*=============================== COLLECT PARAMETERS ===========================*/
+
+	/* Parameter 1: fd (type: PT_FD) */
+	ringbuf__store_s64(&ringbuf, (int64_t)key->fd);
+
+	/* Parameter 2: direction (type: PT_ENUMFLAGS8) */
+	ringbuf__store_u8(&ringbuf, (uint8_t)key->direction);
+
+	/* Parameter 3: count (type: PT_UINT64) */
+	ringbuf__store_u64(&ringbuf, entry->count);
+
+	/* Parameter 4: bytes (type: PT_UINT64) */
+	ringbuf__store_u64(&ringbuf, entry->bytes);
+
+	/* Parameter 5: first_ts (type: PT_ABSTIME) */
+	ringbuf__store_u64(&ringbuf, entry->first_ts);
+
+	/* Parameter 6: last_ts (type: PT_ABSTIME) */
+	ringbuf__store_u64(&ringbuf, entry->last_ts);
+
+	/*=============================== COLLECT PARAMETERS ===========================*/
+
+	ringbuf__submit_event(&ringbuf);
+	entry->count = 0;
+	entry->bytes = 0;
+	return true;
+}
+
+/* Flush and forget the I/O folded on an fd closed by the current thread, so
+ * that the `io_summary` events precede the close one and the first I/O on the
+ * next file with the same fd number is sent again.
+ */
+static __always_inline void io_aggregation__flush_fd(struct io_aggregation_key *key) {
+	struct io_aggregation_entry *entry = bpf_map_lookup_elem(&io_aggregation, key);
+	if(entry == NULL) {
+		return;
+	}
+	if(entry->count > 0) {
+		io_aggregation__send_summary(key, entry);
+	}
+	bpf_map_delete_elem(&io_aggregation, key);
+}
+
+/* I/O aggregation: the first successful read-like and write-like syscall of a
+ * (thread, fd, direction) is sent as usual, the following ones are folded into
+ * a counter and summarized by a `PPME_IO_SUMMARY_E` event once every
+ * `io_aggregation_interval` ns, or when the thread closes the fd.
+ * A summary is sent by the next syscall folded after the interval elapsed, so
+ * an idle fd keeps its counters until it is used or closed again.
+ * PLEASE NOTE: the folded syscalls don't carry their data buffers or socket
+ * tuples, and the entries of the fds closed by other threads, or evicted from
+ * the LRU map, are lost.
+ */
+static __always_inline bool io_aggregation_logic_exit(struct pt_regs *regs,
+                                                      uint32_t id,
+                                                      long ret) {
+	uint64_t interval = maps__get_io_aggregation_interval();
+	if(interval == 0) {
+		return false;
+	}
+
+	struct io_aggregation_key key = {
+	        .tid = (uint32_t)bpf_get_current_pid_tgid(),
+	};
+
+	if(syscalls_dispatcher__is_close(id)) {
+		key.fd = (int32_t)extract__syscall_argument(regs, 0);
+		key.direction = PPM_IO_SUMMARY_IN;
+		io_aggregation__flush_fd(&key);
+		key.direction = PPM_IO_SUMMARY_OUT;
+		io_aggregation__flush_fd(&key);
+		return false;
+	}
+
+	int direction = syscalls_dispatcher__io_direction(id);
+	if(direction < 0 || ret < 0) {
+		return false;
+	}
+
+	unsigned long fd = 0;
+	extract__network_args(&fd, 1, regs);
+	key.fd = (int32_t)fd;
+	key.direction = (uint32_t)direction;
+
+	uint64_t now = bpf_ktime_get_boot_ns();
+	struct io_aggregation_entry *entry = bpf_map_lookup_elem(&io_aggregation, &key);
+	if(entry == NULL) {
+		struct io_aggregation_entry new_entry = {
+		        .window_start = now,
+		};
+		bpf_map_update_elem(&io_aggregation, &key, &new_entry, BPF_NOEXIST);
+		return false;
+	}
+
+	uint64_t ts = maps__get_boot_time() + now;
+	if(entry->count == 0) {
+		entry->first_ts = ts;
+	}
+	entry->count++;
+	entry->bytes += (uint64_t)ret;
+	entry->last_ts = ts;
+
+	struct counter_map *counter = maps__get_counter_map();
+	if(counter != NULL) {
+		counter->n_io_aggregated++;
+	}
+
+	if(now - entry->window_start >= interval && io_aggregation__send_summary(&key, entry)) {
+		entry->window_start = now;
+	}
+	return true;
+}
+
 #define X86_64_NR_EXECVE 59
 #define X86_64_NR_EXECVEAT 322
 
@@ -237,6 +460,30 @@ int BPF_PROG(sys_exit, struct pt_regs *regs, long ret) {
 		return 0;
 	}
 
+	if(syscalls_dispatcher__is_cgroup_filtered(syscall_id)) {
+		struct counter_map *counter = maps__get_counter_map();
+		if(counter != NULL) {
+			counter->n_cgroup_filtered++;
+		}
+		return 0;
+	}
+
+	if(syscalls_dispatcher__is_suppressed(syscall_id, ret)) {
+		struct counter_map *counter = maps__get_counter_map();
+		if(counter != NULL) {
+			counter->n_suppressed++;
+		}
+		return 0;
+	}
+
+	if(syscalls_dispatcher__is_fd_type_filtered(regs, syscall_id)) {
+		struct counter_map *counter = maps__get_counter_map();
+		if(counter != NULL) {
+			counter->n_fd_type_filtered++;
+		}
+		return 0;
+	}
+
 	if(sampling_logic_exit(ctx, syscall_id)) {
 		return 0;
 	}
@@ -245,6 +492,14 @@ int BPF_PROG(sys_exit, struct pt_regs *regs, long ret) {
 		return 0;
 	}
 
+	if(io_aggregation_logic_exit(regs, syscall_id, ret)) {
+		return 0;
+	}
+
+	if(rate_limit_logic_exit(syscall_id)) {
+		return 0;
+	}
+
 	// If we cannot find a ring buffer for this CPU we probably have an hotplug event. It's ok to
 	// check only in the exit path since we will always have at least one exit syscall enabled. If
 	// we change our architecture we may need to update this logic.
@@ -139,6 +139,19 @@ static __always_inline pid_t find_new_reaper_pid(struct task_struct *father) {
  */
 SEC("tp_btf/sched_process_exit")
 int BPF_PROG(sched_proc_exit, struct task_struct *task) {
+	/* The proc exit event is never suppressed, otherwise userspace would keep
+	 * stale threads. We only forget the thread group once its last thread exits.
+	 */
+	if(maps__get_suppression_enabled()) {
+		int live = 0;
+		BPF_CORE_READ_INTO(&live, task, signal, live.counter);
+		if(live == 0) {
+			uint32_t tgid = 0;
+			READ_TASK_FIELD_INTO(&tgid, task, tgid);
+			maps__unsuppress_tgid(tgid);
+		}
+	}
+
 	/* NOTE: this is a fixed-size event and so we should use the `ringbuf-approach`.
 	 * Unfortunately we are hitting a sort of complexity limit in some kernel versions (<5.10)
 	 * It seems like the verifier is not able to recognize the `ringbuf` pointer as a real pointer
@@ -57,6 +57,17 @@ int BPF_PROG(sched_p_fork, struct task_struct *parent, struct task_struct *child
 		return 0;
 	}
 
+	/* Here we are still the parent: the child of a suppressed thread group
+	 * is suppressed as well. The child event is still sent so that userspace
+	 * tracks it, see `syscalls_dispatcher__is_suppressed`.
+	 */
+	if(maps__get_suppression_enabled() &&
+	   maps__is_suppressed_tgid(bpf_get_current_pid_tgid() >> 32)) {
+		uint32_t child_tgid = 0;
+		READ_TASK_FIELD_INTO(&child_tgid, child, tgid);
+		maps__suppress_tgid(child_tgid);
+	}
+
 	struct auxiliary_map *auxmap = auxmap__get();
 	if(!auxmap) {
 		return 0;
@@ -13,6 +13,45 @@
 
 SEC("tp_btf/sys_exit")
 int BPF_PROG(pread64_x, struct pt_regs *regs, long ret) {
+	/* We read the minimum between `snaplen` and what we really
+	 * have in the buffer.
+	 */
+	uint16_t snaplen = 0;
+	if(ret > 0) {
+		dynamic_snaplen_args snaplen_args = {
+		        .only_port_range = false,
+		        .evt_type = PPME_SYSCALL_PREAD_X,
+		};
+		snaplen = maps__get_snaplen();
+		apply_dynamic_snaplen(regs, &snaplen, &snaplen_args);
+		if(snaplen > ret) {
+			snaplen = ret;
+		}
+	}
+
+	unsigned long data_ptr = extract__syscall_argument(regs, 1);
+	int32_t fd = (int32_t)extract__syscall_argument(regs, 0);
+	uint32_t size = (uint32_t)extract__syscall_argument(regs, 2);
+	uint64_t pos = (uint64_t)extract__syscall_argument(regs, 3);
+
+	struct ringbuf_struct ringbuf;
+	switch(ringbuf__reserve_bytebuf_event_space(&ringbuf, snaplen, PPME_SYSCALL_PREAD_X)) {
+	case DIRECT_RESERVED:
+		ringbuf__store_event_header(&ringbuf);
+		ringbuf__store_s64(&ringbuf, ret);
+		ringbuf__store_bytebuf_param(&ringbuf, data_ptr, snaplen, USER);
+		ringbuf__store_s64(&ringbuf, (int64_t)fd);
+		ringbuf__store_u32(&ringbuf, size);
+		ringbuf__store_u64(&ringbuf, pos);
+		ringbuf__finalize_event_header(&ringbuf);
+		ringbuf__submit_event(&ringbuf);
+		return 0;
+	case DIRECT_DROPPED:
+		return 0;
+	default:
+		break;
+	}
+
 	struct auxiliary_map *auxmap = auxmap__get();
 	if(!auxmap) {
 		return 0;
@@ -25,38 +64,20 @@ int BPF_PROG(pread64_x, struct pt_regs *regs, long ret) {
 	/* Parameter 1: res (type: PT_ERRNO) */
 	auxmap__store_s64_param(auxmap, ret);
 
+	/* Parameter 2: data (type: PT_BYTEBUF) */
 	if(ret > 0) {
-		/* We read the minimum between `snaplen` and what we really
-		 * have in the buffer.
-		 */
-		dynamic_snaplen_args snaplen_args = {
-		        .only_port_range = false,
-		        .evt_type = PPME_SYSCALL_PREAD_X,
-		};
-		uint16_t snaplen = maps__get_snaplen();
-		apply_dynamic_snaplen(regs, &snaplen, &snaplen_args);
-		if(snaplen > ret) {
-			snaplen = ret;
-		}
-
-		/* Parameter 2: data (type: PT_BYTEBUF) */
-		unsigned long data_ptr = extract__syscall_argument(regs, 1);
 		auxmap__store_bytebuf_param(auxmap, data_ptr, snaplen, USER);
 	} else {
-		/* Parameter 2: data (type: PT_BYTEBUF) */
 		auxmap__store_empty_param(auxmap);
 	}
 
 	/* Parameter 3: fd (type: PT_FD) */
-	int32_t fd = (int32_t)extract__syscall_argument(regs, 0);
 	auxmap__store_s64_param(auxmap, (int64_t)fd);
 
 	/* Parameter 4: size (type: PT_UINT32) */
-	uint32_t size = (uint32_t)extract__syscall_argument(regs, 2);
 	auxmap__store_u32_param(auxmap, (uint32_t)size);
 
 	/* Parameter 5: pos (type: PT_UINT64) */
-	uint64_t pos = (uint64_t)extract__syscall_argument(regs, 3);
 	auxmap__store_u64_param(auxmap, pos);
 
 	/*=============================== COLLECT PARAMETERS  ===========================*/
@@ -13,18 +13,6 @@
 
 SEC("tp_btf/sys_exit")
 int BPF_PROG(pwrite64_x, struct pt_regs *regs, long ret) {
-	struct auxiliary_map *auxmap = auxmap__get();
-	if(!auxmap) {
-		return 0;
-	}
-
-	auxmap__preload_event_header(auxmap, PPME_SYSCALL_PWRITE_X);
-
-	/*=============================== COLLECT PARAMETERS  ===========================*/
-
-	/* Parameter 1: res (type: PT_ERRNO) */
-	auxmap__store_s64_param(auxmap, ret);
-
 	/* If the syscall doesn't fail we use the return value as `size`
 	 * otherwise we need to rely on the syscall parameter provided by the user.
 	 */
@@ -40,19 +28,50 @@ int BPF_PROG(pwrite64_x, struct pt_regs *regs, long ret) {
 		snaplen = bytes_to_read;
 	}
 
-	/* Parameter 2: data (type: PT_BYTEBUF) */
 	unsigned long data_pointer = extract__syscall_argument(regs, 1);
+	int32_t fd = (int32_t)extract__syscall_argument(regs, 0);
+	uint64_t pos = (uint64_t)extract__syscall_argument(regs, 3);
+
+	struct ringbuf_struct ringbuf;
+	switch(ringbuf__reserve_bytebuf_event_space(&ringbuf, snaplen, PPME_SYSCALL_PWRITE_X)) {
+	case DIRECT_RESERVED:
+		ringbuf__store_event_header(&ringbuf);
+		ringbuf__store_s64(&ringbuf, ret);
+		ringbuf__store_bytebuf_param(&ringbuf, data_pointer, snaplen, USER);
+		ringbuf__store_s64(&ringbuf, (int64_t)fd);
+		ringbuf__store_u32(&ringbuf, size);
+		ringbuf__store_u64(&ringbuf, pos);
+		ringbuf__finalize_event_header(&ringbuf);
+		ringbuf__submit_event(&ringbuf);
+		return 0;
+	case DIRECT_DROPPED:
+		return 0;
+	default:
+		break;
+	}
+
+	struct auxiliary_map *auxmap = auxmap__get();
+	if(!auxmap) {
+		return 0;
+	}
+
+	auxmap__preload_event_header(auxmap, PPME_SYSCALL_PWRITE_X);
+
+	/*=============================== COLLECT PARAMETERS  ===========================*/
+
+	/* Parameter 1: res (type: PT_ERRNO) */
+	auxmap__store_s64_param(auxmap, ret);
+
+	/* Parameter 2: data (type: PT_BYTEBUF) */
 	auxmap__store_bytebuf_param(auxmap, data_pointer, snaplen, USER);
 
 	/* Parameter 3: fd (type: PT_FD) */
-	int32_t fd = (int32_t)extract__syscall_argument(regs, 0);
 	auxmap__store_s64_param(auxmap, (int64_t)fd);
 
 	/* Parameter 4: size (type: PT_UINT32) */
 	auxmap__store_u32_param(auxmap, size);
 
 	/* Parameter 5: pos (type: PT_UINT64) */
-	uint64_t pos = (uint64_t)extract__syscall_argument(regs, 3);
 	auxmap__store_u64_param(auxmap, pos);
 
 	/*=============================== COLLECT PARAMETERS  ===========================*/
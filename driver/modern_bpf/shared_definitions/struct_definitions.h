@@ -18,6 +18,33 @@
  */
 #define AUXILIARY_MAP_SIZE 128 * 1024
 
+/* Maximum number of suppressed thread groups and comms kept in the
+ * `suppressed_tgids` and `suppressed_comms` maps.
+ */
+#define MAX_SUPPRESSED_TGIDS 16384
+#define MAX_SUPPRESSED_COMMS 64
+#define SUPPRESSED_COMM_LEN 16
+
+/* Maximum number of thread groups tracked by the rate limiter, the least
+ * recently used ones are evicted.
+ */
+#define MAX_RATE_LIMITED_TGIDS 16384
+
+/* Maximum number of cgroup ids kept in the `cgroup_filter` map. */
+#define MAX_CGROUP_FILTER_IDS 1024
+
+/* Values of `capture_settings.cgroup_filter_mode`, they must match the
+ * `scap_cgroup_filter_mode` ones.
+ */
+#define CGROUP_FILTER_DISABLED 0 /* the `cgroup_filter` map is ignored */
+#define CGROUP_FILTER_ALLOW 1    /* only the cgroups in the map are captured */
+#define CGROUP_FILTER_DENY 2     /* the cgroups in the map are not captured */
+
+/* Maximum number of (thread, fd, direction) tuples tracked by the I/O
+ * aggregation, the least recently used ones are evicted.
+ */
+#define MAX_IO_AGGREGATION_ENTRIES 65536
+
 /**
  * @brief General settings shared among all the CPUs.
  *
@@ -33,6 +60,53 @@ struct capture_settings {
 	uint16_t fullcapture_port_range_end;   /* last interesting port */
 	uint16_t statsd_port;                  /* port for statsd metrics */
 	int32_t scap_tid;                      /* tid of the scap process */
+	bool suppression_enabled; /* some tgids or comms are in the suppression maps */
+	uint32_t rate_limit_rate;  /* events per second allowed to each thread group, 0 disables it */
+	uint32_t rate_limit_burst; /* events a thread group can send at once after being idle */
+	uint8_t cgroup_filter_mode; /* how the `cgroup_filter` map is applied, `CGROUP_FILTER_*` */
+	uint64_t io_aggregation_interval; /* ns between two `io_summary` events of the same fd, 0
+	                                     disables the I/O aggregation */
+	uint32_t io_fd_type_mask; /* `PPM_FD_TYPE_*` of the fds whose I/O events are sent, 0 sends
+	                             all of them */
+};
+
+/**
+ * @brief Key of the I/O aggregation map, see `io_aggregation_logic_exit`.
+ */
+struct io_aggregation_key {
+	uint32_t tid;
+	int32_t fd;
+	uint32_t direction; /* `PPM_IO_SUMMARY_IN` or `PPM_IO_SUMMARY_OUT`. */
+};
+
+/**
+ * @brief I/O syscalls of a (thread, fd, direction) tuple folded since the
+ * last `io_summary` event.
+ */
+struct io_aggregation_entry {
+	uint64_t count;        /* syscalls folded in the current window. */
+	uint64_t bytes;        /* bytes transferred by them. */
+	uint64_t first_ts;     /* timestamp of the first of them. */
+	uint64_t last_ts;      /* timestamp of the last of them. */
+	uint64_t window_start; /* boot time (ns) the current window started. */
+};
+
+/**
+ * @brief Token bucket of a thread group, see `rate_limit_logic_exit`.
+ */
+struct rate_limit_bucket {
+	uint64_t tokens;         /* events that can still be sent right now. */
+	uint64_t last_refill;    /* boot time (ns) the tokens were last refilled. */
+	uint64_t throttle_start; /* boot time (ns) of the first event skipped in this episode. */
+	uint64_t n_skipped;      /* events skipped in this episode, not yet notified. */
+	uint64_t n_drops;        /* events skipped since the thread group is tracked. */
+};
+
+/**
+ * @brief Key of the `suppressed_comms` map: the comm of a task, NUL padded.
+ */
+struct suppressed_comm {
+	char comm[SUPPRESSED_COMM_LEN];
 };
 
 /**
@@ -75,6 +149,11 @@ struct counter_map {
 	uint64_t n_drops_buffer_close_exit;
 	uint64_t n_drops_buffer_proc_exit;
 	uint64_t n_drops_max_event_size; /* Number of drops due to an excessive event size (>64KB). */
+	uint64_t n_suppressed; /* Number of events skipped because their tgid or comm is suppressed. */
+	uint64_t n_drops_rate_limit; /* Number of events skipped by the per-process rate limiter. */
+	uint64_t n_cgroup_filtered;  /* Number of events skipped by the cgroup filter. */
+	uint64_t n_io_aggregated;    /* Number of I/O events folded into `io_summary` events. */
+	uint64_t n_fd_type_filtered; /* Number of I/O events skipped because of their fd type. */
 };
 
 /**
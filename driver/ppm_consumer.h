@@ -12,6 +12,15 @@ or GPL2.txt for full copies of the license.
 #define CONSUMER_H_
 
 #include <linux/types.h>
+#include <linux/atomic.h>
+#include <linux/hashtable.h>
+#include <linux/spinlock.h>
+#include <linux/sched.h>
+
+/* Suppressed thread groups, see `consumer_is_suppressed_event()`. */
+#define PPM_SUPPRESSED_TGIDS_HASH_BITS 10
+#define PPM_MAX_SUPPRESSED_TGIDS 16384
+#define PPM_MAX_SUPPRESSED_COMMS 64
 
 struct ppm_consumer_t {
 	unsigned int id;  // numeric id for the consumer (ie: registration index)
@@ -38,6 +47,21 @@ struct ppm_consumer_t {
 	unsigned long buffer_bytes_dim; /* Every consumer will have its per-CPU buffer dim in bytes. */
 	DECLARE_BITMAP(syscalls_mask, SYSCALL_TABLE_SIZE);
 	uint32_t tracepoints_attached;
+	/* Events of these thread groups, and of their children, are dropped. The table is
+	 * read under RCU and written under `suppress_lock`.
+	 */
+	DECLARE_HASHTABLE(suppressed_tgids, PPM_SUPPRESSED_TGIDS_HASH_BITS);
+	atomic_t n_suppressed_tgids;
+	/* Processes calling execve with one of these comms get suppressed. Rarely
+	 * accessed, always under `suppress_lock`.
+	 */
+	char suppressed_comms[PPM_MAX_SUPPRESSED_COMMS][TASK_COMM_LEN];
+	uint32_t n_suppressed_comms;
+	spinlock_t suppress_lock;
+	/* I/O events on fds whose `PPM_FD_TYPE_*` is not in the mask are dropped, 0 disables the
+	 * prefilter. See `consumer_is_fd_type_filtered()`.
+	 */
+	uint32_t io_fd_type_mask;
 };
 
 typedef struct ppm_consumer_t ppm_consumer_t;
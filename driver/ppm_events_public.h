@@ -851,6 +851,23 @@ or GPL2.txt for full copies of the license.
 #define PPM_CLOSE_RANGE_UNSHARE (1 << 1)
 #define PPM_CLOSE_RANGE_CLOEXEC (1 << 2)
 
+/*
+ * io_summary directions
+ */
+#define PPM_IO_SUMMARY_IN 0
+#define PPM_IO_SUMMARY_OUT 1
+
+/*
+ * fd types of the I/O prefilter, see `scap_open_args.io_fd_type_mask`
+ */
+#define PPM_FD_TYPE_FILE (1 << 0)
+#define PPM_FD_TYPE_DIRECTORY (1 << 1)
+#define PPM_FD_TYPE_SOCKET (1 << 2)
+#define PPM_FD_TYPE_PIPE (1 << 3)
+#define PPM_FD_TYPE_DEVICE (1 << 4)
+#define PPM_FD_TYPE_ANON_INODE (1 << 5)
+#define PPM_FD_TYPE_OTHER (1 << 6)
+
 /*
  * bpf_commands
  */
@@ -1584,7 +1601,11 @@ typedef enum {
 	PPME_SYSCALL_CLOSE_RANGE_X = 451,
 	PPME_SYSCALL_KEYCTL_E = 452,
 	PPME_SYSCALL_KEYCTL_X = 453,
-	PPM_EVENT_MAX = 454
+	PPME_RATE_LIMIT_E = 454, /* For internal use */
+	PPME_RATE_LIMIT_X = 455,
+	PPME_IO_SUMMARY_E = 456, /* For internal use */
+	PPME_IO_SUMMARY_X = 457,
+	PPM_EVENT_MAX = 458
 } ppm_event_code;
 /*@}*/
 
@@ -2310,6 +2331,18 @@ struct ppm_evt_hdr {
 #define PPM_IOCTL_DISABLE_TP _IO(PPM_IOCTL_MAGIC, 32)
 #define PPM_IOCTL_ENABLE_DROPFAILED _IO(PPM_IOCTL_MAGIC, 33)
 #define PPM_IOCTL_DISABLE_DROPFAILED _IO(PPM_IOCTL_MAGIC, 34)
+#define PPM_IOCTL_SUPPRESS_TGID _IO(PPM_IOCTL_MAGIC, 35)
+#define PPM_IOCTL_UNSUPPRESS_TGID _IO(PPM_IOCTL_MAGIC, 36)
+#define PPM_IOCTL_SUPPRESS_COMM _IO(PPM_IOCTL_MAGIC, 37)  // arg: pointer to a PPM_COMM_LEN buffer
+#define PPM_IOCTL_UNSUPPRESS_COMM _IO(PPM_IOCTL_MAGIC, 38)
+#define PPM_IOCTL_CLEAR_SUPPRESSED _IO(PPM_IOCTL_MAGIC, 39)
+#define PPM_IOCTL_SET_IO_FD_TYPE_MASK _IO(PPM_IOCTL_MAGIC, 40)  // arg: PPM_FD_TYPE_* mask
+
+/*
+ * Size of the comm buffers passed to PPM_IOCTL_(UN)SUPPRESS_COMM, NUL padded,
+ * like the kernel TASK_COMM_LEN.
+ */
+#define PPM_COMM_LEN 16
 
 extern const struct ppm_name_value socket_families[];
 extern const struct ppm_name_value file_flags[];
@@ -2370,6 +2403,7 @@ extern const struct ppm_name_value delete_module_flags[];
 extern const struct ppm_name_value close_range_flags[];
 extern const struct ppm_name_value finit_module_flags[];
 extern const struct ppm_name_value anon_inode_fd_types[];
+extern const struct ppm_name_value io_summary_directions[];
 /*!
   \brief Process information as returned by the PPM_IOCTL_GET_PROCLIST IOCTL.
 */
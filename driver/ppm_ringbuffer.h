@@ -56,6 +56,10 @@ struct ppm_ring_buffer_info {
 	volatile uint64_t n_drops_pf;         /* Number of dropped events (page faults). */
 	volatile uint64_t n_preemptions;      /* Number of preemptions. */
 	volatile uint64_t n_context_switches; /* Number of received context switch events. */
+	volatile uint64_t n_suppressed; /* Number of events skipped because their tgid or comm is
+	                                   suppressed. */
+	volatile uint64_t n_fd_type_filtered; /* Number of I/O events skipped because of the type of
+	                                         their fd. */
 };
 
 #endif /* PPM_RINGBUFFER_H_ */
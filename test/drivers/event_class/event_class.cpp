@@ -192,6 +192,34 @@ void event_test::disable_drop_failed() {
 	scap_set_dropfailed(s_scap_handle, false);
 }
 
+int32_t event_test::suppress_tgid(uint32_t tgid, bool suppress) {
+	return scap_suppress_tgid(s_scap_handle, tgid, suppress);
+}
+
+void event_test::clear_suppressed() {
+	scap_clear_suppressed(s_scap_handle);
+}
+
+void event_test::set_rate_limit(uint32_t rate, uint32_t burst) {
+	scap_set_rate_limit(s_scap_handle, rate, burst);
+}
+
+void event_test::set_cgroup_filter_mode(scap_cgroup_filter_mode mode) {
+	scap_set_cgroup_filter_mode(s_scap_handle, mode);
+}
+
+int32_t event_test::cgroup_filter(uint64_t cgroup_id, bool add) {
+	return scap_cgroup_filter(s_scap_handle, cgroup_id, add);
+}
+
+void event_test::clear_cgroup_filter() {
+	scap_clear_cgroup_filter(s_scap_handle);
+}
+
+void event_test::set_io_aggregation(uint32_t interval_ms) {
+	scap_set_io_aggregation(s_scap_handle, interval_ms);
+}
+
 void event_test::set_do_dynamic_snaplen(bool enable) {
 	if(enable) {
 		scap_enable_dynamic_snaplen(s_scap_handle);
@@ -200,6 +228,10 @@ void event_test::set_do_dynamic_snaplen(bool enable) {
 	}
 }
 
+void event_test::set_snaplen(uint32_t snaplen) {
+	scap_set_snaplen(s_scap_handle, snaplen);
+}
+
 void event_test::set_statsd_port(uint16_t port) {
 	scap_set_statsd_port(s_scap_handle, port);
 }
@@ -229,6 +229,13 @@ public:
 	 */
 	void set_do_dynamic_snaplen(bool enable);
 
+	/**
+	 * @brief Set the snaplen, the default one is `DEFAULT_SNAPLEN`
+	 *
+	 * @param snaplen maximum number of bytes captured from I/O buffers
+	 */
+	void set_snaplen(uint32_t snaplen);
+
 	/**
 	 * @brief Set stasd port
 	 *
@@ -244,6 +251,59 @@ public:
 	 */
 	void set_fullcapture_port_range(uint16_t start, uint16_t end);
 
+	/**
+	 * @brief Suppress/unsuppress a thread group in the driver
+	 *
+	 * @param tgid thread group id
+	 * @param suppress true to suppress it, false to remove it
+	 * @return the scap return code
+	 */
+	int32_t suppress_tgid(uint32_t tgid, bool suppress);
+
+	/**
+	 * @brief Remove all the suppressed thread groups and comms from the driver
+	 *
+	 */
+	void clear_suppressed();
+
+	/**
+	 * @brief Configure the per-process rate limiter
+	 *
+	 * @param rate events per second allowed to each thread group, 0 to disable it
+	 * @param burst burst size, 0 means `rate`
+	 */
+	void set_rate_limit(uint32_t rate, uint32_t burst);
+
+	/**
+	 * @brief Set how the cgroup filter of the driver is applied
+	 *
+	 * @param mode filter mode
+	 */
+	void set_cgroup_filter_mode(scap_cgroup_filter_mode mode);
+
+	/**
+	 * @brief Add/remove a cgroup id to/from the cgroup filter of the driver
+	 *
+	 * @param cgroup_id cgroup id
+	 * @param add true to add it, false to remove it
+	 * @return SCAP_SUCCESS on success
+	 */
+	int32_t cgroup_filter(uint64_t cgroup_id, bool add);
+
+	/**
+	 * @brief Remove all the cgroup ids from the cgroup filter of the driver
+	 *
+	 */
+	void clear_cgroup_filter();
+
+	/**
+	 * @brief Configure the in-kernel I/O aggregation
+	 *
+	 * @param interval_ms milliseconds between two `io_summary` events of the same fd,
+	 * 0 to disable it
+	 */
+	void set_io_aggregation(uint32_t interval_ms);
+
 	/**
 	 * @brief Clear the ring buffers from all previous events until they
 	 * are all empty.
@@ -0,0 +1,30 @@
+#include "../../event_class/event_class.h"
+
+#if defined(__NR_unshare)
+TEST(Actions, cgroup_filter) {
+	auto evt_test = get_syscall_event_test(__NR_unshare, EXIT_EVENT);
+
+	if(!evt_test->is_modern_bpf_engine()) {
+		GTEST_SKIP() << "[CGROUP_FILTER]: the engine doesn't support the cgroup filter"
+		             << std::endl;
+	}
+
+	evt_test->clear_cgroup_filter();
+
+	evt_test->enable_capture();
+
+	/* Allow mode with no cgroups: nothing passes */
+	evt_test->set_cgroup_filter_mode(SCAP_CGROUP_FILTER_ALLOW);
+	syscall(__NR_unshare, 0);
+	evt_test->assert_event_absence();
+
+	/* Deny mode with no cgroups: everything passes */
+	evt_test->set_cgroup_filter_mode(SCAP_CGROUP_FILTER_DENY);
+	syscall(__NR_unshare, 0);
+	evt_test->assert_event_presence();
+
+	evt_test->set_cgroup_filter_mode(SCAP_CGROUP_FILTER_DISABLED);
+
+	evt_test->disable_capture();
+}
+#endif
@@ -0,0 +1,63 @@
+#include "../../event_class/event_class.h"
+
+#if defined(__NR_write) && defined(__NR_openat) && defined(__NR_close)
+TEST(Actions, io_aggregation) {
+	auto evt_test = get_syscall_event_test(__NR_write, EXIT_EVENT);
+
+	if(!evt_test->is_modern_bpf_engine()) {
+		GTEST_SKIP() << "[IO_AGGREGATION]: the engine doesn't support the I/O aggregation"
+		             << std::endl;
+	}
+
+	int fd = syscall(__NR_openat, AT_FDCWD, "/dev/null", O_WRONLY);
+	assert_syscall_state(SYSCALL_SUCCESS, "openat", fd, NOT_EQUAL, -1);
+
+	/* At most one summary per second */
+	evt_test->set_io_aggregation(1000);
+
+	evt_test->enable_capture();
+
+	/* The first write on the fd is sent */
+	char buf[4] = "xyz";
+	syscall(__NR_write, fd, buf, sizeof(buf));
+	evt_test->assert_event_presence();
+
+	/* The following ones are folded */
+	syscall(__NR_write, fd, buf, sizeof(buf));
+	syscall(__NR_write, fd, buf, 1);
+	evt_test->assert_event_absence();
+
+	/* The first write folded after the interval sends the summary */
+	usleep(1100000);
+	syscall(__NR_write, fd, buf, 1);
+
+	uint16_t cpu_id = 0;
+	struct ppm_evt_hdr* evt = NULL;
+	uint64_t count = 0;
+	uint64_t bytes = 0;
+	bool found_summary = false;
+	for(int i = 0; i < 1000 && !found_summary; i++) {
+		evt = evt_test->get_event_from_ringbuffer(&cpu_id);
+		if(evt != NULL && evt->type == PPME_IO_SUMMARY_E && evt->tid == (uint64_t)::getpid()) {
+			/* Parameter 3: count (type: PT_UINT64), after the six param lengths, the fd
+			 * and the direction.
+			 */
+			char* params = (char*)evt + sizeof(struct ppm_evt_hdr) + 6 * sizeof(uint16_t);
+			memcpy(&count, params + sizeof(int64_t) + sizeof(uint8_t), sizeof(uint64_t));
+			memcpy(&bytes,
+			       params + sizeof(int64_t) + sizeof(uint8_t) + sizeof(uint64_t),
+			       sizeof(uint64_t));
+			found_summary = true;
+		}
+	}
+	ASSERT_TRUE(found_summary);
+	ASSERT_EQ(count, 3);
+	ASSERT_EQ(bytes, sizeof(buf) + 2);
+
+	evt_test->set_io_aggregation(0);
+
+	evt_test->disable_capture();
+
+	syscall(__NR_close, fd);
+}
+#endif
@@ -0,0 +1,52 @@
+#include "../../event_class/event_class.h"
+
+#if defined(__NR_unshare)
+TEST(Actions, rate_limit) {
+	auto evt_test = get_syscall_event_test(__NR_unshare, EXIT_EVENT);
+
+	if(!evt_test->is_modern_bpf_engine()) {
+		GTEST_SKIP() << "[RATE_LIMIT]: the engine doesn't support the rate limiter" << std::endl;
+	}
+
+	/* One event per second, without bursts */
+	evt_test->set_rate_limit(1, 1);
+
+	evt_test->enable_capture();
+
+	/* The first event consumes the only token */
+	syscall(__NR_unshare, 0);
+	evt_test->assert_event_presence();
+
+	/* No tokens left */
+	syscall(__NR_unshare, 0);
+	evt_test->assert_event_absence();
+
+	/* Wait for the bucket to be refilled */
+	usleep(1100000);
+	syscall(__NR_unshare, 0);
+
+	/* The event is preceded by the summary of the skipped ones */
+	uint16_t cpu_id = 0;
+	struct ppm_evt_hdr* evt = NULL;
+	uint64_t skipped = 0;
+	bool found_summary = false;
+	for(int i = 0; i < 1000 && !found_summary; i++) {
+		evt = evt_test->get_event_from_ringbuffer(&cpu_id);
+		if(evt != NULL && evt->type == PPME_RATE_LIMIT_E && evt->tid == (uint64_t)::getpid()) {
+			/* Parameter 1: skipped (type: PT_UINT64), after the two param lengths */
+			memcpy(&skipped,
+			       (char*)evt + sizeof(struct ppm_evt_hdr) + 2 * sizeof(uint16_t),
+			       sizeof(uint64_t));
+			found_summary = true;
+		}
+	}
+	ASSERT_TRUE(found_summary);
+	ASSERT_EQ(skipped, 1);
+
+	evt_test->assert_event_presence();
+
+	evt_test->set_rate_limit(0, 0);
+
+	evt_test->disable_capture();
+}
+#endif
@@ -0,0 +1,28 @@
+#include "../../event_class/event_class.h"
+
+#if defined(__NR_unshare)
+TEST(Actions, suppress_tgid) {
+	auto evt_test = get_syscall_event_test(__NR_unshare, EXIT_EVENT);
+
+	if(!evt_test->is_kmod_engine() && !evt_test->is_modern_bpf_engine()) {
+		GTEST_SKIP() << "[SUPPRESS]: the engine doesn't support the suppression" << std::endl;
+	}
+
+	ASSERT_EQ(evt_test->suppress_tgid(::getpid(), true), SCAP_SUCCESS);
+
+	evt_test->enable_capture();
+
+	syscall(__NR_unshare, 0);
+
+	/* The whole thread group of the test is suppressed */
+	evt_test->assert_event_absence();
+
+	evt_test->clear_suppressed();
+
+	syscall(__NR_unshare, 0);
+
+	evt_test->assert_event_presence();
+
+	evt_test->disable_capture();
+}
+#endif
@@ -105,6 +105,65 @@ TEST(SyscallExit, writeX_snaplen) {
 	evt_test->assert_num_params_pushed(4);
 }
 
+TEST(SyscallExit, writeX_large_snaplen) {
+	auto evt_test = get_syscall_event_test(__NR_write, EXIT_EVENT);
+
+	/* Large enough for the event to be written straight into the ring buffer
+	 * by the modern probe.
+	 */
+	const unsigned snaplen = 4096;
+	evt_test->set_snaplen(snaplen);
+
+	evt_test->enable_capture();
+
+	/*=============================== TRIGGER SYSCALL  ===========================*/
+
+	/* Open a generic file for writing */
+	auto fo = file_opener(".", (O_WRONLY | O_TMPFILE));
+	int fd = fo.get_fd();
+
+	/* Write data to the generic file */
+	const unsigned data_len = snaplen / 2;
+	char buf[data_len];
+	memset(buf, 'x', data_len);
+	ssize_t write_bytes = syscall(__NR_write, fd, (void *)buf, data_len);
+	assert_syscall_state(SYSCALL_SUCCESS, "write", write_bytes, NOT_EQUAL, -1);
+
+	/*=============================== TRIGGER SYSCALL ===========================*/
+
+	evt_test->disable_capture();
+
+	evt_test->set_snaplen(DEFAULT_SNAPLEN);
+
+	evt_test->assert_event_presence();
+
+	if(HasFatalFailure()) {
+		return;
+	}
+
+	evt_test->parse_event();
+
+	evt_test->assert_header();
+
+	/*=============================== ASSERT PARAMETERS  ===========================*/
+
+	/* Parameter 1: res (type: PT_ERRNO) */
+	evt_test->assert_numeric_param(1, (int64_t)write_bytes);
+
+	/* Parameter 2: data (type: PT_BYTEBUF) */
+	evt_test->assert_bytebuf_param(2, buf, write_bytes);
+
+	/* Parameter 3: fd (type: PT_FD) */
+	evt_test->assert_numeric_param(3, (int64_t)fd);
+
+	/* Parameter 4: size (type: PT_UINT32)*/
+	evt_test->assert_numeric_param(4, (uint32_t)data_len);
+
+	/*=============================== ASSERT PARAMETERS  ===========================*/
+
+	evt_test->assert_num_params_pushed(4);
+}
+
 TEST(SyscallExit, writeX_fail) {
 	auto evt_test = get_syscall_event_test(__NR_write, EXIT_EVENT);
 
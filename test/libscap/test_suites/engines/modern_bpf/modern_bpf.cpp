@@ -384,6 +384,58 @@ TEST(modern_bpf, metrics_v2_check_kernel_iter_stats) {
 	scap_close(h);
 }
 
+TEST(modern_bpf, metrics_v2_check_buffers_stats) {
+	char error_buffer[FILENAME_MAX]{};
+	int ret = 0;
+	scap_t* h = open_modern_bpf_engine(error_buffer, &ret, 1 * 1024 * 1024, 0, false);
+	ASSERT_EQ(!h || ret != SCAP_SUCCESS, false)
+	        << "unable to open modern bpf engine with one single shared ring buffer: "
+	        << error_buffer << std::endl;
+
+	constexpr uint32_t flags = METRICS_V2_KERNEL_BUFFERS;
+	uint32_t nstats;
+	int32_t rc;
+	const metrics_v2* stats_v2 = scap_get_stats_v2(h, flags, &nstats, &rc);
+	ASSERT_EQ(rc, SCAP_SUCCESS);
+
+	// A single shared buffer: 4 histogram buckets, the consumer lag, the merge time and the
+	// recommended configuration.
+	const std::unordered_set<std::string> expected_stats_name = {
+	        N_UTIL_SAMPLES_PER_BUFFER_PREFIX "0_le_25",
+	        N_UTIL_SAMPLES_PER_BUFFER_PREFIX "0_le_50",
+	        N_UTIL_SAMPLES_PER_BUFFER_PREFIX "0_le_75",
+	        N_UTIL_SAMPLES_PER_BUFFER_PREFIX "0_le_100",
+	        "occupancy_max_bytes_buf_0",
+	        "lag_bytes_buf_0",
+	        "oldest_evt_age_ns_buf_0",
+	        "merge_time_avg_ns",
+	        "autotune_cpus_for_each_buffer",
+	        "autotune_buffer_bytes_dim",
+	};
+	ASSERT_EQ(nstats, expected_stats_name.size());
+
+	for(uint32_t i = 0; i < nstats; i++) {
+		const struct metrics_v2* stat = &stats_v2[i];
+		if(std::string stat_name{stat->name};
+		   expected_stats_name.find(stat_name) == expected_stats_name.end()) {
+			FAIL() << "unable to find stat '" << stat_name << "' into the array";
+		}
+		ASSERT_EQ(stat->type, METRIC_VALUE_TYPE_U64);
+		ASSERT_EQ(stat->flags, METRICS_V2_KERNEL_BUFFERS);
+		if(strcmp(stat->name, "autotune_cpus_for_each_buffer") == 0) {
+			ASSERT_GT(stat->value.u64, 0);
+			ASSERT_LE(stat->value.u64, num_possible_cpus());
+		} else if(strcmp(stat->name, "autotune_buffer_bytes_dim") == 0) {
+			ASSERT_GE(stat->value.u64, 1 * 1024 * 1024);
+		} else if(strcmp(stat->name, "occupancy_max_bytes_buf_0") == 0 ||
+		          strcmp(stat->name, "lag_bytes_buf_0") == 0) {
+			ASSERT_LE(stat->value.u64, 1 * 1024 * 1024);
+		}
+	}
+
+	scap_close(h);
+}
+
 TEST(modern_bpf, metrics_v2_check_results) {
 	char error_buffer[FILENAME_MAX]{};
 	int ret = 0;
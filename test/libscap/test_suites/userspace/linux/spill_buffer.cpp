@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2024 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <gtest/gtest.h>
+#include <libscap/scap.h>
+#include <libscap/ringbuffer/spill_buffer.h>
+
+#include <vector>
+
+namespace {
+struct fake_engine {
+	uint64_t n_evts;
+	uint64_t produced;
+	std::vector<char> buf;
+};
+
+int32_t fake_next(scap_engine_handle engine, scap_evt** pevent, uint16_t* pdevid, uint32_t* pflags) {
+	auto* e = static_cast<fake_engine*>(engine.m_handle);
+	if(e->produced == e->n_evts) {
+		return SCAP_EOF;
+	}
+	auto* evt = reinterpret_cast<scap_evt*>(e->buf.data());
+	evt->ts = e->produced;
+	evt->tid = e->produced;
+	evt->len = sizeof(scap_evt) + (e->produced % 64);
+	evt->type = PPME_GENERIC_E;
+	evt->nparams = 0;
+	*pevent = evt;
+	*pdevid = e->produced % 4;
+	*pflags = 0;
+	e->produced++;
+	return SCAP_SUCCESS;
+}
+}  // namespace
+
+TEST(spill_buffer, push_and_consume_in_order) {
+	char error[SCAP_LASTERR_SIZE]{};
+	spill_buffer* sb = spill_buffer_alloc(4096, 0, error);
+	ASSERT_NE(sb, nullptr) << error;
+
+	std::vector<char> buf(sizeof(scap_evt) + 16);
+	auto* evt = reinterpret_cast<scap_evt*>(buf.data());
+	evt->len = buf.size();
+	for(uint64_t i = 0; i < 10; i++) {
+		evt->ts = i;
+		ASSERT_TRUE(spill_buffer_push(sb, evt, i, 0));
+	}
+
+	scap_evt* out = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	for(uint64_t i = 0; i < 10; i++) {
+		ASSERT_EQ(spill_buffer_next(sb, &out, &devid, &flags), SCAP_SUCCESS);
+		ASSERT_EQ(out->ts, i);
+		ASSERT_EQ(devid, i);
+	}
+	ASSERT_EQ(spill_buffer_next(sb, &out, &devid, &flags), SCAP_TIMEOUT);
+	ASSERT_EQ(out, nullptr);
+
+	spill_buffer_free(sb);
+}
+
+TEST(spill_buffer, drops_when_full) {
+	char error[SCAP_LASTERR_SIZE]{};
+	// A single 256 bytes segment that can't grow
+	spill_buffer* sb = spill_buffer_alloc(256, 256, error);
+	ASSERT_NE(sb, nullptr) << error;
+
+	std::vector<char> buf(64);
+	auto* evt = reinterpret_cast<scap_evt*>(buf.data());
+	evt->len = buf.size();
+	uint64_t pushed = 0;
+	for(int i = 0; i < 100; i++) {
+		pushed += spill_buffer_push(sb, evt, 0, 0) ? 1 : 0;
+	}
+
+	spill_buffer_stats stats{};
+	spill_buffer_get_stats(sb, &stats);
+	ASSERT_GT(pushed, 0);
+	ASSERT_LT(pushed, 100);
+	ASSERT_EQ(stats.n_evts, pushed);
+	ASSERT_EQ(stats.n_drops, 100 - pushed);
+	ASSERT_EQ(stats.n_bytes_allocated, 256);
+
+	spill_buffer_free(sb);
+}
+
+TEST(spill_buffer, grows_up_to_max) {
+	char error[SCAP_LASTERR_SIZE]{};
+	spill_buffer* sb = spill_buffer_alloc(256, 1024, error);
+	ASSERT_NE(sb, nullptr) << error;
+
+	std::vector<char> buf(64);
+	auto* evt = reinterpret_cast<scap_evt*>(buf.data());
+	evt->len = buf.size();
+	for(int i = 0; i < 100; i++) {
+		spill_buffer_push(sb, evt, 0, 0);
+	}
+
+	spill_buffer_stats stats{};
+	spill_buffer_get_stats(sb, &stats);
+	ASSERT_EQ(stats.n_bytes_allocated, 1024);
+	ASSERT_GT(stats.n_drops, 0);
+
+	// Consuming everything recycles the segments without allocating new ones
+	scap_evt* out = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	uint64_t consumed = 0;
+	while(spill_buffer_next(sb, &out, &devid, &flags) == SCAP_SUCCESS) {
+		consumed++;
+	}
+	ASSERT_EQ(consumed, stats.n_evts);
+	ASSERT_TRUE(spill_buffer_push(sb, evt, 0, 0));
+	spill_buffer_get_stats(sb, &stats);
+	ASSERT_EQ(stats.n_bytes_allocated, 1024);
+
+	spill_buffer_free(sb);
+}
+
+TEST(spill_buffer, drain_thread) {
+	char error[SCAP_LASTERR_SIZE]{};
+	spill_buffer* sb = spill_buffer_alloc(8192, 64 * 1024 * 1024, error);
+	ASSERT_NE(sb, nullptr) << error;
+
+	fake_engine e{100000, 0, std::vector<char>(sizeof(scap_evt) + 64)};
+	ASSERT_EQ(spill_buffer_start(sb, {&e}, fake_next, error), SCAP_SUCCESS) << error;
+
+	scap_evt* out = nullptr;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	uint64_t expected_ts = 0;
+	int32_t res;
+	while((res = spill_buffer_next(sb, &out, &devid, &flags)) != SCAP_EOF) {
+		if(res == SCAP_TIMEOUT) {
+			continue;
+		}
+		ASSERT_EQ(res, SCAP_SUCCESS);
+		ASSERT_EQ(out->ts, expected_ts);
+		ASSERT_EQ(out->len, sizeof(scap_evt) + (expected_ts % 64));
+		ASSERT_EQ(devid, expected_ts % 4);
+		expected_ts++;
+	}
+	ASSERT_EQ(expected_ts, e.n_evts);
+
+	spill_buffer_stats stats{};
+	spill_buffer_get_stats(sb, &stats);
+	ASSERT_EQ(stats.n_evts, e.n_evts);
+	ASSERT_EQ(stats.n_drops, 0);
+
+	spill_buffer_free(sb);
+}
@@ -31,6 +31,7 @@ extern "C" {
 /* Forward declare them */
 struct metrics_v2;
 struct scap_stats;
+struct scap_rate_limit_stats;
 
 /* `libpman` return values convention:
  * In case of success `0` is returned otherwise `errno`. If `errno` is not
@@ -150,6 +151,21 @@ int pman_finalize_ringbuf_array_after_loading(void);
  */
 void pman_consume_first_event(void** event_ptr, int16_t* buffer_id);
 
+/**
+ * @brief Recommend a ring buffer configuration for the next restart, based on
+ * the buffers utilization observed so far and on the drop counters:
+ * - under pressure (drops or buffers often full), halve `cpus_for_each_buffer`,
+ *   or double the buffer dimension if every CPU already has its own buffer.
+ * - if no buffer ever got half full, double `cpus_for_each_buffer` so that
+ *   fewer buffers need to be merged.
+ * - otherwise keep the current configuration.
+ *
+ * @param cpus_for_each_buffer recommended number of CPUs for each buffer.
+ * @param buf_bytes_dim recommended dimension of a single buffer in bytes.
+ * @return `0` on success, `errno` in case of error.
+ */
+int pman_get_buffers_recommendation(uint16_t* cpus_for_each_buffer, unsigned long* buf_bytes_dim);
+
 /////////////////////////////
 // CAPTURE (EXCHANGE VALUES WITH BPF SIDE)
 /////////////////////////////
@@ -254,6 +270,97 @@ void pman_set_statsd_port(uint16_t statsd_port);
  */
 void pman_set_scap_tid(int32_t scap_tid);
 
+/**
+ * @brief Configure the per-process rate limiter: every thread group can
+ * send `rate` events per second, with bursts of up to `burst` events.
+ *
+ * @param rate events per second, `0` disables the rate limiter.
+ * @param burst size of the token bucket, `0` means `rate`.
+ */
+void pman_set_rate_limit(uint32_t rate, uint32_t burst);
+
+/**
+ * @brief Configure the in-kernel I/O aggregation: after the first one, the
+ * read-like and write-like syscalls of a thread on an fd are summarized by an
+ * `io_summary` event at most once per interval, and when the fd is closed.
+ *
+ * @param interval_ms milliseconds between two summaries of the same fd,
+ * `0` disables the I/O aggregation.
+ */
+void pman_set_io_aggregation_interval(uint32_t interval_ms);
+
+/**
+ * @brief Drop the I/O syscalls on fds whose type is not in `mask`.
+ *
+ * @param mask `PPM_FD_TYPE_*` of the fds whose I/O syscalls are sent,
+ * `0` disables the prefilter.
+ */
+void pman_set_io_fd_type_mask(uint32_t mask);
+
+/**
+ * @brief Fill `stats` with the number of events dropped by the rate limiter
+ * for each thread group that dropped at least one event.
+ *
+ * @param stats array of at most `max_stats` entries.
+ * @param max_stats size of the `stats` array.
+ * @param nstats [out] number of entries filled.
+ * @return `0` on success, `errno` in case of error.
+ */
+int pman_get_rate_limit_stats(struct scap_rate_limit_stats* stats,
+                              uint32_t max_stats,
+                              uint32_t* nstats);
+
+/**
+ * @brief Set how the `cgroup_filter` map is applied.
+ *
+ * @param mode one of the `scap_cgroup_filter_mode` values.
+ */
+void pman_set_cgroup_filter_mode(uint8_t mode);
+
+/**
+ * @brief Add or remove a cgroup id from the `cgroup_filter` map.
+ *
+ * @param cgroup_id cgroup id.
+ * @param add true to add, false to remove.
+ * @return `0` on success, `errno` in case of error.
+ */
+int pman_cgroup_filter(uint64_t cgroup_id, bool add);
+
+/**
+ * @brief Remove all the cgroup ids from the `cgroup_filter` map.
+ *
+ * @return `0` on success, `errno` in case of error.
+ */
+int pman_clear_cgroup_filter(void);
+
+/**
+ * @brief Add or remove a thread group from the set of suppressed ones.
+ * The events of a suppressed thread group are dropped in the dispatcher,
+ * and its children are suppressed as well.
+ *
+ * @param tgid thread group id.
+ * @param suppress true to suppress, false to stop suppressing.
+ * @return `0` on success, `errno` in case of error.
+ */
+int pman_suppress_tgid(uint32_t tgid, bool suppress);
+
+/**
+ * @brief Add or remove a comm from the set of suppressed ones.
+ * A process is suppressed when it calls execve and its new comm is suppressed.
+ *
+ * @param comm process comm.
+ * @param suppress true to suppress, false to stop suppressing.
+ * @return `0` on success, `errno` in case of error.
+ */
+int pman_suppress_comm(const char* comm, bool suppress);
+
+/**
+ * @brief Remove all the suppressed thread groups and comms.
+ *
+ * @return `0` on success, `errno` in case of error.
+ */
+int pman_clear_suppressed(void);
+
 /**
  * @brief Get API version to check it a runtime.
  *
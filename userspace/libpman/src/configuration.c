@@ -85,6 +85,11 @@ static void clear_state() {
 	g_state.ringbuf_pos = 0;
 	g_state.cons_pos = NULL;
 	g_state.prod_pos = NULL;
+	g_state.buf_util_hist = NULL;
+	g_state.buf_lag_info = NULL;
+	g_state.n_consume_calls = 0;
+	g_state.merge_time_ns = 0;
+	g_state.n_merge_samples = 0;
 	g_state.inner_ringbuf_map_fd = -1;
 	g_state.buffer_bytes_dim = 0;
 	g_state.last_ring_read = -1;
@@ -275,6 +275,16 @@ void pman_close_probe() {
 		g_state.prod_pos = NULL;
 	}
 
+	if(g_state.buf_util_hist) {
+		free(g_state.buf_util_hist);
+		g_state.buf_util_hist = NULL;
+	}
+
+	if(g_state.buf_lag_info) {
+		free(g_state.buf_lag_info);
+		g_state.buf_lag_info = NULL;
+	}
+
 	if(g_state.skel) {
 		bpf_probe__detach(g_state.skel);
 		bpf_probe__destroy(g_state.skel);
@@ -18,10 +18,13 @@ limitations under the License.
 
 #include "state.h"
 
+#include <inttypes.h>
 #include <stdint.h>
+#include <string.h>
 #include "events_prog_table.h"
 #include "support_probing.h"
 #include <libscap/scap.h>
+#include <libscap/strl.h>
 
 /* Some exit events can require more than one bpf program to collect all the data. */
 static const char* sys_exit_extra_event_names[SYS_EXIT_EXTRA_CODE_MAX] = {
@@ -200,6 +203,43 @@ void pman_set_scap_tid(int32_t scap_tid) {
 	update_capture_settings(&settings);
 }
 
+void pman_set_rate_limit(uint32_t rate, uint32_t burst) {
+	struct capture_settings settings;
+	if(get_capture_settings(&settings) != 0) {
+		return;
+	}
+	settings.rate_limit_rate = rate;
+	settings.rate_limit_burst = burst != 0 ? burst : rate;
+	update_capture_settings(&settings);
+}
+
+void pman_set_cgroup_filter_mode(uint8_t mode) {
+	struct capture_settings settings;
+	if(get_capture_settings(&settings) != 0) {
+		return;
+	}
+	settings.cgroup_filter_mode = mode;
+	update_capture_settings(&settings);
+}
+
+void pman_set_io_aggregation_interval(uint32_t interval_ms) {
+	struct capture_settings settings;
+	if(get_capture_settings(&settings) != 0) {
+		return;
+	}
+	settings.io_aggregation_interval = (uint64_t)interval_ms * 1000000;
+	update_capture_settings(&settings);
+}
+
+void pman_set_io_fd_type_mask(uint32_t mask) {
+	struct capture_settings settings;
+	if(get_capture_settings(&settings) != 0) {
+		return;
+	}
+	settings.io_fd_type_mask = mask;
+	update_capture_settings(&settings);
+}
+
 static void fill_syscall_sampling_table() {
 	for(int syscall_id = 0; syscall_id < SYSCALL_TABLE_SIZE; syscall_id++) {
 		if(g_syscall_table[syscall_id].flags & UF_NEVER_DROP) {
@@ -395,6 +435,152 @@ static int size_counter_maps(const struct bpf_probe* probe, const uint32_t max_e
 
 /*=============================== BPF_MAP_TYPE_ARRAY ===============================*/
 
+/*=============================== BPF_MAP_TYPE_HASH ===============================*/
+
+static void set_suppression_enabled(bool enabled) {
+	struct capture_settings settings;
+	if(get_capture_settings(&settings) != 0) {
+		return;
+	}
+	if(settings.suppression_enabled != enabled) {
+		settings.suppression_enabled = enabled;
+		update_capture_settings(&settings);
+	}
+}
+
+int pman_suppress_tgid(uint32_t tgid, bool suppress) {
+	const int fd = bpf_map__fd(g_state.skel->maps.suppressed_tgids);
+	if(suppress) {
+		const uint8_t one = 1;
+		if(bpf_map_update_elem(fd, &tgid, &one, BPF_ANY) < 0) {
+			const int last_errno = errno;
+			log_errorf("unable to suppress tgid %u", tgid);
+			return last_errno;
+		}
+		set_suppression_enabled(true);
+	} else if(bpf_map_delete_elem(fd, &tgid) < 0 && errno != ENOENT) {
+		const int last_errno = errno;
+		log_errorf("unable to unsuppress tgid %u", tgid);
+		return last_errno;
+	}
+	return 0;
+}
+
+int pman_suppress_comm(const char* comm, bool suppress) {
+	const int fd = bpf_map__fd(g_state.skel->maps.suppressed_comms);
+	struct suppressed_comm key = {};
+	/* Comms longer than the kernel ones can't match any task. */
+	if(strlen(comm) >= sizeof(key.comm)) {
+		return 0;
+	}
+	strlcpy(key.comm, comm, sizeof(key.comm));
+	if(suppress) {
+		const uint8_t one = 1;
+		if(bpf_map_update_elem(fd, &key, &one, BPF_ANY) < 0) {
+			const int last_errno = errno;
+			log_errorf("unable to suppress comm '%s'", comm);
+			return last_errno;
+		}
+		set_suppression_enabled(true);
+	} else if(bpf_map_delete_elem(fd, &key) < 0 && errno != ENOENT) {
+		const int last_errno = errno;
+		log_errorf("unable to unsuppress comm '%s'", comm);
+		return last_errno;
+	}
+	return 0;
+}
+
+static int clear_hash_map(int fd, void* key, void* next_key, size_t key_size) {
+	/* Always restart from the first key since we delete what we visit. */
+	while(bpf_map_get_next_key(fd, NULL, next_key) == 0) {
+		memcpy(key, next_key, key_size);
+		if(bpf_map_delete_elem(fd, key) < 0 && errno != ENOENT) {
+			return errno;
+		}
+	}
+	return 0;
+}
+
+int pman_clear_suppressed(void) {
+	set_suppression_enabled(false);
+
+	uint32_t tgid, next_tgid;
+	int err = clear_hash_map(bpf_map__fd(g_state.skel->maps.suppressed_tgids),
+	                         &tgid,
+	                         &next_tgid,
+	                         sizeof(tgid));
+	if(err == 0) {
+		struct suppressed_comm comm, next_comm;
+		err = clear_hash_map(bpf_map__fd(g_state.skel->maps.suppressed_comms),
+		                     &comm,
+		                     &next_comm,
+		                     sizeof(comm));
+	}
+	if(err != 0) {
+		log_errorf("unable to clear the suppression maps");
+	}
+	return err;
+}
+
+int pman_cgroup_filter(uint64_t cgroup_id, bool add) {
+	const int fd = bpf_map__fd(g_state.skel->maps.cgroup_filter);
+	if(add) {
+		const uint8_t one = 1;
+		if(bpf_map_update_elem(fd, &cgroup_id, &one, BPF_ANY) < 0) {
+			const int last_errno = errno;
+			log_errorf("unable to add cgroup %" PRIu64 " to the cgroup filter", cgroup_id);
+			return last_errno;
+		}
+	} else if(bpf_map_delete_elem(fd, &cgroup_id) < 0 && errno != ENOENT) {
+		const int last_errno = errno;
+		log_errorf("unable to remove cgroup %" PRIu64 " from the cgroup filter", cgroup_id);
+		return last_errno;
+	}
+	return 0;
+}
+
+int pman_clear_cgroup_filter(void) {
+	uint64_t cgroup_id, next_cgroup_id;
+	int err = clear_hash_map(bpf_map__fd(g_state.skel->maps.cgroup_filter),
+	                         &cgroup_id,
+	                         &next_cgroup_id,
+	                         sizeof(cgroup_id));
+	if(err != 0) {
+		log_errorf("unable to clear the cgroup filter");
+	}
+	return err;
+}
+
+/*=============================== BPF_MAP_TYPE_HASH ===============================*/
+
+/*=============================== BPF_MAP_TYPE_LRU_HASH ===============================*/
+
+int pman_get_rate_limit_stats(struct scap_rate_limit_stats* stats,
+                              uint32_t max_stats,
+                              uint32_t* nstats) {
+	const int fd = bpf_map__fd(g_state.skel->maps.rate_limit_buckets);
+	struct rate_limit_bucket bucket;
+	uint32_t key = 0;
+	uint32_t next_key = 0;
+	uint32_t* prev_key = NULL;
+
+	*nstats = 0;
+	while(*nstats < max_stats && bpf_map_get_next_key(fd, prev_key, &next_key) == 0) {
+		key = next_key;
+		prev_key = &key;
+		/* The entry could have been evicted in the meantime. */
+		if(bpf_map_lookup_elem(fd, &key, &bucket) != 0 || bucket.n_drops == 0) {
+			continue;
+		}
+		stats[*nstats].tgid = key;
+		stats[*nstats].n_drops = bucket.n_drops;
+		(*nstats)++;
+	}
+	return 0;
+}
+
+/*=============================== BPF_MAP_TYPE_LRU_HASH ===============================*/
+
 /* Here we split maps operations, before and after the loading phase.
  */
 
@@ -22,8 +22,10 @@ limitations under the License.
 #include <stdint.h>
 #include <stdbool.h>
 #include <sys/mman.h>
+#include <time.h>
 #include <ringbuffer_debug_macro.h>
 #include <driver/ppm_events_public.h>
+#include <libpman.h>
 
 #include "ringbuffer_definitions.h"
 #include "support_probing.h"
@@ -70,8 +72,11 @@ static int allocate_consumer_producer_positions() {
 	g_state.ringbuf_pos = 0;
 	g_state.cons_pos = (unsigned long *)calloc(g_state.n_required_buffers, sizeof(unsigned long));
 	g_state.prod_pos = (unsigned long *)calloc(g_state.n_required_buffers, sizeof(unsigned long));
-	if(g_state.cons_pos == NULL || g_state.prod_pos == NULL) {
-		log_errorf("failed to alloc memory for cons_pos and prod_pos");
+	g_state.buf_util_hist = calloc(g_state.n_required_buffers, sizeof(*g_state.buf_util_hist));
+	g_state.buf_lag_info = calloc(g_state.n_required_buffers, sizeof(*g_state.buf_lag_info));
+	if(g_state.cons_pos == NULL || g_state.prod_pos == NULL || g_state.buf_util_hist == NULL ||
+	   g_state.buf_lag_info == NULL) {
+		log_errorf("failed to alloc memory for the ringbuf positions and stats");
 		return errno;
 	}
 	return 0;
@@ -263,8 +268,21 @@ static inline void *ringbuf__get_first_ring_event(struct ring *r, int pos) {
 		// lowest than all the other events in the other buffers.
 		g_state.prod_pos[pos] = smp_load_acquire(r->producer_pos);
 		if(g_state.cons_pos[pos] == g_state.prod_pos[pos]) {
+			g_state.buf_lag_info[pos].head_ts = 0;
 			return NULL;
 		}
+		/* Everything between the two positions has been produced since the last time we
+		 * caught up with the producer: this is how full the buffer got in the meantime.
+		 */
+		const unsigned long occupancy = g_state.prod_pos[pos] - g_state.cons_pos[pos];
+		unsigned long bucket = occupancy * RINGBUF_UTIL_BUCKETS / (r->mask + 1);
+		if(bucket >= RINGBUF_UTIL_BUCKETS) {
+			bucket = RINGBUF_UTIL_BUCKETS - 1;
+		}
+		g_state.buf_util_hist[pos][bucket]++;
+		if(occupancy > g_state.buf_lag_info[pos].max_occupancy) {
+			g_state.buf_lag_info[pos].max_occupancy = occupancy;
+		}
 	}
 
 	len_ptr = r->data + (g_state.cons_pos[pos] & r->mask);
@@ -279,7 +297,9 @@ static inline void *ringbuf__get_first_ring_event(struct ring *r, int pos) {
 	if((len & BPF_RINGBUF_DISCARD_BIT) == 0) {
 		/* Save the size of the event if we need to increment the consumer */
 		g_state.last_event_size = roundup_len(len);
-		return (void *)len_ptr + BPF_RINGBUF_HDR_SZ;
+		struct ppm_evt_hdr *hdr = (void *)len_ptr + BPF_RINGBUF_HDR_SZ;
+		g_state.buf_lag_info[pos].head_ts = hdr->ts;
+		return hdr;
 	} else {
 		/* Discard the event kernel side and update the consumer position */
 		g_state.cons_pos[pos] += roundup_len(len);
@@ -303,6 +323,13 @@ static void ringbuf__consume_first_event(struct ring_buffer *rb,
 		smp_store_release(r->consumer_pos, g_state.cons_pos[g_state.last_ring_read]);
 	}
 
+	struct timespec merge_start = {};
+	const bool sample_merge_time =
+	        (g_state.n_consume_calls++ & (RINGBUF_MERGE_SAMPLING_RATE - 1)) == 0;
+	if(sample_merge_time) {
+		clock_gettime(CLOCK_MONOTONIC, &merge_start);
+	}
+
 	R_D_MSG("\n-----------------------------\nIterate over all the buffers\n");
 	for(uint16_t pos = 0; pos < rb->ring_cnt; pos++) {
 		*event_ptr = ringbuf__get_first_ring_event(rb->rings[pos], pos);
@@ -322,6 +349,14 @@ static void ringbuf__consume_first_event(struct ring_buffer *rb,
 		}
 	}
 
+	if(sample_merge_time) {
+		struct timespec merge_end;
+		clock_gettime(CLOCK_MONOTONIC, &merge_end);
+		g_state.merge_time_ns += (merge_end.tv_sec - merge_start.tv_sec) * 1000000000ULL +
+		                         merge_end.tv_nsec - merge_start.tv_nsec;
+		g_state.n_merge_samples++;
+	}
+
 	*event_ptr = tmp_pointer;
 	*buffer_id = tmp_ring;
 	g_state.last_ring_read = tmp_ring;
@@ -334,3 +369,60 @@ static void ringbuf__consume_first_event(struct ring_buffer *rb,
 void pman_consume_first_event(void **event_ptr, int16_t *buffer_id) {
 	ringbuf__consume_first_event(g_state.rb_manager, (struct ppm_evt_hdr **)event_ptr, buffer_id);
 }
+
+/* Autotune */
+
+/* Don't propose buffers bigger than this, they are mapped twice. */
+#define AUTOTUNE_MAX_BUFFER_BYTES_DIM (512UL * 1024 * 1024)
+/* Samples in the last utilization bucket, per 1000 samples, above which a buffer is considered
+ * under pressure even without drops. */
+#define AUTOTUNE_FULL_SAMPLES_PER_MILLE 10
+
+int pman_get_buffers_recommendation(uint16_t *cpus_for_each_buffer,
+                                    unsigned long *buf_bytes_dim) {
+	*cpus_for_each_buffer = g_state.cpus_for_each_buffer;
+	*buf_bytes_dim = g_state.buffer_bytes_dim;
+	if(g_state.buf_util_hist == NULL) {
+		return 0;
+	}
+
+	struct scap_stats stats = {};
+	int err = pman_get_scap_stats(&stats);
+	if(err) {
+		return err;
+	}
+
+	uint64_t n_samples = 0;
+	bool under_pressure = stats.n_drops_buffer != 0;
+	bool half_empty = true;
+	for(uint32_t pos = 0; pos < g_state.n_required_buffers; pos++) {
+		uint64_t buf_samples = 0;
+		for(int bucket = 0; bucket < RINGBUF_UTIL_BUCKETS; bucket++) {
+			buf_samples += g_state.buf_util_hist[pos][bucket];
+			if(bucket >= RINGBUF_UTIL_BUCKETS / 2 && g_state.buf_util_hist[pos][bucket] != 0) {
+				half_empty = false;
+			}
+		}
+		n_samples += buf_samples;
+		if(g_state.buf_util_hist[pos][RINGBUF_UTIL_BUCKETS - 1] * 1000 >
+		   buf_samples * AUTOTUNE_FULL_SAMPLES_PER_MILLE) {
+			under_pressure = true;
+		}
+	}
+
+	if(under_pressure) {
+		/* First spread the load on more buffers, then make them bigger. */
+		if(g_state.cpus_for_each_buffer > 1) {
+			*cpus_for_each_buffer = g_state.cpus_for_each_buffer / 2;
+		} else if(g_state.buffer_bytes_dim < AUTOTUNE_MAX_BUFFER_BYTES_DIM) {
+			*buf_bytes_dim = g_state.buffer_bytes_dim * 2;
+		}
+	} else if(n_samples != 0 && half_empty && g_state.n_required_buffers > 1) {
+		/* No buffer ever got half full, merging fewer buffers is cheaper. */
+		*cpus_for_each_buffer = g_state.cpus_for_each_buffer * 2;
+		if(*cpus_for_each_buffer > g_state.n_interesting_cpus) {
+			*cpus_for_each_buffer = g_state.n_interesting_cpus;
+		}
+	}
+	return 0;
+}
@@ -38,8 +38,23 @@ limitations under the License.
 	(UINT32_MAX >> 8) /* Recommended log buffer size, taken from libbpf. Used for verifier logs */
 #define BPF_LOG_SMALL_BUF_SIZE 8192 /* Used for libbpf non-verifier logs */
 
+/* Number of buckets of the per-buffer utilization histograms, each bucket covers
+ * `100 / RINGBUF_UTIL_BUCKETS` percent of the buffer. */
+#define RINGBUF_UTIL_BUCKETS 4
+
+/* The time spent in the k-way merge is measured once every `RINGBUF_MERGE_SAMPLING_RATE` events
+ * (must be a power of 2), reading the clock for every event would cost more than the merge. */
+#define RINGBUF_MERGE_SAMPLING_RATE 256
+
 struct metrics_v2;
 
+/* Consumer-side view of a ring buffer, sampled while looking for the next event. */
+struct ringbuf_lag_info {
+	unsigned long max_occupancy; /* high watermark of `prod_pos - cons_pos` in bytes. */
+	uint64_t head_ts;            /* timestamp of the first unconsumed event, `0` if the ring
+	                                was empty the last time we looked at it. */
+};
+
 #ifdef BPF_ITERATOR_SUPPORT
 
 // Store information about the support for `bpf_iter_link_info` or any of its members.
@@ -75,6 +90,14 @@ struct internal_state {
 	               there were no successful reads. */
 	unsigned long last_event_size; /* Last event correctly read. Could be `0` if there were no
 	                                  successful reads. */
+	uint64_t (*buf_util_hist)[RINGBUF_UTIL_BUCKETS]; /* for every ringbuf, histogram of the
+	                                                    occupancy found every time the consumer
+	                                                    reloads the producer position. */
+	struct ringbuf_lag_info* buf_lag_info; /* for every ringbuf, occupancy and oldest event. */
+	uint64_t n_consume_calls;              /* number of calls to `pman_consume_first_event`. */
+	uint64_t merge_time_ns;  /* time spent merging the ringbufs, sampled once every
+	                            `RINGBUF_MERGE_SAMPLING_RATE` calls. */
+	uint64_t n_merge_samples; /* number of merge time samples. */
 
 	/* Stats v2 utilities */
 	int32_t attached_progs_fds[MODERN_BPF_PROG_ATTACHED_MAX]; /* file descriptors of attached
@@ -17,9 +17,12 @@ limitations under the License.
 */
 
 #include "state.h"
+#include "ringbuffer_definitions.h"
+#include <time.h>
 #include <libscap/scap_assert.h>
 #include <libscap/scap.h>
 #include <libscap/strl.h>
+#include <libpman.h>
 
 typedef enum modern_bpf_kernel_counters_stats {
 	MODERN_BPF_N_EVTS = 0,
@@ -36,6 +39,11 @@ typedef enum modern_bpf_kernel_counters_stats {
 	MODERN_BPF_N_DROPS_BUFFER_PROC_EXIT,
 	MODERN_BPF_N_DROPS_SCRATCH_MAP,
 	MODERN_BPF_N_DROPS,
+	MODERN_BPF_N_SUPPRESSED,
+	MODERN_BPF_N_DROPS_RATE_LIMIT,
+	MODERN_BPF_N_CGROUP_FILTERED,
+	MODERN_BPF_N_IO_AGGREGATED,
+	MODERN_BPF_N_FD_TYPE_FILTERED,
 	MODERN_BPF_MAX_KERNEL_COUNTERS_STATS
 } modern_bpf_kernel_counters_stats;
 
@@ -73,6 +81,19 @@ typedef enum modern_bpf_libbpf_stats {
 	MODERN_BPF_MAX_LIBBPF_STATS,
 } modern_bpf_libbpf_stats;
 
+typedef enum modern_bpf_buffer_lag_stats {
+	MODERN_BPF_BUFFER_OCCUPANCY_MAX = 0,
+	MODERN_BPF_BUFFER_LAG,
+	MODERN_BPF_BUFFER_OLDEST_EVT_AGE,
+	MODERN_BPF_MAX_BUFFER_LAG_STATS,
+} modern_bpf_buffer_lag_stats;
+
+typedef enum modern_bpf_autotune_stats {
+	MODERN_BPF_AUTOTUNE_CPUS_FOR_EACH_BUFFER = 0,
+	MODERN_BPF_AUTOTUNE_BUFFER_BYTES_DIM,
+	MODERN_BPF_MAX_AUTOTUNE_STATS,
+} modern_bpf_autotune_stats;
+
 const char *const modern_bpf_kernel_counters_stats_names[] = {
         [MODERN_BPF_N_EVTS] = N_EVENTS_PREFIX,
         [MODERN_BPF_N_DROPS_BUFFER_TOTAL] = "n_drops_buffer_total",
@@ -88,6 +109,11 @@ const char *const modern_bpf_kernel_counters_stats_names[] = {
         [MODERN_BPF_N_DROPS_BUFFER_PROC_EXIT] = "n_drops_buffer_proc_exit",
         [MODERN_BPF_N_DROPS_SCRATCH_MAP] = "n_drops_scratch_map",
         [MODERN_BPF_N_DROPS] = "n_drops",
+        [MODERN_BPF_N_SUPPRESSED] = "n_suppressed",
+        [MODERN_BPF_N_DROPS_RATE_LIMIT] = "n_drops_rate_limit",
+        [MODERN_BPF_N_CGROUP_FILTERED] = "n_cgroup_filtered",
+        [MODERN_BPF_N_IO_AGGREGATED] = "n_io_aggregated",
+        [MODERN_BPF_N_FD_TYPE_FILTERED] = "n_fd_type_filtered",
 };
 
 #ifdef BPF_ITERATOR_SUPPORT
@@ -116,6 +142,18 @@ const char *const modern_bpf_kernel_iter_counters_stats_names[] = {
 };
 #endif /* BPF_ITERATOR_SUPPORT */
 
+// Prefixes, the ring buffer id is appended to them.
+const char *const modern_bpf_buffer_lag_stats_names[] = {
+        [MODERN_BPF_BUFFER_OCCUPANCY_MAX] = "occupancy_max_bytes_buf_",
+        [MODERN_BPF_BUFFER_LAG] = "lag_bytes_buf_",
+        [MODERN_BPF_BUFFER_OLDEST_EVT_AGE] = "oldest_evt_age_ns_buf_",
+};
+
+const char *const modern_bpf_autotune_stats_names[] = {
+        [MODERN_BPF_AUTOTUNE_CPUS_FOR_EACH_BUFFER] = "autotune_cpus_for_each_buffer",
+        [MODERN_BPF_AUTOTUNE_BUFFER_BYTES_DIM] = "autotune_buffer_bytes_dim",
+};
+
 const char *const modern_bpf_libbpf_stats_names[] = {
         [RUN_CNT] = ".run_cnt",          ///< `bpf_prog_info` run_cnt.
         [RUN_TIME_NS] = ".run_time_ns",  ///<`bpf_prog_info` run_time_ns.
@@ -168,6 +206,11 @@ int pman_get_scap_stats(struct scap_stats *stats) {
 		stats->n_drops_buffer_other_interest_exit += cnt_map.n_drops_buffer_other_interest_exit;
 		stats->n_drops_scratch_map += cnt_map.n_drops_max_event_size;
 		stats->n_drops += (cnt_map.n_drops_buffer + cnt_map.n_drops_max_event_size);
+		stats->n_suppressed += cnt_map.n_suppressed;
+		stats->n_drops_rate_limit += cnt_map.n_drops_rate_limit;
+		stats->n_cgroup_filtered += cnt_map.n_cgroup_filtered;
+		stats->n_io_aggregated += cnt_map.n_io_aggregated;
+		stats->n_fd_type_filtered += cnt_map.n_fd_type_filtered;
 	}
 	return 0;
 }
@@ -204,8 +247,18 @@ static int init_metrics_v2(const uint32_t flags) {
 	}
 #endif /* BPF_ITERATOR_SUPPORT */
 
+	uint32_t buffers_stats = 0;
+	if(flags & METRICS_V2_KERNEL_BUFFERS) {
+		// For each ring buffer we want its utilization histogram and consumer lag,
+		// plus the time spent merging them and the recommended configuration.
+		buffers_stats = g_state.n_required_buffers *
+		                        (RINGBUF_UTIL_BUCKETS + MODERN_BPF_MAX_BUFFER_LAG_STATS) +
+		                1 + MODERN_BPF_MAX_AUTOTUNE_STATS;
+	}
+
 	const uint32_t n_stats = MODERN_BPF_MAX_KERNEL_COUNTERS_STATS + per_cpu_stats +
-	                         (nprogs_attached * MODERN_BPF_MAX_LIBBPF_STATS) + iter_stats;
+	                         (nprogs_attached * MODERN_BPF_MAX_LIBBPF_STATS) + iter_stats +
+	                         buffers_stats;
 	struct metrics_v2 *stats = (metrics_v2 *)calloc(n_stats, sizeof(metrics_v2));
 	if(!stats) {
 		log_errorf("unable to allocate memory for 'metrics_v2' array");
@@ -270,6 +323,11 @@ static int collect_kernel_counter_stats(const int counter_maps_fd, const bool co
 		g_state.stats[MODERN_BPF_N_DROPS_SCRATCH_MAP].value.u64 += cnt_map.n_drops_max_event_size;
 		g_state.stats[MODERN_BPF_N_DROPS].value.u64 +=
 		        (cnt_map.n_drops_buffer + cnt_map.n_drops_max_event_size);
+		g_state.stats[MODERN_BPF_N_SUPPRESSED].value.u64 += cnt_map.n_suppressed;
+		g_state.stats[MODERN_BPF_N_DROPS_RATE_LIMIT].value.u64 += cnt_map.n_drops_rate_limit;
+		g_state.stats[MODERN_BPF_N_CGROUP_FILTERED].value.u64 += cnt_map.n_cgroup_filtered;
+		g_state.stats[MODERN_BPF_N_IO_AGGREGATED].value.u64 += cnt_map.n_io_aggregated;
+		g_state.stats[MODERN_BPF_N_FD_TYPE_FILTERED].value.u64 += cnt_map.n_fd_type_filtered;
 
 		if(!collect_per_cpu) {
 			continue;
@@ -448,6 +506,96 @@ static int collect_kernel_iter_counter_stats(const int counters_map_fd, const in
 
 #endif /* BPF_ITERATOR_SUPPORT */
 
+// Collects stats for `METRICS_V2_KERNEL_BUFFERS`. `base_offset` is the first free position in the
+// global v2 metrics array to push buffer stats to. Returns the strictly-positive number of
+// collected stats on success, -1 otherwise.
+static int collect_buffers_stats(const int base_offset) {
+	uint32_t offset = base_offset;
+	if(offset +
+	           g_state.n_required_buffers *
+	                   (RINGBUF_UTIL_BUCKETS + MODERN_BPF_MAX_BUFFER_LAG_STATS) +
+	           1 + MODERN_BPF_MAX_AUTOTUNE_STATS >
+	   g_state.nstats) {
+		log_errorf("no enough space for all the stats");
+		return -1;
+	}
+
+	struct timespec now_ts;
+	clock_gettime(CLOCK_REALTIME, &now_ts);
+	const uint64_t now = now_ts.tv_sec * (uint64_t)1000000000 + now_ts.tv_nsec;
+	for(uint32_t pos = 0; pos < g_state.n_required_buffers; pos++) {
+		const struct ringbuf_lag_info *info = &g_state.buf_lag_info[pos];
+		const struct ring *r = g_state.rb_manager->rings[pos];
+		const unsigned long prod_pos = smp_load_acquire(r->producer_pos);
+		uint64_t values[MODERN_BPF_MAX_BUFFER_LAG_STATS] = {
+		        [MODERN_BPF_BUFFER_OCCUPANCY_MAX] = info->max_occupancy,
+		        [MODERN_BPF_BUFFER_LAG] = prod_pos - g_state.cons_pos[pos],
+		        [MODERN_BPF_BUFFER_OLDEST_EVT_AGE] =
+		                info->head_ts != 0 && now > info->head_ts ? now - info->head_ts : 0,
+		};
+		for(uint32_t stat = 0; stat < MODERN_BPF_MAX_BUFFER_LAG_STATS; stat++) {
+			g_state.stats[offset].type = METRIC_VALUE_TYPE_U64;
+			g_state.stats[offset].flags = METRICS_V2_KERNEL_BUFFERS;
+			g_state.stats[offset].unit = stat == MODERN_BPF_BUFFER_OLDEST_EVT_AGE
+			                                     ? METRIC_VALUE_UNIT_TIME_NS
+			                                     : METRIC_VALUE_UNIT_MEMORY_BYTES;
+			g_state.stats[offset].metric_type = METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT;
+			g_state.stats[offset].value.u64 = values[stat];
+			snprintf(g_state.stats[offset].name,
+			         METRIC_NAME_MAX,
+			         "%s%u",
+			         modern_bpf_buffer_lag_stats_names[stat],
+			         pos);
+			offset++;
+		}
+	}
+
+	g_state.stats[offset].type = METRIC_VALUE_TYPE_U64;
+	g_state.stats[offset].flags = METRICS_V2_KERNEL_BUFFERS;
+	g_state.stats[offset].unit = METRIC_VALUE_UNIT_TIME_NS;
+	g_state.stats[offset].metric_type = METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT;
+	g_state.stats[offset].value.u64 =
+	        g_state.n_merge_samples ? g_state.merge_time_ns / g_state.n_merge_samples : 0;
+	strlcpy(g_state.stats[offset].name, "merge_time_avg_ns", METRIC_NAME_MAX);
+	offset++;
+
+	for(uint32_t pos = 0; pos < g_state.n_required_buffers; pos++) {
+		for(int bucket = 0; bucket < RINGBUF_UTIL_BUCKETS; bucket++) {
+			set_u64_monotonic_kernel_counter(offset,
+			                                 g_state.buf_util_hist[pos][bucket],
+			                                 METRICS_V2_KERNEL_BUFFERS);
+			snprintf(g_state.stats[offset].name,
+			         METRIC_NAME_MAX,
+			         N_UTIL_SAMPLES_PER_BUFFER_PREFIX "%u_le_%d",
+			         pos,
+			         (bucket + 1) * 100 / RINGBUF_UTIL_BUCKETS);
+			offset++;
+		}
+	}
+
+	uint16_t cpus_for_each_buffer = 0;
+	unsigned long buf_bytes_dim = 0;
+	if(pman_get_buffers_recommendation(&cpus_for_each_buffer, &buf_bytes_dim)) {
+		return -1;
+	}
+	for(uint32_t stat = 0; stat < MODERN_BPF_MAX_AUTOTUNE_STATS; stat++) {
+		g_state.stats[offset + stat].type = METRIC_VALUE_TYPE_U64;
+		g_state.stats[offset + stat].flags = METRICS_V2_KERNEL_BUFFERS;
+		g_state.stats[offset + stat].metric_type = METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT;
+		strlcpy(g_state.stats[offset + stat].name,
+		        modern_bpf_autotune_stats_names[stat],
+		        METRIC_NAME_MAX);
+	}
+	g_state.stats[offset + MODERN_BPF_AUTOTUNE_CPUS_FOR_EACH_BUFFER].unit = METRIC_VALUE_UNIT_COUNT;
+	g_state.stats[offset + MODERN_BPF_AUTOTUNE_CPUS_FOR_EACH_BUFFER].value.u64 =
+	        cpus_for_each_buffer;
+	g_state.stats[offset + MODERN_BPF_AUTOTUNE_BUFFER_BYTES_DIM].unit = METRIC_VALUE_UNIT_MEMORY_BYTES;
+	g_state.stats[offset + MODERN_BPF_AUTOTUNE_BUFFER_BYTES_DIM].value.u64 = buf_bytes_dim;
+	offset += MODERN_BPF_MAX_AUTOTUNE_STATS;
+
+	return offset - base_offset;
+}
+
 struct metrics_v2 *pman_get_metrics_v2(uint32_t flags, uint32_t *nstats, int32_t *rc) {
 	*rc = SCAP_FAILURE;
 	*nstats = 0;
@@ -509,6 +657,15 @@ struct metrics_v2 *pman_get_metrics_v2(uint32_t flags, uint32_t *nstats, int32_t
 	}
 #endif /* BPF_ITERATOR_SUPPORT */
 
+	/* RING BUFFERS STATS */
+	if(flags & METRICS_V2_KERNEL_BUFFERS) {
+		const int collected_stats = collect_buffers_stats(offset);
+		if(collected_stats < 0) {
+			return NULL;
+		}
+		offset += collected_stats;
+	}
+
 	/* Update with the real number of stats collected */
 	*nstats = offset;
 	*rc = SCAP_SUCCESS;
@@ -32,4 +32,5 @@ struct kmod_engine {
 	bool capturing;
 	metrics_v2* m_stats;
 	uint32_t m_nstats;
+	struct spill_buffer* m_spill;  // userspace spill buffer, NULL if disabled
 };
@@ -27,6 +27,13 @@ struct scap_kmod_engine_params {
 	unsigned long buffer_bytes_dim;  ///< Dimension of a single per-CPU buffer in bytes. Please
 	                                 ///< note: this buffer will be mapped twice in the process
 	                                 ///< virtual memory, so pay attention to its size.
+	unsigned long spill_buffer_bytes_dim;  ///< [EXPERIMENTAL] If not `0`, a dedicated thread
+	                                       ///< drains the per-CPU buffers into a userspace spill
+	                                       ///< buffer of this size, so that a slow consumer
+	                                       ///< doesn't cause kernel-side drops.
+	unsigned long spill_buffer_max_bytes_dim;  ///< [EXPERIMENTAL] Size up to which the spill
+	                                           ///< buffer is allowed to grow. `0` means that
+	                                           ///< it never grows past `spill_buffer_bytes_dim`.
 };
 
 extern const struct scap_linux_vtable scap_kmod_linux_vtable;
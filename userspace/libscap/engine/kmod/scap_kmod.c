@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -32,6 +33,7 @@ limitations under the License.
 #include <libscap/scap-int.h>
 #include <libscap/scap_engine_util.h>
 #include <libscap/ringbuffer/ringbuffer.h>
+#include <libscap/ringbuffer/spill_buffer.h>
 #include <libscap/strl.h>
 #include <libscap/strerror.h>
 #include <driver/ppm_tp.h>
@@ -56,6 +58,8 @@ static const char *const kmod_kernel_counters_stats_names[] = {
         [KMOD_N_DROPS_BUG] = "n_drops_bug",
         [KMOD_N_DROPS] = "n_drops",
         [KMOD_N_PREEMPTIONS] = "n_preemptions",
+        [KMOD_N_SUPPRESSED] = "n_suppressed",
+        [KMOD_N_FD_TYPE_FILTERED] = "n_fd_type_filtered",
 };
 
 static void *alloc_handle(scap_t *main_handle, char *lasterr_ptr) {
@@ -286,6 +290,13 @@ static int32_t scap_kmod_handle_sc(struct scap_engine_handle engine, uint32_t op
 	return SCAP_SUCCESS;
 }
 
+static int32_t scap_kmod_consume(struct scap_engine_handle engine,
+                                 scap_evt **pevent,
+                                 uint16_t *pdevid,
+                                 uint32_t *pflags) {
+	return ringbuffer_next(&HANDLE(engine)->m_dev_set, pevent, pdevid, pflags);
+}
+
 int32_t scap_kmod_init(scap_t *handle, scap_open_args *oargs) {
 	struct scap_engine_handle engine = handle->m_engine;
 	struct scap_kmod_engine_params *params = oargs->engine_params;
@@ -523,12 +534,39 @@ int32_t scap_kmod_init(scap_t *handle, scap_open_args *oargs) {
 	       &oargs->ppm_sc_of_interest,
 	       sizeof(interesting_ppm_sc_set));
 
+	/* The settings are per consumer, it's enough to send them through the first device. */
+	if(oargs->io_fd_type_mask != 0 &&
+	   ioctl(devset->m_devs[0].m_fd, PPM_IOCTL_SET_IO_FD_TYPE_MASK, oargs->io_fd_type_mask)) {
+		return scap_errprintf(handle->m_lasterr, errno, "unable to set the I/O fd type mask");
+	}
+
+	/* Start draining the per-CPU buffers from a dedicated thread, if requested */
+	if(params->spill_buffer_bytes_dim != 0) {
+		HANDLE(engine)->m_spill = spill_buffer_alloc(params->spill_buffer_bytes_dim,
+		                                             params->spill_buffer_max_bytes_dim,
+		                                             handle->m_lasterr);
+		if(HANDLE(engine)->m_spill == NULL) {
+			return SCAP_FAILURE;
+		}
+		rc = spill_buffer_start(HANDLE(engine)->m_spill,
+		                        engine,
+		                        scap_kmod_consume,
+		                        handle->m_lasterr);
+		if(rc != SCAP_SUCCESS) {
+			return rc;
+		}
+	}
+
 	return SCAP_SUCCESS;
 }
 
 int32_t scap_kmod_close(struct scap_engine_handle engine) {
 	struct scap_device_set *devset = &HANDLE(engine)->m_dev_set;
 
+	// The drain thread must be stopped before the buffers are unmapped
+	spill_buffer_free(HANDLE(engine)->m_spill);
+	HANDLE(engine)->m_spill = NULL;
+
 	devset_free(devset);
 
 	if(HANDLE(engine)->m_stats) {
@@ -542,7 +580,11 @@ int32_t scap_kmod_next(struct scap_engine_handle engine,
                        scap_evt **pevent,
                        uint16_t *pdevid,
                        uint32_t *pflags) {
-	return ringbuffer_next(&HANDLE(engine)->m_dev_set, pevent, pdevid, pflags);
+	// When the spill buffer is enabled the per-CPU buffers are consumed by the drain thread
+	if(HANDLE(engine)->m_spill) {
+		return spill_buffer_next(HANDLE(engine)->m_spill, pevent, pdevid, pflags);
+	}
+	return scap_kmod_consume(engine, pevent, pdevid, pflags);
 }
 
 uint32_t scap_kmod_get_n_devs(struct scap_engine_handle engine) {
@@ -578,6 +620,15 @@ int32_t scap_kmod_get_stats(struct scap_engine_handle engine, scap_stats *stats)
 		stats->n_drops_pf += dev->m_bufinfo->n_drops_pf;
 		stats->n_drops += dev->m_bufinfo->n_drops_buffer + dev->m_bufinfo->n_drops_pf;
 		stats->n_preemptions += dev->m_bufinfo->n_preemptions;
+		stats->n_suppressed += dev->m_bufinfo->n_suppressed;
+		stats->n_fd_type_filtered += dev->m_bufinfo->n_fd_type_filtered;
+	}
+
+	if(HANDLE(engine)->m_spill) {
+		struct spill_buffer_stats spill_stats;
+		spill_buffer_get_stats(HANDLE(engine)->m_spill, &spill_stats);
+		stats->n_drops_spill = spill_stats.n_drops;
+		stats->n_drops += spill_stats.n_drops;
 	}
 
 	return SCAP_SUCCESS;
@@ -669,6 +720,8 @@ const struct metrics_v2 *scap_kmod_get_stats_v2(struct scap_engine_handle engine
 			stats[KMOD_N_DROPS].value.u64 +=
 			        dev->m_bufinfo->n_drops_buffer + dev->m_bufinfo->n_drops_pf;
 			stats[KMOD_N_PREEMPTIONS].value.u64 += dev->m_bufinfo->n_preemptions;
+			stats[KMOD_N_SUPPRESSED].value.u64 += dev->m_bufinfo->n_suppressed;
+			stats[KMOD_N_FD_TYPE_FILTERED].value.u64 += dev->m_bufinfo->n_fd_type_filtered;
 
 			if((flags & METRICS_V2_KERNEL_COUNTERS_PER_CPU)) {
 				// We set the num events for that CPU.
@@ -881,6 +934,42 @@ int32_t scap_kmod_set_statsd_port(struct scap_engine_handle engine, const uint16
 	return SCAP_SUCCESS;
 }
 
+int32_t scap_kmod_suppress_tgid(struct scap_engine_handle engine, uint32_t tgid, bool suppress) {
+	int req = suppress ? PPM_IOCTL_SUPPRESS_TGID : PPM_IOCTL_UNSUPPRESS_TGID;
+	if(ioctl(HANDLE(engine)->m_dev_set.m_devs[0].m_fd, req, tgid)) {
+		return scap_errprintf(HANDLE(engine)->m_lasterr, errno, "scap_suppress_tgid failed");
+	}
+	return SCAP_SUCCESS;
+}
+
+int32_t scap_kmod_suppress_comm(struct scap_engine_handle engine,
+                                const char *comm,
+                                bool suppress) {
+	char buf[PPM_COMM_LEN] = {0};
+
+	//
+	// Comms longer than the kernel ones can never match, the userspace
+	// suppression takes care of them.
+	//
+	if(comm == NULL || strlen(comm) >= PPM_COMM_LEN) {
+		return SCAP_SUCCESS;
+	}
+	memcpy(buf, comm, strlen(comm));
+
+	int req = suppress ? PPM_IOCTL_SUPPRESS_COMM : PPM_IOCTL_UNSUPPRESS_COMM;
+	if(ioctl(HANDLE(engine)->m_dev_set.m_devs[0].m_fd, req, buf)) {
+		return scap_errprintf(HANDLE(engine)->m_lasterr, errno, "scap_suppress_comm failed");
+	}
+	return SCAP_SUCCESS;
+}
+
+int32_t scap_kmod_clear_suppressed(struct scap_engine_handle engine) {
+	if(ioctl(HANDLE(engine)->m_dev_set.m_devs[0].m_fd, PPM_IOCTL_CLEAR_SUPPRESSED)) {
+		return scap_errprintf(HANDLE(engine)->m_lasterr, errno, "scap_clear_suppressed failed");
+	}
+	return SCAP_SUCCESS;
+}
+
 static int32_t configure(struct scap_engine_handle engine,
                          enum scap_setting setting,
                          unsigned long arg1,
@@ -904,6 +993,12 @@ static int32_t configure(struct scap_engine_handle engine,
 		return scap_kmod_set_fullcapture_port_range(engine, arg1, arg2);
 	case SCAP_STATSD_PORT:
 		return scap_kmod_set_statsd_port(engine, arg1);
+	case SCAP_SUPPRESS_TGID:
+		return scap_kmod_suppress_tgid(engine, arg1, arg2);
+	case SCAP_SUPPRESS_COMM:
+		return scap_kmod_suppress_comm(engine, (const char *)arg1, arg2);
+	case SCAP_CLEAR_SUPPRESSED:
+		return scap_kmod_clear_suppressed(engine);
 	default: {
 		return scap_err_unsupported_setting(HANDLE(engine)->m_lasterr, setting, arg1, arg2);
 	}
@@ -35,5 +35,7 @@ typedef enum kmod_kernel_counters_stats {
 	KMOD_N_DROPS_BUG,
 	KMOD_N_DROPS,
 	KMOD_N_PREEMPTIONS,
+	KMOD_N_SUPPRESSED,
+	KMOD_N_FD_TYPE_FILTERED,
 	KMOD_MAX_KERNEL_COUNTERS_STATS
 } kmod_kernel_counters_stats;
@@ -40,6 +40,30 @@ struct scap_modern_bpf_engine_params {
 	bool disable_iterators;    ///< If true, disable the BPF iterator support for synchronous
 	                           ///< information fetching, letting scap falling back to the procfs
 	                           ///< lookups.
+	unsigned long spill_buffer_bytes_dim;  ///< [EXPERIMENTAL] If not `0`, a dedicated thread
+	                                       ///< drains the ring buffers into a userspace spill
+	                                       ///< buffer of this size, so that a slow consumer
+	                                       ///< doesn't cause kernel-side drops.
+	unsigned long spill_buffer_max_bytes_dim;  ///< [EXPERIMENTAL] Size up to which the spill
+	                                           ///< buffer is allowed to grow. `0` means that
+	                                           ///< it never grows past `spill_buffer_bytes_dim`.
+	const char* buffers_autotune_path;  ///< [EXPERIMENTAL] If not NULL, on close the engine writes
+	                                    ///< here the ring buffer configuration recommended from
+	                                    ///< the observed utilization (see the
+	                                    ///< `METRICS_V2_KERNEL_BUFFERS` metrics), and on the next
+	                                    ///< open it uses it in place of `cpus_for_each_buffer`
+	                                    ///< and `buffer_bytes_dim`.
+	uint32_t rate_limit_rate;   ///< [EXPERIMENTAL] If not `0`, every thread group can send at most
+	                            ///< this number of events per second, the following ones are
+	                            ///< dropped in the kernel and summarized by a `rate_limit` event.
+	                            ///< The syscalls needed to keep the state are never dropped.
+	uint32_t rate_limit_burst;  ///< [EXPERIMENTAL] Number of events a thread group can send at
+	                            ///< once after being idle. `0` means `rate_limit_rate`.
+	uint32_t io_aggregation_interval_ms;  ///< [EXPERIMENTAL] If not `0`, only the first read-like
+	                                      ///< and write-like syscall of each thread on an fd is
+	                                      ///< sent, the following ones are counted in the kernel
+	                                      ///< and summarized by an `io_summary` event at most
+	                                      ///< once per interval, and when the fd is closed.
 };
 
 extern const struct scap_linux_vtable scap_modern_bpf_linux_vtable;
@@ -18,6 +18,7 @@ limitations under the License.
 #include <errno.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/socket.h>
 
 #define HANDLE(engine) ((struct modern_bpf_engine*)(engine.m_handle))
@@ -31,6 +32,7 @@ limitations under the License.
 #include <libscap/strl.h>
 #include <sys/utsname.h>
 #include <libscap/ringbuffer/ringbuffer.h>
+#include <libscap/ringbuffer/spill_buffer.h>
 #include <libscap/scap_engine_util.h>
 #include <libscap/strerror.h>
 #include <driver/syscall_compat.h>
@@ -51,10 +53,10 @@ static void scap_modern_bpf__free_engine(struct scap_engine_handle engine) {
  * number. For the old BPF probe and the kernel module the number of CPUs is equal to the number of
  * buffers since we always use a per-CPU approach.
  */
-static int32_t scap_modern_bpf__next(struct scap_engine_handle engine,
-                                     scap_evt** pevent,
-                                     uint16_t* buffer_id,
-                                     uint32_t* pflags) {
+static int32_t scap_modern_bpf__consume(struct scap_engine_handle engine,
+                                        scap_evt** pevent,
+                                        uint16_t* buffer_id,
+                                        uint32_t* pflags) {
 	pman_consume_first_event((void**)pevent, (int16_t*)buffer_id);
 
 	if((*pevent) == NULL) {
@@ -71,6 +73,17 @@ static int32_t scap_modern_bpf__next(struct scap_engine_handle engine,
 	return SCAP_SUCCESS;
 }
 
+static int32_t scap_modern_bpf__next(struct scap_engine_handle engine,
+                                     scap_evt** pevent,
+                                     uint16_t* buffer_id,
+                                     uint32_t* pflags) {
+	/* When the spill buffer is enabled the ring buffers are consumed by the drain thread. */
+	if(HANDLE(engine)->m_spill) {
+		return spill_buffer_next(HANDLE(engine)->m_spill, pevent, buffer_id, pflags);
+	}
+	return scap_modern_bpf__consume(engine, pevent, buffer_id, pflags);
+}
+
 static int32_t scap_modern_bpf_start_dropping_mode(struct scap_engine_handle engine,
                                                    uint32_t sampling_ratio) {
 	pman_set_sampling_ratio(sampling_ratio);
@@ -124,6 +137,62 @@ static int32_t scap_modern_bpf__configure(struct scap_engine_handle engine,
 	case SCAP_STATSD_PORT:
 		pman_set_statsd_port(arg1);
 		break;
+	case SCAP_SUPPRESS_TGID: {
+		int err = pman_suppress_tgid(arg1, arg2);
+		if(err != 0) {
+			return scap_errprintf(HANDLE(engine)->m_lasterr, err, "unable to suppress tgid %lu", arg1);
+		}
+		break;
+	}
+	case SCAP_SUPPRESS_COMM: {
+		int err = pman_suppress_comm((const char*)arg1, arg2);
+		if(err != 0) {
+			return scap_errprintf(HANDLE(engine)->m_lasterr,
+			                      err,
+			                      "unable to suppress comm '%s'",
+			                      (const char*)arg1);
+		}
+		break;
+	}
+	case SCAP_CLEAR_SUPPRESSED: {
+		int err = pman_clear_suppressed();
+		if(err != 0) {
+			return scap_errprintf(HANDLE(engine)->m_lasterr, err, "unable to clear suppressions");
+		}
+		break;
+	}
+	case SCAP_RATE_LIMIT:
+		pman_set_rate_limit(arg1, arg2);
+		break;
+	case SCAP_CGROUP_FILTER_MODE:
+		if(arg1 > SCAP_CGROUP_FILTER_DENY) {
+			return scap_errprintf(HANDLE(engine)->m_lasterr,
+			                      0,
+			                      "invalid cgroup filter mode %lu",
+			                      arg1);
+		}
+		pman_set_cgroup_filter_mode(arg1);
+		break;
+	case SCAP_CGROUP_FILTER: {
+		int err = pman_cgroup_filter(arg1, arg2);
+		if(err != 0) {
+			return scap_errprintf(HANDLE(engine)->m_lasterr,
+			                      err,
+			                      "unable to update the cgroup filter with cgroup %lu",
+			                      arg1);
+		}
+		break;
+	}
+	case SCAP_CGROUP_FILTER_CLEAR: {
+		int err = pman_clear_cgroup_filter();
+		if(err != 0) {
+			return scap_errprintf(HANDLE(engine)->m_lasterr, err, "unable to clear the cgroup filter");
+		}
+		break;
+	}
+	case SCAP_IO_AGGREGATION:
+		pman_set_io_aggregation_interval(arg1);
+		break;
 	default: {
 		return scap_err_unsupported_setting(HANDLE(engine)->m_lasterr, setting, arg1, arg2);
 	}
@@ -194,7 +263,7 @@ static int32_t calibrate_socket_file_ops(struct scap_engine_handle engine) {
 	bool found = false;
 
 	while(attempts <= 1) {
-		res = scap_modern_bpf__next(engine, &pevent, &buffer_id, &flags);
+		res = scap_modern_bpf__consume(engine, &pevent, &buffer_id, &flags);
 		if(res == SCAP_SUCCESS && pevent != NULL) {
 			/* This is not a socket event or this is not our socket event */
 			if(pevent->type != PPME_SOCKET_SOCKET_X || pevent->tid != scap_tid) {
@@ -222,6 +291,38 @@ static int32_t calibrate_socket_file_ops(struct scap_engine_handle engine) {
 	return SCAP_SUCCESS;
 }
 
+/* The autotune file contains a single line: `<cpus_for_each_buffer> <buffer_bytes_dim>`. */
+static void load_buffers_autotune(const char* path,
+                                  uint16_t* cpus_for_each_buffer,
+                                  unsigned long* buffer_bytes_dim) {
+	FILE* f = fopen(path, "r");
+	if(f == NULL) {
+		return;
+	}
+	unsigned int cpus = 0;
+	unsigned long bytes_dim = 0;
+	if(fscanf(f, "%u %lu", &cpus, &bytes_dim) == 2 && cpus <= UINT16_MAX &&
+	   check_buffer_bytes_dim(NULL, bytes_dim) == SCAP_SUCCESS) {
+		*cpus_for_each_buffer = cpus;
+		*buffer_bytes_dim = bytes_dim;
+	}
+	fclose(f);
+}
+
+static void store_buffers_autotune(const char* path) {
+	uint16_t cpus_for_each_buffer = 0;
+	unsigned long buffer_bytes_dim = 0;
+	if(pman_get_buffers_recommendation(&cpus_for_each_buffer, &buffer_bytes_dim)) {
+		return;
+	}
+	FILE* f = fopen(path, "w");
+	if(f == NULL) {
+		return;
+	}
+	fprintf(f, "%u %lu\n", cpus_for_each_buffer, buffer_bytes_dim);
+	fclose(f);
+}
+
 int32_t scap_modern_bpf__init(scap_t* handle, scap_open_args* oargs) {
 	int ret = 0;
 	struct scap_engine_handle engine = handle->m_engine;
@@ -231,7 +332,19 @@ int32_t scap_modern_bpf__init(scap_t* handle, scap_open_args* oargs) {
 	 * - check the ring-buffer dimension in bytes.
 	 * - check the presence of ring buffer and of BTF.
 	 */
-	if(check_buffer_bytes_dim(handle->m_lasterr, params->buffer_bytes_dim) != SCAP_SUCCESS) {
+	uint16_t cpus_for_each_buffer = params->cpus_for_each_buffer;
+	unsigned long buffer_bytes_dim = params->buffer_bytes_dim;
+	if(params->buffers_autotune_path != NULL) {
+		HANDLE(engine)->m_autotune_path = strdup(params->buffers_autotune_path);
+		if(HANDLE(engine)->m_autotune_path == NULL) {
+			return scap_errprintf(handle->m_lasterr, 0, "can't allocate the autotune path");
+		}
+		load_buffers_autotune(HANDLE(engine)->m_autotune_path,
+		                      &cpus_for_each_buffer,
+		                      &buffer_bytes_dim);
+	}
+
+	if(check_buffer_bytes_dim(handle->m_lasterr, buffer_bytes_dim) != SCAP_SUCCESS) {
 		return ENOTSUP;
 	}
 
@@ -244,8 +357,8 @@ int32_t scap_modern_bpf__init(scap_t* handle, scap_open_args* oargs) {
 	 * since this is the unique place where we have the number of CPUs
 	 */
 	if(pman_init_state(oargs->log_fn,
-	                   params->buffer_bytes_dim,
-	                   params->cpus_for_each_buffer,
+	                   buffer_bytes_dim,
+	                   cpus_for_each_buffer,
 	                   params->allocate_online_only,
 	                   params->disable_iterators)) {
 		return scap_errprintf(handle->m_lasterr, 0, "unable to configure the libpman state.");
@@ -273,6 +386,10 @@ int32_t scap_modern_bpf__init(scap_t* handle, scap_open_args* oargs) {
 	}
 	pman_set_boot_time(boot_time);
 
+	pman_set_rate_limit(params->rate_limit_rate, params->rate_limit_burst);
+	pman_set_io_aggregation_interval(params->io_aggregation_interval_ms);
+	pman_set_io_fd_type_mask(oargs->io_fd_type_mask);
+
 	/* Calibrate the socket at init time */
 	if(calibrate_socket_file_ops(engine) != SCAP_SUCCESS) {
 		return SCAP_FAILURE;
@@ -291,6 +408,22 @@ int32_t scap_modern_bpf__init(scap_t* handle, scap_open_args* oargs) {
 		HANDLE(engine)->m_flags |= ENGINE_FLAG_BPF_STATS_ENABLED;
 	}
 
+	/* Start draining the ring buffers from a dedicated thread, if requested. */
+	if(params->spill_buffer_bytes_dim != 0) {
+		HANDLE(engine)->m_spill = spill_buffer_alloc(params->spill_buffer_bytes_dim,
+		                                             params->spill_buffer_max_bytes_dim,
+		                                             handle->m_lasterr);
+		if(HANDLE(engine)->m_spill == NULL) {
+			return SCAP_FAILURE;
+		}
+		if(spill_buffer_start(HANDLE(engine)->m_spill,
+		                      engine,
+		                      scap_modern_bpf__consume,
+		                      handle->m_lasterr) != SCAP_SUCCESS) {
+			return SCAP_FAILURE;
+		}
+	}
+
 	return SCAP_SUCCESS;
 }
 
@@ -299,6 +432,14 @@ static uint64_t scap_modern_bpf__get_flags(struct scap_engine_handle engine) {
 }
 
 int32_t scap_modern_bpf__close(struct scap_engine_handle engine) {
+	/* The drain thread must be stopped before the ring buffers go away. */
+	spill_buffer_free(HANDLE(engine)->m_spill);
+	HANDLE(engine)->m_spill = NULL;
+	if(HANDLE(engine)->m_autotune_path) {
+		store_buffers_autotune(HANDLE(engine)->m_autotune_path);
+		free(HANDLE(engine)->m_autotune_path);
+		HANDLE(engine)->m_autotune_path = NULL;
+	}
 	pman_close_probe();
 	return SCAP_SUCCESS;
 }
@@ -311,6 +452,12 @@ int32_t scap_modern_bpf__get_stats(struct scap_engine_handle engine, scap_stats*
 	if(pman_get_scap_stats(stats)) {
 		return SCAP_FAILURE;
 	}
+	if(HANDLE(engine)->m_spill) {
+		struct spill_buffer_stats spill_stats;
+		spill_buffer_get_stats(HANDLE(engine)->m_spill, &spill_stats);
+		stats->n_drops_spill = spill_stats.n_drops;
+		stats->n_drops += spill_stats.n_drops;
+	}
 	return SCAP_SUCCESS;
 }
 
@@ -341,6 +488,19 @@ uint64_t scap_modern_bpf__get_schema_version(struct scap_engine_handle engine) {
 	return HANDLE(engine)->m_schema_version;
 }
 
+int32_t scap_modern_bpf__get_rate_limit_stats(struct scap_engine_handle engine,
+                                              scap_rate_limit_stats* stats,
+                                              uint32_t max_stats,
+                                              uint32_t* nstats) {
+	int err = pman_get_rate_limit_stats(stats, max_stats, nstats);
+	if(err != 0) {
+		return scap_errprintf(HANDLE(engine)->m_lasterr,
+		                      err,
+		                      "unable to read the rate limiter counters");
+	}
+	return SCAP_SUCCESS;
+}
+
 int32_t scap_modern_bpf__fetch_task(struct scap_engine_handle engine,
                                     const struct scap_fetch_callbacks* callbacks,
                                     const uint32_t tid,
@@ -406,4 +566,5 @@ struct scap_vtable scap_modern_bpf_engine = {
         .get_max_buf_used = noop_get_max_buf_used,
         .get_api_version = scap_modern_bpf__get_api_version,
         .get_schema_version = scap_modern_bpf__get_schema_version,
+        .get_rate_limit_stats = scap_modern_bpf__get_rate_limit_stats,
 };
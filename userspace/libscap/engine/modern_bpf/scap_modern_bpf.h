@@ -34,4 +34,7 @@ struct modern_bpf_engine {
 	uint64_t m_schema_version;
 	bool capturing;
 	uint64_t m_flags;
+	struct spill_buffer* m_spill; /* Userspace spill buffer, NULL if disabled */
+	char* m_autotune_path;        /* Where to store the recommended buffers configuration, NULL if
+	                                 disabled */
 };
@@ -22,9 +22,21 @@ limitations under the License.
 #include <libscap/engine/savefile/scap_reader.h>
 #include <libscap/scap_savefile.h>
 #include <libscap/strerror.h>
+#include <libscap/metrics_v2.h>
 
 #define READER_BUF_SIZE (1 << 16)  // UINT16_MAX + 1, ie: 65536
 
+// Events delivered later than this, with respect to their replay target time, are counted as late
+#define SAVEFILE_REPLAY_LATE_THRESHOLD_NS (1000 * 1000)
+
+typedef enum savefile_replay_stats {
+	SAVEFILE_REPLAY_N_EVTS = 0,
+	SAVEFILE_REPLAY_N_LATE,
+	SAVEFILE_REPLAY_JITTER_AVG_NS,
+	SAVEFILE_REPLAY_JITTER_MAX_NS,
+	SAVEFILE_REPLAY_MAX_STATS,
+} savefile_replay_stats;
+
 #define CHECK_READ_SIZE_ERR(read_size, expected_size, error)                          \
 	if(read_size != expected_size) {                                                  \
 		return scap_errprintf(                                                        \
@@ -113,4 +125,18 @@ struct savefile_engine {
 	char* m_new_evt;
 	char* m_to_convert_evt;
 	struct scap_convert_buffer* m_converter_buf;
+
+	// Replay pacing, see `scap_savefile_engine_params`
+	double m_replay_speed;
+	uint64_t m_replay_evts_per_sec;
+	bool m_replay_rebase_ts;
+	uint64_t m_replay_n_evts;
+	uint64_t m_replay_first_ts;
+	uint64_t m_replay_start_mono_ns;
+	uint64_t m_replay_start_wall_ns;
+	// How late, with respect to their target time, events are delivered
+	uint64_t m_replay_jitter_sum_ns;
+	uint64_t m_replay_jitter_max_ns;
+	uint64_t m_replay_n_late;
+	metrics_v2 m_stats[SAVEFILE_REPLAY_MAX_STATS];
 };
@@ -14,6 +14,7 @@ limitations under the License.
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <libscap/scap_procs.h>
 
@@ -31,6 +32,13 @@ struct scap_savefile_engine_params {
 	                        ///< is leveraged when opening merged files.
 	uint32_t fbuffer_size;  ///< If non-zero, offline captures will read from file using a buffer of
 	                        ///< this size.
+	double replay_speed;    ///< [EXPERIMENTAL] If greater than 0, events are paced according to
+	                        ///< their recorded timestamps, `replay_speed` times faster than they
+	                        ///< were recorded (1 means real time).
+	uint64_t replay_evts_per_sec;  ///< [EXPERIMENTAL] If non-zero, events are paced at this fixed
+	                               ///< rate. Takes precedence over `replay_speed`.
+	bool replay_rebase_ts;  ///< [EXPERIMENTAL] If true, timestamps are shifted so that the first
+	                        ///< event happens now and the following ones follow the replay pace.
 
 	struct scap_platform* platform;
 };
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -2127,11 +2128,10 @@ static int32_t next_event_from_file(struct savefile_engine *handle,
 //
 // Read an event from disk
 //
-static int32_t next(struct scap_engine_handle engine,
-                    scap_evt **pevent,
-                    uint16_t *pdevid,
-                    uint32_t *pflags) {
-	struct savefile_engine *handle = engine.m_handle;
+static int32_t next_converted_event(struct savefile_engine *handle,
+                                    scap_evt **pevent,
+                                    uint16_t *pdevid,
+                                    uint32_t *pflags) {
 	int32_t res = next_event_from_file(handle, pevent, pdevid, pflags);
 	// If we fail we don't convert the event.
 	if(res != SCAP_SUCCESS) {
@@ -2264,6 +2264,123 @@ static int32_t next(struct scap_engine_handle engine,
 	}
 }
 
+static inline bool replay_enabled(struct savefile_engine *handle) {
+	return handle->m_replay_speed > 0 || handle->m_replay_evts_per_sec != 0 ||
+	       handle->m_replay_rebase_ts;
+}
+
+#ifndef _WIN32
+static uint64_t replay_clock_ns(clockid_t clock) {
+	struct timespec ts;
+	clock_gettime(clock, &ts);
+	return ts.tv_sec * (uint64_t)1000000000 + ts.tv_nsec;
+}
+
+//
+// Wait until it's time to deliver `evt`, according to the replay pace, and
+// rebase its timestamp if requested.
+//
+static void replay_event(struct savefile_engine *handle, scap_evt *evt) {
+	uint64_t now = replay_clock_ns(CLOCK_MONOTONIC);
+	if(handle->m_replay_n_evts == 0) {
+		handle->m_replay_first_ts = evt->ts;
+		handle->m_replay_start_mono_ns = now;
+		handle->m_replay_start_wall_ns = replay_clock_ns(CLOCK_REALTIME);
+	}
+
+	// Offset of the event from the beginning of the replay
+	uint64_t offset_ns = 0;
+	if(handle->m_replay_evts_per_sec != 0) {
+		offset_ns = handle->m_replay_n_evts * 1000000000.0 / handle->m_replay_evts_per_sec;
+	} else if(evt->ts > handle->m_replay_first_ts) {
+		offset_ns = evt->ts - handle->m_replay_first_ts;
+		if(handle->m_replay_speed > 0) {
+			offset_ns = (uint64_t)(offset_ns / handle->m_replay_speed);
+		}
+	}
+	handle->m_replay_n_evts++;
+
+	if(handle->m_replay_speed > 0 || handle->m_replay_evts_per_sec != 0) {
+		uint64_t target = handle->m_replay_start_mono_ns + offset_ns;
+		if(target > now) {
+			uint64_t wait_ns = target - now;
+			struct timespec ts = {(time_t)(wait_ns / 1000000000), (long)(wait_ns % 1000000000)};
+			nanosleep(&ts, NULL);
+			now = replay_clock_ns(CLOCK_MONOTONIC);
+		}
+
+		uint64_t jitter = now > target ? now - target : 0;
+		handle->m_replay_jitter_sum_ns += jitter;
+		if(jitter > handle->m_replay_jitter_max_ns) {
+			handle->m_replay_jitter_max_ns = jitter;
+		}
+		if(jitter > SAVEFILE_REPLAY_LATE_THRESHOLD_NS) {
+			handle->m_replay_n_late++;
+		}
+	}
+
+	if(handle->m_replay_rebase_ts) {
+		evt->ts = handle->m_replay_start_wall_ns + offset_ns;
+	}
+}
+#endif
+
+static int32_t next(struct scap_engine_handle engine,
+                    scap_evt **pevent,
+                    uint16_t *pdevid,
+                    uint32_t *pflags) {
+	struct savefile_engine *handle = engine.m_handle;
+	int32_t res = next_converted_event(handle, pevent, pdevid, pflags);
+#ifndef _WIN32
+	if(res == SCAP_SUCCESS && replay_enabled(handle)) {
+		replay_event(handle, *pevent);
+	}
+#endif
+	return res;
+}
+
+static const char *const savefile_replay_stats_names[] = {
+        [SAVEFILE_REPLAY_N_EVTS] = "savefile_replay_n_evts",
+        [SAVEFILE_REPLAY_N_LATE] = "savefile_replay_n_late",
+        [SAVEFILE_REPLAY_JITTER_AVG_NS] = "savefile_replay_jitter_avg_ns",
+        [SAVEFILE_REPLAY_JITTER_MAX_NS] = "savefile_replay_jitter_max_ns",
+};
+
+static const struct metrics_v2 *get_stats_v2(struct scap_engine_handle engine,
+                                             uint32_t flags,
+                                             uint32_t *nstats,
+                                             int32_t *rc) {
+	struct savefile_engine *handle = engine.m_handle;
+	*rc = SCAP_SUCCESS;
+	*nstats = 0;
+	if(!(flags & METRICS_V2_MISC) || !replay_enabled(handle)) {
+		return NULL;
+	}
+
+	metrics_v2 *stats = handle->m_stats;
+	for(uint32_t stat = 0; stat < SAVEFILE_REPLAY_MAX_STATS; stat++) {
+		stats[stat].type = METRIC_VALUE_TYPE_U64;
+		stats[stat].flags = METRICS_V2_MISC;
+		strlcpy(stats[stat].name, savefile_replay_stats_names[stat], METRIC_NAME_MAX);
+	}
+	stats[SAVEFILE_REPLAY_N_EVTS].value.u64 = handle->m_replay_n_evts;
+	stats[SAVEFILE_REPLAY_N_EVTS].unit = METRIC_VALUE_UNIT_COUNT;
+	stats[SAVEFILE_REPLAY_N_EVTS].metric_type = METRIC_VALUE_METRIC_TYPE_MONOTONIC;
+	stats[SAVEFILE_REPLAY_N_LATE].value.u64 = handle->m_replay_n_late;
+	stats[SAVEFILE_REPLAY_N_LATE].unit = METRIC_VALUE_UNIT_COUNT;
+	stats[SAVEFILE_REPLAY_N_LATE].metric_type = METRIC_VALUE_METRIC_TYPE_MONOTONIC;
+	stats[SAVEFILE_REPLAY_JITTER_AVG_NS].value.u64 =
+	        handle->m_replay_n_evts ? handle->m_replay_jitter_sum_ns / handle->m_replay_n_evts : 0;
+	stats[SAVEFILE_REPLAY_JITTER_AVG_NS].unit = METRIC_VALUE_UNIT_TIME_NS;
+	stats[SAVEFILE_REPLAY_JITTER_AVG_NS].metric_type = METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT;
+	stats[SAVEFILE_REPLAY_JITTER_MAX_NS].value.u64 = handle->m_replay_jitter_max_ns;
+	stats[SAVEFILE_REPLAY_JITTER_MAX_NS].unit = METRIC_VALUE_UNIT_TIME_NS;
+	stats[SAVEFILE_REPLAY_JITTER_MAX_NS].metric_type = METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT;
+
+	*nstats = SAVEFILE_REPLAY_MAX_STATS;
+	return stats;
+}
+
 uint64_t scap_savefile_ftell(struct scap_engine_handle engine) {
 	scap_reader_t *reader = HANDLE(engine)->m_reader;
 	return reader->tell(reader);
@@ -2339,6 +2456,23 @@ static int32_t init(struct scap *main_handle, struct scap_open_args *oargs) {
 	struct scap_platform *platform = params->platform;
 	handle->m_platform = params->platform;
 
+	if(params->replay_speed < 0) {
+		return scap_errprintf(main_handle->m_lasterr,
+		                      0,
+		                      "invalid replay speed %f",
+		                      params->replay_speed);
+	}
+	handle->m_replay_speed = params->replay_speed;
+	handle->m_replay_evts_per_sec = params->replay_evts_per_sec;
+	handle->m_replay_rebase_ts = params->replay_rebase_ts;
+#ifdef _WIN32
+	if(replay_enabled(handle)) {
+		return scap_errprintf(main_handle->m_lasterr,
+		                      0,
+		                      "paced replay is not supported on this platform");
+	}
+#endif
+
 	if(fd != 0) {
 		gzfile = gzdopen(fd, "rb");
 	} else {
@@ -2491,7 +2625,7 @@ struct scap_vtable scap_savefile_engine = {
         .stop_capture = noop_stop_capture,
         .configure = noop_configure,
         .get_stats = noop_get_stats,
-        .get_stats_v2 = noop_get_stats_v2,
+        .get_stats_v2 = get_stats_v2,
         .get_n_tracepoint_hit = noop_get_n_tracepoint_hit,
         .get_n_devs = noop_get_n_devs,
         .get_max_buf_used = noop_get_max_buf_used,
@@ -0,0 +1,435 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define HANDLE(engine) ((struct shm_engine*)(engine.m_handle))
+
+#include <libscap/engine/shm/shm.h>
+#include <libscap/engine/noop/noop.h>
+
+#include <libscap/scap.h>
+#include <libscap/scap-int.h>
+#include <libscap/strerror.h>
+#include <libscap/strl.h>
+
+// Attempts at reading a consistent snapshot while the producer rewrites it.
+#define SHM_STATE_READ_ATTEMPTS 100
+
+static const char* const shm_counters_stats_names[] = {
+        [SHM_N_EVTS] = "n_evts",
+        [SHM_N_DROPS] = "n_drops",
+        [SHM_N_OVERRUNS] = "n_overruns",
+        [SHM_N_RETRIES] = "n_state_read_retries",
+};
+
+static void* alloc_handle(scap_t* main_handle, char* lasterr_ptr) {
+	struct shm_engine* engine = calloc(1, sizeof(struct shm_engine));
+	if(engine == NULL) {
+		return NULL;
+	}
+	engine->m_lasterr = lasterr_ptr;
+	engine->m_fd = -1;
+	return engine;
+}
+
+static int32_t init(scap_t* main_handle, scap_open_args* oargs) {
+	struct shm_engine* engine = main_handle->m_engine.m_handle;
+	struct scap_shm_engine_params* params = oargs->engine_params;
+
+	if(params == NULL || params->name == NULL) {
+		return scap_errprintf(engine->m_lasterr, 0, "No shm name provided");
+	}
+
+	engine->m_fd = shm_open(params->name, O_RDONLY, 0);
+	if(engine->m_fd < 0) {
+		return scap_errprintf(engine->m_lasterr, errno, "error opening shm '%s'", params->name);
+	}
+
+	struct stat st;
+	if(fstat(engine->m_fd, &st) < 0) {
+		return scap_errprintf(engine->m_lasterr, errno, "error reading shm '%s' size", params->name);
+	}
+	if((size_t)st.st_size < sizeof(struct scap_shm_header)) {
+		return scap_errprintf(engine->m_lasterr, 0, "shm '%s' is too small", params->name);
+	}
+
+	engine->m_map_size = st.st_size;
+	engine->m_map = mmap(NULL, engine->m_map_size, PROT_READ, MAP_SHARED, engine->m_fd, 0);
+	if(engine->m_map == MAP_FAILED) {
+		engine->m_map = NULL;
+		return scap_errprintf(engine->m_lasterr, errno, "error mapping shm '%s'", params->name);
+	}
+
+	const struct scap_shm_header* hdr = (const struct scap_shm_header*)engine->m_map;
+	if(hdr->magic != SCAP_SHM_MAGIC || hdr->version != SCAP_SHM_VERSION) {
+		return scap_errprintf(engine->m_lasterr,
+		                      0,
+		                      "shm '%s' is not an event ring, or an unsupported version",
+		                      params->name);
+	}
+	atomic_thread_fence(memory_order_acquire);
+
+	if(hdr->tinfo_size != sizeof(scap_threadinfo) || hdr->fdinfo_size != sizeof(scap_fdinfo)) {
+		return scap_errprintf(engine->m_lasterr,
+		                      0,
+		                      "shm '%s' was published by an incompatible libscap version",
+		                      params->name);
+	}
+	if(hdr->data_size == 0 || (hdr->data_size & (hdr->data_size - 1)) != 0 ||
+	   hdr->state_offset + hdr->state_size > engine->m_map_size ||
+	   hdr->data_offset + hdr->data_size > engine->m_map_size) {
+		return scap_errprintf(engine->m_lasterr, 0, "shm '%s' has an invalid layout", params->name);
+	}
+
+	engine->m_hdr = hdr;
+	engine->m_data = engine->m_map + hdr->data_offset;
+	engine->m_data_mask = hdr->data_size - 1;
+
+	// Without a state snapshot (e.g. with a non-shm platform) only the events
+	// published from now on are read.
+	engine->m_read_pos = atomic_load_explicit(&hdr->write_pos, memory_order_acquire);
+	engine->m_next_seq = atomic_load_explicit(&hdr->n_evts, memory_order_relaxed);
+
+	return SCAP_SUCCESS;
+}
+
+static void free_handle(struct scap_engine_handle engine) {
+	free(HANDLE(engine)->m_evt_buf);
+	free(engine.m_handle);
+}
+
+static int32_t close_engine(struct scap_engine_handle engine) {
+	struct shm_engine* handle = HANDLE(engine);
+
+	if(handle->m_map != NULL) {
+		munmap(handle->m_map, handle->m_map_size);
+		handle->m_map = NULL;
+		handle->m_hdr = NULL;
+	}
+	if(handle->m_fd >= 0) {
+		close(handle->m_fd);
+		handle->m_fd = -1;
+	}
+	return SCAP_SUCCESS;
+}
+
+// The producer lapped us: skip everything up to the last complete record.
+// The lost events are accounted when the next one is read.
+static void overrun(struct shm_engine* engine) {
+	engine->m_n_overruns++;
+	engine->m_read_pos = atomic_load_explicit(&engine->m_hdr->write_pos, memory_order_acquire);
+}
+
+static bool overwritten(struct shm_engine* engine, uint64_t pos) {
+	atomic_thread_fence(memory_order_acquire);
+	uint64_t reserve = atomic_load_explicit(&engine->m_hdr->reserve_pos, memory_order_relaxed);
+	return reserve - pos > engine->m_hdr->data_size;
+}
+
+static int32_t next(struct scap_engine_handle handle,
+                    scap_evt** pevent,
+                    uint16_t* pdevid,
+                    uint32_t* pflags) {
+	struct shm_engine* engine = HANDLE(handle);
+	const struct scap_shm_header* hdr = engine->m_hdr;
+	uint64_t data_size = hdr->data_size;
+
+	while(true) {
+		uint64_t write_pos = atomic_load_explicit(&hdr->write_pos, memory_order_acquire);
+		uint64_t read_pos = engine->m_read_pos;
+
+		if(read_pos == write_pos) {
+			if(atomic_load_explicit(&hdr->closed, memory_order_acquire) &&
+			   atomic_load_explicit(&hdr->write_pos, memory_order_acquire) == read_pos) {
+				uint64_t n_evts = atomic_load_explicit(&hdr->n_evts, memory_order_relaxed);
+				if(n_evts > engine->m_next_seq) {
+					engine->m_n_drops += n_evts - engine->m_next_seq;
+					engine->m_next_seq = n_evts;
+				}
+				return SCAP_EOF;
+			}
+			return SCAP_TIMEOUT;
+		}
+
+		if(write_pos - read_pos > data_size) {
+			overrun(engine);
+			continue;
+		}
+
+		const uint8_t* src = engine->m_data + (read_pos & engine->m_data_mask);
+		struct scap_shm_record rec;
+		memcpy(&rec, src, sizeof(rec));
+
+		if(rec.len < sizeof(rec) || SCAP_SHM_ALIGN(rec.len) != rec.len ||
+		   rec.len > write_pos - read_pos ||
+		   (rec.type == SCAP_SHM_RECORD_EVT && rec.len > SCAP_SHM_MAX_RECORD_SIZE(data_size))) {
+			if(overwritten(engine, read_pos)) {
+				overrun(engine);
+				continue;
+			}
+			return scap_errprintf(engine->m_lasterr,
+			                      0,
+			                      "corrupted shm record at position %llu",
+			                      (unsigned long long)read_pos);
+		}
+
+		if(rec.type == SCAP_SHM_RECORD_PAD) {
+			if(overwritten(engine, read_pos)) {
+				overrun(engine);
+				continue;
+			}
+			engine->m_read_pos += rec.len;
+			continue;
+		}
+
+		size_t evt_len = rec.len - sizeof(rec);
+		if(evt_len > engine->m_evt_buf_size) {
+			uint8_t* buf = realloc(engine->m_evt_buf, evt_len);
+			if(buf == NULL) {
+				return scap_errprintf(engine->m_lasterr, 0, "error allocating the shm event buffer");
+			}
+			engine->m_evt_buf = buf;
+			engine->m_evt_buf_size = evt_len;
+		}
+		memcpy(engine->m_evt_buf, src + sizeof(rec), evt_len);
+
+		if(overwritten(engine, read_pos)) {
+			overrun(engine);
+			continue;
+		}
+
+		engine->m_read_pos += rec.len;
+		if(rec.seq > engine->m_next_seq) {
+			engine->m_n_drops += rec.seq - engine->m_next_seq;
+		}
+		engine->m_next_seq = rec.seq + 1;
+		engine->m_n_evts++;
+
+		*pevent = (scap_evt*)engine->m_evt_buf;
+		*pdevid = rec.devid;
+		*pflags = 0;
+		return SCAP_SUCCESS;
+	}
+}
+
+int32_t scap_shm_read_state(struct scap_engine_handle handle,
+                            struct scap_proclist* proclist,
+                            scap_machine_info* machine_info,
+                            char* error) {
+	struct shm_engine* engine = HANDLE(handle);
+	const struct scap_shm_header* hdr = engine->m_hdr;
+	uint8_t* state = NULL;
+	uint64_t state_len = 0;
+	uint64_t write_pos = 0;
+	uint64_t n_evts = 0;
+	int attempt;
+
+	*machine_info = hdr->machine_info;
+
+	for(attempt = 0; attempt < SHM_STATE_READ_ATTEMPTS; attempt++) {
+		uint64_t seq = atomic_load_explicit(&hdr->state_seq, memory_order_acquire);
+		if(seq == 0) {
+			// Nothing published yet: read the ring from the start.
+			free(state);
+			engine->m_read_pos = 0;
+			engine->m_next_seq = 0;
+			return SCAP_SUCCESS;
+		}
+		if(seq & 1) {
+			engine->m_n_retries++;
+			sched_yield();
+			continue;
+		}
+
+		state_len = hdr->state_len;
+		write_pos = hdr->state_write_pos;
+		n_evts = hdr->state_n_evts;
+		if(state_len > hdr->state_size) {
+			engine->m_n_retries++;
+			continue;
+		}
+
+		uint8_t* buf = realloc(state, state_len ? state_len : 1);
+		if(buf == NULL) {
+			free(state);
+			return scap_errprintf(error, 0, "error allocating %llu bytes for the shm state",
+			                      (unsigned long long)state_len);
+		}
+		state = buf;
+		memcpy(state, engine->m_map + hdr->state_offset, state_len);
+
+		atomic_thread_fence(memory_order_acquire);
+		if(atomic_load_explicit(&hdr->state_seq, memory_order_relaxed) == seq) {
+			break;
+		}
+		engine->m_n_retries++;
+	}
+
+	if(attempt == SHM_STATE_READ_ATTEMPTS) {
+		free(state);
+		return scap_errprintf(error, 0, "could not read a consistent shm state snapshot");
+	}
+
+	scap_threadinfo* tinfo = malloc(sizeof(scap_threadinfo));
+	if(tinfo == NULL) {
+		free(state);
+		return scap_errprintf(error, 0, "error allocating the shm thread info");
+	}
+
+	int32_t res = SCAP_SUCCESS;
+	const uint8_t* in = state;
+	const uint8_t* end = state + state_len;
+
+	proclist->m_callbacks.m_refresh_start_cb(proclist->m_callbacks.m_callback_context);
+	while(in < end) {
+		uint32_t n_fdinfos;
+		size_t used;
+		scap_threadinfo* new_tinfo = NULL;
+
+		if((size_t)(end - in) < sizeof(n_fdinfos)) {
+			res = scap_errprintf(error, 0, "truncated shm state snapshot");
+			break;
+		}
+		memcpy(&n_fdinfos, in, sizeof(n_fdinfos));
+		in += sizeof(n_fdinfos);
+
+		used = scap_shm_zrle_decode(in, end - in, (uint8_t*)tinfo, sizeof(*tinfo));
+		if(used == 0) {
+			res = scap_errprintf(error, 0, "malformed thread in shm state snapshot");
+			break;
+		}
+		in += used;
+		tinfo->fdlist = NULL;
+		memset(&tinfo->hh, 0, sizeof(tinfo->hh));
+
+		res = proclist->m_callbacks.m_proc_entry_cb(proclist->m_callbacks.m_callback_context,
+		                                            error,
+		                                            tinfo->tid,
+		                                            tinfo,
+		                                            NULL,
+		                                            &new_tinfo);
+		if(res != SCAP_SUCCESS) {
+			break;
+		}
+		if(new_tinfo == NULL) {
+			new_tinfo = tinfo;
+		}
+
+		for(uint32_t i = 0; i < n_fdinfos; i++) {
+			scap_fdinfo fdi;
+			used = scap_shm_zrle_decode(in, end - in, (uint8_t*)&fdi, sizeof(fdi));
+			if(used == 0) {
+				res = scap_errprintf(error, 0, "malformed fd in shm state snapshot");
+				break;
+			}
+			in += used;
+			memset(&fdi.hh, 0, sizeof(fdi.hh));
+
+			res = proclist->m_callbacks.m_proc_entry_cb(proclist->m_callbacks.m_callback_context,
+			                                            error,
+			                                            new_tinfo->tid,
+			                                            new_tinfo,
+			                                            &fdi,
+			                                            NULL);
+			if(res != SCAP_SUCCESS) {
+				break;
+			}
+		}
+		if(res != SCAP_SUCCESS) {
+			break;
+		}
+	}
+	proclist->m_callbacks.m_refresh_end_cb(proclist->m_callbacks.m_callback_context);
+
+	free(tinfo);
+	free(state);
+
+	if(res == SCAP_SUCCESS) {
+		engine->m_read_pos = write_pos;
+		engine->m_next_seq = n_evts;
+	}
+	return res;
+}
+
+static int32_t get_stats(struct scap_engine_handle engine, scap_stats* stats) {
+	struct shm_engine* handle = HANDLE(engine);
+	stats->n_evts = handle->m_n_evts;
+	stats->n_drops = handle->m_n_drops;
+	stats->n_drops_buffer = handle->m_n_drops;
+	return SCAP_SUCCESS;
+}
+
+static const struct metrics_v2* get_stats_v2(struct scap_engine_handle engine,
+                                             uint32_t flags,
+                                             uint32_t* nstats,
+                                             int32_t* rc) {
+	struct shm_engine* handle = HANDLE(engine);
+	metrics_v2* stats = handle->m_stats;
+
+	*nstats = 0;
+	if(!(flags & METRICS_V2_KERNEL_COUNTERS)) {
+		*rc = SCAP_SUCCESS;
+		return NULL;
+	}
+
+	for(uint32_t stat = 0; stat < MAX_SHM_COUNTERS_STATS; stat++) {
+		stats[stat].type = METRIC_VALUE_TYPE_U64;
+		stats[stat].flags = METRICS_V2_KERNEL_COUNTERS;
+		stats[stat].unit = METRIC_VALUE_UNIT_COUNT;
+		stats[stat].metric_type = METRIC_VALUE_METRIC_TYPE_MONOTONIC;
+		strlcpy(stats[stat].name, shm_counters_stats_names[stat], METRIC_NAME_MAX);
+	}
+	stats[SHM_N_EVTS].value.u64 = handle->m_n_evts;
+	stats[SHM_N_DROPS].value.u64 = handle->m_n_drops;
+	stats[SHM_N_OVERRUNS].value.u64 = handle->m_n_overruns;
+	stats[SHM_N_RETRIES].value.u64 = handle->m_n_retries;
+
+	*nstats = MAX_SHM_COUNTERS_STATS;
+	*rc = SCAP_SUCCESS;
+	return stats;
+}
+
+const struct scap_vtable scap_shm_engine = {
+        .name = SHM_ENGINE,
+        .savefile_ops = NULL,
+
+        .alloc_handle = alloc_handle,
+        .init = init,
+        .free_handle = free_handle,
+        .close = close_engine,
+        .next = next,
+        .start_capture = noop_start_capture,
+        .stop_capture = noop_stop_capture,
+        .configure = noop_configure,
+        .get_stats = get_stats,
+        .get_stats_v2 = get_stats_v2,
+        .get_n_tracepoint_hit = noop_get_n_tracepoint_hit,
+        .get_n_devs = noop_get_n_devs,
+        .get_max_buf_used = noop_get_max_buf_used,
+        .get_api_version = NULL,
+        .get_schema_version = NULL,
+};
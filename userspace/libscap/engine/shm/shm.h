@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <libscap/engine/shm/shm_public.h>
+#include <libscap/engine_handle.h>
+#include <libscap/metrics_v2.h>
+#include <libscap/scap_machine_info.h>
+#include <libscap/scap_platform_impl.h>
+
+#define SCAP_SHM_MAGIC 0x314d485350414353ULL  // "SCAPSHM1"
+#define SCAP_SHM_VERSION 1
+
+// Records are 16 bytes aligned so that the space left before the end of the
+// ring always fits at least a padding record header.
+#define SCAP_SHM_ALIGN(x) (((x) + 15) & ~((uint64_t)15))
+
+// Records longer than a quarter of the ring are refused, so that a consumer
+// always has some slack to copy a record before it can be overwritten.
+#define SCAP_SHM_MAX_RECORD_SIZE(data_size) ((data_size) / 4)
+
+enum scap_shm_record_type {
+	SCAP_SHM_RECORD_EVT = 1,
+	SCAP_SHM_RECORD_PAD = 2,  ///< fills the space up to the end of the ring
+};
+
+struct scap_shm_record {
+	uint32_t len;  ///< length of the whole record, header included
+	uint16_t type;
+	uint16_t devid;
+	uint64_t seq;  ///< sequence number of the event, used by consumers to count drops
+};
+
+_Static_assert(sizeof(struct scap_shm_record) == 16, "shm record header must be 16 bytes");
+
+/*!
+  \brief Header at the beginning of the shared memory object, followed by the
+  state snapshot area and by the event ring.
+
+  The producer owns every field; consumers map the object read-only. The
+  positions are monotonic byte offsets, the offset in the ring is obtained
+  masking them with `data_size - 1`.
+*/
+struct scap_shm_header {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t tinfo_size;   ///< sizeof(scap_threadinfo) on the producer side
+	uint32_t fdinfo_size;  ///< sizeof(scap_fdinfo) on the producer side
+	uint32_t reserved;
+	uint64_t state_offset;
+	uint64_t state_size;
+	uint64_t data_offset;
+	uint64_t data_size;
+	scap_machine_info machine_info;
+
+	// Bumped before a record is written, so a consumer that copied a record
+	// can check it was not overwritten in the meantime.
+	_Alignas(64) _Atomic uint64_t reserve_pos;
+	// Bumped once a record is fully written.
+	_Atomic uint64_t write_pos;
+	_Atomic uint64_t n_evts;
+	_Atomic uint32_t closed;
+
+	// Seqlock protecting the state snapshot: odd while it is rewritten.
+	_Alignas(64) _Atomic uint64_t state_seq;
+	uint64_t state_len;
+	uint64_t state_write_pos;  ///< ring position the snapshot is consistent with
+	uint64_t state_n_evts;     ///< sequence number of the first event after the snapshot
+};
+
+/*
+ * State snapshot encoding: a sequence of threads, each one encoded as
+ *   uint32_t n_fdinfos
+ *   zero-run-length encoded scap_threadinfo
+ *   n_fdinfos zero-run-length encoded scap_fdinfo
+ *
+ * The structures are mostly made of zero-padded arrays, so each of them is
+ * encoded as a sequence of (uint16_t literal length, literal bytes,
+ * uint16_t zero run length) tokens until the whole structure is covered.
+ */
+#define SCAP_SHM_ZRLE_MIN_RUN 8
+#define SCAP_SHM_ZRLE_MAX_SIZE(len) (2 * (len) + 8)
+
+size_t scap_shm_zrle_encode(const uint8_t* src, size_t len, uint8_t* dst);
+// Returns the number of bytes consumed from `src`, 0 if the input is malformed.
+size_t scap_shm_zrle_decode(const uint8_t* src, size_t src_len, uint8_t* dst, size_t len);
+
+typedef enum shm_counters_stats {
+	SHM_N_EVTS = 0,
+	SHM_N_DROPS,
+	SHM_N_OVERRUNS,
+	SHM_N_RETRIES,
+	MAX_SHM_COUNTERS_STATS,
+} shm_counters_stats;
+
+struct shm_engine {
+	char* m_lasterr;
+
+	int m_fd;
+	uint8_t* m_map;
+	size_t m_map_size;
+	const struct scap_shm_header* m_hdr;
+	const uint8_t* m_data;
+	uint64_t m_data_mask;
+
+	uint64_t m_read_pos;
+	uint64_t m_next_seq;
+
+	// Private copy of the last returned event, as the producer may overwrite
+	// the ring while the caller is still using it.
+	uint8_t* m_evt_buf;
+	size_t m_evt_buf_size;
+
+	uint64_t m_n_evts;
+	uint64_t m_n_drops;
+	uint64_t m_n_overruns;  ///< times the producer lapped us
+	uint64_t m_n_retries;   ///< snapshot reads retried because of a concurrent rewrite
+
+	metrics_v2 m_stats[MAX_SHM_COUNTERS_STATS];
+};
+
+struct scap_shm_platform {
+	struct scap_platform m_generic;
+	char* m_lasterr;
+};
+
+// Read the state snapshot published by the producer, feeding every thread and
+// fd to `proclist`, and position the engine right after it.
+int32_t scap_shm_read_state(struct scap_engine_handle engine,
+                            struct scap_proclist* proclist,
+                            scap_machine_info* machine_info,
+                            char* error);
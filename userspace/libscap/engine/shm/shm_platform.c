@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <stdlib.h>
+
+#include <libscap/engine/shm/shm.h>
+#include <libscap/scap.h>
+#include <libscap/scap_proc_util.h>
+
+static int32_t scap_shm_init_platform(struct scap_platform* platform,
+                                      char* lasterr,
+                                      struct scap_engine_handle engine,
+                                      struct scap_open_args* oargs) {
+	struct scap_shm_platform* shm_platform = (struct scap_shm_platform*)platform;
+	shm_platform->m_lasterr = lasterr;
+
+	// The producer's thread table replaces the /proc scan.
+	return scap_shm_read_state(engine, &platform->m_proclist, &platform->m_machine_info, lasterr);
+}
+
+static void scap_shm_free_platform(struct scap_platform* platform) {
+	free(platform);
+}
+
+static const struct scap_platform_vtable scap_shm_platform_vtable = {
+        .init_platform = scap_shm_init_platform,
+        .free_platform = scap_shm_free_platform,
+};
+
+struct scap_platform* scap_shm_alloc_platform(scap_proc_callbacks callbacks) {
+	struct scap_shm_platform* platform = calloc(1, sizeof(*platform));
+	if(platform == NULL) {
+		return NULL;
+	}
+
+	struct scap_platform* generic = &platform->m_generic;
+	generic->m_vtable = &scap_shm_platform_vtable;
+	init_proclist(&platform->m_generic.m_proclist, callbacks);
+	return generic;
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <libscap/scap_procs.h>
+
+#define SHM_ENGINE "shm"
+
+#define SCAP_SHM_DEFAULT_BUFFER_SIZE (64 * 1024 * 1024)
+#define SCAP_SHM_DEFAULT_STATE_SIZE (64 * 1024 * 1024)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ppm_evt_hdr;
+struct _scap_machine_info;
+struct scap_platform;
+
+struct scap_shm_engine_params {
+	const char* name;  ///< name of the shared memory object the events are published to (see
+	                   ///< `scap_shm_producer_open`)
+};
+
+struct scap_platform* scap_shm_alloc_platform(scap_proc_callbacks proc_callback);
+
+/*!
+  \brief Producer side of the shm engine.
+
+  A single producer publishes the events it consumes into a shared memory ring
+  that any number of read-only consumers (opened with the shm engine) read at
+  their own pace. The producer never waits for consumers: a consumer that
+  falls behind by more than the ring size loses events and accounts them as
+  drops.
+
+  Next to the ring, the producer keeps a snapshot of its thread and fd tables,
+  rewritten periodically, so that a consumer attaching at any time can
+  initialize its state without scanning /proc. The snapshot records the ring
+  position it was taken at and consumers start reading from there.
+*/
+struct scap_shm_producer;
+
+/*!
+  \brief Create the shared memory object `name` (as in shm_open(3)) and map it.
+
+  \param buffer_size size of the event ring in bytes, rounded up to a power of 2.
+  \param state_size maximum size in bytes of the encoded state snapshot.
+  \param machine_info machine info handed over to the consumers, may be NULL.
+  \param error buffer of SCAP_LASTERR_SIZE characters filled in case of error.
+
+  \return the producer handle, or NULL in case of error.
+*/
+struct scap_shm_producer* scap_shm_producer_open(const char* name,
+                                                 uint64_t buffer_size,
+                                                 uint64_t state_size,
+                                                 const struct _scap_machine_info* machine_info,
+                                                 char* error);
+
+/*!
+  \brief Copy an event into the ring, overwriting the oldest events if needed.
+*/
+int32_t scap_shm_producer_write(struct scap_shm_producer* producer,
+                                const struct ppm_evt_hdr* evt,
+                                uint16_t devid,
+                                char* error);
+
+/*!
+  \brief Start building a new state snapshot, discarding any uncommitted one.
+*/
+void scap_shm_producer_state_begin(struct scap_shm_producer* producer);
+
+/*!
+  \brief Append a thread and, for main threads, its fds to the snapshot being
+  built. Pointer fields (fdlist, hash handles) are ignored.
+*/
+int32_t scap_shm_producer_state_add(struct scap_shm_producer* producer,
+                                    const scap_threadinfo* tinfo,
+                                    const scap_fdinfo* fdinfos,
+                                    uint32_t n_fdinfos,
+                                    char* error);
+
+/*!
+  \brief Publish the snapshot built since `scap_shm_producer_state_begin`,
+  tagged with the current ring position.
+*/
+int32_t scap_shm_producer_state_commit(struct scap_shm_producer* producer, char* error);
+
+/*!
+  \brief Tell the consumers that no more events will be published, unmap and
+  unlink the shared memory object. Consumers that are attached keep their
+  mapping and get SCAP_EOF once they have read all the remaining events.
+*/
+void scap_shm_producer_close(struct scap_shm_producer* producer);
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <libscap/engine/shm/shm.h>
+#include <libscap/scap.h>
+#include <libscap/strerror.h>
+#include <libscap/strl.h>
+
+// The record length is stored on 32 bits, padding records included.
+#define SCAP_SHM_MAX_BUFFER_SIZE (1ULL << 31)
+
+struct scap_shm_producer {
+	char m_name[SCAP_MAX_PATH_SIZE];
+	int m_fd;
+	uint8_t* m_map;
+	size_t m_map_size;
+	struct scap_shm_header* m_hdr;
+	uint8_t* m_data;
+	uint64_t m_data_mask;
+	uint8_t* m_state;
+
+	uint64_t m_write_pos;
+	uint64_t m_n_evts;
+
+	// Snapshot being built, copied to the shared area on commit.
+	uint8_t* m_staging;
+	size_t m_staging_len;
+	size_t m_staging_size;
+	scap_threadinfo* m_tinfo_scratch;
+};
+
+static size_t count_zeros(const uint8_t* src, size_t len) {
+	size_t n = 0;
+	while(n < len && n < UINT16_MAX && src[n] == 0) {
+		n++;
+	}
+	return n;
+}
+
+size_t scap_shm_zrle_encode(const uint8_t* src, size_t len, uint8_t* dst) {
+	uint8_t* out = dst;
+	size_t i = 0;
+
+	while(i < len) {
+		// Extend the literal up to the next zero run long enough to be worth
+		// a token of its own.
+		size_t lit_start = i;
+		size_t zeros = 0;
+		while(i < len && i - lit_start < UINT16_MAX) {
+			zeros = count_zeros(src + i, len - i);
+			if(zeros >= SCAP_SHM_ZRLE_MIN_RUN || (zeros > 0 && i + zeros == len)) {
+				break;
+			}
+			if(zeros > 0) {
+				size_t room = UINT16_MAX - (i - lit_start);
+				i += zeros < room ? zeros : room;
+			} else {
+				i++;
+			}
+			zeros = 0;
+		}
+
+		uint16_t lit_len = (uint16_t)(i - lit_start);
+		uint16_t zero_len = (uint16_t)zeros;
+		memcpy(out, &lit_len, sizeof(lit_len));
+		out += sizeof(lit_len);
+		memcpy(out, src + lit_start, lit_len);
+		out += lit_len;
+		memcpy(out, &zero_len, sizeof(zero_len));
+		out += sizeof(zero_len);
+		i += zeros;
+	}
+
+	return out - dst;
+}
+
+size_t scap_shm_zrle_decode(const uint8_t* src, size_t src_len, uint8_t* dst, size_t len) {
+	const uint8_t* in = src;
+	const uint8_t* end = src + src_len;
+	size_t i = 0;
+
+	while(i < len) {
+		uint16_t lit_len;
+		uint16_t zero_len;
+
+		if(end - in < (ptrdiff_t)sizeof(lit_len)) {
+			return 0;
+		}
+		memcpy(&lit_len, in, sizeof(lit_len));
+		in += sizeof(lit_len);
+		if(end - in < (ptrdiff_t)lit_len + (ptrdiff_t)sizeof(zero_len) || i + lit_len > len) {
+			return 0;
+		}
+		memcpy(dst + i, in, lit_len);
+		in += lit_len;
+		i += lit_len;
+
+		memcpy(&zero_len, in, sizeof(zero_len));
+		in += sizeof(zero_len);
+		if(i + zero_len > len) {
+			return 0;
+		}
+		memset(dst + i, 0, zero_len);
+		i += zero_len;
+
+		if(lit_len == 0 && zero_len == 0) {
+			return 0;
+		}
+	}
+
+	return in - src;
+}
+
+static uint64_t round_up_pow2(uint64_t v) {
+	uint64_t p = 1;
+	while(p < v) {
+		p <<= 1;
+	}
+	return p;
+}
+
+struct scap_shm_producer* scap_shm_producer_open(const char* name,
+                                                 uint64_t buffer_size,
+                                                 uint64_t state_size,
+                                                 const scap_machine_info* machine_info,
+                                                 char* error) {
+	if(name == NULL || name[0] != '/' || strchr(name + 1, '/') != NULL) {
+		scap_errprintf(error, 0, "invalid shm name '%s', expected '/<name>'", name ? name : "");
+		return NULL;
+	}
+
+	if(buffer_size == 0) {
+		buffer_size = SCAP_SHM_DEFAULT_BUFFER_SIZE;
+	}
+	if(state_size == 0) {
+		state_size = SCAP_SHM_DEFAULT_STATE_SIZE;
+	}
+	buffer_size = round_up_pow2(buffer_size);
+	state_size = SCAP_SHM_ALIGN(state_size);
+	if(buffer_size > SCAP_SHM_MAX_BUFFER_SIZE || buffer_size < 4096) {
+		scap_errprintf(error,
+		               0,
+		               "shm buffer size must be between 4096 and %llu bytes",
+		               (unsigned long long)SCAP_SHM_MAX_BUFFER_SIZE);
+		return NULL;
+	}
+
+	struct scap_shm_producer* p = calloc(1, sizeof(*p));
+	if(p == NULL) {
+		scap_errprintf(error, 0, "error allocating the shm producer");
+		return NULL;
+	}
+	p->m_fd = -1;
+	strlcpy(p->m_name, name, sizeof(p->m_name));
+
+	p->m_tinfo_scratch = malloc(sizeof(scap_threadinfo));
+	p->m_staging_size = SCAP_SHM_ZRLE_MAX_SIZE(sizeof(scap_threadinfo));
+	p->m_staging = malloc(p->m_staging_size);
+	if(p->m_tinfo_scratch == NULL || p->m_staging == NULL) {
+		scap_errprintf(error, 0, "error allocating the shm producer");
+		scap_shm_producer_close(p);
+		return NULL;
+	}
+
+	// Start from a fresh object, consumers of a previous producer keep their
+	// own mapping of the unlinked one.
+	shm_unlink(name);
+	p->m_fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if(p->m_fd < 0) {
+		scap_errprintf(error, errno, "error creating shm object '%s'", name);
+		scap_shm_producer_close(p);
+		return NULL;
+	}
+
+	uint64_t hdr_size = SCAP_SHM_ALIGN(sizeof(struct scap_shm_header));
+	p->m_map_size = hdr_size + state_size + buffer_size;
+	if(ftruncate(p->m_fd, (off_t)p->m_map_size) < 0) {
+		scap_errprintf(error, errno, "error sizing shm object '%s'", name);
+		scap_shm_producer_close(p);
+		return NULL;
+	}
+
+	p->m_map = mmap(NULL, p->m_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, p->m_fd, 0);
+	if(p->m_map == MAP_FAILED) {
+		p->m_map = NULL;
+		scap_errprintf(error, errno, "error mapping shm object '%s'", name);
+		scap_shm_producer_close(p);
+		return NULL;
+	}
+
+	p->m_hdr = (struct scap_shm_header*)p->m_map;
+	p->m_state = p->m_map + hdr_size;
+	p->m_data = p->m_state + state_size;
+	p->m_data_mask = buffer_size - 1;
+
+	struct scap_shm_header* hdr = p->m_hdr;
+	hdr->version = SCAP_SHM_VERSION;
+	hdr->tinfo_size = sizeof(scap_threadinfo);
+	hdr->fdinfo_size = sizeof(scap_fdinfo);
+	hdr->state_offset = hdr_size;
+	hdr->state_size = state_size;
+	hdr->data_offset = hdr_size + state_size;
+	hdr->data_size = buffer_size;
+	if(machine_info != NULL) {
+		hdr->machine_info = *machine_info;
+	}
+	atomic_store_explicit(&hdr->reserve_pos, 0, memory_order_relaxed);
+	atomic_store_explicit(&hdr->write_pos, 0, memory_order_relaxed);
+	atomic_store_explicit(&hdr->n_evts, 0, memory_order_relaxed);
+	atomic_store_explicit(&hdr->closed, 0, memory_order_relaxed);
+	atomic_store_explicit(&hdr->state_seq, 0, memory_order_relaxed);
+
+	// Written last, consumers refuse objects without it.
+	atomic_thread_fence(memory_order_release);
+	hdr->magic = SCAP_SHM_MAGIC;
+
+	return p;
+}
+
+int32_t scap_shm_producer_write(struct scap_shm_producer* p,
+                                const struct ppm_evt_hdr* evt,
+                                uint16_t devid,
+                                char* error) {
+	struct scap_shm_header* hdr = p->m_hdr;
+	uint64_t data_size = hdr->data_size;
+	uint64_t len = SCAP_SHM_ALIGN(sizeof(struct scap_shm_record) + evt->len);
+
+	if(len > SCAP_SHM_MAX_RECORD_SIZE(data_size)) {
+		return scap_errprintf(error,
+		                      0,
+		                      "event of %u bytes does not fit in a shm ring of %llu bytes",
+		                      evt->len,
+		                      (unsigned long long)data_size);
+	}
+
+	uint64_t pos = p->m_write_pos;
+	uint64_t off = pos & p->m_data_mask;
+	uint64_t pad = (off + len > data_size) ? data_size - off : 0;
+
+	atomic_store_explicit(&hdr->reserve_pos, pos + pad + len, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	if(pad != 0) {
+		struct scap_shm_record rec = {.len = (uint32_t)pad, .type = SCAP_SHM_RECORD_PAD};
+		memcpy(p->m_data + off, &rec, sizeof(rec));
+		pos += pad;
+		off = 0;
+	}
+
+	struct scap_shm_record rec = {
+	        .len = (uint32_t)len,
+	        .type = SCAP_SHM_RECORD_EVT,
+	        .devid = devid,
+	        .seq = p->m_n_evts,
+	};
+	memcpy(p->m_data + off, &rec, sizeof(rec));
+	memcpy(p->m_data + off + sizeof(rec), evt, evt->len);
+
+	p->m_write_pos = pos + len;
+	p->m_n_evts++;
+	atomic_store_explicit(&hdr->n_evts, p->m_n_evts, memory_order_relaxed);
+	atomic_store_explicit(&hdr->write_pos, p->m_write_pos, memory_order_release);
+
+	return SCAP_SUCCESS;
+}
+
+void scap_shm_producer_state_begin(struct scap_shm_producer* p) {
+	p->m_staging_len = 0;
+}
+
+static int32_t reserve_staging(struct scap_shm_producer* p, size_t len, char* error) {
+	if(p->m_staging_len + len <= p->m_staging_size) {
+		return SCAP_SUCCESS;
+	}
+
+	size_t new_size = p->m_staging_size;
+	while(p->m_staging_len + len > new_size) {
+		new_size *= 2;
+	}
+	uint8_t* staging = realloc(p->m_staging, new_size);
+	if(staging == NULL) {
+		return scap_errprintf(error, 0, "error allocating %zu bytes for the shm state", new_size);
+	}
+	p->m_staging = staging;
+	p->m_staging_size = new_size;
+	return SCAP_SUCCESS;
+}
+
+int32_t scap_shm_producer_state_add(struct scap_shm_producer* p,
+                                    const scap_threadinfo* tinfo,
+                                    const scap_fdinfo* fdinfos,
+                                    uint32_t n_fdinfos,
+                                    char* error) {
+	size_t max_len = sizeof(n_fdinfos) + SCAP_SHM_ZRLE_MAX_SIZE(sizeof(scap_threadinfo)) +
+	                 (size_t)n_fdinfos * SCAP_SHM_ZRLE_MAX_SIZE(sizeof(scap_fdinfo));
+	if(reserve_staging(p, max_len, error) != SCAP_SUCCESS) {
+		return SCAP_FAILURE;
+	}
+
+	uint8_t* out = p->m_staging + p->m_staging_len;
+	memcpy(out, &n_fdinfos, sizeof(n_fdinfos));
+	out += sizeof(n_fdinfos);
+
+	// Pointers are meaningless in another process, and zeroing them keeps
+	// them out of the encoded stream.
+	*p->m_tinfo_scratch = *tinfo;
+	p->m_tinfo_scratch->fdlist = NULL;
+	memset(&p->m_tinfo_scratch->hh, 0, sizeof(p->m_tinfo_scratch->hh));
+	out += scap_shm_zrle_encode((const uint8_t*)p->m_tinfo_scratch, sizeof(scap_threadinfo), out);
+
+	for(uint32_t i = 0; i < n_fdinfos; i++) {
+		scap_fdinfo fdi = fdinfos[i];
+		memset(&fdi.hh, 0, sizeof(fdi.hh));
+		out += scap_shm_zrle_encode((const uint8_t*)&fdi, sizeof(fdi), out);
+	}
+
+	p->m_staging_len = out - p->m_staging;
+	return SCAP_SUCCESS;
+}
+
+int32_t scap_shm_producer_state_commit(struct scap_shm_producer* p, char* error) {
+	struct scap_shm_header* hdr = p->m_hdr;
+
+	if(p->m_staging_len > hdr->state_size) {
+		return scap_errprintf(error,
+		                      0,
+		                      "shm state snapshot of %zu bytes exceeds the %llu bytes available",
+		                      p->m_staging_len,
+		                      (unsigned long long)hdr->state_size);
+	}
+
+	uint64_t seq = atomic_load_explicit(&hdr->state_seq, memory_order_relaxed);
+	atomic_store_explicit(&hdr->state_seq, seq + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	memcpy(p->m_state, p->m_staging, p->m_staging_len);
+	hdr->state_len = p->m_staging_len;
+	hdr->state_write_pos = p->m_write_pos;
+	hdr->state_n_evts = p->m_n_evts;
+
+	atomic_store_explicit(&hdr->state_seq, seq + 2, memory_order_release);
+	return SCAP_SUCCESS;
+}
+
+void scap_shm_producer_close(struct scap_shm_producer* p) {
+	if(p == NULL) {
+		return;
+	}
+
+	if(p->m_map != NULL) {
+		atomic_store_explicit(&p->m_hdr->closed, 1, memory_order_release);
+		munmap(p->m_map, p->m_map_size);
+	}
+	if(p->m_fd >= 0) {
+		close(p->m_fd);
+		shm_unlink(p->m_name);
+	}
+	free(p->m_staging);
+	free(p->m_tinfo_scratch);
+	free(p);
+}
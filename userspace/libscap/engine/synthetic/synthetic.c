@@ -0,0 +1,579 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2024 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HANDLE(engine) ((struct synthetic_engine*)(engine.m_handle))
+
+#include <libscap/engine/synthetic/synthetic.h>
+#include <libscap/engine/noop/noop.h>
+
+#include <libscap/scap.h>
+#include <libscap/scap-int.h>
+#include <libscap/strerror.h>
+
+/* Default values used when the corresponding param is 0. */
+#define SYNTHETIC_DEFAULT_N_PROCS 64
+#define SYNTHETIC_DEFAULT_N_FDS 16
+
+/* Every synthetic stream starts at the same point in time, so that it is reproducible. */
+#define SYNTHETIC_START_TS 1700000000000000000ULL
+#define SYNTHETIC_DEFAULT_DELTA_NS 1000ULL
+#define SYNTHETIC_FIRST_TID 1000
+#define SYNTHETIC_FIRST_FD 3
+#define SYNTHETIC_INIT_TID 1
+#define SYNTHETIC_MAX_DATA_LEN 80
+
+/* Don't bother sleeping for less than this amount of time while pacing. */
+#define SYNTHETIC_MIN_SLEEP_NS 50000ULL
+
+static const char* const s_exes[] = {
+        "/usr/bin/bash",
+        "/usr/bin/python3",
+        "/usr/sbin/nginx",
+        "/usr/bin/java",
+        "/usr/local/bin/node",
+        "/usr/bin/curl",
+        "/usr/bin/cat",
+        "/usr/sbin/sshd",
+};
+#define SYNTHETIC_N_EXES (sizeof(s_exes) / sizeof(s_exes[0]))
+
+static const char* const s_dirs[] = {
+        "/etc",
+        "/var/log",
+        "/tmp",
+        "/usr/lib",
+        "/proc/self",
+        "/home/user",
+};
+#define SYNTHETIC_N_DIRS (sizeof(s_dirs) / sizeof(s_dirs[0]))
+
+static const char s_payload[SYNTHETIC_MAX_DATA_LEN] =
+        "GET /api/v1/items HTTP/1.1\r\nHost: synthetic.local\r\nUser-Agent: scap\r\n\r\n";
+
+static void* alloc_handle(scap_t* main_handle, char* lasterr_ptr) {
+	struct synthetic_engine* engine = calloc(1, sizeof(struct synthetic_engine));
+	if(engine) {
+		engine->m_lasterr = lasterr_ptr;
+	}
+	return engine;
+}
+
+static void free_handle(struct scap_engine_handle engine) {
+	struct synthetic_engine* handle = engine.m_handle;
+	if(handle) {
+		free(handle->m_procs);
+		free(handle->m_fd_state);
+	}
+	free(handle);
+}
+
+/* xorshift64*: fast, good enough for workload generation and fully deterministic. */
+static inline uint64_t synthetic_rand(struct synthetic_engine* handle) {
+	uint64_t x = handle->m_rng;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	handle->m_rng = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+static inline uint32_t synthetic_rand_range(struct synthetic_engine* handle, uint32_t n) {
+	return (uint32_t)(synthetic_rand(handle) % n);
+}
+
+static uint64_t synthetic_monotonic_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Reserve the next slot of the pending queue and return its buffer. */
+static inline struct scap_sized_buffer synthetic_slot(struct synthetic_engine* handle) {
+	struct scap_sized_buffer buf = {handle->m_pending[handle->m_n_pending].m_buf,
+	                                SYNTHETIC_EVT_BUF_SIZE};
+	return buf;
+}
+
+static int32_t synthetic_commit(struct synthetic_engine* handle, int64_t tid, int32_t res) {
+	if(res != SCAP_SUCCESS) {
+		return res;
+	}
+	scap_evt* evt = (scap_evt*)handle->m_pending[handle->m_n_pending].m_buf;
+	evt->ts = handle->m_next_ts;
+	evt->tid = tid;
+	handle->m_next_ts += handle->m_delta_ns;
+	handle->m_n_pending++;
+	return SCAP_SUCCESS;
+}
+
+static inline uint8_t* synthetic_fd_state(struct synthetic_engine* handle,
+                                          uint32_t proc,
+                                          uint32_t slot) {
+	return &handle->m_fd_state[(size_t)proc * handle->m_n_fds + slot];
+}
+
+static void synthetic_cgroups(struct synthetic_engine* handle,
+                              struct synthetic_proc* proc,
+                              struct scap_const_sized_buffer* out) {
+	if(proc->m_container == 0) {
+		out->size = (size_t)snprintf(proc->m_cgroups, sizeof(proc->m_cgroups), "cpuset=/") + 1;
+	} else {
+		/* Container ids only depend on the seed and the container index. */
+		uint64_t id = (handle->m_seed + proc->m_container) * 0x9E3779B97F4A7C15ULL;
+		out->size = (size_t)snprintf(proc->m_cgroups,
+		                             sizeof(proc->m_cgroups),
+		                             "cpuset=/docker/%016llx%016llx%016llx%016llx",
+		                             (unsigned long long)id,
+		                             (unsigned long long)~id,
+		                             (unsigned long long)(id ^ 0xA5A5A5A5A5A5A5A5ULL),
+		                             (unsigned long long)(id >> 7)) +
+		            1;
+	}
+	out->buf = proc->m_cgroups;
+}
+
+static int32_t synthetic_gen_clone(struct synthetic_engine* handle, struct synthetic_proc* proc) {
+	struct scap_const_sized_buffer empty = {NULL, 0};
+	struct scap_const_sized_buffer cgroups;
+	const char* exe = s_exes[proc->m_exe];
+	const char* comm = strrchr(exe, '/') + 1;
+	synthetic_cgroups(handle, proc, &cgroups);
+
+	/* This is the child side of the clone, so the return value is 0. */
+	return synthetic_commit(handle,
+	                        proc->m_tid,
+	                        scap_event_encode_params(synthetic_slot(handle),
+	                                                 NULL,
+	                                                 handle->m_lasterr,
+	                                                 PPME_SYSCALL_CLONE_20_X,
+	                                                 21,
+	                                                 (int64_t)0,
+	                                                 exe,
+	                                                 empty,
+	                                                 proc->m_tid,
+	                                                 proc->m_tid,
+	                                                 proc->m_ptid,
+	                                                 "/",
+	                                                 (int64_t)1024,
+	                                                 (uint64_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint32_t)0,
+	                                                 (uint32_t)0,
+	                                                 (uint32_t)0,
+	                                                 comm,
+	                                                 cgroups,
+	                                                 (uint32_t)0,
+	                                                 (uint32_t)0,
+	                                                 (uint32_t)0,
+	                                                 proc->m_tid,
+	                                                 proc->m_tid,
+	                                                 (uint64_t)0));
+}
+
+static int32_t synthetic_gen_execve(struct synthetic_engine* handle, struct synthetic_proc* proc) {
+	struct scap_const_sized_buffer empty = {NULL, 0};
+	struct scap_const_sized_buffer cgroups;
+	const char* exe = s_exes[proc->m_exe];
+	const char* comm = strrchr(exe, '/') + 1;
+	synthetic_cgroups(handle, proc, &cgroups);
+
+	return synthetic_commit(handle,
+	                        proc->m_tid,
+	                        scap_event_encode_params(synthetic_slot(handle),
+	                                                 NULL,
+	                                                 handle->m_lasterr,
+	                                                 PPME_SYSCALL_EXECVE_19_X,
+	                                                 31,
+	                                                 (int64_t)0,
+	                                                 exe,
+	                                                 empty,
+	                                                 proc->m_tid,
+	                                                 proc->m_tid,
+	                                                 proc->m_ptid,
+	                                                 "/",
+	                                                 (uint64_t)1024,
+	                                                 (uint64_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint32_t)0,
+	                                                 (uint32_t)0,
+	                                                 (uint32_t)0,
+	                                                 comm,
+	                                                 cgroups,
+	                                                 empty,
+	                                                 (uint32_t)0,
+	                                                 (uint64_t)proc->m_tid,
+	                                                 (uint32_t)0,
+	                                                 (uint32_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint64_t)0,
+	                                                 (uint32_t)0,
+	                                                 exe,
+	                                                 proc->m_tid,
+	                                                 (uint32_t)0,
+	                                                 exe));
+}
+
+static int32_t synthetic_gen_procexit(struct synthetic_engine* handle,
+                                      struct synthetic_proc* proc) {
+	return synthetic_commit(handle,
+	                        proc->m_tid,
+	                        scap_event_encode_params(synthetic_slot(handle),
+	                                                 NULL,
+	                                                 handle->m_lasterr,
+	                                                 PPME_PROCEXIT_1_E,
+	                                                 5,
+	                                                 (int64_t)0,
+	                                                 (int64_t)0,
+	                                                 (uint8_t)0,
+	                                                 (uint8_t)0,
+	                                                 (int64_t)SYNTHETIC_INIT_TID));
+}
+
+static int32_t synthetic_gen_open(struct synthetic_engine* handle,
+                                  struct synthetic_proc* proc,
+                                  uint32_t slot) {
+	char path[SCAP_MAX_PATH_SIZE];
+	snprintf(path,
+	         sizeof(path),
+	         "%s/file-%u.dat",
+	         s_dirs[synthetic_rand_range(handle, SYNTHETIC_N_DIRS)],
+	         synthetic_rand_range(handle, 1024));
+	*synthetic_fd_state(handle, proc->m_idx, slot) = SYNTHETIC_FD_FILE;
+
+	return synthetic_commit(handle,
+	                        proc->m_tid,
+	                        scap_event_encode_params(synthetic_slot(handle),
+	                                                 NULL,
+	                                                 handle->m_lasterr,
+	                                                 PPME_SYSCALL_OPEN_X,
+	                                                 6,
+	                                                 (int64_t)(SYNTHETIC_FIRST_FD + slot),
+	                                                 path,
+	                                                 (uint32_t)PPM_O_RDWR,
+	                                                 (uint32_t)0644,
+	                                                 (uint32_t)0x801,
+	                                                 (uint64_t)(0x10000 + slot)));
+}
+
+static int32_t synthetic_gen_close(struct synthetic_engine* handle,
+                                   struct synthetic_proc* proc,
+                                   uint32_t slot) {
+	*synthetic_fd_state(handle, proc->m_idx, slot) = SYNTHETIC_FD_CLOSED;
+
+	return synthetic_commit(handle,
+	                        proc->m_tid,
+	                        scap_event_encode_params(synthetic_slot(handle),
+	                                                 NULL,
+	                                                 handle->m_lasterr,
+	                                                 PPME_SYSCALL_CLOSE_X,
+	                                                 2,
+	                                                 (int64_t)0,
+	                                                 (int64_t)(SYNTHETIC_FIRST_FD + slot)));
+}
+
+static int32_t synthetic_gen_io(struct synthetic_engine* handle,
+                                struct synthetic_proc* proc,
+                                uint32_t slot,
+                                ppm_event_code type) {
+	uint32_t size = 1 + synthetic_rand_range(handle, 4096);
+	struct scap_const_sized_buffer data = {
+	        s_payload,
+	        size < SYNTHETIC_MAX_DATA_LEN ? size : SYNTHETIC_MAX_DATA_LEN};
+
+	return synthetic_commit(handle,
+	                        proc->m_tid,
+	                        scap_event_encode_params(synthetic_slot(handle),
+	                                                 NULL,
+	                                                 handle->m_lasterr,
+	                                                 type,
+	                                                 4,
+	                                                 (int64_t)size,
+	                                                 data,
+	                                                 (int64_t)(SYNTHETIC_FIRST_FD + slot),
+	                                                 size));
+}
+
+static int32_t synthetic_gen_connect(struct synthetic_engine* handle,
+                                     struct synthetic_proc* proc,
+                                     uint32_t slot) {
+	/* family (1 byte) + saddr (4 bytes) + sport (2 bytes) + daddr (4 bytes) + dport (2 bytes) */
+	uint8_t tuple[13];
+	uint8_t sockaddr[7];
+	uint16_t sport = (uint16_t)(32768 + synthetic_rand_range(handle, 28000));
+	uint16_t dport = synthetic_rand_range(handle, 2) ? 443 : 80;
+	uint8_t saddr[4] = {10, 0, (uint8_t)proc->m_container, (uint8_t)(proc->m_idx + 1)};
+	uint8_t daddr[4] = {10,
+	                    1,
+	                    (uint8_t)synthetic_rand_range(handle, 4),
+	                    (uint8_t)(1 + synthetic_rand_range(handle, 254))};
+	int32_t res;
+
+	tuple[0] = PPM_AF_INET;
+	memcpy(&tuple[1], saddr, sizeof(saddr));
+	memcpy(&tuple[5], &sport, sizeof(sport));
+	memcpy(&tuple[7], daddr, sizeof(daddr));
+	memcpy(&tuple[11], &dport, sizeof(dport));
+	sockaddr[0] = PPM_AF_INET;
+	memcpy(&sockaddr[1], daddr, sizeof(daddr));
+	memcpy(&sockaddr[5], &dport, sizeof(dport));
+
+	*synthetic_fd_state(handle, proc->m_idx, slot) = SYNTHETIC_FD_SOCKET;
+
+	res = synthetic_commit(handle,
+	                       proc->m_tid,
+	                       scap_event_encode_params(synthetic_slot(handle),
+	                                                NULL,
+	                                                handle->m_lasterr,
+	                                                PPME_SOCKET_SOCKET_X,
+	                                                5,
+	                                                (int64_t)(SYNTHETIC_FIRST_FD + slot),
+	                                                (uint32_t)PPM_AF_INET,
+	                                                (uint32_t)1 /* SOCK_STREAM */,
+	                                                (uint32_t)0,
+	                                                (uint32_t)0));
+	if(res != SCAP_SUCCESS) {
+		return res;
+	}
+
+	struct scap_const_sized_buffer tuple_buf = {tuple, sizeof(tuple)};
+	struct scap_const_sized_buffer sockaddr_buf = {sockaddr, sizeof(sockaddr)};
+	return synthetic_commit(handle,
+	                        proc->m_tid,
+	                        scap_event_encode_params(synthetic_slot(handle),
+	                                                 NULL,
+	                                                 handle->m_lasterr,
+	                                                 PPME_SOCKET_CONNECT_X,
+	                                                 4,
+	                                                 (int64_t)0,
+	                                                 tuple_buf,
+	                                                 (int64_t)(SYNTHETIC_FIRST_FD + slot),
+	                                                 sockaddr_buf));
+}
+
+/* Replace the process in the slot with a brand new one. */
+static int32_t synthetic_spawn(struct synthetic_engine* handle, struct synthetic_proc* proc) {
+	int32_t res = SCAP_SUCCESS;
+	if(proc->m_tid != 0) {
+		res = synthetic_gen_procexit(handle, proc);
+		if(res != SCAP_SUCCESS) {
+			return res;
+		}
+	}
+
+	/* The parent is another synthetic process, or init for the first ones. */
+	struct synthetic_proc* parent = &handle->m_procs[synthetic_rand_range(handle, handle->m_n_procs)];
+	proc->m_ptid = (parent != proc && parent->m_tid != 0) ? parent->m_tid : SYNTHETIC_INIT_TID;
+	proc->m_tid = handle->m_next_tid++;
+	proc->m_exe = synthetic_rand_range(handle, SYNTHETIC_N_EXES);
+	memset(synthetic_fd_state(handle, proc->m_idx, 0), SYNTHETIC_FD_CLOSED, handle->m_n_fds);
+
+	res = synthetic_gen_clone(handle, proc);
+	return res != SCAP_SUCCESS ? res : synthetic_gen_execve(handle, proc);
+}
+
+/* Fill the pending queue with the events of the next syscall of the mix. */
+static int32_t synthetic_generate(struct synthetic_engine* handle) {
+	handle->m_n_pending = 0;
+	handle->m_next_pending = 0;
+
+	/* Bootstrap: make sure every process slot is alive. */
+	if(handle->m_n_spawned < handle->m_n_procs) {
+		return synthetic_spawn(handle, &handle->m_procs[handle->m_n_spawned++]);
+	}
+
+	struct synthetic_proc* proc = &handle->m_procs[synthetic_rand_range(handle, handle->m_n_procs)];
+	uint32_t slot = synthetic_rand_range(handle, handle->m_n_fds);
+	uint8_t fd_state = *synthetic_fd_state(handle, proc->m_idx, slot);
+	uint32_t pick = synthetic_rand_range(handle, handle->m_mix_total);
+	int32_t res = SCAP_SUCCESS;
+
+	enum synthetic_family family = 0;
+	while(pick >= handle->m_mix_cumulative[family]) {
+		family++;
+	}
+
+	switch(family) {
+	case SYNTHETIC_CLONE:
+		return synthetic_spawn(handle, proc);
+	case SYNTHETIC_EXECVE:
+		proc->m_exe = synthetic_rand_range(handle, SYNTHETIC_N_EXES);
+		return synthetic_gen_execve(handle, proc);
+	case SYNTHETIC_OPEN:
+		if(fd_state != SYNTHETIC_FD_CLOSED) {
+			res = synthetic_gen_close(handle, proc, slot);
+		}
+		return res != SCAP_SUCCESS ? res : synthetic_gen_open(handle, proc, slot);
+	case SYNTHETIC_READ:
+	case SYNTHETIC_WRITE:
+		if(fd_state == SYNTHETIC_FD_CLOSED) {
+			res = synthetic_gen_open(handle, proc, slot);
+		}
+		if(res != SCAP_SUCCESS) {
+			return res;
+		}
+		return synthetic_gen_io(handle,
+		                        proc,
+		                        slot,
+		                        family == SYNTHETIC_READ ? PPME_SYSCALL_READ_X
+		                                                 : PPME_SYSCALL_WRITE_X);
+	case SYNTHETIC_CONNECT:
+		if(fd_state != SYNTHETIC_FD_CLOSED) {
+			res = synthetic_gen_close(handle, proc, slot);
+		}
+		return res != SCAP_SUCCESS ? res : synthetic_gen_connect(handle, proc, slot);
+	case SYNTHETIC_CLOSE:
+		if(fd_state == SYNTHETIC_FD_CLOSED) {
+			return synthetic_gen_open(handle, proc, slot);
+		}
+		return synthetic_gen_close(handle, proc, slot);
+	default:
+		ASSERT(false);
+		return scap_errprintf(handle->m_lasterr, 0, "unknown synthetic syscall family");
+	}
+}
+
+static int32_t init(scap_t* main_handle, scap_open_args* oargs) {
+	struct synthetic_engine* handle = main_handle->m_engine.m_handle;
+	struct scap_synthetic_engine_params* params = oargs->engine_params;
+	if(params == NULL) {
+		return scap_errprintf(handle->m_lasterr, 0, "No synthetic engine params provided");
+	}
+
+	handle->m_seed = params->seed;
+	/* xorshift64* must never be seeded with 0 */
+	handle->m_rng = params->seed ^ 0x853C49E6748FEA9BULL;
+	if(handle->m_rng == 0) {
+		handle->m_rng = 0x853C49E6748FEA9BULL;
+	}
+	handle->m_evts_per_sec = params->evts_per_sec;
+	handle->m_max_evts = params->max_evts;
+	handle->m_n_procs = params->n_procs ? params->n_procs : SYNTHETIC_DEFAULT_N_PROCS;
+	handle->m_n_fds = params->n_fds ? params->n_fds : SYNTHETIC_DEFAULT_N_FDS;
+	handle->m_n_containers = params->n_containers;
+
+	struct scap_synthetic_mix mix = params->mix;
+	if(mix.clone + mix.execve + mix.open + mix.read + mix.write + mix.connect + mix.close == 0) {
+		/* I/O dominates real workloads, process lifecycle events are comparatively rare. */
+		mix = (struct scap_synthetic_mix){.clone = 1,
+		                                  .execve = 1,
+		                                  .open = 10,
+		                                  .read = 40,
+		                                  .write = 30,
+		                                  .connect = 5,
+		                                  .close = 10};
+	}
+	const uint32_t weights[SYNTHETIC_FAMILY_MAX] =
+	        {mix.clone, mix.execve, mix.open, mix.read, mix.write, mix.connect, mix.close};
+	handle->m_mix_total = 0;
+	for(int i = 0; i < SYNTHETIC_FAMILY_MAX; i++) {
+		handle->m_mix_total += weights[i];
+		handle->m_mix_cumulative[i] = handle->m_mix_total;
+	}
+
+	handle->m_procs = calloc(handle->m_n_procs, sizeof(struct synthetic_proc));
+	handle->m_fd_state = calloc((size_t)handle->m_n_procs * handle->m_n_fds, sizeof(uint8_t));
+	if(handle->m_procs == NULL || handle->m_fd_state == NULL) {
+		return scap_errprintf(handle->m_lasterr, 0, "error allocating the synthetic workload");
+	}
+	for(uint32_t i = 0; i < handle->m_n_procs; i++) {
+		handle->m_procs[i].m_idx = i;
+		handle->m_procs[i].m_container =
+		        handle->m_n_containers ? 1 + (i % handle->m_n_containers) : 0;
+	}
+
+	handle->m_next_tid = SYNTHETIC_FIRST_TID;
+	handle->m_next_ts = SYNTHETIC_START_TS;
+	handle->m_delta_ns = handle->m_evts_per_sec ? 1000000000ULL / handle->m_evts_per_sec
+	                                            : SYNTHETIC_DEFAULT_DELTA_NS;
+	if(handle->m_delta_ns == 0) {
+		handle->m_delta_ns = 1;
+	}
+	handle->m_start_mono_ns = synthetic_monotonic_ns();
+	return SCAP_SUCCESS;
+}
+
+static int32_t next(struct scap_engine_handle engine,
+                    scap_evt** pevent,
+                    uint16_t* pdevid,
+                    uint32_t* pflags) {
+	struct synthetic_engine* handle = engine.m_handle;
+
+	if(handle->m_max_evts != 0 && handle->m_n_evts >= handle->m_max_evts) {
+		return SCAP_EOF;
+	}
+
+	/* Pace the stream: the n-th event is due `n / evts_per_sec` seconds after the start. */
+	if(handle->m_evts_per_sec != 0) {
+		uint64_t due_ns = handle->m_n_evts * 1000000000ULL / handle->m_evts_per_sec;
+		uint64_t elapsed_ns = synthetic_monotonic_ns() - handle->m_start_mono_ns;
+		if(due_ns > elapsed_ns + SYNTHETIC_MIN_SLEEP_NS) {
+			uint64_t wait_ns = due_ns - elapsed_ns;
+			struct timespec ts = {(time_t)(wait_ns / 1000000000ULL),
+			                      (long)(wait_ns % 1000000000ULL)};
+			nanosleep(&ts, NULL);
+		}
+	}
+
+	if(handle->m_next_pending == handle->m_n_pending) {
+		int32_t res = synthetic_generate(handle);
+		if(res != SCAP_SUCCESS) {
+			return res;
+		}
+	}
+
+	*pevent = (scap_evt*)handle->m_pending[handle->m_next_pending++].m_buf;
+	*pdevid = 0;
+	*pflags = 0;
+	handle->m_n_evts++;
+	return SCAP_SUCCESS;
+}
+
+static int32_t get_stats(struct scap_engine_handle engine, scap_stats* stats) {
+	stats->n_evts = HANDLE(engine)->m_n_evts;
+	return SCAP_SUCCESS;
+}
+
+const struct scap_vtable scap_synthetic_engine = {
+        .name = SYNTHETIC_ENGINE,
+        .savefile_ops = NULL,
+
+        .alloc_handle = alloc_handle,
+        .init = init,
+        .free_handle = free_handle,
+        .close = noop_close_engine,
+        .next = next,
+        .start_capture = noop_start_capture,
+        .stop_capture = noop_stop_capture,
+        .configure = noop_configure,
+        .get_stats = get_stats,
+        .get_stats_v2 = noop_get_stats_v2,
+        .get_n_tracepoint_hit = noop_get_n_tracepoint_hit,
+        .get_n_devs = noop_get_n_devs,
+        .get_max_buf_used = noop_get_max_buf_used,
+        .get_api_version = NULL,
+        .get_schema_version = NULL,
+};
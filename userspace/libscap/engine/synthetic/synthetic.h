@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2024 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <libscap/engine/synthetic/synthetic_public.h>
+
+// A single syscall can expand to a few events (e.g. procexit + clone + execve)
+#define SYNTHETIC_MAX_PENDING_EVTS 4
+#define SYNTHETIC_EVT_BUF_SIZE 4096
+#define SYNTHETIC_CGROUPS_SIZE 128
+
+enum synthetic_family {
+	SYNTHETIC_CLONE = 0,
+	SYNTHETIC_EXECVE,
+	SYNTHETIC_OPEN,
+	SYNTHETIC_READ,
+	SYNTHETIC_WRITE,
+	SYNTHETIC_CONNECT,
+	SYNTHETIC_CLOSE,
+	SYNTHETIC_FAMILY_MAX,
+};
+
+enum synthetic_fd_state {
+	SYNTHETIC_FD_CLOSED = 0,
+	SYNTHETIC_FD_FILE,
+	SYNTHETIC_FD_SOCKET,
+};
+
+struct synthetic_proc {
+	uint32_t m_idx;
+	uint32_t m_container;  ///< 1-based container index, 0 means host
+	int64_t m_tid;
+	int64_t m_ptid;
+	uint32_t m_exe;
+	char m_cgroups[SYNTHETIC_CGROUPS_SIZE];
+};
+
+struct synthetic_pending_evt {
+	// aligned like the events in the kernel ring buffers
+	_Alignas(8) char m_buf[SYNTHETIC_EVT_BUF_SIZE];
+};
+
+struct synthetic_engine {
+	char* m_lasterr;
+
+	uint64_t m_seed;
+	uint64_t m_rng;
+	uint64_t m_evts_per_sec;
+	uint64_t m_max_evts;
+	uint32_t m_n_procs;
+	uint32_t m_n_fds;
+	uint32_t m_n_containers;
+	uint32_t m_mix_total;
+	uint32_t m_mix_cumulative[SYNTHETIC_FAMILY_MAX];
+
+	struct synthetic_proc* m_procs;
+	uint8_t* m_fd_state;  ///< m_n_procs * m_n_fds matrix of `enum synthetic_fd_state`
+	uint32_t m_n_spawned;
+	int64_t m_next_tid;
+
+	uint64_t m_next_ts;
+	uint64_t m_delta_ns;
+	uint64_t m_start_mono_ns;
+	uint64_t m_n_evts;
+
+	struct synthetic_pending_evt m_pending[SYNTHETIC_MAX_PENDING_EVTS];
+	uint32_t m_n_pending;
+	uint32_t m_next_pending;
+};
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2024 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define SYNTHETIC_ENGINE "synthetic"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Relative weights of the syscall families produced by the synthetic engine.
+ * A weight of `0` disables the family. If all the weights are `0` a default mix,
+ * dominated by I/O like on a typical production host, is used.
+ */
+struct scap_synthetic_mix {
+	uint32_t clone;
+	uint32_t execve;
+	uint32_t open;
+	uint32_t read;
+	uint32_t write;
+	uint32_t connect;
+	uint32_t close;
+};
+
+struct scap_synthetic_engine_params {
+	uint64_t seed;          ///< Seed of the pseudo-random generator: the same seed always
+	                        ///< produces the same event stream.
+	uint64_t evts_per_sec;  ///< Target event rate, `0` means as fast as possible.
+	uint64_t max_evts;      ///< Number of events after which `SCAP_EOF` is returned, `0` means
+	                        ///< that the stream never ends.
+	uint32_t n_procs;       ///< Number of concurrently alive synthetic processes.
+	uint32_t n_fds;         ///< Number of fds each synthetic process can keep open.
+	uint32_t n_containers;  ///< Number of containers the processes are spread across, `0` means
+	                        ///< that all the processes run on the host.
+	struct scap_synthetic_mix mix;  ///< Syscall mix.
+};
+
+#ifdef __cplusplus
+};
+#endif
@@ -90,6 +90,10 @@ int32_t scap_linux_init_platform(struct scap_platform* platform,
 		return rc;
 	}
 
+	if(linux_platform->m_skip_proc_scan) {
+		return SCAP_SUCCESS;
+	}
+
 	linux_platform->m_lasterr[0] = '\0';
 	char proc_scan_err[SCAP_LASTERR_SIZE];
 	rc = scap_linux_refresh_proc_table(platform, &platform->m_proclist);
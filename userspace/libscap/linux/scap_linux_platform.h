@@ -170,6 +170,7 @@ struct scap_linux_platform {
 	struct scap_mountinfo* m_dev_list;
 	uint32_t m_fd_lookup_limit;
 	bool m_minimal_scan;
+	bool m_skip_proc_scan;  // the proc table is restored by the caller, e.g. from a state snapshot
 	struct scap_cgroup_interface m_cgroups;
 
 	// /proc scan parameters
@@ -40,6 +40,11 @@ extern "C" {
 #define N_EVENTS_PER_CPU_PREFIX "n_evts_cpu_"
 #define N_DROPS_PER_CPU_PREFIX "n_drops_cpu_"
 
+//
+// Prefix name for per-buffer utilization histograms (Used by modern ebpf)
+//
+#define N_UTIL_SAMPLES_PER_BUFFER_PREFIX "n_util_samples_buf_"
+
 //
 // Prefix names for per-Device metrics (Used by kernel module)
 //
@@ -59,6 +64,8 @@ extern "C" {
 #define METRICS_V2_KERNEL_COUNTERS_PER_CPU \
 	(1 << 7)  // Requesting this does also silently enable METRICS_V2_KERNEL_COUNTERS
 #define METRICS_V2_KERNEL_ITER_COUNTERS (1 << 8)
+#define METRICS_V2_KERNEL_BUFFERS (1 << 9)
+#define METRICS_V2_LATENCY (1 << 10)
 
 typedef union metrics_v2_value {
 	uint32_t u32;
@@ -0,0 +1,345 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2024 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/ringbuffer/spill_buffer.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <driver/ppm_events_public.h>
+#include <libscap/ringbuffer/devset.h>
+#include <libscap/scap_const.h>
+#include <libscap/strerror.h>
+
+#define SPILL_ALIGN(x) (((x) + 7) & ~((size_t)7))
+
+// Header stored in front of each staged event.
+struct spill_record {
+	uint32_t size;  // size of the whole record, header included
+	uint32_t flags;
+	uint16_t devid;
+};
+
+#define SPILL_RECORD_HDR_SIZE SPILL_ALIGN(sizeof(struct spill_record))
+
+struct spill_segment {
+	_Atomic(struct spill_segment*) next;
+	_Atomic size_t write_pos;  // written by the producer only
+	size_t read_pos;           // touched by the consumer only
+	char* data;
+};
+
+struct spill_buffer {
+	size_t m_segment_size;
+	uint32_t m_max_segments;
+
+	// Producer side.
+	struct spill_segment* m_tail;
+
+	// Consumer side.
+	struct spill_segment* m_head;
+	unsigned long m_retry_us;
+
+	// Recycled segments and allocation accounting, shared by both sides.
+	pthread_mutex_t m_free_lock;
+	struct spill_segment* m_free_list;
+	uint32_t m_n_segments;
+
+	// Drain thread.
+	pthread_t m_thread;
+	bool m_thread_started;
+	atomic_bool m_stop;
+	atomic_bool m_done;
+	_Atomic int32_t m_drain_res;
+	struct scap_engine_handle m_engine;
+	spill_buffer_next_fn m_next;
+
+	_Atomic uint64_t m_n_evts;
+	_Atomic uint64_t m_n_drops;
+};
+
+static struct spill_segment* spill_segment_alloc(size_t size) {
+	struct spill_segment* seg = calloc(1, sizeof(struct spill_segment));
+	if(seg == NULL) {
+		return NULL;
+	}
+	seg->data = malloc(size);
+	if(seg->data == NULL) {
+		free(seg);
+		return NULL;
+	}
+	return seg;
+}
+
+static void spill_segment_free(struct spill_segment* seg) {
+	free(seg->data);
+	free(seg);
+}
+
+static void spill_segment_reset(struct spill_segment* seg) {
+	atomic_store_explicit(&seg->next, NULL, memory_order_relaxed);
+	atomic_store_explicit(&seg->write_pos, 0, memory_order_relaxed);
+	seg->read_pos = 0;
+}
+
+// Take a segment from the free list, or allocate a new one if we are below the cap.
+static struct spill_segment* spill_get_segment(struct spill_buffer* sb) {
+	struct spill_segment* seg = NULL;
+
+	pthread_mutex_lock(&sb->m_free_lock);
+	if(sb->m_free_list != NULL) {
+		seg = sb->m_free_list;
+		sb->m_free_list = atomic_load_explicit(&seg->next, memory_order_relaxed);
+	} else if(sb->m_n_segments < sb->m_max_segments) {
+		seg = spill_segment_alloc(sb->m_segment_size);
+		if(seg != NULL) {
+			sb->m_n_segments++;
+		}
+	}
+	pthread_mutex_unlock(&sb->m_free_lock);
+
+	if(seg != NULL) {
+		spill_segment_reset(seg);
+	}
+	return seg;
+}
+
+static void spill_put_segment(struct spill_buffer* sb, struct spill_segment* seg) {
+	pthread_mutex_lock(&sb->m_free_lock);
+	atomic_store_explicit(&seg->next, sb->m_free_list, memory_order_relaxed);
+	sb->m_free_list = seg;
+	pthread_mutex_unlock(&sb->m_free_lock);
+}
+
+struct spill_buffer* spill_buffer_alloc(uint64_t bytes_dim, uint64_t max_bytes_dim, char* lasterr) {
+	if(bytes_dim == 0) {
+		scap_errprintf(lasterr, 0, "the spill buffer dimension must be greater than 0");
+		return NULL;
+	}
+	if(max_bytes_dim < bytes_dim) {
+		max_bytes_dim = bytes_dim;
+	}
+
+	struct spill_buffer* sb = calloc(1, sizeof(struct spill_buffer));
+	if(sb == NULL) {
+		scap_errprintf(lasterr, 0, "error allocating the spill buffer");
+		return NULL;
+	}
+
+	sb->m_segment_size = bytes_dim < SPILL_BUFFER_SEGMENT_BYTES ? SPILL_ALIGN(bytes_dim)
+	                                                            : SPILL_BUFFER_SEGMENT_BYTES;
+	sb->m_max_segments = (max_bytes_dim + sb->m_segment_size - 1) / sb->m_segment_size;
+	sb->m_retry_us = BUFFER_EMPTY_WAIT_TIME_US_START;
+	pthread_mutex_init(&sb->m_free_lock, NULL);
+	atomic_init(&sb->m_stop, false);
+	atomic_init(&sb->m_done, false);
+	atomic_init(&sb->m_drain_res, SCAP_SUCCESS);
+	atomic_init(&sb->m_n_evts, 0);
+	atomic_init(&sb->m_n_drops, 0);
+
+	// Preallocate the initial segments so that bursts don't hit the allocator.
+	uint32_t n_prealloc = (bytes_dim + sb->m_segment_size - 1) / sb->m_segment_size;
+	for(uint32_t i = 0; i < n_prealloc; i++) {
+		struct spill_segment* seg = spill_segment_alloc(sb->m_segment_size);
+		if(seg == NULL) {
+			spill_buffer_free(sb);
+			scap_errprintf(lasterr,
+			               0,
+			               "error preallocating %" PRIu64 " bytes for the spill buffer",
+			               bytes_dim);
+			return NULL;
+		}
+		sb->m_n_segments++;
+		spill_put_segment(sb, seg);
+	}
+
+	sb->m_head = sb->m_tail = spill_get_segment(sb);
+	return sb;
+}
+
+bool spill_buffer_push(struct spill_buffer* sb, scap_evt* evt, uint16_t devid, uint32_t flags) {
+	size_t rec_size = SPILL_RECORD_HDR_SIZE + SPILL_ALIGN(evt->len);
+	if(rec_size > sb->m_segment_size) {
+		atomic_fetch_add_explicit(&sb->m_n_drops, 1, memory_order_relaxed);
+		return false;
+	}
+
+	struct spill_segment* tail = sb->m_tail;
+	size_t wpos = atomic_load_explicit(&tail->write_pos, memory_order_relaxed);
+	if(sb->m_segment_size - wpos < rec_size) {
+		struct spill_segment* seg = spill_get_segment(sb);
+		if(seg == NULL) {
+			atomic_fetch_add_explicit(&sb->m_n_drops, 1, memory_order_relaxed);
+			return false;
+		}
+		// Publishing `next` tells the consumer that `tail` won't receive more data.
+		atomic_store_explicit(&tail->next, seg, memory_order_release);
+		sb->m_tail = tail = seg;
+		wpos = 0;
+	}
+
+	struct spill_record* rec = (struct spill_record*)(tail->data + wpos);
+	rec->size = (uint32_t)rec_size;
+	rec->flags = flags;
+	rec->devid = devid;
+	memcpy(tail->data + wpos + SPILL_RECORD_HDR_SIZE, evt, evt->len);
+	atomic_store_explicit(&tail->write_pos, wpos + rec_size, memory_order_release);
+	atomic_fetch_add_explicit(&sb->m_n_evts, 1, memory_order_relaxed);
+	return true;
+}
+
+int32_t spill_buffer_next(struct spill_buffer* sb,
+                          scap_evt** pevent,
+                          uint16_t* pdevid,
+                          uint32_t* pflags) {
+	struct spill_segment* head = sb->m_head;
+	size_t wpos = atomic_load_explicit(&head->write_pos, memory_order_acquire);
+
+	while(head->read_pos == wpos) {
+		// Check `done` before `next`, so that the final events are not missed.
+		bool done = atomic_load_explicit(&sb->m_done, memory_order_acquire);
+		struct spill_segment* next = atomic_load_explicit(&head->next, memory_order_acquire);
+		if(next == NULL) {
+			// The producer could have written more data before we read `next`.
+			wpos = atomic_load_explicit(&head->write_pos, memory_order_acquire);
+			if(head->read_pos != wpos) {
+				break;
+			}
+
+			*pevent = NULL;
+			if(done) {
+				return atomic_load_explicit(&sb->m_drain_res, memory_order_relaxed);
+			}
+			usleep(sb->m_retry_us);
+			sb->m_retry_us = sb->m_retry_us * 2 < BUFFER_EMPTY_WAIT_TIME_US_MAX
+			                         ? sb->m_retry_us * 2
+			                         : BUFFER_EMPTY_WAIT_TIME_US_MAX;
+			return SCAP_TIMEOUT;
+		}
+
+		// Once `next` is published, the producer won't touch `head` anymore.
+		wpos = atomic_load_explicit(&head->write_pos, memory_order_acquire);
+		if(head->read_pos != wpos) {
+			break;
+		}
+		sb->m_head = next;
+		spill_put_segment(sb, head);
+		head = next;
+		wpos = atomic_load_explicit(&head->write_pos, memory_order_acquire);
+	}
+
+	sb->m_retry_us = BUFFER_EMPTY_WAIT_TIME_US_START;
+
+	struct spill_record* rec = (struct spill_record*)(head->data + head->read_pos);
+	*pevent = (scap_evt*)((char*)rec + SPILL_RECORD_HDR_SIZE);
+	*pdevid = rec->devid;
+	*pflags = rec->flags;
+	// The segment is recycled only after we move past it in a later call, so the
+	// returned event stays valid until then.
+	head->read_pos += rec->size;
+	return SCAP_SUCCESS;
+}
+
+static void* spill_buffer_drain_thread(void* arg) {
+	struct spill_buffer* sb = arg;
+	scap_evt* evt = NULL;
+	uint16_t devid = 0;
+	uint32_t flags = 0;
+	int32_t res = SCAP_SUCCESS;
+
+	while(!atomic_load_explicit(&sb->m_stop, memory_order_relaxed)) {
+		res = sb->m_next(sb->m_engine, &evt, &devid, &flags);
+		if(res == SCAP_SUCCESS) {
+			spill_buffer_push(sb, evt, devid, flags);
+		} else if(res != SCAP_TIMEOUT) {
+			break;
+		}
+	}
+
+	atomic_store_explicit(&sb->m_drain_res,
+	                      res == SCAP_SUCCESS || res == SCAP_TIMEOUT ? SCAP_EOF : res,
+	                      memory_order_relaxed);
+	atomic_store_explicit(&sb->m_done, true, memory_order_release);
+	return NULL;
+}
+
+int32_t spill_buffer_start(struct spill_buffer* sb,
+                           struct scap_engine_handle engine,
+                           spill_buffer_next_fn next,
+                           char* lasterr) {
+	sb->m_engine = engine;
+	sb->m_next = next;
+	atomic_store(&sb->m_stop, false);
+	atomic_store(&sb->m_done, false);
+
+	int ret = pthread_create(&sb->m_thread, NULL, spill_buffer_drain_thread, sb);
+	if(ret != 0) {
+		return scap_errprintf(lasterr, ret, "unable to start the spill buffer drain thread");
+	}
+	sb->m_thread_started = true;
+	return SCAP_SUCCESS;
+}
+
+void spill_buffer_stop(struct spill_buffer* sb) {
+	if(sb == NULL || !sb->m_thread_started) {
+		return;
+	}
+	atomic_store(&sb->m_stop, true);
+	pthread_join(sb->m_thread, NULL);
+	sb->m_thread_started = false;
+}
+
+void spill_buffer_free(struct spill_buffer* sb) {
+	if(sb == NULL) {
+		return;
+	}
+
+	spill_buffer_stop(sb);
+
+	struct spill_segment* seg = sb->m_head;
+	while(seg != NULL) {
+		struct spill_segment* next = atomic_load(&seg->next);
+		spill_segment_free(seg);
+		seg = next;
+	}
+	seg = sb->m_free_list;
+	while(seg != NULL) {
+		struct spill_segment* next = atomic_load(&seg->next);
+		spill_segment_free(seg);
+		seg = next;
+	}
+
+	pthread_mutex_destroy(&sb->m_free_lock);
+	free(sb);
+}
+
+void spill_buffer_get_stats(struct spill_buffer* sb, struct spill_buffer_stats* stats) {
+	stats->n_evts = atomic_load_explicit(&sb->m_n_evts, memory_order_relaxed);
+	stats->n_drops = atomic_load_explicit(&sb->m_n_drops, memory_order_relaxed);
+
+	// Segments are recycled and never returned to the system, so this is also the
+	// high watermark of the staging area.
+	pthread_mutex_lock(&sb->m_free_lock);
+	stats->n_bytes_allocated = (uint64_t)sb->m_n_segments * sb->m_segment_size;
+	pthread_mutex_unlock(&sb->m_free_lock);
+}
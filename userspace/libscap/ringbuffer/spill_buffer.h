@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2024 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <libscap/engine_handle.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Userspace spill buffer.
+//
+// When enabled, a dedicated drain thread pulls events from the kernel ring buffers
+// (through the engine `next` method) and copies them into a large userspace staging
+// area, so that a slow consumer doesn't leave the kernel buffers full. The drain
+// thread is the only producer and `spill_buffer_next` is the only consumer, so the
+// events are served in the same order in which the engine returned them.
+//
+// The staging area is made of fixed-size segments: `bytes_dim` bytes are preallocated
+// and the buffer can grow up to `max_bytes_dim` bytes before dropping events.
+//
+
+// Size of a single staging segment in bytes.
+#define SPILL_BUFFER_SEGMENT_BYTES (4 * 1024 * 1024)
+
+typedef struct ppm_evt_hdr scap_evt;
+
+typedef int32_t (*spill_buffer_next_fn)(struct scap_engine_handle engine,
+                                        scap_evt** pevent,
+                                        uint16_t* pdevid,
+                                        uint32_t* pflags);
+
+struct spill_buffer_stats {
+	uint64_t n_evts;             ///< Number of events copied into the spill buffer.
+	uint64_t n_drops;            ///< Number of events dropped because the spill buffer was full.
+	uint64_t n_bytes_allocated;  ///< Bytes allocated for the staging segments.
+};
+
+struct spill_buffer;
+
+// Allocate the spill buffer, preallocating `bytes_dim` bytes. `max_bytes_dim` is the
+// cap up to which the buffer is allowed to grow (0 means "same as bytes_dim").
+struct spill_buffer* spill_buffer_alloc(uint64_t bytes_dim, uint64_t max_bytes_dim, char* lasterr);
+
+// Start the drain thread, which will repeatedly call `next` on `engine`.
+int32_t spill_buffer_start(struct spill_buffer* sb,
+                           struct scap_engine_handle engine,
+                           spill_buffer_next_fn next,
+                           char* lasterr);
+
+// Stop and join the drain thread, if any. Events already staged are still served.
+void spill_buffer_stop(struct spill_buffer* sb);
+
+// Stop the drain thread and release all the memory.
+void spill_buffer_free(struct spill_buffer* sb);
+
+// Copy an event into the staging area. Returns false (and accounts a drop) if there
+// is no room left. Must be called by a single producer.
+bool spill_buffer_push(struct spill_buffer* sb, scap_evt* evt, uint16_t devid, uint32_t flags);
+
+// Return the next staged event. The returned pointer is valid until the next call.
+// Returns SCAP_TIMEOUT if nothing is available, or the error returned by the engine
+// once the drain thread stopped and all the staged events have been consumed.
+int32_t spill_buffer_next(struct spill_buffer* sb,
+                          scap_evt** pevent,
+                          uint16_t* pdevid,
+                          uint32_t* pflags);
+
+void spill_buffer_get_stats(struct spill_buffer* sb, struct spill_buffer_stats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -240,6 +240,11 @@ int32_t scap_get_stats(scap_t* handle, scap_stats* stats) {
 	stats->n_preemptions = 0;
 	stats->n_suppressed = 0;
 	stats->n_tids_suppressed = 0;
+	stats->n_drops_spill = 0;
+	stats->n_drops_rate_limit = 0;
+	stats->n_cgroup_filtered = 0;
+	stats->n_io_aggregated = 0;
+	stats->n_fd_type_filtered = 0;
 
 	if(handle->m_vtable) {
 		return handle->m_vtable->get_stats(handle->m_engine, stats);
@@ -403,6 +408,121 @@ int32_t scap_set_dropfailed(scap_t* handle, bool enabled) {
 	return scap_err_opnotsup(handle->m_lasterr);
 }
 
+int32_t scap_suppress_tgid(scap_t* handle, uint32_t tgid, bool suppress) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine, SCAP_SUPPRESS_TGID, tgid, suppress);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_suppress_comm(scap_t* handle, const char* comm, bool suppress) {
+	if(!handle || !comm) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine,
+		                                   SCAP_SUPPRESS_COMM,
+		                                   (unsigned long)comm,
+		                                   suppress);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_set_rate_limit(scap_t* handle, uint32_t rate, uint32_t burst) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine, SCAP_RATE_LIMIT, rate, burst);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_get_rate_limit_stats(scap_t* handle,
+                                  scap_rate_limit_stats* stats,
+                                  uint32_t max_stats,
+                                  uint32_t* nstats) {
+	if(!handle || (stats == NULL && max_stats > 0) || nstats == NULL) {
+		return SCAP_FAILURE;
+	}
+
+	*nstats = 0;
+	if(handle->m_vtable && handle->m_vtable->get_rate_limit_stats) {
+		return handle->m_vtable->get_rate_limit_stats(handle->m_engine, stats, max_stats, nstats);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_clear_suppressed(scap_t* handle) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine, SCAP_CLEAR_SUPPRESSED, 0, 0);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_set_cgroup_filter_mode(scap_t* handle, scap_cgroup_filter_mode mode) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine, SCAP_CGROUP_FILTER_MODE, mode, 0);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_cgroup_filter(scap_t* handle, uint64_t cgroup_id, bool add) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine, SCAP_CGROUP_FILTER, cgroup_id, add);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_clear_cgroup_filter(scap_t* handle) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine, SCAP_CGROUP_FILTER_CLEAR, 0, 0);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
+int32_t scap_set_io_aggregation(scap_t* handle, uint32_t interval_ms) {
+	if(!handle) {
+		return SCAP_FAILURE;
+	}
+
+	if(handle->m_vtable) {
+		return handle->m_vtable->configure(handle->m_engine, SCAP_IO_AGGREGATION, interval_ms, 0);
+	}
+
+	return scap_err_opnotsup(handle->m_lasterr);
+}
+
 int32_t scap_enable_dynamic_snaplen(scap_t* handle) {
 	if(!handle) {
 		return SCAP_FAILURE;
@@ -82,7 +82,9 @@ struct scap_vtable;
 #include <libscap/engine/modern_bpf/modern_bpf_public.h>
 #include <libscap/engine/nodriver/nodriver_public.h>
 #include <libscap/engine/savefile/savefile_public.h>
+#include <libscap/engine/shm/shm_public.h>
 #include <libscap/engine/source_plugin/source_plugin_public.h>
+#include <libscap/engine/synthetic/synthetic_public.h>
 #include <libscap/engine/test_input/test_input_public.h>
 
 //
@@ -144,8 +146,32 @@ typedef struct scap_stats {
 	uint64_t n_suppressed;       ///< Number of events skipped due to the tid being in a set of
 	                             ///< suppressed tids.
 	uint64_t n_tids_suppressed;  ///< Number of threads currently being suppressed.
+	uint64_t n_drops_spill;      ///< Number of events drained from the kernel buffers but
+	                             ///< dropped because the userspace spill buffer was full.
+	uint64_t n_drops_rate_limit; ///< Number of events skipped by the per-process rate limiter.
+	uint64_t n_cgroup_filtered;  ///< Number of events skipped by the cgroup filter.
+	uint64_t n_io_aggregated;    ///< Number of I/O events folded into `io_summary` events.
+	uint64_t n_fd_type_filtered; ///< Number of I/O events skipped because of their fd type.
 } scap_stats;
 
+/*!
+  \brief Number of events of a thread group skipped by the per-process rate
+  limiter, see `scap_get_rate_limit_stats`.
+*/
+typedef struct scap_rate_limit_stats {
+	uint32_t tgid;
+	uint64_t n_drops;
+} scap_rate_limit_stats;
+
+/*!
+  \brief How the cgroup ids passed to `scap_cgroup_filter` are applied.
+*/
+typedef enum scap_cgroup_filter_mode {
+	SCAP_CGROUP_FILTER_DISABLED = 0,  ///< All the cgroups are captured.
+	SCAP_CGROUP_FILTER_ALLOW = 1,     ///< Only the cgroups in the filter are captured.
+	SCAP_CGROUP_FILTER_DENY = 2,      ///< The cgroups in the filter are not captured.
+} scap_cgroup_filter_mode;
+
 /*!
   \brief File Descriptor type
 */
@@ -819,6 +845,109 @@ int32_t scap_set_ppm_sc(scap_t* handle, ppm_sc_code ppm_sc, bool enabled);
 */
 int32_t scap_set_dropfailed(scap_t* handle, bool enabled);
 
+/*!
+  \brief (Un)Suppress the events of a thread group directly in the driver.
+  The children of a suppressed thread group are suppressed as well.
+
+  \param handle Handle to the capture instance.
+  \param tgid the thread group id
+  \param suppress whether to suppress the thread group or stop suppressing it
+  \note This function can only be called for live captures, and only some
+  engines support it: callers must still suppress the events in userspace.
+*/
+int32_t scap_suppress_tgid(scap_t* handle, uint32_t tgid, bool suppress);
+
+/*!
+  \brief (Un)Suppress the events of the processes executing with a given comm
+  directly in the driver.
+
+  \param handle Handle to the capture instance.
+  \param comm the comm
+  \param suppress whether to suppress the comm or stop suppressing it
+  \note Same constraints as `scap_suppress_tgid`.
+*/
+int32_t scap_suppress_comm(scap_t* handle, const char* comm, bool suppress);
+
+/*!
+  \brief Remove all the thread groups and comms suppressed in the driver.
+
+  \param handle Handle to the capture instance.
+*/
+int32_t scap_clear_suppressed(scap_t* handle);
+
+/*!
+  \brief Limit the events that every thread group can send, the ones over the
+  limit are dropped in the driver and summarized by a `rate_limit` event.
+
+  \param handle Handle to the capture instance.
+  \param rate events per second allowed to each thread group, 0 to disable the limit.
+  \param burst events a thread group can send at once, 0 means `rate`.
+  \note This function can only be called for live captures, and only some
+  engines support it.
+*/
+int32_t scap_set_rate_limit(scap_t* handle, uint32_t rate, uint32_t burst);
+
+/*!
+  \brief Get the number of events skipped by the per-process rate limiter for
+  each thread group it tracks.
+
+  \param handle Handle to the capture instance.
+  \param stats Array filled with at most `max_stats` entries.
+  \param max_stats Size of the `stats` array.
+  \param nstats [out] Number of entries filled.
+  \return SCAP_SUCCESS, or SCAP_NOT_SUPPORTED if the engine has no rate limiter.
+  \note Only the thread groups that dropped at least one event are reported.
+*/
+int32_t scap_get_rate_limit_stats(scap_t* handle,
+                                  scap_rate_limit_stats* stats,
+                                  uint32_t max_stats,
+                                  uint32_t* nstats);
+
+/*!
+  \brief Set how the cgroup filter of the driver is applied. In allow mode
+  with no cgroup in the filter, only the process creation and execve events
+  are captured.
+
+  \param handle Handle to the capture instance.
+  \param mode the filter mode
+  \note This function can only be called for live captures, and only some
+  engines support it. Process creation, execve and process exit events are
+  never filtered, so that the thread table stays consistent.
+*/
+int32_t scap_set_cgroup_filter_mode(scap_t* handle, scap_cgroup_filter_mode mode);
+
+/*!
+  \brief Add or remove a cgroup from the cgroup filter of the driver.
+
+  \param handle Handle to the capture instance.
+  \param cgroup_id the cgroup id, i.e. the inode number of the cgroup v2
+  directory
+  \param add whether to add the cgroup to the filter or remove it
+  \note Same constraints as `scap_set_cgroup_filter_mode`.
+*/
+int32_t scap_cgroup_filter(scap_t* handle, uint64_t cgroup_id, bool add);
+
+/*!
+  \brief Remove all the cgroups from the cgroup filter of the driver.
+
+  \param handle Handle to the capture instance.
+*/
+int32_t scap_clear_cgroup_filter(scap_t* handle);
+
+/*!
+  \brief Fold the read-like and write-like syscalls in the driver: only the
+  first one of each thread on an fd is sent, the following ones are counted
+  and summarized by an `io_summary` event at most once per interval, and when
+  the thread closes the fd.
+
+  \param handle Handle to the capture instance.
+  \param interval_ms milliseconds between two summaries of the same fd, 0 to
+  disable the aggregation.
+  \note This function can only be called for live captures, and only some
+  engines support it.
+*/
+int32_t scap_set_io_aggregation(scap_t* handle, uint32_t interval_ms);
+
 /*!
   \brief Get the root directory of the system. This usually changes
   if running in a container, so that all the information for the
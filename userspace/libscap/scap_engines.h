@@ -45,6 +45,14 @@ extern const struct scap_vtable scap_kmod_engine;
 extern const struct scap_vtable scap_modern_bpf_engine;
 #endif
 
+#ifdef HAS_ENGINE_SYNTHETIC
+extern const struct scap_vtable scap_synthetic_engine;
+#endif
+
+#ifdef HAS_ENGINE_SHM
+extern const struct scap_vtable scap_shm_engine;
+#endif
+
 #ifdef HAS_ENGINE_TEST_INPUT
 extern const struct scap_vtable scap_test_input_engine;
 #endif
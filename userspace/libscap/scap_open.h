@@ -46,6 +46,9 @@ typedef struct scap_open_args {
 	uint64_t proc_scan_timeout_ms;  //< Timeout in msec, after which so-far-successful scan of /proc
 	                                // should be cut short with success return
 	uint64_t proc_scan_log_interval_ms;  //< Interval for logging progress messages from /proc scan
+	uint32_t io_fd_type_mask;            ///< `PPM_FD_TYPE_*` mask of the fds whose I/O events are
+	                                     ///< captured, 0 for all of them. Ignored by the engines
+	                                     ///< without kernel support.
 	void* engine_params;                 ///< engine-specific params.
 } scap_open_args;
 
@@ -28,6 +28,7 @@ extern "C" {
 #endif
 
 struct scap_stats;
+struct scap_rate_limit_stats;
 typedef struct scap scap_t;
 struct metrics_v2;
 typedef struct ppm_evt_hdr scap_evt;
@@ -81,6 +82,48 @@ enum scap_setting {
 	 * arg1: whether to enabled or disable the feature
 	 */
 	SCAP_DROP_FAILED,
+	/**
+	 * @brief suppress the events of a thread group in the driver
+	 * arg1: tgid
+	 * arg2: suppress (1) / stop suppressing (0)
+	 */
+	SCAP_SUPPRESS_TGID,
+	/**
+	 * @brief suppress the events of the processes with a given comm in the driver
+	 * arg1: pointer to the NUL terminated comm
+	 * arg2: suppress (1) / stop suppressing (0)
+	 */
+	SCAP_SUPPRESS_COMM,
+	/**
+	 * @brief remove all the suppressed thread groups and comms from the driver
+	 */
+	SCAP_CLEAR_SUPPRESSED,
+	/**
+	 * @brief configure the per-process rate limiter
+	 * arg1: events per second allowed to each thread group, 0 to disable it
+	 * arg2: burst size, 0 means arg1
+	 */
+	SCAP_RATE_LIMIT,
+	/**
+	 * @brief set how the cgroup filter of the driver is applied
+	 * arg1: a `scap_cgroup_filter_mode` value
+	 */
+	SCAP_CGROUP_FILTER_MODE,
+	/**
+	 * @brief add or remove a cgroup id from the cgroup filter of the driver
+	 * arg1: cgroup id
+	 * arg2: add (1) / remove (0)
+	 */
+	SCAP_CGROUP_FILTER,
+	/**
+	 * @brief remove all the cgroup ids from the cgroup filter of the driver
+	 */
+	SCAP_CGROUP_FILTER_CLEAR,
+	/**
+	 * @brief configure the in-kernel I/O aggregation
+	 * arg1: milliseconds between two `io_summary` events of the same fd, 0 to disable it
+	 */
+	SCAP_IO_AGGREGATION,
 };
 
 struct scap_savefile_vtable {
@@ -266,6 +309,19 @@ struct scap_vtable {
 	 * @return the schema version
 	 */
 	uint64_t (*get_schema_version)(struct scap_engine_handle engine);
+
+	/**
+	 * @brief get the per-process drop counters of the rate limiter, optional
+	 * @param engine wraps the pointer to the engine-specific handle
+	 * @param stats [out] array of at most `max_stats` entries to be filled
+	 * @param max_stats size of the `stats` array
+	 * @param nstats [out] number of entries filled
+	 * @return SCAP_SUCCESS or a failure code
+	 */
+	int32_t (*get_rate_limit_stats)(struct scap_engine_handle engine,
+	                                struct scap_rate_limit_stats* stats,
+	                                uint32_t max_stats,
+	                                uint32_t* nstats);
 };
 
 #ifdef __cplusplus
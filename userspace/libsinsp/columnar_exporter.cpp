@@ -0,0 +1,691 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/sinsp.h>
+#include <libsinsp/columnar_exporter.h>
+#include <libsinsp/filter.h>
+#include <libsinsp/filter/parser.h>
+
+#include <cstring>
+
+using namespace libsinsp::columnar;
+
+namespace {
+
+void put_u8(std::string& out, uint8_t v) {
+	out.push_back(static_cast<char>(v));
+}
+
+void put_u32(std::string& out, uint32_t v) {
+	for(int i = 0; i < 4; i++) {
+		out.push_back(static_cast<char>(v >> (8 * i)));
+	}
+}
+
+void put_u64(std::string& out, uint64_t v) {
+	for(int i = 0; i < 8; i++) {
+		out.push_back(static_cast<char>(v >> (8 * i)));
+	}
+}
+
+void put_str(std::string& out, std::string_view s) {
+	put_u32(out, static_cast<uint32_t>(s.size()));
+	out.append(s.data(), s.size());
+}
+
+// Fixed width encoding of a non-null value of the given column type.
+void put_value(std::string& out, column_type type, const value& v) {
+	switch(type) {
+	case column_type::INT64:
+		put_u64(out, static_cast<uint64_t>(std::get<int64_t>(v)));
+		break;
+	case column_type::UINT64:
+		put_u64(out, std::get<uint64_t>(v));
+		break;
+	case column_type::DOUBLE: {
+		uint64_t bits;
+		double d = std::get<double>(v);
+		memcpy(&bits, &d, sizeof(bits));
+		put_u64(out, bits);
+		break;
+	}
+	case column_type::BOOL:
+		put_u8(out, std::get<bool>(v) ? 1 : 0);
+		break;
+	case column_type::STRING:
+		put_str(out, std::get<std::string>(v));
+		break;
+	}
+}
+
+// Bounds-checked cursor over a buffer read from a columnar file.
+class cursor {
+public:
+	cursor(const std::string& buf, size_t pos = 0): m_buf(buf), m_pos(pos) {}
+
+	uint8_t u8() { return static_cast<uint8_t>(*take(1)); }
+
+	uint32_t u32() {
+		const char* p = take(4);
+		uint32_t v = 0;
+		for(int i = 0; i < 4; i++) {
+			v |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+		}
+		return v;
+	}
+
+	uint64_t u64() {
+		const char* p = take(8);
+		uint64_t v = 0;
+		for(int i = 0; i < 8; i++) {
+			v |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+		}
+		return v;
+	}
+
+	std::string str() {
+		uint32_t len = u32();
+		return std::string(take(len), len);
+	}
+
+	const char* take(size_t len) {
+		if(len > m_buf.size() - m_pos) {
+			throw sinsp_exception("invalid columnar file: unexpected end of data");
+		}
+		const char* p = m_buf.data() + m_pos;
+		m_pos += len;
+		return p;
+	}
+
+	value get_value(column_type type) {
+		switch(type) {
+		case column_type::INT64:
+			return static_cast<int64_t>(u64());
+		case column_type::UINT64:
+			return u64();
+		case column_type::DOUBLE: {
+			uint64_t bits = u64();
+			double d;
+			memcpy(&d, &bits, sizeof(d));
+			return d;
+		}
+		case column_type::BOOL:
+			return u8() != 0;
+		case column_type::STRING:
+			return str();
+		}
+		throw sinsp_exception("invalid columnar file: unknown column type");
+	}
+
+private:
+	const std::string& m_buf;
+	size_t m_pos;
+};
+
+bool is_signed_type(ppm_param_type type) {
+	switch(type) {
+	case PT_INT8:
+	case PT_INT16:
+	case PT_INT32:
+	case PT_INT64:
+	case PT_ERRNO:
+	case PT_FD:
+	case PT_PID:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool is_unsigned_type(ppm_param_type type) {
+	switch(type) {
+	case PT_UINT8:
+	case PT_UINT16:
+	case PT_UINT32:
+	case PT_UINT64:
+	case PT_SYSCALLID:
+	case PT_SIGTYPE:
+	case PT_RELTIME:
+	case PT_ABSTIME:
+	case PT_PORT:
+	case PT_L4PROTO:
+	case PT_SOCKFAMILY:
+	case PT_FLAGS8:
+	case PT_FLAGS16:
+	case PT_FLAGS32:
+	case PT_UID:
+	case PT_GID:
+	case PT_MODE:
+	case PT_ENUMFLAGS8:
+	case PT_ENUMFLAGS16:
+	case PT_ENUMFLAGS32:
+	case PT_SIGSET:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool is_string_type(ppm_param_type type) {
+	return type == PT_CHARBUF || type == PT_FSPATH || type == PT_FSRELPATH;
+}
+
+uint64_t read_unsigned(const extract_value_t& v) {
+	switch(v.len) {
+	case 1:
+		return *v.ptr;
+	case 2: {
+		uint16_t r;
+		memcpy(&r, v.ptr, sizeof(r));
+		return r;
+	}
+	case 4: {
+		uint32_t r;
+		memcpy(&r, v.ptr, sizeof(r));
+		return r;
+	}
+	case 8: {
+		uint64_t r;
+		memcpy(&r, v.ptr, sizeof(r));
+		return r;
+	}
+	default:
+		throw sinsp_exception("unexpected integer size " + std::to_string(v.len));
+	}
+}
+
+int64_t read_signed(const extract_value_t& v) {
+	switch(v.len) {
+	case 1:
+		return static_cast<int8_t>(*v.ptr);
+	case 2: {
+		int16_t r;
+		memcpy(&r, v.ptr, sizeof(r));
+		return r;
+	}
+	case 4: {
+		int32_t r;
+		memcpy(&r, v.ptr, sizeof(r));
+		return r;
+	}
+	case 8: {
+		int64_t r;
+		memcpy(&r, v.ptr, sizeof(r));
+		return r;
+	}
+	default:
+		throw sinsp_exception("unexpected integer size " + std::to_string(v.len));
+	}
+}
+
+}  // namespace
+
+// Values of one column for the row group being built.
+struct sinsp_columnar_exporter::column_builder {
+	column_type type;
+	// true if the column is filled with the string rendering of the field
+	bool render = false;
+	ppm_param_type field_type = PT_NONE;
+
+	uint32_t nrows = 0;
+	uint64_t null_count = 0;
+	std::vector<uint8_t> validity;
+	std::vector<uint64_t> numbers;
+	std::vector<uint8_t> bools;
+	std::vector<uint32_t> indices;
+	std::vector<std::string> dict;
+	std::unordered_map<std::string, uint32_t> dict_index;
+	value min;
+	value max;
+
+	void append(const value& v) {
+		if(nrows % 8 == 0) {
+			validity.push_back(0);
+		}
+
+		if(std::holds_alternative<std::monostate>(v)) {
+			null_count++;
+			switch(type) {
+			case column_type::BOOL:
+				bools.push_back(0);
+				break;
+			case column_type::STRING:
+				indices.push_back(0);
+				break;
+			default:
+				numbers.push_back(0);
+				break;
+			}
+			nrows++;
+			return;
+		}
+
+		validity.back() |= 1 << (nrows % 8);
+		switch(type) {
+		case column_type::INT64:
+			numbers.push_back(static_cast<uint64_t>(std::get<int64_t>(v)));
+			break;
+		case column_type::UINT64:
+			numbers.push_back(std::get<uint64_t>(v));
+			break;
+		case column_type::DOUBLE: {
+			uint64_t bits;
+			double d = std::get<double>(v);
+			memcpy(&bits, &d, sizeof(bits));
+			numbers.push_back(bits);
+			break;
+		}
+		case column_type::BOOL:
+			bools.push_back(std::get<bool>(v) ? 1 : 0);
+			break;
+		case column_type::STRING: {
+			const auto& s = std::get<std::string>(v);
+			auto it = dict_index.find(s);
+			if(it == dict_index.end()) {
+				it = dict_index.emplace(s, static_cast<uint32_t>(dict.size())).first;
+				dict.push_back(s);
+			}
+			indices.push_back(it->second);
+			break;
+		}
+		}
+
+		if(std::holds_alternative<std::monostate>(min) || v < min) {
+			min = v;
+		}
+		if(std::holds_alternative<std::monostate>(max) || max < v) {
+			max = v;
+		}
+		nrows++;
+	}
+
+	void encode(std::string& out) const {
+		put_u8(out,
+		       static_cast<uint8_t>(type == column_type::STRING ? encoding::DICTIONARY
+		                                                        : encoding::PLAIN));
+		out.append(reinterpret_cast<const char*>(validity.data()), validity.size());
+		switch(type) {
+		case column_type::BOOL:
+			out.append(reinterpret_cast<const char*>(bools.data()), bools.size());
+			break;
+		case column_type::STRING:
+			put_u32(out, static_cast<uint32_t>(dict.size()));
+			for(const auto& s : dict) {
+				put_str(out, s);
+			}
+			for(auto idx : indices) {
+				put_u32(out, idx);
+			}
+			break;
+		default:
+			for(auto n : numbers) {
+				put_u64(out, n);
+			}
+			break;
+		}
+	}
+
+	void reset() {
+		nrows = 0;
+		null_count = 0;
+		validity.clear();
+		numbers.clear();
+		bools.clear();
+		indices.clear();
+		dict.clear();
+		dict_index.clear();
+		min = std::monostate{};
+		max = std::monostate{};
+	}
+};
+
+sinsp_columnar_exporter::sinsp_columnar_exporter(sinsp* inspector,
+                                                 filter_check_list& available_checks,
+                                                 const std::vector<std::string>& fields,
+                                                 uint32_t row_group_size):
+        m_row_group_size(row_group_size == 0 ? DEFAULT_ROW_GROUP_SIZE : row_group_size) {
+	if(fields.empty()) {
+		throw sinsp_exception("columnar exporter: no fields given");
+	}
+
+	auto factory = std::make_shared<sinsp_filter_factory>(inspector, available_checks);
+	for(const auto& field : fields) {
+		std::unique_ptr<sinsp_filter_check> chk;
+		try {
+			libsinsp::filter::parser parser(field);
+			auto ast = parser.parse_field_or_transformer();
+			if(parser.get_pos().idx != field.size()) {
+				throw sinsp_exception("unexpected token after the field");
+			}
+			chk = sinsp_extractor_compiler(factory, ast.get()).compile();
+		} catch(const sinsp_exception& e) {
+			throw sinsp_exception("columnar exporter: invalid field '" + field + "': " + e.what());
+		}
+
+		auto builder = std::make_unique<column_builder>();
+		const auto* info = chk->get_transformed_field_info();
+		builder->field_type = info->m_type;
+		if(info->is_list()) {
+			builder->type = column_type::STRING;
+			builder->render = true;
+		} else if(is_signed_type(info->m_type)) {
+			builder->type = column_type::INT64;
+		} else if(is_unsigned_type(info->m_type)) {
+			builder->type = column_type::UINT64;
+		} else if(info->m_type == PT_DOUBLE) {
+			builder->type = column_type::DOUBLE;
+		} else if(info->m_type == PT_BOOL) {
+			builder->type = column_type::BOOL;
+		} else {
+			builder->type = column_type::STRING;
+			builder->render = !is_string_type(info->m_type);
+		}
+
+		m_columns.push_back({field, builder->type});
+		m_checks.push_back(std::move(chk));
+		m_builders.push_back(std::move(builder));
+	}
+}
+
+sinsp_columnar_exporter::~sinsp_columnar_exporter() {
+	try {
+		close();
+	} catch(...) {
+	}
+}
+
+void sinsp_columnar_exporter::open(const std::string& path) {
+	close();
+
+	m_file.open(path, std::ios::binary | std::ios::trunc);
+	if(!m_file.is_open()) {
+		throw sinsp_exception("can't open columnar file " + path + ": " + strerror(errno));
+	}
+
+	m_path = path;
+	m_nrows = 0;
+	m_rows_in_group = 0;
+	m_row_groups.clear();
+	for(auto& b : m_builders) {
+		b->reset();
+	}
+
+	std::string header(MAGIC, sizeof(MAGIC));
+	put_u32(header, VERSION);
+	m_file.write(header.data(), header.size());
+}
+
+void sinsp_columnar_exporter::write(sinsp_evt* evt) {
+	if(!m_file.is_open()) {
+		throw sinsp_exception("columnar exporter not opened yet");
+	}
+
+	std::vector<extract_value_t> values;
+	for(size_t i = 0; i < m_checks.size(); i++) {
+		auto& chk = m_checks[i];
+		auto& b = *m_builders[i];
+
+		if(b.render) {
+			const char* str = chk->tostring(evt);
+			b.append(str == nullptr ? value{} : value{std::string(str)});
+			continue;
+		}
+
+		values.clear();
+		if(!chk->extract(evt, values) || values.empty() || values[0].ptr == nullptr) {
+			b.append(value{});
+			continue;
+		}
+
+		const auto& v = values[0];
+		switch(b.type) {
+		case column_type::INT64:
+			b.append(read_signed(v));
+			break;
+		case column_type::UINT64:
+			b.append(read_unsigned(v));
+			break;
+		case column_type::DOUBLE: {
+			double d;
+			memcpy(&d, v.ptr, sizeof(d));
+			b.append(d);
+			break;
+		}
+		case column_type::BOOL:
+			b.append(read_unsigned(v) != 0);
+			break;
+		case column_type::STRING:
+			b.append(std::string(reinterpret_cast<const char*>(v.ptr),
+			                     strnlen(reinterpret_cast<const char*>(v.ptr), v.len)));
+			break;
+		}
+	}
+
+	m_nrows++;
+	if(++m_rows_in_group == m_row_group_size) {
+		flush_row_group();
+	}
+}
+
+void sinsp_columnar_exporter::flush_row_group() {
+	if(m_rows_in_group == 0) {
+		return;
+	}
+
+	row_group_info rg;
+	rg.num_rows = m_rows_in_group;
+	std::string chunk;
+	for(auto& b : m_builders) {
+		column_chunk_info info;
+		info.offset = static_cast<uint64_t>(m_file.tellp());
+		chunk.clear();
+		b->encode(chunk);
+		m_file.write(chunk.data(), chunk.size());
+		info.size = chunk.size();
+		info.null_count = b->null_count;
+		info.min = std::move(b->min);
+		info.max = std::move(b->max);
+		rg.columns.push_back(std::move(info));
+		b->reset();
+	}
+
+	if(!m_file) {
+		throw sinsp_exception("error writing columnar file " + m_path);
+	}
+
+	m_row_groups.push_back(std::move(rg));
+	m_rows_in_group = 0;
+}
+
+void sinsp_columnar_exporter::close() {
+	if(!m_file.is_open()) {
+		return;
+	}
+
+	flush_row_group();
+
+	std::string footer;
+	put_u32(footer, static_cast<uint32_t>(m_columns.size()));
+	for(const auto& col : m_columns) {
+		put_str(footer, col.name);
+		put_u8(footer, static_cast<uint8_t>(col.type));
+	}
+
+	put_u32(footer, static_cast<uint32_t>(m_row_groups.size()));
+	for(const auto& rg : m_row_groups) {
+		put_u64(footer, rg.num_rows);
+		for(size_t i = 0; i < m_columns.size(); i++) {
+			const auto& chunk = rg.columns[i];
+			put_u64(footer, chunk.offset);
+			put_u64(footer, chunk.size);
+			put_u64(footer, chunk.null_count);
+			bool has_minmax = !std::holds_alternative<std::monostate>(chunk.min);
+			put_u8(footer, has_minmax ? 1 : 0);
+			if(has_minmax) {
+				put_value(footer, m_columns[i].type, chunk.min);
+				put_value(footer, m_columns[i].type, chunk.max);
+			}
+		}
+	}
+
+	put_u64(footer, footer.size());
+	footer.append(MAGIC, sizeof(MAGIC));
+	m_file.write(footer.data(), footer.size());
+	m_file.close();
+	if(m_file.fail()) {
+		throw sinsp_exception("error writing columnar file " + m_path);
+	}
+}
+
+sinsp_columnar_reader::sinsp_columnar_reader(const std::string& path) {
+	m_file.open(path, std::ios::binary);
+	if(!m_file.is_open()) {
+		throw sinsp_exception("can't open columnar file " + path + ": " + strerror(errno));
+	}
+
+	// Header: magic and version; trailer: footer length and magic.
+	constexpr size_t header_len = sizeof(MAGIC) + sizeof(uint32_t);
+	constexpr size_t trailer_len = sizeof(uint64_t) + sizeof(MAGIC);
+	m_file.seekg(0, std::ios::end);
+	auto file_size = static_cast<uint64_t>(m_file.tellg());
+	if(file_size < header_len + trailer_len) {
+		throw sinsp_exception("invalid columnar file " + path + ": too short");
+	}
+
+	std::string header(header_len, '\0');
+	m_file.seekg(0);
+	m_file.read(header.data(), header.size());
+	std::string trailer(trailer_len, '\0');
+	m_file.seekg(file_size - trailer_len);
+	m_file.read(trailer.data(), trailer.size());
+	if(!m_file || memcmp(header.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+	   memcmp(trailer.data() + sizeof(uint64_t), MAGIC, sizeof(MAGIC)) != 0) {
+		throw sinsp_exception("invalid columnar file " + path + ": bad magic");
+	}
+
+	uint32_t version = cursor(header, sizeof(MAGIC)).u32();
+	if(version != VERSION) {
+		throw sinsp_exception("unsupported columnar file version " + std::to_string(version));
+	}
+
+	uint64_t footer_len = cursor(trailer).u64();
+	if(footer_len > file_size - header_len - trailer_len) {
+		throw sinsp_exception("invalid columnar file " + path + ": bad footer length");
+	}
+
+	std::string footer(footer_len, '\0');
+	m_file.seekg(file_size - trailer_len - footer_len);
+	m_file.read(footer.data(), footer.size());
+	if(!m_file) {
+		throw sinsp_exception("error reading columnar file " + path);
+	}
+
+	cursor c(footer);
+	uint32_t ncols = c.u32();
+	for(uint32_t i = 0; i < ncols; i++) {
+		column_info col;
+		col.name = c.str();
+		col.type = static_cast<column_type>(c.u8());
+		if(col.type < column_type::INT64 || col.type > column_type::STRING) {
+			throw sinsp_exception("invalid columnar file " + path + ": unknown column type");
+		}
+		m_columns.push_back(std::move(col));
+	}
+
+	uint32_t nrgs = c.u32();
+	for(uint32_t i = 0; i < nrgs; i++) {
+		row_group_info rg;
+		rg.num_rows = c.u64();
+		for(const auto& col : m_columns) {
+			column_chunk_info chunk;
+			chunk.offset = c.u64();
+			chunk.size = c.u64();
+			chunk.null_count = c.u64();
+			if(chunk.offset > file_size || chunk.size > file_size - chunk.offset) {
+				throw sinsp_exception("invalid columnar file " + path + ": bad chunk position");
+			}
+			if(c.u8() != 0) {
+				chunk.min = c.get_value(col.type);
+				chunk.max = c.get_value(col.type);
+			}
+			rg.columns.push_back(std::move(chunk));
+		}
+		m_row_groups.push_back(std::move(rg));
+	}
+}
+
+int32_t sinsp_columnar_reader::find_column(const std::string& name) const {
+	for(size_t i = 0; i < m_columns.size(); i++) {
+		if(m_columns[i].name == name) {
+			return static_cast<int32_t>(i);
+		}
+	}
+	return -1;
+}
+
+void sinsp_columnar_reader::read_column(size_t row_group,
+                                        size_t column,
+                                        std::vector<value>& values) {
+	const auto& rg = m_row_groups.at(row_group);
+	const auto& chunk = rg.columns.at(column);
+	const auto type = m_columns[column].type;
+
+	std::string buf(chunk.size, '\0');
+	m_file.clear();
+	m_file.seekg(chunk.offset);
+	m_file.read(buf.data(), buf.size());
+	if(!m_file) {
+		throw sinsp_exception("error reading columnar column chunk");
+	}
+
+	cursor c(buf);
+	auto enc = static_cast<encoding>(c.u8());
+	const char* validity = c.take((rg.num_rows + 7) / 8);
+	auto is_valid = [&](uint64_t row) { return (validity[row / 8] >> (row % 8)) & 1; };
+
+	values.clear();
+	values.reserve(rg.num_rows);
+	if(type == column_type::STRING) {
+		if(enc != encoding::DICTIONARY) {
+			throw sinsp_exception("invalid columnar file: unexpected string encoding");
+		}
+		std::vector<std::string> dict(c.u32());
+		for(auto& s : dict) {
+			s = c.str();
+		}
+		for(uint64_t row = 0; row < rg.num_rows; row++) {
+			uint32_t idx = c.u32();
+			if(!is_valid(row)) {
+				values.emplace_back();
+			} else if(idx >= dict.size()) {
+				throw sinsp_exception("invalid columnar file: bad dictionary index");
+			} else {
+				values.emplace_back(dict[idx]);
+			}
+		}
+		return;
+	}
+
+	if(enc != encoding::PLAIN) {
+		throw sinsp_exception("invalid columnar file: unexpected encoding");
+	}
+	for(uint64_t row = 0; row < rg.num_rows; row++) {
+		value v = c.get_value(type);
+		values.push_back(is_valid(row) ? std::move(v) : value{});
+	}
+}
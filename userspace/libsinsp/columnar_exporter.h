@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <libsinsp/sinsp_public.h>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+class sinsp;
+class sinsp_evt;
+class sinsp_filter_check;
+class filter_check_list;
+
+/*!
+  \brief Self-contained columnar file format for the event stream, laid out
+  like the Parquet/Arrow family so that analytics engines can load it in bulk
+  and skip data they don't need:
+
+  - the file starts and ends with the "SCOL" magic;
+  - rows are grouped in row groups, and each row group stores one chunk per
+    column: a validity bitmap (bit set = value present, LSB first) followed by
+    the values, 8-byte little endian for numbers, one byte for booleans, and
+    a dictionary plus 32-bit indices for strings;
+  - the footer, located through the 64-bit length stored right before the
+    trailing magic, holds the schema and, for each row group, the position,
+    the null count and the min/max values of every column chunk, so that
+    readers can prune row groups from the footer alone.
+
+  All integers are little endian.
+*/
+namespace libsinsp::columnar {
+
+constexpr char MAGIC[4] = {'S', 'C', 'O', 'L'};
+constexpr uint32_t VERSION = 1;
+
+enum class column_type : uint8_t {
+	INT64 = 1,
+	UINT64 = 2,
+	DOUBLE = 3,
+	BOOL = 4,
+	STRING = 5,
+};
+
+enum class encoding : uint8_t {
+	PLAIN = 1,
+	DICTIONARY = 2,
+};
+
+// A single cell: std::monostate is a null.
+using value = std::variant<std::monostate, int64_t, uint64_t, double, bool, std::string>;
+
+struct column_info {
+	std::string name;
+	column_type type;
+};
+
+struct column_chunk_info {
+	uint64_t offset = 0;
+	uint64_t size = 0;
+	uint64_t null_count = 0;
+	value min;  ///< null if the chunk only contains nulls
+	value max;
+};
+
+struct row_group_info {
+	uint64_t num_rows = 0;
+	std::vector<column_chunk_info> columns;
+};
+
+}  // namespace libsinsp::columnar
+
+/*!
+  \brief Writes events to a columnar file, one row per event and one typed
+  column per field. Fields are given like the ones of `sinsp_evt_formatter`,
+  without the '%', and transformers are supported.
+
+  Fields with numeric or boolean types get typed columns, everything else
+  (strings, addresses, lists...) is stored as its string rendering.
+*/
+class SINSP_PUBLIC sinsp_columnar_exporter {
+public:
+	static constexpr uint32_t DEFAULT_ROW_GROUP_SIZE = 64 * 1024;
+
+	/*!
+	  \throws sinsp_exception if a field can't be compiled.
+	*/
+	sinsp_columnar_exporter(sinsp* inspector,
+	                        filter_check_list& available_checks,
+	                        const std::vector<std::string>& fields,
+	                        uint32_t row_group_size = DEFAULT_ROW_GROUP_SIZE);
+	~sinsp_columnar_exporter();
+
+	sinsp_columnar_exporter(const sinsp_columnar_exporter&) = delete;
+	sinsp_columnar_exporter& operator=(const sinsp_columnar_exporter&) = delete;
+
+	void open(const std::string& path);
+
+	/*!
+	  \brief Flushes the last row group, writes the footer and closes the file.
+	*/
+	void close();
+
+	bool is_open() const { return m_file.is_open(); }
+
+	/*!
+	  \brief Appends the row of an event.
+	*/
+	void write(sinsp_evt* evt);
+
+	uint64_t written_rows() const { return m_nrows; }
+
+	const std::vector<libsinsp::columnar::column_info>& columns() const { return m_columns; }
+
+private:
+	struct column_builder;
+
+	void flush_row_group();
+
+	std::vector<libsinsp::columnar::column_info> m_columns;
+	std::vector<std::unique_ptr<sinsp_filter_check>> m_checks;
+	std::vector<std::unique_ptr<column_builder>> m_builders;
+	std::vector<libsinsp::columnar::row_group_info> m_row_groups;
+	uint32_t m_row_group_size;
+	uint32_t m_rows_in_group = 0;
+	uint64_t m_nrows = 0;
+	std::string m_path;
+	std::ofstream m_file;
+};
+
+/*!
+  \brief Reads back the files written by `sinsp_columnar_exporter`.
+*/
+class SINSP_PUBLIC sinsp_columnar_reader {
+public:
+	/*!
+	  \throws sinsp_exception if the file can't be read or isn't a valid
+	   columnar file.
+	*/
+	explicit sinsp_columnar_reader(const std::string& path);
+
+	const std::vector<libsinsp::columnar::column_info>& columns() const { return m_columns; }
+
+	const std::vector<libsinsp::columnar::row_group_info>& row_groups() const {
+		return m_row_groups;
+	}
+
+	/*!
+	  \brief Return the index of the column named `name`, -1 if not found.
+	*/
+	int32_t find_column(const std::string& name) const;
+
+	/*!
+	  \brief Decodes a single column chunk.
+	*/
+	void read_column(size_t row_group,
+	                 size_t column,
+	                 std::vector<libsinsp::columnar::value>& values);
+
+private:
+	std::vector<libsinsp::columnar::column_info> m_columns;
+	std::vector<libsinsp::columnar::row_group_info> m_row_groups;
+	std::ifstream m_file;
+};
@@ -23,15 +23,43 @@ limitations under the License.
 
 static constexpr const char* s_not_available_str = "<NA>";
 
-sinsp_evt_formatter::sinsp_evt_formatter(sinsp* inspector, filter_check_list& available_checks):
+// Installs the extraction cache for the given field expression, the same way the filter
+// compiler does, so that both share the values extracted for the same event.
+static void install_extract_cache(const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory,
+                                  const libsinsp::filter::ast::expr* e,
+                                  sinsp_filter_check& check) {
+	if(!cache_factory) {
+		return;
+	}
+
+	sinsp_filter_cache_factory::node_info_t node_info;
+	node_info.m_field = check.get_transformed_field_info();
+	check.m_cache_metrics = cache_factory->new_metrics(e, node_info);
+	check.m_extract_cache = cache_factory->new_extract_cache(e, node_info);
+
+	// values of plugin-implemented fields may not outlive the extraction,
+	// so a cached copy of them needs its own storage
+	if(check.get_field_info()->is_ptr_unstable() && check.m_extract_cache) {
+		check.add_transformer(filter_transformer_type::FTR_STORAGE);
+	}
+}
+
+sinsp_evt_formatter::sinsp_evt_formatter(
+        sinsp* inspector,
+        filter_check_list& available_checks,
+        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory):
         m_inspector(inspector),
-        m_available_checks(available_checks) {}
+        m_available_checks(available_checks),
+        m_cache_factory(cache_factory) {}
 
-sinsp_evt_formatter::sinsp_evt_formatter(sinsp* inspector,
-                                         const std::string& fmt,
-                                         filter_check_list& available_checks):
+sinsp_evt_formatter::sinsp_evt_formatter(
+        sinsp* inspector,
+        const std::string& fmt,
+        filter_check_list& available_checks,
+        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory):
         m_inspector(inspector),
-        m_available_checks(available_checks) {
+        m_available_checks(available_checks),
+        m_cache_factory(cache_factory) {
 	output_format of = sinsp_evt_formatter::OF_NORMAL;
 
 	if(m_inspector->get_buffer_format() == sinsp_evt::PF_JSON ||
@@ -130,7 +158,9 @@ void sinsp_evt_formatter::set_format(output_format of, const std::string& fmt) {
 					auto factory =
 					        std::make_shared<sinsp_filter_factory>(m_inspector, m_available_checks);
 					sinsp_extractor_compiler compiler(factory, ast.get());
-					chk = compiler.compile();
+					auto newchk = compiler.compile();
+					install_extract_cache(m_cache_factory, ast.get(), *newchk);
+					chk = std::move(newchk);
 					found = true;
 					fsize = parser.get_pos().idx;
 				} catch(sinsp_exception& e) {
@@ -142,7 +172,7 @@ void sinsp_evt_formatter::set_format(output_format of, const std::string& fmt) {
 			}
 
 			auto factory = std::make_shared<sinsp_filter_factory>(m_inspector, m_available_checks);
-			formatter_visitor(factory, m_resolution_tokens).fill(ast.get());
+			formatter_visitor(factory, m_resolution_tokens, m_cache_factory).fill(ast.get());
 
 			j += fsize;
 			ASSERT(j <= lfmtlen);
@@ -250,10 +280,13 @@ bool sinsp_evt_formatter::tostring(sinsp_evt* evt, std::string& res) {
 	return tostring_withformat(evt, res, m_output_format);
 }
 
-sinsp_evt_formatter_factory::sinsp_evt_formatter_factory(sinsp* inspector,
-                                                         filter_check_list& available_checks):
+sinsp_evt_formatter_factory::sinsp_evt_formatter_factory(
+        sinsp* inspector,
+        filter_check_list& available_checks,
+        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory):
         m_inspector(inspector),
         m_available_checks(available_checks),
+        m_cache_factory(cache_factory),
         m_output_format(sinsp_evt_formatter::OF_NORMAL) {}
 
 void sinsp_evt_formatter_factory::set_output_format(sinsp_evt_formatter::output_format of) {
@@ -270,7 +303,8 @@ std::shared_ptr<sinsp_evt_formatter> sinsp_evt_formatter_factory::create_formatt
 		return it->second;
 	}
 
-	auto ret = std::make_shared<sinsp_evt_formatter>(m_inspector, m_available_checks);
+	auto ret =
+	        std::make_shared<sinsp_evt_formatter>(m_inspector, m_available_checks, m_cache_factory);
 
 	ret->set_format(m_output_format, format);
 	m_formatters[format] = ret;
@@ -278,10 +312,13 @@ std::shared_ptr<sinsp_evt_formatter> sinsp_evt_formatter_factory::create_formatt
 	return ret;
 }
 
-formatter_visitor::formatter_visitor(const std::shared_ptr<sinsp_filter_factory>& factory,
-                                     std::vector<resolution_token>& resolution_tokens):
+formatter_visitor::formatter_visitor(
+        const std::shared_ptr<sinsp_filter_factory>& factory,
+        std::vector<resolution_token>& resolution_tokens,
+        const std::shared_ptr<sinsp_filter_cache_factory>& cache_factory):
         m_factory(factory),
-        m_resolution_tokens(resolution_tokens) {}
+        m_resolution_tokens(resolution_tokens),
+        m_cache_factory(cache_factory) {}
 
 void formatter_visitor::fill(const libsinsp::filter::ast::expr* ast) {
 	ast->accept(this);
@@ -343,8 +380,10 @@ void formatter_visitor::visit(const libsinsp::filter::ast::binary_check_expr* e)
 
 void formatter_visitor::visit(const libsinsp::filter::ast::field_expr* e) {
 	sinsp_extractor_compiler compiler(m_factory, e);
+	auto chk = compiler.compile();
+	install_extract_cache(m_cache_factory, e, *chk);
 	m_last_field_name = libsinsp::filter::ast::as_string(e);
-	m_resolution_tokens.emplace_back(m_last_field_name, compiler.compile(), false);
+	m_resolution_tokens.emplace_back(m_last_field_name, std::move(chk), false);
 	m_is_last_transformer = false;
 }
 
@@ -362,7 +401,9 @@ void formatter_visitor::visit(const libsinsp::filter::ast::field_transformer_exp
 	if(m_is_last_transformer) {
 		m_resolution_tokens.pop_back();
 	}
-	m_resolution_tokens.emplace_back(transformer_str, compiler.compile(), true);
+	auto chk = compiler.compile();
+	install_extract_cache(m_cache_factory, e, *chk);
+	m_resolution_tokens.emplace_back(transformer_str, std::move(chk), true);
 	m_last_field_name = transformer_str;
 	m_is_last_transformer = true;
 }
@@ -60,12 +60,20 @@ public:
 	  \param fmt The printf-like format to use. The accepted format is the same
 	   as the one of the output in Falco rules, so refer to the Falco
 	   documentation for details.
+	  \param cache_factory Optional factory of extraction caches. When it's
+	   shared with the filter compiler, the values already extracted by
+	   filters for the same event are reused, and vice versa.
 	*/
-	sinsp_evt_formatter(sinsp *inspector, filter_check_list &available_checks);
+	sinsp_evt_formatter(
+	        sinsp *inspector,
+	        filter_check_list &available_checks,
+	        const std::shared_ptr<sinsp_filter_cache_factory> &cache_factory = nullptr);
 
-	sinsp_evt_formatter(sinsp *inspector,
-	                    const std::string &fmt,
-	                    filter_check_list &available_checks);
+	sinsp_evt_formatter(
+	        sinsp *inspector,
+	        const std::string &fmt,
+	        filter_check_list &available_checks,
+	        const std::shared_ptr<sinsp_filter_cache_factory> &cache_factory = nullptr);
 
 	virtual ~sinsp_evt_formatter() = default;
 
@@ -130,6 +138,7 @@ private:
 	std::vector<resolution_token> m_resolution_tokens;
 	sinsp *m_inspector = nullptr;
 	filter_check_list &m_available_checks;
+	std::shared_ptr<sinsp_filter_cache_factory> m_cache_factory;
 	bool m_require_all_values = false;
 	bool m_resolve_transformed_fields = false;
 
@@ -139,7 +148,10 @@ private:
 
 class sinsp_evt_formatter_factory {
 public:
-	sinsp_evt_formatter_factory(sinsp *inspector, filter_check_list &available_checks);
+	sinsp_evt_formatter_factory(
+	        sinsp *inspector,
+	        filter_check_list &available_checks,
+	        const std::shared_ptr<sinsp_filter_cache_factory> &cache_factory = nullptr);
 	virtual ~sinsp_evt_formatter_factory() = default;
 
 	virtual void set_output_format(sinsp_evt_formatter::output_format of);
@@ -152,13 +164,15 @@ protected:
 
 	sinsp *m_inspector;
 	filter_check_list &m_available_checks;
+	std::shared_ptr<sinsp_filter_cache_factory> m_cache_factory;
 	sinsp_evt_formatter::output_format m_output_format;
 };
 
 class formatter_visitor : private libsinsp::filter::ast::const_expr_visitor {
 public:
 	formatter_visitor(const std::shared_ptr<sinsp_filter_factory> &factory,
-	                  std::vector<resolution_token> &resolution_tokens);
+	                  std::vector<resolution_token> &resolution_tokens,
+	                  const std::shared_ptr<sinsp_filter_cache_factory> &cache_factory = nullptr);
 	void fill(const libsinsp::filter::ast::expr *ast);
 
 	virtual ~formatter_visitor() = default;
@@ -178,4 +192,5 @@ public:
 	bool m_is_last_transformer;
 	std::shared_ptr<sinsp_filter_factory> m_factory;
 	std::vector<resolution_token> &m_resolution_tokens;
+	std::shared_ptr<sinsp_filter_cache_factory> m_cache_factory;
 };
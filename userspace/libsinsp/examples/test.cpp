@@ -24,6 +24,7 @@ limitations under the License.
 #include <libsinsp/sinsp.h>
 #include <libscap/scap_engines.h>
 #include <functional>
+#include <sstream>
 #include <memory>
 #include "util.h"
 
@@ -34,6 +35,7 @@ limitations under the License.
 #include <memory>
 #include <thread>
 #include <json/json.h>
+#include <libsinsp/columnar_exporter.h>
 
 #ifndef _WIN32
 extern "C" {
@@ -79,6 +81,11 @@ static std::shared_ptr<sinsp_plugin> plugin;
 static std::string open_params;  // for source plugins, its open params
 static std::unique_ptr<filter_check_list> filter_list;
 static std::shared_ptr<sinsp_filter_factory> filter_factory;
+static string columnar_path = "";
+static string columnar_fields =
+        "evt.num,evt.rawtime,evt.cpu,evt.type,evt.res,proc.pid,proc.ppid,proc.name,proc.exepath,"
+        "user.uid,container.id,fd.num,fd.type,fd.name,evt.buflen";
+static std::unique_ptr<sinsp_columnar_exporter> columnar_exporter;
 
 sinsp_evt* get_event(sinsp& inspector, std::function<void(const std::string&)> handle_error);
 
@@ -386,6 +393,12 @@ void parse_CLI_options(sinsp& inspector, int argc, char** argv) {
 			"the test binary source and re-compile.")
 		("r,raw", "Raw event output.")
 		("t,perftest", "Run in performance test mode.")
+		("C,columnar",
+			"Write the events to a columnar file instead of printing them.",
+			cxxopts::value<std::string>())
+		("F,columnar-fields",
+			"Comma separated list of the fields written with -C, one column per field.",
+			cxxopts::value<std::string>())
 		("T,tables",
 			"-T or -Tbrief print tables descriptions. -Tlist print table entries, if "
 			"-n is specified, print only the first n entries.",
@@ -525,6 +538,14 @@ void parse_CLI_options(sinsp& inspector, int argc, char** argv) {
 			perftest = true;
 		}
 
+		if(result.count("columnar")) {
+			columnar_path = result["columnar"].as<std::string>();
+		}
+
+		if(result.count("columnar-fields")) {
+			columnar_fields = result["columnar-fields"].as<std::string>();
+		}
+
 		if(result.count("tables")) {
 			table_mode = result["tables"].as<std::string>();
 			if(table_mode != "brief" && table_mode != "list") {
@@ -806,6 +827,22 @@ int main(int argc, char** argv) {
 	plugin_evt_formatter =
 	        std::make_unique<sinsp_evt_formatter>(&inspector, plugin_output, *filter_list.get());
 
+	if(!columnar_path.empty()) {
+		std::vector<std::string> fields;
+		std::stringstream ss(columnar_fields);
+		for(std::string field; std::getline(ss, field, ',');) {
+			fields.push_back(field);
+		}
+		try {
+			columnar_exporter =
+			        std::make_unique<sinsp_columnar_exporter>(&inspector, *filter_list, fields);
+			columnar_exporter->open(columnar_path);
+		} catch(const sinsp_exception& e) {
+			std::cerr << "[ERROR] Unable to open the columnar file: " << e.what() << std::endl;
+			return -1;
+		}
+	}
+
 	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
 	uint64_t curr_num_events = 0, last_num_events = 0;
 	uint64_t last_ts_ns = 0;
@@ -890,6 +927,8 @@ int main(int argc, char** argv) {
 					last_ts_ns = ts_ns;
 					last_num_events = curr_num_events;
 				}
+			} else if(columnar_exporter) {
+				columnar_exporter->write(ev);
 			} else if(!thread || g_all_threads || thread->is_main_thread()) {
 				dump(inspector, ev);
 			}
@@ -900,6 +939,9 @@ int main(int argc, char** argv) {
 	        std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
 
 	inspector.stop_capture();
+	if(columnar_exporter) {
+		columnar_exporter->close();
+	}
 
 	std::cout
 	        << "-- Stop capture                                                                    "
@@ -379,4 +379,10 @@ public:
 	uint64_t m_ino = 0;
 	int64_t m_pid = 0;  // only if fd is a pidfd
 	int64_t m_fd = -1;
+	uint64_t m_last_use = 0;  // Value of the fd table access clock at the last lookup of this fd.
+	// I/O syscalls folded by the driver and reported by `io_summary` events.
+	uint64_t m_summarized_reads = 0;
+	uint64_t m_summarized_read_bytes = 0;
+	uint64_t m_summarized_writes = 0;
+	uint64_t m_summarized_write_bytes = 0;
 };
@@ -16,10 +16,9 @@ limitations under the License.
 
 */
 
-#ifndef _WIN32
 #include <algorithm>
-#endif
 #include <cinttypes>
+#include <vector>
 
 #include <libsinsp/fdtable.h>
 #include <libsinsp/sinsp_int.h>
@@ -27,6 +26,10 @@ limitations under the License.
 
 static const auto s_fdtable_static_fields = sinsp_fdinfo::get_static_fields();
 
+// When a full table evicts, it drops this fraction of its entries at once, so that the scan for
+// the least recently used fds is amortized over many insertions.
+static constexpr size_t s_lru_eviction_batch_divisor = 16;
+
 sinsp_fdtable::sinsp_fdtable(const std::shared_ptr<ctor_params>& params):
         extensible_table{type_tag<sinsp_fdinfo>{}, "file_descriptors", &s_fdtable_static_fields},
         m_params{params},
@@ -42,6 +45,7 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::find_ref(int64_t fd)
 		if(m_params->m_sinsp_stats_v2) {
 			m_params->m_sinsp_stats_v2->m_n_cached_fd_lookups++;
 		}
+		m_last_accessed_fdinfo->m_last_use = ++m_access_clock;
 		return m_last_accessed_fdinfo;
 	}
 
@@ -62,6 +66,7 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::find_ref(int64_t fd)
 
 		m_last_accessed_fd = fd;
 		m_last_accessed_fdinfo = fdit->second;
+		m_last_accessed_fdinfo->m_last_use = ++m_access_clock;
 		lookup_device(*m_last_accessed_fdinfo);
 		return m_last_accessed_fdinfo;
 	}
@@ -71,16 +76,19 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::add_ref(
         int64_t fd,
         std::shared_ptr<sinsp_fdinfo>&& fdinfo) {
 	fdinfo->m_fd = fd;
+	fdinfo->m_last_use = ++m_access_clock;
 
 	const auto it = m_table.find(fd);
 
 	// Three possible exits here:
 	// 1. fd is not on the table
 	//   a. the table size is under the limit so create a new entry
-	//   b. table size is over the limit, discard the fd
+	//   b. table size is over the limit, evict the least recently used fds if allowed to,
+	//      otherwise discard the fd
 	// 2. fd is already in the table, replace it
 	if(it == m_table.end()) {
-		if(m_table.size() == m_params->m_max_table_size) {
+		if(m_table.size() >= m_params->m_max_table_size &&
+		   (!m_params->m_lru_eviction || evict_lru() == 0)) {
 			return m_nullptr_ret;
 		}
 
@@ -111,6 +119,32 @@ inline const std::shared_ptr<sinsp_fdinfo>& sinsp_fdtable::add_ref(
 	return it->second;
 }
 
+size_t sinsp_fdtable::evict_lru() {
+	const size_t n_to_evict = std::max<size_t>(1, m_table.size() / s_lru_eviction_batch_divisor);
+
+	std::vector<std::pair<uint64_t, int64_t>> lru;
+	lru.reserve(m_table.size());
+	for(const auto& [fd, fdinfo] : m_table) {
+		lru.emplace_back(fdinfo->m_last_use, fd);
+	}
+
+	const size_t n = std::min(n_to_evict, lru.size());
+	if(n < lru.size()) {
+		std::nth_element(lru.begin(), lru.begin() + n, lru.end());
+	}
+	for(size_t i = 0; i < n; i++) {
+		if(lru[i].second == m_last_accessed_fd) {
+			reset_cache();
+		}
+		m_table.erase(lru[i].second);
+	}
+
+	if(m_params->m_sinsp_stats_v2 != nullptr) {
+		m_params->m_sinsp_stats_v2->m_n_evicted_fds += n;
+	}
+	return n;
+}
+
 bool sinsp_fdtable::erase(int64_t fd) {
 	auto fdit = m_table.find(fd);
 
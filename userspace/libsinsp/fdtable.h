@@ -45,6 +45,8 @@ public:
 		// read-only.
 		const sinsp_mode& m_sinsp_mode;
 		const uint32_t m_max_table_size;
+		// If true, a full table evicts its least recently used fds instead of dropping new ones.
+		const bool& m_lru_eviction;
 		const sinsp_fdinfo_factory m_fdinfo_factory;
 		const std::shared_ptr<const sinsp_plugin> m_input_plugin;
 
@@ -153,6 +155,8 @@ private:
 	//
 	int64_t m_last_accessed_fd;
 	std::shared_ptr<sinsp_fdinfo> m_last_accessed_fdinfo;
+	// Logical clock stamped on the fds at each lookup, used to find the least recently used ones.
+	uint64_t m_access_clock = 0;
 	uint64_t m_tid;
 	std::shared_ptr<sinsp_fdinfo> m_nullptr_ret;  // needed for returning a reference
 
@@ -161,6 +165,7 @@ private:
 	}
 
 	inline void lookup_device(sinsp_fdinfo& fdi) const;
+	size_t evict_lru();
 	const std::shared_ptr<sinsp_fdinfo>& find_ref(int64_t fd);
 	const std::shared_ptr<sinsp_fdinfo>& add_ref(int64_t fd,
 	                                             std::shared_ptr<sinsp_fdinfo>&& fdinfo);
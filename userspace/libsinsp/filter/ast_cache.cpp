@@ -0,0 +1,396 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/filter/ast_cache.h>
+#include <libsinsp/filter/parser.h>
+#include <libsinsp/sinsp_exception.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace libsinsp::filter;
+
+namespace {
+
+// The file layout is: magic, format version, user version, number of entries, and then the
+// entries, each one made of the filter text and its encoded AST. Integers are stored in host
+// byte order, as the cache is meant to be local.
+constexpr char s_magic[4] = {'S', 'F', 'A', 'C'};
+constexpr uint32_t s_format_version = 1;
+
+// Deeper ASTs can only come from a corrupted encoding, as the parser caps the recursion way
+// below this.
+constexpr uint32_t s_max_decode_depth = 1000;
+
+enum node_tag : uint8_t {
+	TAG_AND = 1,
+	TAG_OR,
+	TAG_NOT,
+	TAG_IDENTIFIER,
+	TAG_VALUE,
+	TAG_LIST,
+	TAG_TRANSFORMER_LIST,
+	TAG_UNARY_CHECK,
+	TAG_BINARY_CHECK,
+	TAG_FIELD,
+	TAG_FIELD_TRANSFORMER,
+};
+
+void write_u32(std::string& out, uint32_t v) {
+	out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void write_str(std::string& out, std::string_view s) {
+	write_u32(out, static_cast<uint32_t>(s.size()));
+	out.append(s);
+}
+
+void write_opt_str(std::string& out, const std::optional<std::string>& s) {
+	out.push_back(s ? 1 : 0);
+	if(s) {
+		write_str(out, *s);
+	}
+}
+
+struct reader {
+	std::string_view data;
+
+	void need(size_t n) const {
+		if(data.size() < n) {
+			throw sinsp_exception("truncated filter AST encoding");
+		}
+	}
+
+	uint8_t u8() {
+		need(1);
+		auto v = static_cast<uint8_t>(data[0]);
+		data.remove_prefix(1);
+		return v;
+	}
+
+	uint32_t u32() {
+		uint32_t v;
+		need(sizeof(v));
+		memcpy(&v, data.data(), sizeof(v));
+		data.remove_prefix(sizeof(v));
+		return v;
+	}
+
+	std::string str() {
+		const auto len = u32();
+		need(len);
+		std::string v(data.substr(0, len));
+		data.remove_prefix(len);
+		return v;
+	}
+
+	std::optional<std::string> opt_str() {
+		if(u8() == 0) {
+			return std::nullopt;
+		}
+		return str();
+	}
+};
+
+class ast_encoder : public ast::const_expr_visitor {
+public:
+	explicit ast_encoder(std::string& out): m_out(out) {}
+
+	void encode(const ast::expr* e) {
+		if(e == nullptr) {
+			throw sinsp_exception("can't encode a null filter AST node");
+		}
+		e->accept(this);
+	}
+
+	void visit(const ast::and_expr* e) override {
+		header(TAG_AND, e);
+		children(e->children);
+	}
+
+	void visit(const ast::or_expr* e) override {
+		header(TAG_OR, e);
+		children(e->children);
+	}
+
+	void visit(const ast::not_expr* e) override {
+		header(TAG_NOT, e);
+		encode(e->child.get());
+	}
+
+	void visit(const ast::identifier_expr* e) override {
+		header(TAG_IDENTIFIER, e);
+		write_str(m_out, e->identifier);
+	}
+
+	void visit(const ast::value_expr* e) override {
+		header(TAG_VALUE, e);
+		write_str(m_out, e->value);
+	}
+
+	void visit(const ast::list_expr* e) override {
+		header(TAG_LIST, e);
+		write_u32(m_out, static_cast<uint32_t>(e->values.size()));
+		for(const auto& v : e->values) {
+			write_str(m_out, v);
+		}
+	}
+
+	void visit(const ast::transformer_list_expr* e) override {
+		header(TAG_TRANSFORMER_LIST, e);
+		children(e->children);
+	}
+
+	void visit(const ast::unary_check_expr* e) override {
+		header(TAG_UNARY_CHECK, e);
+		encode(e->left.get());
+		write_str(m_out, e->op);
+	}
+
+	void visit(const ast::binary_check_expr* e) override {
+		header(TAG_BINARY_CHECK, e);
+		encode(e->left.get());
+		write_str(m_out, e->op);
+		encode(e->right.get());
+	}
+
+	void visit(const ast::field_expr* e) override {
+		header(TAG_FIELD, e);
+		write_str(m_out, e->field);
+		write_opt_str(m_out, e->arg);
+	}
+
+	void visit(const ast::field_transformer_expr* e) override {
+		header(TAG_FIELD_TRANSFORMER, e);
+		write_str(m_out, e->transformer);
+		children(e->values);
+		write_opt_str(m_out, e->arg);
+	}
+
+private:
+	void header(node_tag tag, const ast::expr* e) {
+		m_out.push_back(static_cast<char>(tag));
+		write_u32(m_out, e->get_pos().idx);
+		write_u32(m_out, e->get_pos().line);
+		write_u32(m_out, e->get_pos().col);
+	}
+
+	void children(const std::vector<std::unique_ptr<ast::expr>>& c) {
+		write_u32(m_out, static_cast<uint32_t>(c.size()));
+		for(const auto& child : c) {
+			encode(child.get());
+		}
+	}
+
+	std::string& m_out;
+};
+
+std::unique_ptr<ast::expr> decode(reader& r, uint32_t depth);
+
+std::vector<std::unique_ptr<ast::expr>> decode_children(reader& r, uint32_t depth) {
+	const auto n = r.u32();
+	// every node takes at least its tag and position
+	r.need(static_cast<size_t>(n) * 13);
+	std::vector<std::unique_ptr<ast::expr>> res;
+	res.reserve(n);
+	for(uint32_t i = 0; i < n; i++) {
+		res.push_back(decode(r, depth));
+	}
+	return res;
+}
+
+std::unique_ptr<ast::expr> decode(reader& r, uint32_t depth) {
+	if(++depth > s_max_decode_depth) {
+		throw sinsp_exception("filter AST encoding is too deep");
+	}
+
+	const auto tag = r.u8();
+	ast::pos_info pos;
+	pos.idx = r.u32();
+	pos.line = r.u32();
+	pos.col = r.u32();
+
+	switch(tag) {
+	case TAG_AND: {
+		auto c = decode_children(r, depth);
+		return ast::and_expr::create(c, pos);
+	}
+	case TAG_OR: {
+		auto c = decode_children(r, depth);
+		return ast::or_expr::create(c, pos);
+	}
+	case TAG_NOT:
+		return ast::not_expr::create(decode(r, depth), pos);
+	case TAG_IDENTIFIER:
+		return ast::identifier_expr::create(r.str(), pos);
+	case TAG_VALUE:
+		return ast::value_expr::create(r.str(), pos);
+	case TAG_LIST: {
+		const auto n = r.u32();
+		r.need(static_cast<size_t>(n) * sizeof(uint32_t));
+		std::vector<std::string> values;
+		values.reserve(n);
+		for(uint32_t i = 0; i < n; i++) {
+			values.push_back(r.str());
+		}
+		return ast::list_expr::create(values, pos);
+	}
+	case TAG_TRANSFORMER_LIST: {
+		auto c = decode_children(r, depth);
+		return ast::transformer_list_expr::create(c, pos);
+	}
+	case TAG_UNARY_CHECK: {
+		auto left = decode(r, depth);
+		auto op = r.str();
+		return ast::unary_check_expr::create(std::move(left), op, pos);
+	}
+	case TAG_BINARY_CHECK: {
+		auto left = decode(r, depth);
+		auto op = r.str();
+		auto right = decode(r, depth);
+		return ast::binary_check_expr::create(std::move(left), op, std::move(right), pos);
+	}
+	case TAG_FIELD: {
+		auto field = r.str();
+		auto arg = r.opt_str();
+		return ast::field_expr::create(field, arg, pos);
+	}
+	case TAG_FIELD_TRANSFORMER: {
+		auto transformer = r.str();
+		auto values = decode_children(r, depth);
+		auto arg = r.opt_str();
+		return ast::field_transformer_expr::create(transformer, values, arg, pos);
+	}
+	default:
+		throw sinsp_exception("unknown filter AST node tag " + std::to_string(tag));
+	}
+}
+
+}  // namespace
+
+std::string libsinsp::filter::serialize_ast(const ast::expr* e) {
+	std::string res;
+	ast_encoder(res).encode(e);
+	return res;
+}
+
+std::unique_ptr<ast::expr> libsinsp::filter::deserialize_ast(std::string_view data) {
+	reader r{data};
+	auto res = decode(r, 0);
+	if(!r.data.empty()) {
+		throw sinsp_exception("trailing data after filter AST encoding");
+	}
+	return res;
+}
+
+ast_cache::ast_cache(const std::string& version): m_version(version) {}
+
+const ast::expr* ast_cache::get(const std::string& filter) {
+	auto it = m_entries.find(filter);
+	if(it != m_entries.end()) {
+		auto& e = it->second;
+		if(e.ast == nullptr) {
+			try {
+				e.ast = deserialize_ast(e.data);
+			} catch(const sinsp_exception&) {
+				// a broken entry is just parsed again
+			}
+		}
+		if(e.ast != nullptr) {
+			m_hits++;
+			return e.ast.get();
+		}
+	}
+
+	m_misses++;
+	parser p(filter);
+	std::unique_ptr<ast::expr> res;
+	try {
+		res = p.parse();
+	} catch(const sinsp_exception& e) {
+		throw sinsp_exception("filter error at " + p.get_pos().as_string() + ": " + e.what());
+	}
+
+	auto& e = m_entries[filter];
+	e.data = serialize_ast(res.get());
+	e.ast = std::move(res);
+	return e.ast.get();
+}
+
+bool ast_cache::load(const std::string& path) {
+	std::ifstream f(path, std::ios::binary);
+	if(!f) {
+		return false;
+	}
+	const std::string content{std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+
+	std::unordered_map<std::string, entry> entries;
+	try {
+		reader r{content};
+		r.need(sizeof(s_magic));
+		if(memcmp(r.data.data(), s_magic, sizeof(s_magic)) != 0) {
+			return false;
+		}
+		r.data.remove_prefix(sizeof(s_magic));
+		if(r.u32() != s_format_version || r.str() != m_version) {
+			return false;
+		}
+
+		const auto n = r.u32();
+		for(uint32_t i = 0; i < n; i++) {
+			auto filter = r.str();
+			entries[std::move(filter)].data = r.str();
+		}
+		if(!r.data.empty()) {
+			return false;
+		}
+	} catch(const sinsp_exception&) {
+		return false;
+	}
+
+	// entries already in use are kept as they are
+	m_entries.merge(entries);
+	return true;
+}
+
+bool ast_cache::save(const std::string& path) const {
+	std::string content(s_magic, sizeof(s_magic));
+	write_u32(content, s_format_version);
+	write_str(content, m_version);
+	write_u32(content, static_cast<uint32_t>(m_entries.size()));
+	for(const auto& [filter, e] : m_entries) {
+		write_str(content, filter);
+		write_str(content, e.data);
+	}
+
+	const auto tmp_path = path + ".tmp";
+	{
+		std::ofstream f(tmp_path, std::ios::binary | std::ios::trunc);
+		if(!f || !f.write(content.data(), content.size())) {
+			std::remove(tmp_path.c_str());
+			return false;
+		}
+	}
+	if(std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+		std::remove(tmp_path.c_str());
+		return false;
+	}
+	return true;
+}
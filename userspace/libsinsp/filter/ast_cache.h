@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <libsinsp/filter/ast.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace libsinsp {
+namespace filter {
+
+/*!
+    \brief Encodes an AST, positions included, in a compact binary form.
+*/
+std::string serialize_ast(const ast::expr* e);
+
+/*!
+    \brief Decodes an AST encoded with serialize_ast().
+    \note Throws a sinsp_exception if the input is not a valid encoding.
+*/
+std::unique_ptr<ast::expr> deserialize_ast(std::string_view data);
+
+/*!
+    \brief A cache of parsed filters that can be persisted to a file, so that
+    filters that don't change between restarts don't need to be parsed again.
+
+    Entries are keyed by the filter text. The file also stores a version string
+    provided by the user (for example the libsinsp version and the versions of
+    the loaded plugins) and it's discarded as a whole if the version doesn't
+    match. The ASTs loaded from file are decoded lazily, at their first use.
+    The ASTs only refer to fields by name, so they still need to be compiled
+    with sinsp_filter_compiler, which skips the parsing step.
+*/
+class SINSP_PUBLIC ast_cache {
+public:
+	explicit ast_cache(const std::string& version = "");
+
+	/*!
+	    \brief Returns the AST of the given filter, from the cache if present,
+	    otherwise parsing the filter and adding it to the cache. The AST is owned
+	    by the cache and lives as long as the cache.
+	    \note Throws a sinsp_exception in case of parsing errors.
+	*/
+	const ast::expr* get(const std::string& filter);
+
+	/*!
+	    \brief Adds to the cache the entries stored in the given file.
+	    \return false if the file doesn't exist, is corrupted or has been
+	    written with a different version, true otherwise.
+	*/
+	bool load(const std::string& path);
+
+	/*!
+	    \brief Writes the cache to the given file, replacing it atomically.
+	    \return false in case of errors, true otherwise.
+	*/
+	bool save(const std::string& path) const;
+
+	inline size_t size() const { return m_entries.size(); }
+
+	inline uint64_t hits() const { return m_hits; }
+
+	inline uint64_t misses() const { return m_misses; }
+
+private:
+	struct entry {
+		std::string data;
+		std::unique_ptr<ast::expr> ast;
+	};
+
+	std::string m_version;
+	std::unordered_map<std::string, entry> m_entries;
+	uint64_t m_hits = 0;
+	uint64_t m_misses = 0;
+};
+
+}  // namespace filter
+}  // namespace libsinsp
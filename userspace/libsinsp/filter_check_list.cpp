@@ -16,6 +16,7 @@ limitations under the License.
 
 */
 
+#include <algorithm>
 #include <cstdint>
 
 #include <libsinsp/sinsp.h>
@@ -49,31 +50,98 @@ void filter_check_list::add_filter_check(std::unique_ptr<sinsp_filter_check> fil
 	m_check_list.push_back(std::move(filter_check));
 }
 
+void filter_check_list::index_fields(uint32_t check) const {
+	const auto* info = m_check_list[check]->get_fields();
+	for(int32_t j = 0; j < info->m_nfields; j++) {
+		uint32_t node = 0;
+		for(const char c : info->m_fields[j].m_name) {
+			auto& children = m_field_index[node].children;
+			auto child = std::find_if(children.begin(), children.end(), [c](const auto& e) {
+				return e.first == c;
+			});
+			if(child != children.end()) {
+				node = child->second;
+				continue;
+			}
+			const auto next = static_cast<uint32_t>(m_field_index.size());
+			children.emplace_back(c, next);
+			m_field_index.emplace_back();
+			node = next;
+		}
+		// Checks are indexed in list order, so the first one to own a name keeps it.
+		if(m_field_index[node].check == s_no_check) {
+			m_field_index[node].check = check;
+		}
+	}
+}
+
+uint32_t filter_check_list::find_check(std::string_view name) const {
+	std::lock_guard<std::mutex> lock(m_field_index_mtx);
+	for(; m_indexed_checks < m_check_list.size(); m_indexed_checks++) {
+		index_fields(m_indexed_checks);
+	}
+
+	uint32_t res = s_no_check;
+	uint32_t node = 0;
+	for(const char c : name) {
+		const auto& children = m_field_index[node].children;
+		auto child = std::find_if(children.begin(), children.end(), [c](const auto& e) {
+			return e.first == c;
+		});
+		if(child == children.end()) {
+			break;
+		}
+		node = child->second;
+		res = std::min(res, m_field_index[node].check);
+	}
+	return res;
+}
+
 void filter_check_list::get_all_fields(std::vector<const filter_check_info*>& list) const {
 	for(const auto& chk : m_check_list) {
 		list.push_back(chk->get_fields());
 	}
 }
 
-/* Craft a new filter check from the field name */
 std::unique_ptr<sinsp_filter_check> filter_check_list::new_filter_check_from_fldname(
         std::string_view name,
         sinsp* inspector,
         bool do_exact_check) const {
-	for(const auto& chk : m_check_list) {
-		chk->m_inspector = inspector;
-
-		int32_t fldnamelen = chk->parse_field_name(name, false, true);
+	// The name is parsed by a new check rather than by the one in the list, so that the list is
+	// never modified here.
+	bool matched = false;
+	auto try_check = [&](sinsp_filter_check& chk) -> std::unique_ptr<sinsp_filter_check> {
+		auto newchk = chk.allocate_new();
+		newchk->set_inspector(inspector);
+
+		int32_t fldnamelen = newchk->parse_field_name(name, false, true);
+		if(fldnamelen == -1) {
+			return nullptr;
+		}
 
-		if(fldnamelen != -1) {
-			if(do_exact_check) {
-				if((int32_t)name.size() != fldnamelen) {
-					break;
-				}
-			}
+		matched = true;
+		if(do_exact_check && (int32_t)name.size() != fldnamelen) {
+			return nullptr;
+		}
+		return newchk;
+	};
+
+	// Most of the times the index gives us the right check straight away.
+	const auto check = find_check(name);
+	if(check != s_no_check) {
+		auto newchk = try_check(*m_check_list[check]);
+		if(matched) {
+			return newchk;
+		}
+	}
 
-			auto newchk = chk->allocate_new();
-			newchk->set_inspector(inspector);
+	// Otherwise, we ask every check in order, as some of them parse names in a custom way.
+	for(uint32_t i = 0; i < m_check_list.size(); i++) {
+		if(i == check) {
+			continue;
+		}
+		auto newchk = try_check(*m_check_list[i]);
+		if(matched) {
 			return newchk;
 		}
 	}
@@ -18,9 +18,13 @@ limitations under the License.
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 class sinsp_filter_check;
 class filter_check_info;
@@ -37,12 +41,41 @@ public:
 
 	void add_filter_check(std::unique_ptr<sinsp_filter_check> filter_check);
 	void get_all_fields(std::vector<const filter_check_info*>&) const;
+
+	/*!
+	  \brief Craft a new filter check from the field name.
+	  This doesn't modify the list, so it can be called from multiple threads at once, for
+	  example to compile independent filters in parallel, as long as no check is added
+	  meanwhile.
+	*/
 	std::unique_ptr<sinsp_filter_check> new_filter_check_from_fldname(std::string_view name,
 	                                                                  sinsp*,
 	                                                                  bool do_exact_check) const;
 
 protected:
 	std::vector<std::unique_ptr<sinsp_filter_check>> m_check_list;
+
+private:
+	static constexpr uint32_t s_no_check = UINT32_MAX;
+
+	// Prefix tree over the field names of all the checks in the list.
+	struct field_index_node {
+		std::vector<std::pair<char, uint32_t>> children;
+		// Position in m_check_list of the first check having exactly this field name.
+		uint32_t check = s_no_check;
+	};
+
+	void index_fields(uint32_t check) const;
+
+	// Returns the position of the first check having a field name that is a prefix of `name`,
+	// that is the first check that can parse it.
+	uint32_t find_check(std::string_view name) const;
+
+	// The index is built lazily at the first lookup, as many lists (e.g. the default one of
+	// every filter compiler) are never used to look up fields at all.
+	mutable std::mutex m_field_index_mtx;
+	mutable std::vector<field_index_node> m_field_index{1};
+	mutable uint32_t m_indexed_checks = 0;
 };
 
 //
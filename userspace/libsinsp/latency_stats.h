@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <driver/ppm_events_public.h>
+
+#include <array>
+#include <cstdint>
+
+namespace libsinsp {
+
+/*!
+  \brief Log-linear (HDR-style) histogram of nanosecond values.
+
+  Every power of 2 is split into 2^SUB_BUCKET_BITS linear sub-buckets, so any
+  recorded value is reported with a relative error below 1/2^SUB_BUCKET_BITS
+  (12.5%), with a fixed memory footprint and no allocation. Recording a value
+  is a handful of integer operations.
+*/
+class latency_histogram {
+public:
+	static constexpr uint32_t SUB_BUCKET_BITS = 3;
+	static constexpr uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static constexpr uint32_t N_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+	inline void record(uint64_t value) {
+		m_buckets[bucket_index(value)]++;
+		m_count++;
+		if(value > m_max) {
+			m_max = value;
+		}
+	}
+
+	inline uint64_t count() const { return m_count; }
+	inline uint64_t max() const { return m_max; }
+
+	/*!
+	  \brief Returns the upper bound of the bucket containing the value at
+	  quantile `q` (in [0, 1]), never more than the max recorded value.
+	*/
+	uint64_t percentile(double q) const {
+		if(m_count == 0) {
+			return 0;
+		}
+		uint64_t rank = static_cast<uint64_t>(q * m_count);
+		if(rank >= m_count) {
+			rank = m_count - 1;
+		}
+		uint64_t seen = 0;
+		for(uint32_t i = 0; i < N_BUCKETS; i++) {
+			seen += m_buckets[i];
+			if(seen > rank) {
+				uint64_t upper = bucket_upper_bound(i);
+				return upper < m_max ? upper : m_max;
+			}
+		}
+		return m_max;
+	}
+
+	void reset() {
+		m_buckets.fill(0);
+		m_count = 0;
+		m_max = 0;
+	}
+
+	static inline uint32_t bucket_index(uint64_t value) {
+		if(value < SUB_BUCKETS) {
+			return static_cast<uint32_t>(value);
+		}
+		uint32_t msb = highest_bit(value);
+		uint32_t shift = msb - SUB_BUCKET_BITS;
+		uint32_t sub = static_cast<uint32_t>(value >> shift) & (SUB_BUCKETS - 1);
+		return ((shift + 1) << SUB_BUCKET_BITS) + sub;
+	}
+
+	static inline uint64_t bucket_upper_bound(uint32_t index) {
+		if(index < SUB_BUCKETS) {
+			return index;
+		}
+		uint32_t shift = (index >> SUB_BUCKET_BITS) - 1;
+		uint64_t sub = index & (SUB_BUCKETS - 1);
+		return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+	}
+
+private:
+	static inline uint32_t highest_bit(uint64_t value) {
+		uint32_t bit = 0;
+		for(uint32_t step = 32; step > 0; step >>= 1) {
+			if(value >> step) {
+				value >>= step;
+				bit += step;
+			}
+		}
+		return bit;
+	}
+
+	std::array<uint64_t, N_BUCKETS> m_buckets{};
+	uint64_t m_count = 0;
+	uint64_t m_max = 0;
+};
+
+/*!
+  \brief Latency of the events returned by sinsp::next(): age of the event
+  when it is delivered (wall clock minus event timestamp, only for live
+  captures) per event category, and duration of the next() call.
+*/
+class latency_stats {
+public:
+	enum category : uint8_t {
+		CAT_FILE = 0,
+		CAT_NET,
+		CAT_IPC,
+		CAT_MEMORY,
+		CAT_PROCESS,
+		CAT_IO,
+		CAT_OTHER,
+		CAT_MAX,
+	};
+
+	static constexpr const char* category_name(category cat) {
+		constexpr const char* names[] = {"file", "net", "ipc", "memory", "process", "io", "other"};
+		return names[cat];
+	}
+
+	static inline category from_event_category(uint32_t ppm_category) {
+		if(ppm_category & EC_IO_BASE) {
+			return CAT_IO;
+		}
+		switch(ppm_category & (EC_IO_BASE - 1)) {
+		case EC_FILE:
+			return CAT_FILE;
+		case EC_NET:
+			return CAT_NET;
+		case EC_IPC:
+			return CAT_IPC;
+		case EC_MEMORY:
+			return CAT_MEMORY;
+		case EC_PROCESS:
+			return CAT_PROCESS;
+		default:
+			return CAT_OTHER;
+		}
+	}
+
+	inline void record_delivery(uint32_t ppm_category, uint64_t age_ns) {
+		m_delivery[from_event_category(ppm_category)].record(age_ns);
+	}
+
+	inline void record_next_duration(uint64_t duration_ns) { m_next_duration.record(duration_ns); }
+
+	const latency_histogram& delivery(category cat) const { return m_delivery[cat]; }
+	const latency_histogram& next_duration() const { return m_next_duration; }
+
+	void reset() {
+		for(auto& h : m_delivery) {
+			h.reset();
+		}
+		m_next_duration.reset();
+	}
+
+private:
+	std::array<latency_histogram, CAT_MAX> m_delivery;
+	latency_histogram m_next_duration;
+};
+
+}  // namespace libsinsp
@@ -267,6 +267,54 @@ libs_state_counters::libs_state_counters(const std::shared_ptr<sinsp_stats_v2>&
 	}
 }
 
+// For each non-empty histogram: `<prefix>_count`, `<prefix>_p50_ns`, `<prefix>_p99_ns` and
+// `<prefix>_max_ns`.
+static void push_latency_histogram(std::vector<metrics_v2>& metrics,
+                                   const std::string& prefix,
+                                   const libsinsp::latency_histogram& histogram) {
+	if(histogram.count() == 0) {
+		return;
+	}
+	metrics.emplace_back(libsinsp_metrics::new_metric((prefix + "_count").c_str(),
+	                                                  METRICS_V2_LATENCY,
+	                                                  METRIC_VALUE_TYPE_U64,
+	                                                  METRIC_VALUE_UNIT_COUNT,
+	                                                  METRIC_VALUE_METRIC_TYPE_MONOTONIC,
+	                                                  histogram.count()));
+	const std::pair<const char*, uint64_t> values[] = {
+	        {"_p50_ns", histogram.percentile(0.50)},
+	        {"_p99_ns", histogram.percentile(0.99)},
+	        {"_max_ns", histogram.max()},
+	};
+	for(const auto& [suffix, value] : values) {
+		metrics.emplace_back(
+		        libsinsp_metrics::new_metric((prefix + suffix).c_str(),
+		                                     METRICS_V2_LATENCY,
+		                                     METRIC_VALUE_TYPE_U64,
+		                                     METRIC_VALUE_UNIT_TIME_NS,
+		                                     METRIC_VALUE_METRIC_TYPE_NON_MONOTONIC_CURRENT,
+		                                     value));
+	}
+}
+
+std::vector<metrics_v2> libs_latency_metrics::to_metrics() {
+	std::vector<metrics_v2> metrics;
+	if(m_latency_stats == nullptr) {
+		return metrics;
+	}
+
+	for(uint8_t cat = 0; cat < libsinsp::latency_stats::CAT_MAX; cat++) {
+		const auto category = static_cast<libsinsp::latency_stats::category>(cat);
+		push_latency_histogram(
+		        metrics,
+		        std::string("evt_delivery_latency_") +
+		                libsinsp::latency_stats::category_name(category),
+		        m_latency_stats->delivery(category));
+	}
+	push_latency_histogram(metrics, "next_duration", m_latency_stats->next_duration());
+	return metrics;
+}
+
 std::vector<metrics_v2> libs_state_counters::to_metrics() {
 	std::vector<metrics_v2> metrics;
 
@@ -317,6 +365,12 @@ std::vector<metrics_v2> libs_state_counters::to_metrics() {
 	                                METRIC_VALUE_UNIT_COUNT,
 	                                METRIC_VALUE_METRIC_TYPE_MONOTONIC,
 	                                m_sinsp_stats_v2->m_n_removed_fds));
+	metrics.emplace_back(new_metric("n_evicted_fds",
+	                                METRICS_V2_STATE_COUNTERS,
+	                                METRIC_VALUE_TYPE_U64,
+	                                METRIC_VALUE_UNIT_COUNT,
+	                                METRIC_VALUE_METRIC_TYPE_MONOTONIC,
+	                                m_sinsp_stats_v2->m_n_evicted_fds));
 	metrics.emplace_back(new_metric("n_stored_evts",
 	                                METRICS_V2_STATE_COUNTERS,
 	                                METRIC_VALUE_TYPE_U64,
@@ -371,6 +425,12 @@ std::vector<metrics_v2> libs_state_counters::to_metrics() {
 	                                METRIC_VALUE_UNIT_COUNT,
 	                                METRIC_VALUE_METRIC_TYPE_MONOTONIC,
 	                                m_sinsp_stats_v2->m_n_removed_threads));
+	metrics.emplace_back(new_metric("n_evicted_threads",
+	                                METRICS_V2_STATE_COUNTERS,
+	                                METRIC_VALUE_TYPE_U64,
+	                                METRIC_VALUE_UNIT_COUNT,
+	                                METRIC_VALUE_METRIC_TYPE_MONOTONIC,
+	                                m_sinsp_stats_v2->m_n_evicted_threads));
 	metrics.emplace_back(new_metric("n_drops_full_threadtable",
 	                                METRICS_V2_STATE_COUNTERS,
 	                                METRIC_VALUE_TYPE_U32,
@@ -393,7 +453,8 @@ void libs_metrics_collector::snapshot() {
 	if((m_metrics_flags & METRICS_V2_KERNEL_COUNTERS) ||
 	   (m_metrics_flags & METRICS_V2_LIBBPF_STATS) ||
 	   (m_metrics_flags & METRICS_V2_KERNEL_COUNTERS_PER_CPU) ||
-	   (m_metrics_flags & METRICS_V2_KERNEL_ITER_COUNTERS)) {
+	   (m_metrics_flags & METRICS_V2_KERNEL_ITER_COUNTERS) ||
+	   (m_metrics_flags & METRICS_V2_KERNEL_BUFFERS)) {
 		uint32_t nstats = 0;
 		int32_t rc = 0;
 		// libscap metrics: m_metrics_flags are pushed down from consumers' input,
@@ -428,6 +489,12 @@ void libs_metrics_collector::snapshot() {
 		m_metrics.insert(m_metrics.end(), sc_metrics.begin(), sc_metrics.end());
 	}
 
+	if((m_metrics_flags & METRICS_V2_LATENCY)) {
+		libs_latency_metrics latency_metrics(m_inspector->get_latency_stats());
+		std::vector<metrics_v2> lat_metrics = latency_metrics.to_metrics();
+		m_metrics.insert(m_metrics.end(), lat_metrics.begin(), lat_metrics.end());
+	}
+
 	/*
 	 * plugins metrics
 	 */
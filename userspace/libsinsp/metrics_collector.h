@@ -21,6 +21,7 @@ limitations under the License.
 #include <libscap/metrics_v2.h>
 #include <libscap/scap_machine_info.h>
 #include <libsinsp/thread_manager.h>
+#include <libsinsp/latency_stats.h>
 #include <libscap/strl.h>
 #include <cmath>
 #include <memory>
@@ -36,6 +37,7 @@ struct sinsp_stats_v2 {
 	uint64_t m_n_failed_fd_lookups;
 	uint64_t m_n_added_fds;
 	uint64_t m_n_removed_fds;
+	uint64_t m_n_evicted_fds;
 	///@)
 	///@(
 	/** evt parsing related counters, unit: count. */
@@ -51,6 +53,7 @@ struct sinsp_stats_v2 {
 	uint64_t m_n_failed_thread_lookups;
 	uint64_t m_n_added_threads;
 	uint64_t m_n_removed_threads;
+	uint64_t m_n_evicted_threads;
 	///@)
 	uint32_t m_n_drops_full_threadtable;  ///< Number of drops due to full threadtable, unit: count.
 };
@@ -308,6 +311,17 @@ private:
 	                       ///< table, unit: count.
 };
 
+class libs_latency_metrics : libsinsp_metrics {
+public:
+	libs_latency_metrics(const libsinsp::latency_stats* latency_stats):
+	        m_latency_stats(latency_stats) {}
+
+	std::vector<metrics_v2> to_metrics() override;
+
+private:
+	const libsinsp::latency_stats* m_latency_stats;
+};
+
 class libs_metrics_collector {
 public:
 	libs_metrics_collector(sinsp* inspector, uint32_t flags);
@@ -304,6 +304,9 @@ void sinsp_parser::process_event(sinsp_evt &evt, sinsp_parser_verdict &verdict)
 	case PPME_SYSCALL_PRCTL_X:
 		parse_prctl_exit(evt);
 		break;
+	case PPME_IO_SUMMARY_E:
+		parse_io_summary(evt);
+		break;
 	default:
 		break;
 	}
@@ -450,6 +453,14 @@ bool sinsp_parser::reset(sinsp_evt &evt) const {
 		tinfo->m_flags |= PPM_CL_ACTIVE;
 	}
 
+	// The I/O summaries are sent in between the syscalls of the thread, so unlike the other enter
+	// events using fds they must not change the last event type used to pair enter/exit events.
+	if(etype == PPME_IO_SUMMARY_E) {
+		tinfo->m_lastevent_fd = evt.get_param(0)->as<int64_t>();
+		evt.set_fd_info(tinfo->get_fd(tinfo->m_lastevent_fd));
+		return evt.get_fd_info() != nullptr;
+	}
+
 	// todo!: at the end of we work we should remove the enter/exit distinction and ideally we
 	//   should set the fdinfos directly here and return if they are not present.
 	if(PPME_IS_ENTER(etype)) {
@@ -1790,8 +1801,9 @@ void sinsp_parser::parse_execve_exit(sinsp_evt &evt, sinsp_parser_verdict &verdi
 	 * we still have some not leader threads in the group.
 	 */
 	if(evt.get_tinfo()->m_tginfo != nullptr && evt.get_tinfo()->m_tginfo->get_thread_count() > 1) {
-		for(const auto &thread : evt.get_tinfo()->m_tginfo->get_thread_list()) {
-			auto thread_ptr = thread.lock().get();
+		/* Removing a thread unlinks it from the thread list, so we collect the tids first. */
+		std::vector<int64_t> tids_to_remove;
+		for(auto thread_ptr : evt.get_tinfo()->m_tginfo->get_thread_list()) {
 			/* we don't want to remove the main thread since it is the one
 			 * running in this parser!
 			 *
@@ -1804,11 +1816,13 @@ void sinsp_parser::parse_execve_exit(sinsp_evt &evt, sinsp_parser_verdict &verdi
 			 *
 			 * To handle such cases gracefully, keep the event thread.
 			 */
-			if(thread_ptr == nullptr || thread_ptr->is_main_thread() ||
-			   thread_ptr->m_tid == evt.get_tinfo()->m_tid) {
+			if(thread_ptr->is_main_thread() || thread_ptr->m_tid == evt.get_tinfo()->m_tid) {
 				continue;
 			}
-			m_thread_manager->remove_thread(thread_ptr->m_tid);
+			tids_to_remove.push_back(thread_ptr->m_tid);
+		}
+		for(auto tid : tids_to_remove) {
+			m_thread_manager->remove_thread(tid);
 		}
 	}
 }
@@ -2886,7 +2900,7 @@ void sinsp_parser::parse_thread_exit(sinsp_evt &evt, sinsp_parser_verdict &verdi
 	/* If this thread has no children we don't send the reaper info from the kernel,
 	 * so we do nothing.
 	 */
-	if(evt.get_tinfo()->m_children.size() == 0) {
+	if(evt.get_tinfo()->get_children().empty()) {
 		return;
 	}
 
@@ -3971,6 +3985,23 @@ void sinsp_parser::parse_cpu_hotplug_enter(sinsp_evt &evt) const {
 	}
 }
 
+void sinsp_parser::parse_io_summary(sinsp_evt &evt) {
+	auto *fdinfo = evt.get_fd_info();
+	if(fdinfo == nullptr) {
+		return;
+	}
+
+	const auto count = evt.get_param(2)->as<uint64_t>();
+	const auto bytes = evt.get_param(3)->as<uint64_t>();
+	if(evt.get_param(1)->as<uint8_t>() == PPM_IO_SUMMARY_IN) {
+		fdinfo->m_summarized_reads += count;
+		fdinfo->m_summarized_read_bytes += bytes;
+	} else {
+		fdinfo->m_summarized_writes += count;
+		fdinfo->m_summarized_write_bytes += bytes;
+	}
+}
+
 void sinsp_parser::parse_prctl_exit(sinsp_evt &evt) {
 	if(evt.get_syscall_return_value() < 0) {
 		// We are not interested in parsing something if the syscall fails.
@@ -134,6 +134,7 @@ private:
 	void parse_getsockopt_exit(sinsp_evt& evt, sinsp_parser_verdict& verdict) const;
 	static void parse_capset_exit(sinsp_evt& evt);
 	static void parse_unshare_setns_exit(sinsp_evt& evt);
+	static void parse_io_summary(sinsp_evt& evt);
 
 	// Set the event thread user to the user corresponding to the effective user id taken from the
 	// provided parameter. This is no-op if there is no thread associated with the provided event
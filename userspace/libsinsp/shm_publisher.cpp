@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/scap_config.h>
+#include <libsinsp/sinsp.h>
+#include <libsinsp/sinsp_int.h>
+#include <libsinsp/shm_publisher.h>
+#include <libscap/scap.h>
+
+sinsp_shm_publisher::~sinsp_shm_publisher() {
+	close();
+}
+
+void sinsp_shm_publisher::open(sinsp* inspector,
+                               const std::string& name,
+                               uint64_t buffer_size,
+                               uint64_t state_size,
+                               uint64_t state_interval_ns) {
+#ifdef HAS_ENGINE_SHM
+	char error[SCAP_LASTERR_SIZE];
+	if(inspector->get_scap_handle() == NULL) {
+		throw sinsp_exception("can't start publishing events, inspector not opened yet");
+	}
+
+	close();
+
+	m_producer = scap_shm_producer_open(name.c_str(),
+	                                    buffer_size,
+	                                    state_size,
+	                                    inspector->get_machine_info(),
+	                                    error);
+	if(m_producer == nullptr) {
+		throw sinsp_exception(error);
+	}
+
+	m_inspector = inspector;
+	m_state_interval_ns = state_interval_ns;
+	m_last_state_ts = 0;
+	m_nevts = 0;
+	publish_state();
+#else
+	throw sinsp_exception("SHM engine is not supported in this build");
+#endif
+}
+
+void sinsp_shm_publisher::close() {
+#ifdef HAS_ENGINE_SHM
+	if(m_producer != nullptr) {
+		scap_shm_producer_close(m_producer);
+		m_producer = nullptr;
+	}
+#endif
+}
+
+void sinsp_shm_publisher::publish(sinsp_evt* evt) {
+#ifdef HAS_ENGINE_SHM
+	char error[SCAP_LASTERR_SIZE];
+	if(m_producer == nullptr) {
+		throw sinsp_exception("shm publisher not opened yet");
+	}
+
+	if(scap_shm_producer_write(m_producer, evt->get_scap_evt(), evt->get_cpuid(), error) !=
+	   SCAP_SUCCESS) {
+		throw sinsp_exception(error);
+	}
+	m_nevts++;
+
+	// The snapshot follows the event, so consumers starting from it see the
+	// state the event left behind.
+	uint64_t ts = evt->get_ts();
+	if(ts - m_last_state_ts >= m_state_interval_ns || ts < m_last_state_ts) {
+		publish_state();
+		m_last_state_ts = ts;
+	}
+#endif
+}
+
+void sinsp_shm_publisher::publish_state() {
+#ifdef HAS_ENGINE_SHM
+	char error[SCAP_LASTERR_SIZE];
+	if(m_producer == nullptr) {
+		throw sinsp_exception("shm publisher not opened yet");
+	}
+
+	int32_t res = SCAP_SUCCESS;
+	scap_shm_producer_state_begin(m_producer);
+	m_inspector->m_thread_manager->threads_to_scap(
+	        [&](const scap_threadinfo& tinfo, const std::vector<scap_fdinfo>& fdinfos) {
+		        res = scap_shm_producer_state_add(m_producer,
+		                                          &tinfo,
+		                                          fdinfos.data(),
+		                                          fdinfos.size(),
+		                                          error);
+		        return res == SCAP_SUCCESS;
+	        });
+
+	if(res == SCAP_SUCCESS) {
+		res = scap_shm_producer_state_commit(m_producer, error);
+	}
+
+	// Consumers keep using the previous snapshot, that is only stale.
+	if(res != SCAP_SUCCESS) {
+		libsinsp_logger()->format(sinsp_logger::SEV_WARNING,
+		                          "unable to publish shm state snapshot: %s",
+		                          error);
+	}
+#endif
+}
+
+uint64_t sinsp_shm_publisher::published_events() const {
+	return m_nevts;
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+class sinsp;
+class sinsp_evt;
+
+#include <cstdint>
+#include <string>
+
+struct scap_shm_producer;
+
+/*!
+  \brief Publishes the events of an inspector to a shared memory ring, so that
+  other processes on the same host can consume them with `sinsp::open_shm()`
+  instead of opening their own driver instance.
+
+  Consumers get a copy of the thread and fd tables of the publishing
+  inspector, refreshed every `state_interval_ns` of event time, and start from
+  the first event after it.
+*/
+class SINSP_PUBLIC sinsp_shm_publisher {
+public:
+	static constexpr uint64_t DEFAULT_STATE_INTERVAL_NS = 1000000000;
+
+	sinsp_shm_publisher() = default;
+	~sinsp_shm_publisher();
+
+	sinsp_shm_publisher(const sinsp_shm_publisher&) = delete;
+	sinsp_shm_publisher& operator=(const sinsp_shm_publisher&) = delete;
+
+	/*!
+	  \brief Creates the shared memory object and publishes a first snapshot of
+	  the inspector state.
+
+	  \param inspector Pointer to the inspector whose events are published.
+	  \param name Name of the shared memory object, in the "/<name>" form.
+	  \param buffer_size Size of the event ring, 0 for the default.
+	  \param state_size Maximum size of the state snapshot, 0 for the default.
+	  \param state_interval_ns Event time between two snapshots.
+	*/
+	void open(sinsp* inspector,
+	          const std::string& name,
+	          uint64_t buffer_size = 0,
+	          uint64_t state_size = 0,
+	          uint64_t state_interval_ns = DEFAULT_STATE_INTERVAL_NS);
+
+	/*!
+	  \brief Marks the stream as ended for the consumers and removes the
+	  shared memory object.
+	*/
+	void close();
+
+	bool is_open() const { return m_producer != nullptr; }
+
+	/*!
+	  \brief Publishes an event returned by the inspector. Events must be
+	  published in the order they are returned by `sinsp::next()`, after they
+	  have been parsed.
+	*/
+	void publish(sinsp_evt* evt);
+
+	/*!
+	  \brief Rewrites the state snapshot right away.
+	*/
+	void publish_state();
+
+	/*!
+	  \brief Return the number of events published so far.
+	*/
+	uint64_t published_events() const;
+
+private:
+	sinsp* m_inspector = nullptr;
+	scap_shm_producer* m_producer = nullptr;
+	uint64_t m_state_interval_ns = DEFAULT_STATE_INTERVAL_NS;
+	uint64_t m_last_state_ts = 0;
+	uint64_t m_nevts = 0;
+};
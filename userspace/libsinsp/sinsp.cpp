@@ -38,6 +38,7 @@ limitations under the License.
 #include <sys/time.h>
 #endif  // _WIN32
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
@@ -172,6 +173,7 @@ sinsp::sinsp(bool with_metrics):
         m_fdtable_ctor_params{std::make_shared<sinsp_fdtable::ctor_params>(
                 sinsp_fdtable::ctor_params{m_mode,
                                            s_max_fdtable_size,
+                                           m_lru_eviction,
                                            m_fdinfo_factory,
                                            m_input_plugin,
                                            m_sinsp_stats_v2,
@@ -463,10 +465,15 @@ void sinsp::open_common(scap_open_args* oargs,
 	/* We need to save the actual mode and the engine used by the inspector. */
 	m_mode = mode;
 
+	/* Only the platform allocated for this open tells whether it skips the /proc scan. */
+	const bool restore_state_snapshot = m_restore_state_snapshot;
+	m_restore_state_snapshot = false;
+
 	oargs->import_users = m_usergroup_manager->m_import_users;
 	oargs->log_fn = &sinsp_scap_log_fn;
 	oargs->proc_scan_timeout_ms = m_proc_scan_timeout_ms;
 	oargs->proc_scan_log_interval_ms = m_proc_scan_log_interval_ms;
+	oargs->io_fd_type_mask = m_io_fd_type_mask;
 
 	m_h = scap_alloc();
 	if(m_h == nullptr) {
@@ -500,8 +507,24 @@ void sinsp::open_common(scap_open_args* oargs,
 		throw scap_open_exception(m_platform_lasterr, scap_rc);
 	}
 
+	// The platform skipped the /proc scan: load the thread table from the
+	// snapshot, or fall back to the scan if that's not possible.
+	std::vector<std::unique_ptr<sinsp_evt>> state_evts;
+	if(restore_state_snapshot && !load_state_snapshot(state_evts)) {
+		scap_rc = scap_refresh_proc_table(platform);
+		if(scap_rc != SCAP_SUCCESS) {
+			throw scap_open_exception(m_platform_lasterr, scap_rc);
+		}
+	}
+
 	init();
 
+	replay_state_snapshot(state_evts);
+
+	if(is_live()) {
+		push_suppression_to_engine();
+	}
+
 	// enable generation of async meta-events for all loaded plugins supporting
 	// that capability. Meta-events are considered only during live captures,
 	// because offline captures will have the async events already encoded
@@ -572,6 +595,8 @@ void sinsp::open_kmod(unsigned long driver_buffer_bytes_dim,
 	/* Engine-specific args. */
 	scap_kmod_engine_params params;
 	params.buffer_bytes_dim = driver_buffer_bytes_dim;
+	params.spill_buffer_bytes_dim = m_spill_buffer_bytes_dim;
+	params.spill_buffer_max_bytes_dim = m_spill_buffer_max_bytes_dim;
 	oargs.engine_params = &params;
 
 	scap_platform* platform = scap_linux_alloc_platform({::on_proc_table_refresh_start,
@@ -581,6 +606,8 @@ void sinsp::open_kmod(unsigned long driver_buffer_bytes_dim,
 	if(platform) {
 		auto linux_plat = (scap_linux_platform*)platform;
 		linux_plat->m_linux_vtable = &scap_kmod_linux_vtable;
+		linux_plat->m_skip_proc_scan = !m_state_snapshot_path.empty();
+		m_restore_state_snapshot = linux_plat->m_skip_proc_scan;
 	}
 
 	try_open_common(&oargs, &scap_kmod_engine, platform, SINSP_MODE_LIVE);
@@ -597,11 +624,13 @@ void sinsp::open_nodriver(bool full_proc_scan) {
 	                                                     ::on_new_entry_from_proc,
 	                                                     this});
 	if(platform) {
+		auto linux_plat = (scap_linux_platform*)platform;
 		if(!full_proc_scan) {
-			auto linux_plat = (scap_linux_platform*)platform;
 			linux_plat->m_fd_lookup_limit = SCAP_NODRIVER_MAX_FD_LOOKUP;
 			linux_plat->m_minimal_scan = true;
 		}
+		linux_plat->m_skip_proc_scan = !m_state_snapshot_path.empty();
+		m_restore_state_snapshot = linux_plat->m_skip_proc_scan;
 	} else {
 		platform = scap_generic_alloc_platform({::on_proc_table_refresh_start,
 		                                        ::on_proc_table_refresh_end,
@@ -647,6 +676,9 @@ void sinsp::open_savefile(const std::string& filename, int fd) {
 
 	params.start_offset = 0;
 	params.fbuffer_size = 0;
+	params.replay_speed = m_savefile_replay_speed;
+	params.replay_evts_per_sec = m_savefile_replay_evts_per_sec;
+	params.replay_rebase_ts = m_savefile_replay_rebase_ts;
 	oargs.engine_params = &params;
 
 	scap_platform* platform = scap_savefile_alloc_platform({::on_proc_table_refresh_start,
@@ -719,6 +751,14 @@ void sinsp::open_modern_bpf(unsigned long driver_buffer_bytes_dim,
 	params.cpus_for_each_buffer = cpus_for_each_buffer;
 	params.allocate_online_only = online_only;
 	params.disable_iterators = disable_iterators;
+	params.spill_buffer_bytes_dim = m_spill_buffer_bytes_dim;
+	params.spill_buffer_max_bytes_dim = m_spill_buffer_max_bytes_dim;
+	params.rate_limit_rate = m_rate_limit_rate;
+	params.rate_limit_burst = m_rate_limit_burst;
+	params.io_aggregation_interval_ms = m_io_aggregation_interval_ms;
+	params.buffers_autotune_path = m_modern_bpf_buffers_autotune_path.empty()
+	                                       ? nullptr
+	                                       : m_modern_bpf_buffers_autotune_path.c_str();
 	oargs.engine_params = &params;
 
 	scap_platform* platform = scap_linux_alloc_platform({::on_proc_table_refresh_start,
@@ -728,6 +768,8 @@ void sinsp::open_modern_bpf(unsigned long driver_buffer_bytes_dim,
 	if(platform) {
 		auto* const linux_platform = reinterpret_cast<scap_linux_platform*>(platform);
 		linux_platform->m_linux_vtable = &scap_modern_bpf_linux_vtable;
+		linux_platform->m_skip_proc_scan = !m_state_snapshot_path.empty();
+		m_restore_state_snapshot = linux_platform->m_skip_proc_scan;
 	}
 
 	try_open_common(&oargs, &scap_modern_bpf_engine, platform, SINSP_MODE_LIVE);
@@ -768,6 +810,44 @@ void sinsp::open_test_input(scap_test_input_data* data, sinsp_mode_t mode) {
 #endif
 }
 
+void sinsp::open_synthetic(const scap_synthetic_engine_params& params) {
+#ifdef HAS_ENGINE_SYNTHETIC
+	scap_open_args oargs{};
+	scap_synthetic_engine_params engine_params = params;
+	oargs.engine_params = &engine_params;
+
+	scap_platform* platform = scap_generic_alloc_platform({::on_proc_table_refresh_start,
+	                                                      ::on_proc_table_refresh_end,
+	                                                      ::on_new_entry_from_proc,
+	                                                      this});
+	try_open_common(&oargs, &scap_synthetic_engine, platform, SINSP_MODE_TEST);
+
+	set_get_procs_cpu_from_driver(false);
+#else
+	throw sinsp_exception("SYNTHETIC engine is not supported in this build");
+#endif
+}
+
+void sinsp::open_shm(const std::string& name) {
+#ifdef HAS_ENGINE_SHM
+	scap_open_args oargs{};
+	scap_shm_engine_params params;
+	params.name = name.c_str();
+	oargs.engine_params = &params;
+
+	// The thread table comes from the publisher's snapshot, not from /proc.
+	scap_platform* platform = scap_shm_alloc_platform({::on_proc_table_refresh_start,
+	                                                  ::on_proc_table_refresh_end,
+	                                                  ::on_new_entry_from_proc,
+	                                                  this});
+	try_open_common(&oargs, &scap_shm_engine, platform, SINSP_MODE_LIVE);
+
+	set_get_procs_cpu_from_driver(false);
+#else
+	throw sinsp_exception("SHM engine is not supported in this build");
+#endif
+}
+
 /*=============================== OPEN METHODS ===============================*/
 
 /*=============================== Engine related ===============================*/
@@ -1192,6 +1272,114 @@ void sinsp::import_user_list() {
 	}
 }
 
+bool sinsp::load_state_snapshot(std::vector<std::unique_ptr<sinsp_evt>>& state_evts) {
+#ifdef HAS_ENGINE_SAVEFILE
+	scap_open_args oargs{};
+	scap_savefile_engine_params params{};
+	params.fname = m_state_snapshot_path.c_str();
+	oargs.engine_params = &params;
+	oargs.log_fn = &sinsp_scap_log_fn;
+
+	// The snapshot is read with a handle of its own, the threads it contains
+	// go through the same callbacks as the ones found by a /proc scan.
+	scap_platform* platform = scap_savefile_alloc_platform({::on_proc_table_refresh_start,
+	                                                        ::on_proc_table_refresh_end,
+	                                                        ::on_new_entry_from_proc,
+	                                                        this});
+	params.platform = platform;
+	scap_t* h = platform != nullptr ? scap_alloc() : nullptr;
+	if(h == nullptr || scap_init(h, &oargs, &scap_savefile_engine) != SCAP_SUCCESS) {
+		libsinsp_logger()->format(sinsp_logger::SEV_WARNING,
+		                          "unable to restore the state snapshot %s: %s, scanning /proc",
+		                          m_state_snapshot_path.c_str(),
+		                          h != nullptr ? scap_getlasterr(h) : "allocation failure");
+		scap_close(h);
+		scap_platform_close(platform);
+		scap_platform_free(platform);
+		m_thread_manager->clear();
+		return false;
+	}
+
+	// Users, groups and async plugin state are stored as events, they are
+	// parsed once the inspector is initialized.
+	scap_evt* pevent;
+	uint16_t cpuid;
+	uint32_t flags;
+	while(scap_next(h, &pevent, &cpuid, &flags) == SCAP_SUCCESS) {
+		if(!is_initialstate_event(*pevent)) {
+			continue;
+		}
+		std::unique_ptr<uint8_t[]> buf(new uint8_t[pevent->len]);
+		memcpy(buf.get(), pevent, pevent->len);
+		state_evts.push_back(sinsp_evt::from_scap_evt(std::move(buf)));
+		state_evts.back()->set_cpuid(cpuid);
+	}
+
+	scap_close(h);
+	scap_platform_close(platform);
+	scap_platform_free(platform);
+
+	// Lightweight reconciliation with /proc: drop the threads that exited, or
+	// whose tid got reused by another command, since the snapshot was taken.
+	std::vector<int64_t> to_remove;
+	m_thread_manager->get_threads()->loop([&](sinsp_threadinfo& tinfo) {
+		if(!scap_is_thread_alive(m_platform, tinfo.m_pid, tinfo.m_tid, tinfo.m_comm.c_str())) {
+			to_remove.push_back(tinfo.m_tid);
+		}
+		return true;
+	});
+	for(const auto tid : to_remove) {
+		m_thread_manager->remove_thread(tid);
+	}
+
+	libsinsp_logger()->format(sinsp_logger::SEV_INFO,
+	                          "restored %u threads from the state snapshot %s, %zu exited since",
+	                          m_thread_manager->get_thread_count(),
+	                          m_state_snapshot_path.c_str(),
+	                          to_remove.size());
+	return true;
+#else
+	return false;
+#endif
+}
+
+void sinsp::replay_state_snapshot(const std::vector<std::unique_ptr<sinsp_evt>>& state_evts) {
+	if(state_evts.empty()) {
+		return;
+	}
+
+	sinsp_evt* evt;
+	for(const auto& state_evt : state_evts) {
+		m_replay_scap_evt = state_evt->get_scap_evt();
+		m_replay_scap_cpuid = state_evt->get_cpuid();
+		m_replay_scap_flags = 0;
+		next(&evt);
+	}
+
+	// The restored state doesn't count as captured events.
+	m_nevts = 0;
+	m_firstevent_ts = 0;
+}
+
+void sinsp::save_state_snapshot(const std::string& path) {
+	// Write aside and rename, so that a crash never leaves a truncated snapshot.
+	const std::string tmp_path = path + ".tmp";
+	try {
+		sinsp_dumper dumper;
+		dumper.open(this, tmp_path, false);
+		dumper.close();
+	} catch(...) {
+		std::remove(tmp_path.c_str());
+		throw;
+	}
+
+	if(std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+		std::string error = "unable to write the state snapshot " + path + ": " + strerror(errno);
+		std::remove(tmp_path.c_str());
+		throw sinsp_exception(error);
+	}
+}
+
 void sinsp::refresh_ifaddr_list() {
 #if !defined(_WIN32)
 	if(is_live() || is_syscall_plugin()) {
@@ -1358,6 +1546,14 @@ int32_t sinsp::next(sinsp_evt** puevt) {
 	*puevt = nullptr;
 	sinsp_evt* evt = &m_evt;
 
+	std::chrono::steady_clock::time_point latency_start;
+	bool measure_latency = false;
+	if(m_latency_stats != nullptr && m_latency_sampling_countdown-- == 0) {
+		m_latency_sampling_countdown = m_latency_sampling_ratio - 1;
+		measure_latency = true;
+		latency_start = std::chrono::steady_clock::now();
+	}
+
 	// fetch the next event
 	int32_t res = fetch_next_event(evt);
 
@@ -1533,6 +1729,10 @@ int32_t sinsp::next(sinsp_evt** puevt) {
 		m_external_event_processor->process_event(evt, libsinsp::EVENT_RETURN_NONE);
 	}
 
+	if(measure_latency) {
+		record_latency(evt, latency_start);
+	}
+
 	// Clean parse related event data after analyzer did its parsing too
 	sinsp_parser::event_cleanup(*evt);
 
@@ -1568,21 +1768,59 @@ uint64_t sinsp::get_num_events() const {
 	}
 }
 
+// The engines that support it drop the events of the suppressed thread
+// groups before they reach the ring buffers. It's just an optimization:
+// m_suppress still filters everything, so failures are ignored.
+bool sinsp::is_thread_group_leader(int64_t tid) const {
+	auto tinfo = m_thread_manager->find_thread(tid, true);
+	return tinfo == nullptr || tinfo->is_main_thread();
+}
+
+void sinsp::push_suppression_to_engine() {
+	if(scap_clear_suppressed(m_h) != SCAP_SUCCESS) {
+		return;
+	}
+	for(const auto& comm : m_suppress.get_suppressed_comms()) {
+		scap_suppress_comm(m_h, comm.c_str(), true);
+	}
+	for(auto tid : m_suppress.get_suppressed_tids()) {
+		if(is_thread_group_leader(tid)) {
+			scap_suppress_tgid(m_h, tid, true);
+		}
+	}
+}
+
 bool sinsp::suppress_events_comm(const std::string& comm) {
 	m_suppress.suppress_comm(comm);
+	if(m_h != nullptr && is_live()) {
+		scap_suppress_comm(m_h, comm.c_str(), true);
+	}
 	return true;
 }
 
 bool sinsp::suppress_events_tid(int64_t tid) {
 	m_suppress.suppress_tid(tid);
+	if(m_h != nullptr && is_live() && is_thread_group_leader(tid)) {
+		scap_suppress_tgid(m_h, tid, true);
+	}
 	return true;
 }
 
 void sinsp::clear_suppress_events_comm() {
+	if(m_h != nullptr && is_live()) {
+		for(const auto& comm : m_suppress.get_suppressed_comms()) {
+			scap_suppress_comm(m_h, comm.c_str(), false);
+		}
+	}
 	m_suppress.clear_suppress_comm();
 }
 
 void sinsp::clear_suppress_events_tid() {
+	if(m_h != nullptr && is_live()) {
+		for(auto tid : m_suppress.get_suppressed_tids()) {
+			scap_suppress_tgid(m_h, tid, false);
+		}
+	}
 	m_suppress.clear_suppress_tid();
 }
 
@@ -1821,7 +2059,8 @@ std::unique_ptr<sinsp_filter_check> sinsp::new_generic_filtercheck() {
 void sinsp::get_capture_stats(scap_stats* stats) const {
 	/* On purpose ignoring failures to not interrupt in case of stats retrieval failure. */
 	scap_get_stats(m_h, stats);
-	stats->n_suppressed = m_suppress.get_num_suppressed_events();
+	// The engine already counted the events suppressed in the kernel.
+	stats->n_suppressed += m_suppress.get_num_suppressed_events();
 	stats->n_tids_suppressed = m_suppress.get_num_suppressed_tids();
 }
 
@@ -1838,7 +2077,9 @@ void sinsp::print_capture_stats(sinsp_logger::severity sev) const {
 	        "\nn_drops_buffer_dir_file_exit:%" PRIu64
 	        "\nn_drops_buffer_other_interest_exit:%" PRIu64 "\nn_drops_buffer_close_exit:%" PRIu64
 	        "\nn_drops_buffer_proc_exit:%" PRIu64 "\nn_drops_scratch_map:%" PRIu64
-	        "\nn_drops_pf:%" PRIu64 "\nn_drops_bug:%" PRIu64 "\n",
+	        "\nn_drops_pf:%" PRIu64 "\nn_drops_bug:%" PRIu64 "\nn_drops_spill:%" PRIu64
+	        "\nn_drops_rate_limit:%" PRIu64 "\nn_cgroup_filtered:%" PRIu64
+	        "\nn_io_aggregated:%" PRIu64 "\nn_fd_type_filtered:%" PRIu64 "\n",
 	        stats.n_evts,
 	        stats.n_drops,
 	        stats.n_drops_buffer,
@@ -1854,7 +2095,12 @@ void sinsp::print_capture_stats(sinsp_logger::severity sev) const {
 	        stats.n_drops_buffer_proc_exit,
 	        stats.n_drops_scratch_map,
 	        stats.n_drops_pf,
-	        stats.n_drops_bug);
+	        stats.n_drops_bug,
+	        stats.n_drops_spill,
+	        stats.n_drops_rate_limit,
+	        stats.n_cgroup_filtered,
+	        stats.n_io_aggregated,
+	        stats.n_fd_type_filtered);
 }
 
 const metrics_v2* sinsp::get_capture_stats_v2(uint32_t flags, uint32_t* nstats, int32_t* rc) const {
@@ -1994,6 +2240,11 @@ void sinsp::set_thread_timeout_s(uint32_t val) {
 	m_thread_timeout_ns = (uint64_t)val * ONE_SECOND_IN_NS;
 }
 
+void sinsp::set_lru_eviction(bool enabled) {
+	m_lru_eviction = enabled;
+	m_thread_manager->set_lru_eviction(enabled);
+}
+
 void sinsp::set_proc_scan_timeout_ms(uint64_t val) {
 	m_proc_scan_timeout_ms = val;
 }
@@ -2002,6 +2253,72 @@ void sinsp::set_proc_scan_log_interval_ms(uint64_t val) {
 	m_proc_scan_log_interval_ms = val;
 }
 
+void sinsp::set_spill_buffer_bytes_dim(uint64_t bytes_dim, uint64_t max_bytes_dim) {
+	m_spill_buffer_bytes_dim = bytes_dim;
+	m_spill_buffer_max_bytes_dim = max_bytes_dim;
+}
+
+void sinsp::set_rate_limit(uint32_t rate, uint32_t burst) {
+	m_rate_limit_rate = rate;
+	m_rate_limit_burst = burst;
+	if(m_h != nullptr && is_live() && scap_set_rate_limit(m_h, rate, burst) != SCAP_SUCCESS) {
+		throw sinsp_exception(scap_getlasterr(m_h));
+	}
+}
+
+std::vector<scap_rate_limit_stats> sinsp::get_rate_limit_stats() const {
+	// The rate limiter tracks up to 16384 processes.
+	std::vector<scap_rate_limit_stats> stats(16384);
+	uint32_t nstats = 0;
+	if(m_h == nullptr ||
+	   scap_get_rate_limit_stats(m_h, stats.data(), stats.size(), &nstats) != SCAP_SUCCESS) {
+		nstats = 0;
+	}
+	stats.resize(nstats);
+	return stats;
+}
+
+void sinsp::set_io_aggregation(uint32_t interval_ms) {
+	m_io_aggregation_interval_ms = interval_ms;
+	if(m_h != nullptr && is_live() && scap_set_io_aggregation(m_h, interval_ms) != SCAP_SUCCESS) {
+		throw sinsp_exception(scap_getlasterr(m_h));
+	}
+}
+
+void sinsp::set_savefile_replay(double speed, uint64_t evts_per_sec, bool rebase_ts) {
+	m_savefile_replay_speed = speed;
+	m_savefile_replay_evts_per_sec = evts_per_sec;
+	m_savefile_replay_rebase_ts = rebase_ts;
+}
+
+void sinsp::set_latency_stats(uint32_t sampling_ratio) {
+	m_latency_sampling_ratio = sampling_ratio;
+	m_latency_sampling_countdown = 0;
+	if(sampling_ratio == 0) {
+		m_latency_stats.reset();
+	} else if(m_latency_stats == nullptr) {
+		m_latency_stats = std::make_unique<libsinsp::latency_stats>();
+	}
+}
+
+void sinsp::record_latency(const sinsp_evt* evt, std::chrono::steady_clock::time_point start) {
+	m_latency_stats->record_next_duration(
+	        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+	                                                             start)
+	                .count());
+	if(is_live()) {
+		const uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		                             std::chrono::system_clock::now().time_since_epoch())
+		                             .count();
+		const uint64_t ts = evt->get_ts();
+		m_latency_stats->record_delivery(evt->get_category(), now > ts ? now - ts : 0);
+	}
+}
+
+void sinsp::set_modern_bpf_buffers_autotune_path(const std::string& path) {
+	m_modern_bpf_buffers_autotune_path = path;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Note: this is defined here so we can inline it in sinso::next
 ///////////////////////////////////////////////////////////////////////////////
@@ -2032,6 +2349,7 @@ bool sinsp_thread_manager::remove_inactive_threads() {
 	// 1. Invalid threads.
 	// 2. Threads that we are not using and that are no more alive in /proc.
 	std::unordered_set<int64_t> to_delete;
+	std::unordered_set<int64_t> groups_to_check;
 	m_threadtable.loop([&](sinsp_threadinfo& tinfo) {
 		if(tinfo.is_invalid() || (last_event_ts > tinfo.m_lastaccess_ts + m_thread_timeout_ns &&
 		                          !scap_is_thread_alive(m_scap_platform,
@@ -2039,10 +2357,30 @@ bool sinsp_thread_manager::remove_inactive_threads() {
 		                                                tinfo.m_tid,
 		                                                tinfo.m_comm.c_str()))) {
 			to_delete.insert(tinfo.m_tid);
+			if(tinfo.m_tginfo != nullptr) {
+				groups_to_check.insert(tinfo.m_tginfo->get_tgroup_pid());
+			}
 		}
 		return true;
 	});
 
+	// Thread groups whose threads are all gone are removed in one pass.
+	for(const auto pid : groups_to_check) {
+		const auto& tginfo = get_thread_group_info(pid);
+		if(tginfo == nullptr) {
+			continue;
+		}
+		const auto& threads = tginfo->get_thread_list();
+		if(std::all_of(threads.begin(), threads.end(), [&](const sinsp_threadinfo* thread) {
+			   return to_delete.count(thread->m_tid) > 0;
+		   })) {
+			for(const auto thread : threads) {
+				to_delete.erase(thread->m_tid);
+			}
+			remove_thread_group(pid);
+		}
+	}
+
 	for(const auto& tid_to_remove : to_delete) {
 		remove_thread(tid_to_remove);
 	}
@@ -61,6 +61,7 @@ limitations under the License.
 #include <libsinsp/plugin_parser.h>
 #include <libsinsp/plugin_tables.h>
 #include <libsinsp/settings.h>
+#include <libsinsp/shm_publisher.h>
 #include <libsinsp/sinsp_cycledumper.h>
 #include <libsinsp/sinsp_exception.h>
 #include <libsinsp/sinsp_external_processor.h>
@@ -69,6 +70,7 @@ limitations under the License.
 #include <libsinsp/sinsp_suppress.h>
 #include <libsinsp/state/table_registry.h>
 #include <libsinsp/metrics_collector.h>
+#include <libsinsp/latency_stats.h>
 #include <libsinsp/thread_manager.h>
 #include <libsinsp/tuples.h>
 #include <libsinsp/utils.h>
@@ -80,6 +82,7 @@ limitations under the License.
 #include <libsinsp/sinsp_parser_verdict.h>
 #include <libsinsp/timestamper.h>
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
@@ -161,6 +164,10 @@ public:
 	        const libsinsp::events::set<ppm_sc_code>& ppm_sc_of_interest = {},
 	        bool disable_iterators = false);
 	virtual void open_test_input(scap_test_input_data* data, sinsp_mode_t mode = SINSP_MODE_TEST);
+	/* Generates a deterministic stream of syscall events, meant for benchmarks. */
+	virtual void open_synthetic(const scap_synthetic_engine_params& params);
+	/* Consumes the events published by a `sinsp_shm_publisher` on the same host. */
+	virtual void open_shm(const std::string& name);
 
 	void fseek(uint64_t filepos) { scap_fseek(m_h, filepos); }
 
@@ -244,6 +251,34 @@ public:
 	*/
 	void set_import_users(bool import_users);
 
+	/*!
+	  \brief Write the current thread, fd, user and group tables, together
+	  with the state of the async plugins, to a capture file containing no
+	  events. The file is written next to `path` and renamed into place, so
+	  that a snapshot is either complete or not there at all.
+
+	  \note Dynamic fields that plugins add to the thread table are not
+	   part of the capture file format and are not saved.
+
+	  @throws a sinsp_exception containing the error string is thrown in case
+	   of failure.
+	*/
+	void save_state_snapshot(const std::string& path);
+
+	/*!
+	  \brief Restore the state from a snapshot written by
+	  `save_state_snapshot()` the next time a kmod, modern_bpf or nodriver
+	  capture is opened, instead of scanning /proc.
+
+	  Threads that exited or were replaced since the snapshot was taken are
+	  dropped right after the restore; threads started in the meantime are
+	  looked up in /proc the first time an event refers to them, as usual.
+	  If the snapshot can't be read, the full /proc scan is done instead.
+
+	  \param path Path of the snapshot, an empty string to disable the restore.
+	*/
+	void set_state_snapshot_path(const std::string& path) { m_state_snapshot_path = path; }
+
 	/*!
 	  \brief temporarily pauses event capture.
 
@@ -353,6 +388,14 @@ public:
 	 */
 	void set_thread_timeout_s(uint32_t val);
 
+	/*!
+	 * \brief Enables or disables the bounded-memory mode of the thread and fd tables.
+	 *        When enabled, a full table evicts its least recently used entries to make
+	 *        room for new ones, instead of dropping them. An evicted thread is reloaded
+	 *        from /proc, within the proc lookup limits, when it shows up again.
+	 */
+	void set_lru_eviction(bool enabled);
+
 	/*!
 	 * \brief sets the max amount of time that the initial scan of /proc should execute,
 	 *        after which a so-far-successful scan should be stopped and success returned.
@@ -366,6 +409,72 @@ public:
 	 */
 	void set_proc_scan_log_interval_ms(uint64_t val);
 
+	/*!
+	 * \brief [EXPERIMENTAL] sets the size of the userspace spill buffer used by the
+	 *        kmod and modern_bpf engines. When not 0, a dedicated thread drains the
+	 *        kernel buffers into a preallocated buffer of `bytes_dim` bytes, which can
+	 *        grow up to `max_bytes_dim` bytes. Must be called before opening the inspector.
+	 *        Value of 0 (default) disables the drain thread.
+	 */
+	void set_spill_buffer_bytes_dim(uint64_t bytes_dim, uint64_t max_bytes_dim = 0);
+
+	/*!
+	 * \brief [EXPERIMENTAL] limits the events that every process can send to
+	 *        `rate` per second, with bursts of up to `burst` events (`0` means
+	 *        `rate`). The events over the limit are dropped in the kernel and
+	 *        reported by a `rate_limit` event, so a noisy process doesn't cost the
+	 *        visibility on the other ones. Only supported by the modern_bpf engine,
+	 *        can be called before opening the inspector or during a live capture.
+	 *        Value of 0 (default) disables the rate limiter.
+	 */
+	void set_rate_limit(uint32_t rate, uint32_t burst = 0);
+
+	/*!
+	 * \brief [EXPERIMENTAL] returns the number of events dropped by the rate limiter
+	 *        for each process that dropped at least one event. Empty if the engine
+	 *        has no rate limiter.
+	 */
+	std::vector<scap_rate_limit_stats> get_rate_limit_stats() const;
+
+	/*!
+	 * \brief [EXPERIMENTAL] folds the read-like and write-like syscalls in the
+	 *        kernel: only the first one of each thread on an fd is sent, the following
+	 *        ones are summarized by an `io_summary` event every `interval_ms`
+	 *        milliseconds at most, and when the fd is closed. The summaries update
+	 *        the `fd.summary.*` fields. Only supported by the modern_bpf engine, can be
+	 *        called before opening the inspector or during a live capture.
+	 *        Value of 0 (default) disables the aggregation.
+	 */
+	void set_io_aggregation(uint32_t interval_ms);
+
+	/*!
+	 * \brief [EXPERIMENTAL] drops in the kernel the I/O events (read, write, send,
+	 *        recv, sendfile and their variants) on fds whose type is not in `mask`,
+	 *        a combination of `PPM_FD_TYPE_*` values. Events on fds the driver can't
+	 *        resolve are kept. Supported by the kmod and modern_bpf engines, must be
+	 *        called before opening the inspector.
+	 *        Value of 0 (default) disables the prefilter.
+	 */
+	void set_io_fd_type_mask(uint32_t mask) { m_io_fd_type_mask = mask; }
+
+	/*!
+	 * \brief [EXPERIMENTAL] paces the events read from a capture file. `speed` is a
+	 *        multiplier of the original event spacing (1.0 is real time, 0 disables
+	 *        pacing); `evts_per_sec`, when not 0, replays at a fixed rate instead.
+	 *        If `rebase_ts` is true, event timestamps are shifted so that the
+	 *        capture appears to start now. Must be called before open_savefile().
+	 */
+	void set_savefile_replay(double speed, uint64_t evts_per_sec = 0, bool rebase_ts = false);
+
+	/*!
+	 * \brief [EXPERIMENTAL] enables the ring buffer auto-tuner of the modern_bpf engine.
+	 *        On close, the buffer configuration recommended from the observed
+	 *        utilization is stored in `path`; the next open_modern_bpf() uses it in
+	 *        place of the requested `cpus_for_each_buffer` and `driver_buffer_bytes_dim`.
+	 *        An empty path (default) disables it.
+	 */
+	void set_modern_bpf_buffers_autotune_path(const std::string& path);
+
 	/*!
 	  \brief Returns a new instance of a filtercheck supporting fields for
 	  a generic event source (e.g. evt.num, evt.time, evt.pluginname...)
@@ -401,6 +510,21 @@ public:
 		return m_sinsp_stats_v2;
 	}
 
+	/*!
+	  \brief [EXPERIMENTAL] enables the latency histograms of next(): the age of
+	  the returned events (for live captures, per event category) and the
+	  duration of the call. One event every `sampling_ratio` is measured, 0
+	  (default) disables them.
+	*/
+	void set_latency_stats(uint32_t sampling_ratio);
+
+	/*!
+	  \brief Return the latency histograms, nullptr if they are not enabled.
+	*/
+	inline const libsinsp::latency_stats* get_latency_stats() const {
+		return m_latency_stats.get();
+	}
+
 	/*!
 	  \brief Fill the given structure with statistics about the currently
 	   open capture.
@@ -824,6 +948,10 @@ private:
 	static bool is_initialstate_event(const scap_evt& pevent);
 	void import_ifaddr_list();
 	void import_user_list();
+	bool load_state_snapshot(std::vector<std::unique_ptr<sinsp_evt>>& state_evts);
+	void replay_state_snapshot(const std::vector<std::unique_ptr<sinsp_evt>>& state_evts);
+	bool is_thread_group_leader(int64_t tid) const;
+	void push_suppression_to_engine();
 	int32_t fetch_next_event(sinsp_evt*& evt);
 
 	//
@@ -850,6 +978,7 @@ private:
 	void get_read_progress_plugin(double* nres, std::string* sres) const;
 
 	void get_procs_cpu_from_driver(uint64_t ts);
+	void record_latency(const sinsp_evt* evt, std::chrono::steady_clock::time_point start);
 
 	// regulates the logic behind event timestamp ordering.
 	// returns true if left "comes first" than right, and false otherwise.
@@ -863,6 +992,9 @@ private:
 	bool must_notify_thread_group_update() const { return m_mode.is_live() || is_syscall_plugin(); }
 
 	std::shared_ptr<sinsp_stats_v2> m_sinsp_stats_v2;
+	std::unique_ptr<libsinsp::latency_stats> m_latency_stats;
+	uint32_t m_latency_sampling_ratio = 0;
+	uint32_t m_latency_sampling_countdown = 0;
 	scap_t* m_h;
 	struct scap_platform* m_platform{};
 	char m_platform_lasterr[SCAP_LASTERR_SIZE];
@@ -964,6 +1096,7 @@ public:
 	// Some thread table limits
 	//
 	static constexpr uint32_t s_max_fdtable_size = MAX_FD_TABLE_SIZE;
+	bool m_lru_eviction = false;
 	bool m_auto_threads_purging = true;
 	uint64_t m_thread_timeout_ns = (uint64_t)1800 * ONE_SECOND_IN_NS;
 	uint64_t m_threads_purging_scan_time_ns = (uint64_t)1200 * ONE_SECOND_IN_NS;
@@ -1056,6 +1189,47 @@ public:
 	uint64_t m_proc_scan_timeout_ms;
 	uint64_t m_proc_scan_log_interval_ms;
 
+	//
+	// Userspace spill buffer parameters
+	//
+	uint64_t m_spill_buffer_bytes_dim = 0;
+	uint64_t m_spill_buffer_max_bytes_dim = 0;
+
+	//
+	// Per-process rate limiter parameters
+	//
+	uint32_t m_rate_limit_rate = 0;
+	uint32_t m_rate_limit_burst = 0;
+
+	//
+	// In-kernel I/O aggregation interval, in milliseconds
+	//
+	uint32_t m_io_aggregation_interval_ms = 0;
+
+	//
+	// `PPM_FD_TYPE_*` mask of the in-kernel I/O prefilter
+	//
+	uint32_t m_io_fd_type_mask = 0;
+
+	//
+	// Savefile replay parameters
+	//
+	double m_savefile_replay_speed = 0;
+	uint64_t m_savefile_replay_evts_per_sec = 0;
+	bool m_savefile_replay_rebase_ts = false;
+
+	//
+	// Where the modern_bpf engine stores the recommended ring buffer configuration
+	//
+	std::string m_modern_bpf_buffers_autotune_path;
+
+	//
+	// State snapshot restored in place of the /proc scan. The flag is set by
+	// the open methods whose platform skips the scan for it.
+	//
+	std::string m_state_snapshot_path;
+	bool m_restore_state_snapshot = false;
+
 	libsinsp::sinsp_suppress m_suppress;
 
 	//
@@ -142,14 +142,11 @@ int main(int argc, char** argv) {
 
 		case PPME_PROCEXIT_1_E:
 			printf("💥 THREAD EXIT: evt_num(%" PRIu64 ")\n", ev->get_num());
-			for(const auto& child : tinfo->m_children) {
-				if(!child.expired()) {
-					auto child_shr = child.lock().get();
-					printf("- move child, tid: %" PRId64 ", ptid: %" PRId64
-					       " (dead) to a new reaper.\n",
-					       child_shr->m_tid,
-					       child_shr->m_ptid);
-				}
+			for(auto child : tinfo->get_children()) {
+				printf("- move child, tid: %" PRId64 ", ptid: %" PRId64
+				       " (dead) to a new reaper.\n",
+				       child->m_tid,
+				       child->m_ptid);
 			}
 			display_thread_lineage(*inspector.m_thread_manager, tinfo);
 			break;
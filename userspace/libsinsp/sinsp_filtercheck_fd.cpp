@@ -292,6 +292,32 @@ static const filtercheck_field_info sinsp_filter_check_fd_fields[] = {
          "fd.is_lower_layer",
          "FD Lower Layer",
          "'true' if the fd is of a file  in the lower layer of an overlayfs."},
+        {PT_UINT64,
+         EPF_NONE,
+         PF_DEC,
+         "fd.summary.reads",
+         "FD Summarized Reads",
+         "number of read-like syscalls on the fd that the driver folded into io_summary events "
+         "instead of sending them. Only set when the in-kernel I/O aggregation is enabled."},
+        {PT_UINT64,
+         EPF_NONE,
+         PF_DEC,
+         "fd.summary.read_bytes",
+         "FD Summarized Read Bytes",
+         "number of bytes read by the syscalls counted in fd.summary.reads."},
+        {PT_UINT64,
+         EPF_NONE,
+         PF_DEC,
+         "fd.summary.writes",
+         "FD Summarized Writes",
+         "number of write-like syscalls on the fd that the driver folded into io_summary events "
+         "instead of sending them. Only set when the in-kernel I/O aggregation is enabled."},
+        {PT_UINT64,
+         EPF_NONE,
+         PF_DEC,
+         "fd.summary.write_bytes",
+         "FD Summarized Write Bytes",
+         "number of bytes written by the syscalls counted in fd.summary.writes."},
 };
 
 sinsp_filter_check_fd::sinsp_filter_check_fd() {
@@ -1215,6 +1241,30 @@ uint8_t *sinsp_filter_check_fd::extract_single(sinsp_evt *evt, uint32_t *len) {
 		m_val.u32 = m_fdinfo->is_overlay_lower();
 		return extract_single_val(m_val.u32, len);
 	} break;
+	case TYPE_SUMMARY_READS:
+		if(m_fdinfo == NULL) {
+			return NULL;
+		}
+		m_val.u64 = m_fdinfo->m_summarized_reads;
+		return extract_single_val(m_val.u64, len);
+	case TYPE_SUMMARY_READ_BYTES:
+		if(m_fdinfo == NULL) {
+			return NULL;
+		}
+		m_val.u64 = m_fdinfo->m_summarized_read_bytes;
+		return extract_single_val(m_val.u64, len);
+	case TYPE_SUMMARY_WRITES:
+		if(m_fdinfo == NULL) {
+			return NULL;
+		}
+		m_val.u64 = m_fdinfo->m_summarized_writes;
+		return extract_single_val(m_val.u64, len);
+	case TYPE_SUMMARY_WRITE_BYTES:
+		if(m_fdinfo == NULL) {
+			return NULL;
+		}
+		m_val.u64 = m_fdinfo->m_summarized_write_bytes;
+		return extract_single_val(m_val.u64, len);
 	default:
 		ASSERT(false);
 	}
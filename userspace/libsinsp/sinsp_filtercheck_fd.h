@@ -69,6 +69,10 @@ public:
 		TYPE_FDTYPES = 43,
 		TYPE_FDUPPER = 44,
 		TYPE_FDLOWER = 45,
+		TYPE_SUMMARY_READS = 46,
+		TYPE_SUMMARY_READ_BYTES = 47,
+		TYPE_SUMMARY_WRITES = 48,
+		TYPE_SUMMARY_WRITE_BYTES = 49,
 	};
 
 	sinsp_filter_check_fd();
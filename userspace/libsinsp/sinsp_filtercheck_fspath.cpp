@@ -245,20 +245,32 @@ void sinsp_filter_check_fspath::set_fspath_checks(
 }
 
 std::unique_ptr<sinsp_filter_check> sinsp_filter_check_fspath::allocate_new() {
-	// If not yet populated, do so now. The maps will be empty
-	// *only* for the initial filtercheck created in
-	// filter_check_list.
-	if(m_path_checks->empty()) {
-		create_fspath_checks();
-	}
-
 	auto ret = std::make_unique<sinsp_filter_check_fspath>();
 
-	ret->set_fspath_checks(m_success_checks, m_path_checks, m_source_checks, m_target_checks);
+	// Share the sub-checks only if they have already been
+	// created. The prototype in filter_check_list never creates
+	// them, so that allocating new checks never modifies it and
+	// can happen from multiple threads at once.
+	if(!m_path_checks->empty()) {
+		ret->set_fspath_checks(m_success_checks, m_path_checks, m_source_checks, m_target_checks);
+	}
 
 	return ret;
 }
 
+int32_t sinsp_filter_check_fspath::parse_field_name(std::string_view str,
+                                                    bool alloc_state,
+                                                    bool needed_for_filtering) {
+	int32_t res = sinsp_filter_check::parse_field_name(str, alloc_state, needed_for_filtering);
+
+	// The sub-checks need the inspector, which is set by now
+	if(res != -1 && m_path_checks->empty()) {
+		create_fspath_checks();
+	}
+
+	return res;
+}
+
 // Similar to sinsp_parser::parse_dirfd().
 // Makes only sense when called against a directory fdinfo.
 static inline std::string format_dirfd(sinsp_evt* evt) {
@@ -35,6 +35,9 @@ public:
 	virtual ~sinsp_filter_check_fspath() = default;
 
 	std::unique_ptr<sinsp_filter_check> allocate_new() override;
+	int32_t parse_field_name(std::string_view,
+	                         bool alloc_state,
+	                         bool needed_for_filtering) override;
 
 protected:
 	uint8_t* extract_single(sinsp_evt*, uint32_t* len) override;
@@ -51,6 +51,12 @@ public:
 
 	uint64_t get_num_suppressed_tids() const { return m_suppressed_tids.size(); }
 
+	const std::unordered_set<std::string>& get_suppressed_comms() const {
+		return m_suppressed_comms;
+	}
+
+	const std::unordered_set<uint64_t>& get_suppressed_tids() const { return m_suppressed_tids; }
+
 	void initialize();
 
 	void finalize();
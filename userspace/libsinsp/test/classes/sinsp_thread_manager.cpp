@@ -117,7 +117,7 @@ TEST(sinsp_thread_manager, create_thread_dependencies_new_tginfo) {
 	tinfo->m_vpid = 1;
 
 	m_inspector.m_thread_manager->create_thread_dependencies(tinfo);
-	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 1, true, 1, 1);
+	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 1, true, 1);
 
 	ASSERT_EQ(tinfo->m_ptid, 0);
 }
@@ -146,7 +146,7 @@ TEST(sinsp_thread_manager, create_thread_dependencies_use_existing_tginfo) {
 	other_tinfo->m_ptid = 51004;
 
 	m_inspector.m_thread_manager->create_thread_dependencies(other_tinfo);
-	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 2, false, 2, 2);
+	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 2, false, 2);
 }
 
 TEST_F(sinsp_with_test_input, THRD_MANAGER_create_thread_dependencies_valid_parent) {
@@ -159,9 +159,9 @@ TEST_F(sinsp_with_test_input, THRD_MANAGER_create_thread_dependencies_valid_pare
 	tinfo->m_ptid = p6_t1_tid;
 
 	m_inspector.m_thread_manager->create_thread_dependencies(tinfo);
-	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 1, false, 1, 1);
+	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 1, false, 1);
 	ASSERT_EQ(tinfo->m_ptid, p6_t1_tid);
-	ASSERT_THREAD_CHILDREN(p6_t1_tid, 1, 1);
+	ASSERT_THREAD_CHILDREN(p6_t1_tid, 1);
 }
 
 TEST_F(sinsp_with_test_input, THRD_MANAGER_create_thread_dependencies_invalid_parent) {
@@ -174,7 +174,7 @@ TEST_F(sinsp_with_test_input, THRD_MANAGER_create_thread_dependencies_invalid_pa
 	tinfo->m_ptid = 8000;
 
 	m_inspector.m_thread_manager->create_thread_dependencies(tinfo);
-	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 1, false, 1, 1);
+	ASSERT_THREAD_GROUP_INFO(tinfo->m_pid, 1, false, 1);
 	/* the new parent will be 0 */
 	ASSERT_EQ(tinfo->m_ptid, 0);
 }
@@ -76,6 +76,47 @@ TEST(thread_group_info, populate_thread_group_info) {
 	const auto tinfo2 = threadinfo_factory.create_shared();
 	tginfo.add_thread_to_group(tinfo2, false);
 	ASSERT_EQ(tginfo.get_first_thread(), tinfo1.get());
-	ASSERT_EQ(tginfo.get_thread_list().back().lock().get(), tinfo2.get());
+	ASSERT_EQ(tginfo.get_thread_list().back(), tinfo2.get());
+	EXPECT_EQ(tginfo.get_thread_count(), 4);
+}
+
+TEST(thread_group_info, remove_thread_from_group) {
+	const sinsp inspector;
+	const auto& threadinfo_factory = inspector.get_threadinfo_factory();
+	auto main_tinfo = threadinfo_factory.create_shared();
+	main_tinfo->m_tid = 23;
+	main_tinfo->m_pid = 23;
+	auto tinfo1 = threadinfo_factory.create_shared();
+	auto tinfo2 = threadinfo_factory.create_shared();
+	auto tinfo3 = threadinfo_factory.create_shared();
+
+	thread_group_info tginfo(main_tinfo->m_pid, false, tinfo1);
+	tginfo.add_thread_to_group(tinfo2, false);
+	tginfo.add_thread_to_group(tinfo3, false);
+	tginfo.add_thread_to_group(main_tinfo, true);
+	ASSERT_EQ(tginfo.get_thread_list().size(), 4);
+	ASSERT_EQ(tginfo.get_first_thread(), main_tinfo.get());
+
+	/* The main thread stays in front */
+	tginfo.remove_thread_from_group(tinfo2.get());
+	ASSERT_EQ(tginfo.get_thread_list().size(), 3);
+	ASSERT_EQ(tginfo.get_first_thread(), main_tinfo.get());
+
+	/* Removing a thread twice does nothing */
+	tginfo.remove_thread_from_group(tinfo2.get());
+	ASSERT_EQ(tginfo.get_thread_list().size(), 3);
+
+	/* Destroyed threads are unlinked */
+	tinfo1.reset();
+	ASSERT_EQ(tginfo.get_thread_list().size(), 2);
+	ASSERT_EQ(tginfo.get_first_thread(), main_tinfo.get());
+	ASSERT_EQ(tginfo.get_thread_list().back(), tinfo3.get());
+
+	/* A thread can be moved to another group */
+	thread_group_info other_tginfo(30, false, tinfo3);
+	ASSERT_EQ(tginfo.get_thread_list().size(), 1);
+	ASSERT_EQ(other_tginfo.get_first_thread(), tinfo3.get());
+
+	/* The alive count is not touched */
 	EXPECT_EQ(tginfo.get_thread_count(), 4);
 }
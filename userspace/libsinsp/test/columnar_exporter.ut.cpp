@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/sinsp.h>
+#include <libsinsp/columnar_exporter.h>
+#include <libscap/scap_config.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#ifdef HAS_ENGINE_SYNTHETIC
+
+using namespace libsinsp::columnar;
+
+namespace {
+std::string columnar_path(const char* test) {
+	return "/tmp/sinsp_ut_" + std::string(test) + "_" + std::to_string(getpid()) + ".scol";
+}
+
+struct expected_row {
+	uint64_t num;
+	int64_t pid;
+	std::string type;
+	std::string upper_comm;
+};
+}  // namespace
+
+TEST(columnar_exporter, round_trip) {
+	const auto path = columnar_path("round_trip");
+	scap_synthetic_engine_params params{};
+	params.seed = 7;
+	params.max_evts = 2000;
+	params.n_procs = 8;
+	params.n_fds = 4;
+
+	sinsp inspector;
+	sinsp_filter_check_list checks;
+	inspector.open_synthetic(params);
+
+	sinsp_columnar_exporter exporter(
+	        &inspector,
+	        checks,
+	        {"evt.num", "proc.pid", "evt.type", "toupper(proc.name)", "evt.is_io", "fd.name"},
+	        500);
+	ASSERT_EQ(exporter.columns()[0].type, column_type::UINT64);
+	ASSERT_EQ(exporter.columns()[1].type, column_type::INT64);
+	ASSERT_EQ(exporter.columns()[2].type, column_type::STRING);
+	ASSERT_EQ(exporter.columns()[3].type, column_type::STRING);
+	ASSERT_EQ(exporter.columns()[4].type, column_type::BOOL);
+	ASSERT_EQ(exporter.columns()[5].type, column_type::STRING);
+	exporter.open(path);
+
+	std::vector<expected_row> expected;
+	sinsp_evt* evt = nullptr;
+	int32_t res;
+	while((res = inspector.next(&evt)) != SCAP_EOF) {
+		if(res != SCAP_SUCCESS) {
+			continue;
+		}
+		exporter.write(evt);
+		auto tinfo = evt->get_thread_info();
+		std::string comm = tinfo ? tinfo->m_comm : "";
+		for(auto& c : comm) {
+			c = toupper(c);
+		}
+		expected.push_back({evt->get_num(), tinfo ? tinfo->m_pid : -1, evt->get_name(), comm});
+	}
+	exporter.close();
+	ASSERT_GT(expected.size(), 0);
+	ASSERT_EQ(exporter.written_rows(), expected.size());
+
+	sinsp_columnar_reader reader(path);
+	ASSERT_EQ(reader.columns().size(), 6);
+	ASSERT_EQ(reader.find_column("evt.type"), 2);
+	ASSERT_EQ(reader.find_column("evt.dir"), -1);
+	ASSERT_EQ(reader.row_groups().size(), (expected.size() + 499) / 500);
+
+	size_t row = 0;
+	std::vector<value> nums, pids, types, comms, fds;
+	for(size_t rg = 0; rg < reader.row_groups().size(); rg++) {
+		const auto& info = reader.row_groups()[rg];
+		reader.read_column(rg, 0, nums);
+		reader.read_column(rg, 1, pids);
+		reader.read_column(rg, 2, types);
+		reader.read_column(rg, 3, comms);
+		reader.read_column(rg, 5, fds);
+		ASSERT_EQ(nums.size(), info.num_rows);
+
+		// Row group statistics match the data.
+		ASSERT_EQ(std::get<uint64_t>(info.columns[0].min), expected[row].num);
+		ASSERT_EQ(std::get<uint64_t>(info.columns[0].max), expected[row + info.num_rows - 1].num);
+		ASSERT_EQ(info.columns[0].null_count, 0);
+
+		uint64_t fd_nulls = 0;
+		for(size_t i = 0; i < info.num_rows; i++, row++) {
+			ASSERT_EQ(std::get<uint64_t>(nums[i]), expected[row].num);
+			ASSERT_EQ(std::get<int64_t>(pids[i]), expected[row].pid);
+			ASSERT_EQ(std::get<std::string>(types[i]), expected[row].type);
+			ASSERT_EQ(std::get<std::string>(comms[i]), expected[row].upper_comm);
+			fd_nulls += std::holds_alternative<std::monostate>(fds[i]) ? 1 : 0;
+		}
+		ASSERT_EQ(info.columns[5].null_count, fd_nulls);
+	}
+	ASSERT_EQ(row, expected.size());
+	std::remove(path.c_str());
+}
+
+TEST(columnar_exporter, invalid_field) {
+	sinsp inspector;
+	sinsp_filter_check_list checks;
+	ASSERT_THROW(sinsp_columnar_exporter(&inspector, checks, {"evt.num", "not.a.field"}),
+	             sinsp_exception);
+	ASSERT_THROW(sinsp_columnar_exporter(&inspector, checks, {}), sinsp_exception);
+}
+
+TEST(columnar_exporter, corrupted_file) {
+	const auto path = columnar_path("corrupted");
+	{
+		std::ofstream f(path, std::ios::binary);
+		f << "SCOL not really a columnar file";
+	}
+	ASSERT_THROW(sinsp_columnar_reader{path}, sinsp_exception);
+	std::remove(path.c_str());
+}
+
+#endif
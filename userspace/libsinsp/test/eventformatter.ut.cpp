@@ -581,3 +581,37 @@ TEST_F(sinsp_formatter_test, ancestor_aname_with_arg_still_works) {
 	EXPECT_EQ(m_last_res, true);
 	EXPECT_EQ(m_last_output, "start init end");
 }
+
+TEST_F(sinsp_formatter_test, shared_extract_cache) {
+	struct metrics_cache_factory : public exprstr_sinsp_filter_cache_factory {
+		const std::shared_ptr<sinsp_filter_cache_metrics> metrics =
+		        std::make_shared<sinsp_filter_cache_metrics>();
+
+		std::shared_ptr<sinsp_filter_cache_metrics> new_metrics(const ast_expr_t* e,
+		                                                        node_info_t& info) override {
+			return metrics;
+		}
+	};
+	auto cache_factory = std::make_shared<metrics_cache_factory>();
+
+	auto factory = std::make_shared<sinsp_filter_factory>(&m_inspector, m_filter_list);
+	auto filter = sinsp_filter_compiler(factory, "proc.name = init", cache_factory).compile();
+	sinsp_evt_formatter f(&m_inspector, "%proc.name", m_filter_list, cache_factory);
+
+	auto evt = generate_getcwd_failed_entry_event(INIT_TID);
+	ASSERT_TRUE(filter->run(evt));
+	EXPECT_EQ(cache_factory->metrics->m_num_extract, 1);
+	EXPECT_EQ(cache_factory->metrics->m_num_extract_cache, 0);
+
+	// the formatter reuses the value extracted by the filter
+	ASSERT_TRUE(f.tostring(evt, m_last_output));
+	EXPECT_EQ(m_last_output, "init");
+	EXPECT_EQ(cache_factory->metrics->m_num_extract, 2);
+	EXPECT_EQ(cache_factory->metrics->m_num_extract_cache, 1);
+
+	// and the value is extracted again for the next event
+	evt = generate_getcwd_failed_entry_event(INIT_TID);
+	ASSERT_TRUE(f.tostring(evt, m_last_output));
+	EXPECT_EQ(m_last_output, "init");
+	EXPECT_EQ(cache_factory->metrics->m_num_extract_cache, 1);
+}
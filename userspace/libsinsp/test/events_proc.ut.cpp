@@ -1302,7 +1302,7 @@ TEST_F(sinsp_with_test_input, proc_ppid_apid) {
 	[[maybe_unused]] int64_t p7_t1_ptid = p2_t3_tid;
 
 	auto evt = generate_clone_x_event(p7_t1_tid, p2_t3_tid, p2_t3_pid, p2_t3_ptid);
-	ASSERT_THREAD_CHILDREN(p2_t3_tid, 1, 1, p7_t1_tid);
+	ASSERT_THREAD_CHILDREN(p2_t3_tid, 1, p7_t1_tid);
 
 	/* Check that proc.ppid and proc.apid[1] are the same and that this holds even in the case
 	    a thread performed a clone */
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+#include <libsinsp/filter/ast_cache.h>
+#include <libsinsp/filter/parser.h>
+#include <libsinsp/sinsp_exception.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace libsinsp::filter;
+
+static const std::vector<std::string> s_filters = {
+        "evt.type = open",
+        "evt.type in (open, openat) and not fd.name startswith /tmp",
+        "(proc.name = bash or proc.pname = sh) and evt.dir = <",
+        "fd.name exists and evt.arg[0] contains \"x\"",
+        "evt.arg.flags icontains O_RDONLY or evt.rawarg.res < 0",
+        "toupper(proc.name) = BASH and tolower(proc.pname) = val(proc.name)",
+        "macro_a and (macro_b or not macro_c)",
+        "fd.sip in (\"10.0.0.0/8\", \"::1\") and proc.aname[2] glob '*sh'",
+};
+
+static std::string temp_path() {
+	return std::string(testing::TempDir()) + "/filter_ast_cache_" +
+	       testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+TEST(filter_ast_cache, serialize_roundtrip) {
+	for(const auto& f : s_filters) {
+		auto ast = parser(f).parse();
+		auto data = serialize_ast(ast.get());
+		auto res = deserialize_ast(data);
+		ASSERT_TRUE(res->is_equal(ast.get())) << f;
+		EXPECT_EQ(res->get_pos().as_string(), ast->get_pos().as_string()) << f;
+		EXPECT_EQ(serialize_ast(res.get()), data) << f;
+	}
+}
+
+TEST(filter_ast_cache, deserialize_invalid) {
+	auto data = serialize_ast(parser(s_filters[1]).parse().get());
+	for(size_t i = 0; i < data.size(); i++) {
+		EXPECT_THROW(deserialize_ast(data.substr(0, i)), sinsp_exception) << i;
+	}
+	EXPECT_THROW(deserialize_ast(data + "x"), sinsp_exception);
+	EXPECT_THROW(deserialize_ast(std::string(13, '\xff')), sinsp_exception);
+}
+
+TEST(filter_ast_cache, get) {
+	ast_cache cache;
+	auto a = cache.get(s_filters[0]);
+	ASSERT_NE(a, nullptr);
+	EXPECT_EQ(cache.misses(), 1);
+	EXPECT_EQ(cache.hits(), 0);
+	EXPECT_EQ(cache.get(s_filters[0]), a);
+	EXPECT_EQ(cache.hits(), 1);
+	EXPECT_EQ(cache.size(), 1);
+	EXPECT_THROW(cache.get("evt.type = "), sinsp_exception);
+	EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(filter_ast_cache, save_load) {
+	const auto path = temp_path();
+	{
+		ast_cache cache("v1");
+		for(const auto& f : s_filters) {
+			cache.get(f);
+		}
+		ASSERT_TRUE(cache.save(path));
+	}
+
+	ast_cache cache("v1");
+	ASSERT_TRUE(cache.load(path));
+	EXPECT_EQ(cache.size(), s_filters.size());
+	for(const auto& f : s_filters) {
+		auto ast = cache.get(f);
+		ASSERT_NE(ast, nullptr);
+		EXPECT_TRUE(ast->is_equal(parser(f).parse().get())) << f;
+	}
+	EXPECT_EQ(cache.hits(), s_filters.size());
+	EXPECT_EQ(cache.misses(), 0);
+
+	// a different version invalidates the whole file
+	ast_cache other("v2");
+	EXPECT_FALSE(other.load(path));
+	EXPECT_EQ(other.size(), 0);
+
+	std::remove(path.c_str());
+	EXPECT_FALSE(cache.load(path));
+}
+
+TEST(filter_ast_cache, load_corrupted) {
+	const auto path = temp_path();
+	{
+		ast_cache cache;
+		cache.get(s_filters[0]);
+		ASSERT_TRUE(cache.save(path));
+	}
+
+	std::string content;
+	{
+		std::ifstream f(path, std::ios::binary);
+		content.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream f(path, std::ios::binary | std::ios::trunc);
+		f.write(content.data(), content.size() - 1);
+	}
+
+	ast_cache cache;
+	EXPECT_FALSE(cache.load(path));
+	EXPECT_EQ(cache.size(), 0);
+	std::remove(path.c_str());
+}
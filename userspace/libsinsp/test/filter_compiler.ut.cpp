@@ -18,7 +18,9 @@ limitations under the License.
 #include <libsinsp/sinsp.h>
 #include <libsinsp/filter.h>
 #include <gtest/gtest.h>
+#include <atomic>
 #include <list>
+#include <thread>
 #include <sinsp_with_test_input.h>
 #include <plugins/test_plugins.h>
 
@@ -1165,3 +1167,87 @@ TEST_F(sinsp_with_test_input, filter_str_op_modifier_cache_consistency) {
 		EXPECT_EQ(r1, r2);
 	}
 }
+
+// Resolves field names by asking every check in order, like the list did before it had an index.
+class linear_filter_check_list : public sinsp_filter_check_list {
+public:
+	std::string linear_lookup(std::string_view name, sinsp* inspector) {
+		for(const auto& chk : m_check_list) {
+			chk->set_inspector(inspector);
+			if(chk->parse_field_name(name, false, true) != -1) {
+				return chk->get_fields()->m_name;
+			}
+		}
+		return "";
+	}
+};
+
+TEST(filter_check_list, field_index_matches_linear_lookup) {
+	sinsp inspector;
+	linear_filter_check_list flist;
+	std::vector<const filter_check_info*> infos;
+	flist.get_all_fields(infos);
+
+	auto check_name = [&](const std::string& name) {
+		std::string expected = "<exception>";
+		std::string actual = "<exception>";
+		try {
+			expected = flist.linear_lookup(name, &inspector);
+		} catch(const sinsp_exception&) {
+		}
+		try {
+			auto chk = flist.new_filter_check_from_fldname(name, &inspector, false);
+			actual = chk ? chk->get_fields()->m_name : "";
+		} catch(const sinsp_exception&) {
+		}
+		EXPECT_EQ(expected, actual) << "field " << name;
+	};
+
+	for(const auto* info : infos) {
+		for(int32_t i = 0; i < info->m_nfields; i++) {
+			const std::string name = info->m_fields[i].m_name;
+			check_name(name);
+			check_name(name + "[1]");
+			check_name(name + ".res");
+			check_name(name + "x");
+		}
+	}
+	check_name("arg.foo");
+	check_name("not.a.field");
+	check_name("");
+}
+
+TEST(sinsp_filter_compiler, parallel_compile) {
+	sinsp inspector;
+	sinsp_filter_check_list flist;
+	auto factory = std::make_shared<sinsp_filter_factory>(&inspector, flist);
+	const std::vector<std::string> filters = {
+	        "evt.type in (open, openat) and fd.name startswith /etc",
+	        "proc.name = bash and proc.aname[2] = sshd and not user.name = root",
+	        "evt.arg.res < 0 and evt.rawarg.fd > 2",
+	        "fd.sport in (80, 443) and fd.sip = 10.0.0.1",
+	        "tolower(proc.exe) glob '*/bin/*' and evt.type.is.execve = 1",
+	        "proc.cmdline contains curl or thread.cgroup.cpuacct exists"};
+
+	std::atomic<int> failures{0};
+	std::vector<std::thread> threads;
+	for(int t = 0; t < 4; t++) {
+		threads.emplace_back([&]() {
+			for(int i = 0; i < 50; i++) {
+				for(const auto& filter : filters) {
+					try {
+						if(sinsp_filter_compiler(factory, filter).compile() == nullptr) {
+							failures++;
+						}
+					} catch(const sinsp_exception&) {
+						failures++;
+					}
+				}
+			}
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	ASSERT_EQ(failures, 0);
+}
@@ -41,7 +41,6 @@ limitations under the License.
                                  alive_threads,                                         \
                                  reaper_enabled,                                        \
                                  threads_num,                                           \
-                                 not_expired,                                           \
                                  ...)                                                   \
 	{                                                                                   \
 		const auto& thread_manager = m_inspector.m_thread_manager;                      \
@@ -60,48 +59,33 @@ limitations under the License.
 			                   "' doesn't belong to the thread group id '" +            \
 			                   std::to_string(tg_pid) + "'";                            \
 			bool found = false;                                                         \
-			for(const auto& thread : tginfo->get_thread_list()) {                       \
-				if(thread.lock().get() == tid_tinfo) {                                  \
+			for(const auto thread : tginfo->get_thread_list()) {                        \
+				if(thread == tid_tinfo) {                                               \
 					found = true;                                                       \
 				}                                                                       \
 			}                                                                           \
 			ASSERT_TRUE(found);                                                         \
 		}                                                                               \
-		uint64_t not_expired_count = 0;                                                 \
-		for(const auto& thread : tginfo->get_thread_list()) {                           \
-			if(!thread.expired()) {                                                     \
-				not_expired_count++;                                                    \
-			}                                                                           \
-		}                                                                               \
-		ASSERT_EQ(not_expired_count, not_expired);                                      \
 	}
 
-#define ASSERT_THREAD_CHILDREN(parent_tid, children_num, not_expired, ...)                    \
+#define ASSERT_THREAD_CHILDREN(parent_tid, children_num, ...)                                 \
 	{                                                                                         \
 		const auto& thread_manager = m_inspector.m_thread_manager;                            \
 		sinsp_threadinfo* parent_tinfo = thread_manager->find_thread(parent_tid, true).get(); \
 		ASSERT_TRUE(parent_tinfo);                                                            \
-		ASSERT_EQ(parent_tinfo->m_children.size(), children_num);                             \
+		ASSERT_EQ(parent_tinfo->get_children().size(), children_num);                         \
 		std::set<int64_t> tid_to_assert{__VA_ARGS__};                                         \
 		for(const auto& tid : tid_to_assert) {                                                \
 			sinsp_threadinfo* tid_tinfo = thread_manager->find_thread(tid, true).get();       \
 			ASSERT_TRUE(tid_tinfo);                                                           \
 			bool found = false;                                                               \
-			for(const auto& child : parent_tinfo->m_children) {                               \
-				if(child.lock().get() == tid_tinfo) {                                         \
+			for(const auto child : parent_tinfo->get_children()) {                            \
+				if(child == tid_tinfo) {                                                      \
 					found = true;                                                             \
 				}                                                                             \
 			}                                                                                 \
 			ASSERT_TRUE(found);                                                               \
 		}                                                                                     \
-		uint16_t not_expired_count = 0;                                                       \
-		for(const auto& child : parent_tinfo->m_children) {                                   \
-			if(!child.expired()) {                                                            \
-				not_expired_count++;                                                          \
-			}                                                                                 \
-		}                                                                                     \
-		ASSERT_EQ(not_expired_count, not_expired);                                            \
-		ASSERT_EQ(not_expired_count, parent_tinfo->m_not_expired_children);                   \
 	}
 
 /* if `missing==true` we shouldn't find the thread info */
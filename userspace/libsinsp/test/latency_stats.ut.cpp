@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/latency_stats.h>
+#include <libsinsp/sinsp.h>
+#include <libscap/scap_config.h>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+using libsinsp::latency_histogram;
+using libsinsp::latency_stats;
+
+TEST(latency_histogram, buckets) {
+	// small values are exact
+	for(uint64_t v = 0; v < latency_histogram::SUB_BUCKETS; v++) {
+		ASSERT_EQ(latency_histogram::bucket_upper_bound(latency_histogram::bucket_index(v)), v);
+	}
+	// every value falls in a bucket whose upper bound is within 12.5%
+	for(uint64_t v : {8ULL, 9ULL, 100ULL, 1000ULL, 123456ULL, 1ULL << 40, ~0ULL}) {
+		uint32_t index = latency_histogram::bucket_index(v);
+		ASSERT_LT(index, latency_histogram::N_BUCKETS);
+		uint64_t upper = latency_histogram::bucket_upper_bound(index);
+		ASSERT_GE(upper, v);
+		ASSERT_LE(upper - v, v / latency_histogram::SUB_BUCKETS);
+	}
+	// buckets are ordered
+	for(uint32_t i = 1; i < latency_histogram::N_BUCKETS; i++) {
+		ASSERT_GT(latency_histogram::bucket_upper_bound(i),
+		          latency_histogram::bucket_upper_bound(i - 1));
+	}
+}
+
+TEST(latency_histogram, percentiles) {
+	latency_histogram h;
+	ASSERT_EQ(h.percentile(0.5), 0);
+
+	for(uint64_t v = 1; v <= 1000; v++) {
+		h.record(v * 1000);
+	}
+	ASSERT_EQ(h.count(), 1000);
+	ASSERT_EQ(h.max(), 1000000);
+	uint64_t p50 = h.percentile(0.5);
+	ASSERT_GE(p50, 500000);
+	ASSERT_LE(p50, 500000 + 500000 / latency_histogram::SUB_BUCKETS);
+	ASSERT_EQ(h.percentile(1.0), 1000000);
+
+	h.reset();
+	ASSERT_EQ(h.count(), 0);
+	ASSERT_EQ(h.max(), 0);
+}
+
+TEST(latency_stats, categories) {
+	ASSERT_EQ(latency_stats::from_event_category(EC_FILE | EC_SYSCALL), latency_stats::CAT_FILE);
+	ASSERT_EQ(latency_stats::from_event_category(EC_IO_READ | EC_SYSCALL), latency_stats::CAT_IO);
+	ASSERT_EQ(latency_stats::from_event_category(EC_PROCESS | EC_TRACEPOINT),
+	          latency_stats::CAT_PROCESS);
+	ASSERT_EQ(latency_stats::from_event_category(EC_SCHEDULER), latency_stats::CAT_OTHER);
+}
+
+#ifdef HAS_ENGINE_SYNTHETIC
+TEST(latency_stats, next_duration_metrics) {
+	scap_synthetic_engine_params params{};
+	params.seed = 1;
+	params.max_evts = 1000;
+
+	sinsp inspector;
+	ASSERT_EQ(inspector.get_latency_stats(), nullptr);
+	inspector.set_latency_stats(10);
+	inspector.open_synthetic(params);
+	sinsp_evt* evt = nullptr;
+	uint64_t n_evts = 0;
+	int32_t res;
+	while((res = inspector.next(&evt)) != SCAP_EOF) {
+		n_evts += (res == SCAP_SUCCESS || res == SCAP_FILTERED_EVENT) ? 1 : 0;
+	}
+
+	// one event every 10 is measured; the synthetic engine isn't live, so there is no
+	// delivery latency
+	const auto* stats = inspector.get_latency_stats();
+	ASSERT_NE(stats, nullptr);
+	ASSERT_GT(stats->next_duration().count(), 0);
+	ASSERT_LE(stats->next_duration().count(), n_evts / 10 + 1);
+	for(uint8_t cat = 0; cat < latency_stats::CAT_MAX; cat++) {
+		ASSERT_EQ(stats->delivery(static_cast<latency_stats::category>(cat)).count(), 0);
+	}
+
+	libs::metrics::libs_metrics_collector collector(&inspector, METRICS_V2_LATENCY);
+	collector.snapshot();
+	std::set<std::string> names;
+	for(const auto& m : collector.get_metrics()) {
+		ASSERT_EQ(m.flags, METRICS_V2_LATENCY);
+		names.insert(m.name);
+	}
+	ASSERT_EQ(names,
+	          std::set<std::string>({"next_duration_count",
+	                                 "next_duration_p50_ns",
+	                                 "next_duration_p99_ns",
+	                                 "next_duration_max_ns"}));
+
+	inspector.set_latency_stats(0);
+	ASSERT_EQ(inspector.get_latency_stats(), nullptr);
+}
+#endif
@@ -170,8 +170,8 @@ TEST_F(sinsp_with_test_input, CLONE_CALLER_new_main_thread) {
 	/* Parent clone exit event */
 	generate_clone_x_event(p1_t1_tid, INIT_TID, INIT_PID, INIT_PTID);
 	ASSERT_THREAD_INFO_PIDS(p1_t1_tid, p1_t1_pid, p1_t1_ptid)
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, 1, p1_t1_tid)
-	ASSERT_THREAD_CHILDREN(INIT_TID, 1, 1, p1_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, p1_t1_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 1, p1_t1_tid)
 }
 
 TEST_F(sinsp_with_test_input, CLONE_CALLER_flag_CLONE_PARENT) {
@@ -192,7 +192,7 @@ TEST_F(sinsp_with_test_input, CLONE_CALLER_flag_CLONE_PARENT) {
 	/* Parent clone exit event */
 	generate_clone_x_event(p1_t1_tid, INIT_TID, INIT_PID, INIT_PTID);
 	ASSERT_THREAD_INFO_PIDS(p1_t1_tid, p1_t1_pid, p1_t1_ptid)
-	ASSERT_THREAD_CHILDREN(INIT_TID, 1, 1, p1_t1_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 1, p1_t1_tid)
 
 	/* The process p1 creates a second process p2 with the `CLONE_PARENT` flag */
 	int64_t p2_t1_tid = 30;
@@ -209,12 +209,12 @@ TEST_F(sinsp_with_test_input, CLONE_CALLER_flag_CLONE_PARENT) {
 
 	generate_clone_x_event(0, p2_t1_tid, p2_t1_pid, p2_t1_ptid, PPM_CL_CLONE_PARENT);
 	ASSERT_THREAD_INFO_PIDS(p2_t1_tid, p2_t1_pid, p2_t1_ptid)
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, 1, p2_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, p2_t1_tid)
 
 	ASSERT_THREAD_INFO_FLAG(p2_t1_tid, PPM_CL_CLONE_PARENT, true);
 
 	/* Assert that init has 2 children */
-	ASSERT_THREAD_CHILDREN(INIT_TID, 2, 2, p1_t1_tid, p2_t1_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 2, p1_t1_tid, p2_t1_tid)
 }
 
 TEST_F(sinsp_with_test_input, CLONE_CALLER_flag_CLONE_THREAD) {
@@ -235,8 +235,8 @@ TEST_F(sinsp_with_test_input, CLONE_CALLER_flag_CLONE_THREAD) {
 	/* Parent clone exit event */
 	generate_clone_x_event(p1_t1_tid, INIT_TID, INIT_PID, INIT_PTID);
 	ASSERT_THREAD_INFO_PIDS(p1_t1_tid, p1_t1_pid, p1_t1_ptid)
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, 1, p1_t1_tid)
-	ASSERT_THREAD_CHILDREN(INIT_TID, 1, 1, p1_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, p1_t1_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 1, p1_t1_tid)
 
 	/* The process p1 creates a second thread p1_t2 */
 	int64_t p1_t2_tid = 25;
@@ -246,8 +246,8 @@ TEST_F(sinsp_with_test_input, CLONE_CALLER_flag_CLONE_THREAD) {
 	/* Parent clone exit event */
 	generate_clone_x_event(p1_t2_tid, p1_t1_tid, p1_t1_pid, p1_t1_ptid, PPM_CL_CLONE_THREAD);
 	ASSERT_THREAD_INFO_PIDS(p1_t2_tid, p1_t2_pid, p1_t2_ptid);
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, 2, p1_t1_tid, p1_t2_tid);
-	ASSERT_THREAD_CHILDREN(INIT_TID, 2, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 2, p1_t1_tid, p1_t2_tid);
 
 	ASSERT_THREAD_INFO_FLAG(p1_t2_tid, PPM_CL_CLONE_THREAD, true);
 	ASSERT_THREAD_INFO_FLAG(p1_t2_tid, PPM_CL_CLONE_FILES, true);
@@ -323,13 +323,13 @@ TEST_F(sinsp_with_test_input, CLONE_CALLER_missing_both_clone_events_create_lead
 	/* We use the clone caller exit event */
 	generate_clone_x_event(p3_t1_tid, p2_t1_tid, p2_t1_pid, p2_t1_ptid);
 	ASSERT_THREAD_INFO_PIDS(p3_t1_tid, p3_t1_pid, p3_t1_ptid);
-	ASSERT_THREAD_GROUP_INFO(p3_t1_pid, 1, false, 1, 1, p3_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p3_t1_pid, 1, false, 1, p3_t1_tid);
 
 	/* We should have created a valid thread info for p2_t1 */
 	ASSERT_THREAD_INFO_PIDS(p2_t1_tid, p2_t1_pid, p2_t1_ptid);
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, 1, p2_t1_tid);
-	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, 1, p3_t1_tid);
-	ASSERT_THREAD_CHILDREN(p1_t1_tid, 1, 1, p2_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, p2_t1_tid);
+	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, p3_t1_tid);
+	ASSERT_THREAD_CHILDREN(p1_t1_tid, 1, p2_t1_tid);
 }
 
 TEST_F(sinsp_with_test_input, CLONE_CALLER_missing_both_clone_events_create_secondary_threads) {
@@ -357,8 +357,8 @@ TEST_F(sinsp_with_test_input, CLONE_CALLER_missing_both_clone_events_create_seco
 
 	/* We should have created a valid thread info for p1_t1 */
 	ASSERT_THREAD_INFO_PIDS(p1_t1_tid, p1_t1_pid, p1_t1_ptid);
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, 2, p1_t1_tid, p1_t2_tid);
-	ASSERT_THREAD_CHILDREN(INIT_TID, 2, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 2, p1_t1_tid, p1_t2_tid);
 
 	/* We create also the new child of course */
 	ASSERT_THREAD_INFO_PIDS(p1_t2_tid, p1_t2_pid, p1_t2_ptid)
@@ -429,8 +429,8 @@ TEST_F(sinsp_with_test_input, CLONE_CHILD_in_container) {
 	                       p1_t1_vpid);
 
 	ASSERT_THREAD_INFO_PIDS_IN_CONTAINER(p1_t1_tid, p1_t1_pid, p1_t1_ptid, p1_t1_vtid, p1_t1_vpid)
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, 1, p1_t1_tid)
-	ASSERT_THREAD_CHILDREN(INIT_TID, 1, 1, p1_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, p1_t1_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 1, p1_t1_tid)
 }
 
 TEST_F(sinsp_with_test_input, CLONE_CHILD_already_there) {
@@ -512,8 +512,8 @@ TEST_F(sinsp_with_test_input, CLONE_CHILD_new_main_thread) {
 	/* Child clone exit event */
 	evt = generate_clone_x_event(0, p1_t1_tid, p1_t1_pid, p1_t1_ptid);
 	ASSERT_THREAD_INFO_PIDS(p1_t1_tid, p1_t1_pid, p1_t1_ptid)
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, 1, p1_t1_tid)
-	ASSERT_THREAD_CHILDREN(INIT_TID, 1, 1, p1_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, p1_t1_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 1, p1_t1_tid)
 
 	/* Check if the thread-info in the thread table is correctly assigned to our event */
 	sinsp_threadinfo* p1_t1_tinfo =
@@ -550,7 +550,7 @@ TEST_F(sinsp_with_test_input, CLONE_CHILD_flag_CLONE_PARENT) {
 	 */
 	generate_clone_x_event(0, p2_t1_tid, p2_t1_pid, p2_t1_ptid);  // omitted PPM_CL_CLONE_PARENT
 	ASSERT_THREAD_INFO_PIDS(p2_t1_tid, p2_t1_pid, p2_t1_ptid)
-	ASSERT_THREAD_CHILDREN(INIT_TID, 2, 2, p1_t1_tid, p2_t1_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 2, p1_t1_tid, p2_t1_tid)
 
 	ASSERT_THREAD_INFO_FLAG(p2_t1_tid, PPM_CL_CLONE_PARENT, false);
 }
@@ -577,8 +577,8 @@ TEST_F(sinsp_with_test_input, CLONE_CHILD_flag_CLONE_THREAD) {
 	generate_clone_x_event(0, p1_t2_tid, p1_t2_pid, p1_t2_ptid, PPM_CL_CLONE_THREAD);
 	ASSERT_THREAD_INFO_PIDS(p1_t2_tid, p1_t2_pid, p1_t2_ptid)
 
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, 2, p1_t1_tid, p1_t2_tid)
-	ASSERT_THREAD_CHILDREN(INIT_TID, 2, 2, p1_t1_tid, p1_t2_tid)
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, p1_t1_tid, p1_t2_tid)
+	ASSERT_THREAD_CHILDREN(INIT_TID, 2, p1_t1_tid, p1_t2_tid)
 
 	ASSERT_THREAD_INFO_FLAG(p1_t2_tid, PPM_CL_CLONE_THREAD, true);
 	ASSERT_THREAD_INFO_FLAG(p1_t2_tid, PPM_CL_CLONE_FILES, true);
@@ -647,8 +647,8 @@ TEST_F(sinsp_with_test_input, CLONE_CHILD_missing_both_clone_events_create_secon
 
 	/* We should have created a valid thread info for p1_t1 */
 	ASSERT_THREAD_INFO_PIDS(p1_t1_tid, p1_t1_pid, p1_t1_ptid);
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, 2, p1_t1_tid, p1_t2_tid);
-	ASSERT_THREAD_CHILDREN(INIT_TID, 2, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 2, p1_t1_tid, p1_t2_tid);
 
 	/* We create also the new child of course */
 	ASSERT_THREAD_INFO_PIDS(p1_t2_tid, p1_t2_pid, p1_t2_ptid)
@@ -28,7 +28,7 @@ TEST_F(sinsp_with_test_input, EXECVEAT_from_a_not_leader_thread) {
 	generate_execveat_enter_and_exit_event(0, p2_t2_tid, p2_t1_tid, p2_t1_pid, p2_t1_ptid);
 
 	/* we should have just one thread alive, the leader one */
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 3, 1, p2_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, p2_t1_tid);
 
 	/* we shouldn't be able to find other threads in the thread table */
 	ASSERT_MISSING_THREAD_INFO(p2_t2_tid, true);
@@ -43,7 +43,7 @@ TEST_F(sinsp_with_test_input, EXECVEAT_from_a_leader_thread) {
 	generate_execveat_enter_and_exit_event(0, p2_t1_tid, p2_t1_tid, p2_t1_pid, p2_t1_ptid);
 
 	/* we should have just one thread alive, the leader one */
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 3, 1, p2_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, p2_t1_tid);
 
 	/* we shouldn't be able to find other threads in the thread table */
 	ASSERT_MISSING_THREAD_INFO(p2_t2_tid, true);
@@ -60,23 +60,23 @@ TEST_F(sinsp_with_test_input, EXECVEAT_from_a_not_leader_thread_with_a_child) {
 	[[maybe_unused]] int64_t p7_t1_ptid = p2_t3_tid;
 
 	generate_clone_x_event(p7_t1_tid, p2_t3_tid, p2_t3_pid, p2_t3_ptid);
-	ASSERT_THREAD_CHILDREN(p2_t3_tid, 1, 1, p7_t1_tid);
+	ASSERT_THREAD_CHILDREN(p2_t3_tid, 1, p7_t1_tid);
 
 	/* Right now `p2_t1` has just one child */
-	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, 1, p3_t1_tid);
+	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, p3_t1_tid);
 
 	/* `p2_t2` calls an execveat and `p2_t1` will take control in the exit event */
 	generate_execveat_enter_and_exit_event(0, p2_t2_tid, p2_t1_tid, p2_t1_pid, p2_t1_ptid);
 
 	/* we should have just one thread alive, the leader one */
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 3, 1, p2_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, p2_t1_tid);
 
 	/* we shouldn't be able to find other threads in the thread table */
 	ASSERT_MISSING_THREAD_INFO(p2_t2_tid, true);
 	ASSERT_MISSING_THREAD_INFO(p2_t3_tid, true);
 
 	/* Now the father of `p7_t1` should be `p2_t1` */
-	ASSERT_THREAD_CHILDREN(p2_t1_tid, 2, 2, p3_t1_tid, p7_t1_tid);
+	ASSERT_THREAD_CHILDREN(p2_t1_tid, 2, p3_t1_tid, p7_t1_tid);
 }
 
 TEST_F(sinsp_with_test_input, EXECVEAT_resurrect_thread) {
@@ -90,8 +90,8 @@ TEST_F(sinsp_with_test_input, EXECVEAT_resurrect_thread) {
 
 	/* `p2t1` dies, p2t2 is the reaper */
 	remove_thread(p2_t1_tid, p2_t2_tid);
-	ASSERT_THREAD_CHILDREN(p2_t2_tid, 1, 1, p3_t1_tid);
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 2, false, 3, 3);
+	ASSERT_THREAD_CHILDREN(p2_t2_tid, 1, p3_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 2, false, 3);
 	auto p2_t1_tinfo = m_inspector.m_thread_manager->find_thread(p2_t1_tid, true).get();
 	ASSERT_TRUE(p2_t1_tinfo);
 	/* p2t1 is present but dead */
@@ -104,8 +104,8 @@ TEST_F(sinsp_with_test_input, EXECVEAT_resurrect_thread) {
 
 	/* The main thread is no more dead and it has again its children */
 	ASSERT_FALSE(p2_t1_tinfo->is_dead());
-	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, 1, p3_t1_tid);
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 3, 1);
+	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, p3_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1);
 	ASSERT_MISSING_THREAD_INFO(p2_t2_tid, true);
 	ASSERT_MISSING_THREAD_INFO(p2_t3_tid, true);
 }
@@ -129,8 +129,8 @@ TEST_F(sinsp_with_test_input, EXECVEAT_missing_process_execveat_repair) {
 	 * we are not in a container but we want to assert also vtid, vpid.
 	 */
 	ASSERT_THREAD_INFO_PIDS(p1_t1_tid, p1_t1_pid, p1_t1_ptid);
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, 1, p1_t1_tid);
-	ASSERT_THREAD_CHILDREN(INIT_TID, 1, 1, p1_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 1, false, 1, p1_t1_tid);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 1, p1_t1_tid);
 }
 
 TEST_F(sinsp_with_test_input, EXECVEAT_exepath_with_trusted_exepath) {
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <sinsp_with_test_input.h>
+
+TEST_F(sinsp_with_test_input, parse_io_summary) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = generate_open_x_event();
+	ASSERT_TRUE(evt->get_fd_info());
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.reads"), "0");
+
+	evt = add_event_advance_ts(increasing_ts(),
+	                           INIT_TID,
+	                           PPME_IO_SUMMARY_E,
+	                           6,
+	                           sinsp_test_input::open_params::default_fd,
+	                           (uint8_t)PPM_IO_SUMMARY_IN,
+	                           (uint64_t)10,
+	                           (uint64_t)4096,
+	                           (uint64_t)1000,
+	                           (uint64_t)2000);
+	ASSERT_TRUE(evt->get_fd_info());
+	ASSERT_EQ(get_field_as_string(evt, "fd.num"),
+	          std::to_string(sinsp_test_input::open_params::default_fd));
+	ASSERT_EQ(get_field_as_string(evt, "fd.name"), sinsp_test_input::open_params::default_path);
+	ASSERT_EQ(get_field_as_string(evt, "evt.arg.direction"), "IN");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.reads"), "10");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.read_bytes"), "4096");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.writes"), "0");
+
+	// The counters are cumulative.
+	evt = add_event_advance_ts(increasing_ts(),
+	                           INIT_TID,
+	                           PPME_IO_SUMMARY_E,
+	                           6,
+	                           sinsp_test_input::open_params::default_fd,
+	                           (uint8_t)PPM_IO_SUMMARY_IN,
+	                           (uint64_t)5,
+	                           (uint64_t)100,
+	                           (uint64_t)3000,
+	                           (uint64_t)4000);
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.reads"), "15");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.read_bytes"), "4196");
+
+	evt = add_event_advance_ts(increasing_ts(),
+	                           INIT_TID,
+	                           PPME_IO_SUMMARY_E,
+	                           6,
+	                           sinsp_test_input::open_params::default_fd,
+	                           (uint8_t)PPM_IO_SUMMARY_OUT,
+	                           (uint64_t)3,
+	                           (uint64_t)30,
+	                           (uint64_t)5000,
+	                           (uint64_t)6000);
+	ASSERT_EQ(get_field_as_string(evt, "evt.arg.direction"), "OUT");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.writes"), "3");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.write_bytes"), "30");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.reads"), "15");
+
+	// The fields are available on the following events of the fd as well.
+	std::string data = "hello";
+	uint32_t size = data.size();
+	evt = add_event_advance_ts(increasing_ts(),
+	                           INIT_TID,
+	                           PPME_SYSCALL_READ_X,
+	                           4,
+	                           (int64_t)size,
+	                           scap_const_sized_buffer{data.c_str(), size},
+	                           sinsp_test_input::open_params::default_fd,
+	                           size);
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.reads"), "15");
+	ASSERT_EQ(get_field_as_string(evt, "fd.summary.write_bytes"), "30");
+}
+
+TEST_F(sinsp_with_test_input, parse_io_summary_unknown_fd) {
+	add_default_init_thread();
+	open_inspector();
+
+	auto evt = add_event_advance_ts(increasing_ts(),
+	                                INIT_TID,
+	                                PPME_IO_SUMMARY_E,
+	                                6,
+	                                (int64_t)42,
+	                                (uint8_t)PPM_IO_SUMMARY_OUT,
+	                                (uint64_t)3,
+	                                (uint64_t)30,
+	                                (uint64_t)5000,
+	                                (uint64_t)6000);
+	ASSERT_FALSE(evt->get_fd_info());
+	ASSERT_FALSE(field_has_value(evt, "fd.summary.writes"));
+}
@@ -27,7 +27,7 @@ TEST_F(sinsp_with_test_input, PRCTL_failed) {
 	/* FAILED PPM_PR_SET_CHILD_SUBREAPER */
 
 	/* p2_t2 is not a reaper and shouldn't become it after the next call */
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3);
 
 	/* Let's imagine a prctl is called on `p2_t2` but it fails */
 	add_event_advance_ts(increasing_ts(),
@@ -40,7 +40,7 @@ TEST_F(sinsp_with_test_input, PRCTL_failed) {
 	                     (int64_t)1);
 
 	/* p2_t2_pid shouldn't be a reaper */
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3);
 
 	/* FAILED PPM_PR_GET_CHILD_SUBREAPER */
 
@@ -55,7 +55,7 @@ TEST_F(sinsp_with_test_input, PRCTL_failed) {
 	                     (int64_t)1);
 
 	/* p2_t2_pid shouldn't be a reaper */
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3);
 
 	/* INVALID THREAD INFO */
 
@@ -98,7 +98,7 @@ TEST_F(sinsp_with_test_input, PRCTL_set_child_subreaper) {
 	/* SET CHILD_SUBREAPER */
 
 	/* p2_t2 is not a reaper and should become it after the next call */
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3);
 
 	/* Let's imagine a prctl is called on `p2_t2`. Parameter 4 could
 	 * be anything greater than 1.
@@ -112,7 +112,7 @@ TEST_F(sinsp_with_test_input, PRCTL_set_child_subreaper) {
 	                     "<NA>",
 	                     (int64_t)80);
 
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, true, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, true, 3);
 
 	/* UNSET CHILD_SUBREAPER */
 
@@ -129,7 +129,7 @@ TEST_F(sinsp_with_test_input, PRCTL_set_child_subreaper) {
 	                     (int64_t)0);
 
 	/* p2_t2 group should have reaper==false */
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3);
 }
 
 TEST_F(sinsp_with_test_input, PRCTL_get_child_subreaper) {
@@ -139,7 +139,7 @@ TEST_F(sinsp_with_test_input, PRCTL_get_child_subreaper) {
 	/* SET CHILD_SUBREAPER */
 
 	/* p2_t2 is not a reaper and should become it after the next call */
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3);
 
 	/* Let's imagine a prctl is called on `p2_t2` */
 	add_event_advance_ts(increasing_ts(),
@@ -151,7 +151,7 @@ TEST_F(sinsp_with_test_input, PRCTL_get_child_subreaper) {
 	                     "<NA>",
 	                     (int64_t)1);
 
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, true, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, true, 3);
 
 	/* UNSET CHILD_SUBREAPER */
 
@@ -166,7 +166,7 @@ TEST_F(sinsp_with_test_input, PRCTL_get_child_subreaper) {
 	                     (int64_t)0);
 
 	/* p2_t2 group should have reaper==false */
-	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t2_pid, 3, false, 3);
 }
 
 /*=============================== PRCTL EXIT EVENT ===========================*/
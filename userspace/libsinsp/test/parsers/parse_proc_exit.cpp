@@ -24,7 +24,7 @@ TEST_F(sinsp_with_test_input, PROC_EXIT_not_existent_thread) {
 	DEFAULT_TREE
 
 	/* Before this proc exit init had 5 children */
-	ASSERT_THREAD_CHILDREN(INIT_TID, 5, 5);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 5);
 
 	/* we call the proc_exit event on a not existing thread and we
 	 * say the reaper is: 1
@@ -35,23 +35,23 @@ TEST_F(sinsp_with_test_input, PROC_EXIT_not_existent_thread) {
 	/* The thread info associated with the event should be null and INIT should have the same number
 	 * of children */
 	ASSERT_FALSE(evt->get_thread_info());
-	ASSERT_THREAD_CHILDREN(INIT_TID, 5, 5);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 5);
 }
 
 TEST_F(sinsp_with_test_input, PROC_EXIT_no_children) {
 	DEFAULT_TREE
 
 	/* Before this proc exit init had 5 children */
-	ASSERT_THREAD_CHILDREN(INIT_TID, 5, 5);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 5);
 
 	/* Scaffolding needed to call the PPME_PROCEXIT_1_E */
 	auto evt = generate_proc_exit_event(p5_t1_tid, INIT_TID);
 
 	/* INIT should have the same number of children */
-	ASSERT_THREAD_CHILDREN(INIT_TID, 5, 5);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 5);
 
 	/* After the PROC_EXIT event we still have the thread but it is marked as dead */
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, 2);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2);
 
 	/* The reaper of p5_t1_tinfo should be always -1, p5_t1 has no children so we don't set it */
 	auto p5_t1_tinfo = evt->get_thread_info();
@@ -73,10 +73,10 @@ TEST_F(sinsp_with_test_input, PROC_EXIT_reaper_0) {
 	auto evt = generate_proc_exit_event(p5_t2_tid, 0);
 
 	/* we don't remove the children from p5_t2 */
-	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, p6_t1_tid);
 
 	/* After the PROC_EXIT event we still have the thread but it is marked as dead */
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, 2);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2);
 
 	auto p5_t2_tinfo = evt->get_thread_info();
 	ASSERT_TRUE(p5_t2_tinfo);
@@ -97,10 +97,10 @@ TEST_F(sinsp_with_test_input, PROC_EXIT_negative_reaper) {
 	auto evt = generate_proc_exit_event(p5_t2_tid, -1);
 
 	/* we don't remove the children from p5_t2 */
-	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, p6_t1_tid);
 
 	/* After the PROC_EXIT event we still have the thread but it is marked as dead */
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, 2);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2);
 
 	auto p5_t2_tinfo = evt->get_thread_info();
 	ASSERT_TRUE(p5_t2_tinfo);
@@ -130,10 +130,10 @@ TEST_F(sinsp_with_test_input, PROC_EXIT_already_dead_thread) {
 	/* After the PROC_EXIT event we still have the thread and
 	 * the thread count is not decremented.
 	 */
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 2, false, 2, 2);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 2, false, 2);
 
 	/* we don't remove the children from p5_t2 */
-	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, p6_t1_tid);
 
 	p5_t2_tinfo = evt->get_thread_info();
 	ASSERT_TRUE(p5_t2_tinfo);
@@ -152,10 +152,10 @@ TEST_F(sinsp_with_test_input, PROC_EXIT_positive_reaper) {
 	auto evt = generate_proc_exit_event(p5_t2_tid, 8000);
 
 	/* we don't remove the children from p5_t2 */
-	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, p6_t1_tid);
 
 	/* After the PROC_EXIT event we still have the thread but it is marked as dead */
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, 2);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2);
 
 	auto p5_t2_tinfo = evt->get_thread_info();
 	ASSERT_TRUE(p5_t2_tinfo);
@@ -181,10 +181,10 @@ TEST_F(sinsp_with_test_input, PROC_EXIT_no_reaper) {
 	                                                  (int64_t)0);  // reaper_tid
 
 	/* we don't remove the children from p5_t2 */
-	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, p6_t1_tid);
 
 	/* After the PROC_EXIT event we still have the thread but it is marked as dead */
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, 2);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2);
 
 	auto p5_t2_tinfo = evt->get_thread_info();
 	ASSERT_TRUE(p5_t2_tinfo);
@@ -217,7 +217,9 @@ const libsinsp::events::set<ppm_event_code> expected_sinsp_state_event_set = {
         PPME_SYSCALL_SETREUID_X,
         PPME_SYSCALL_SETREGID_E,
         PPME_SYSCALL_SETREGID_X,
-        PPME_SYSCALL_CLOSE_RANGE_X};
+        PPME_SYSCALL_CLOSE_RANGE_X,
+        PPME_RATE_LIMIT_E,
+        PPME_IO_SUMMARY_E};
 
 const libsinsp::events::set<ppm_sc_code> expected_sinsp_state_sc_set = {
         PPM_SC_ACCEPT,
@@ -328,6 +330,8 @@ const libsinsp::events::set<ppm_event_code> expected_unknown_event_set = {
         PPME_ITER_TASK_FILE_ANON_INODE_X,
         PPME_SYSCALL_CLOSE_RANGE_E,
         PPME_SYSCALL_KEYCTL_E,
+        PPME_RATE_LIMIT_X,
+        PPME_IO_SUMMARY_X,
 };
 
 /// todo(@Andreagit97): here we miss static sets for io, proc, net groups
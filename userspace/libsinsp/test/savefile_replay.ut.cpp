@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/sinsp.h>
+#include <libsinsp/dumper.h>
+#include <libscap/scap_config.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#if defined(HAS_ENGINE_SYNTHETIC) && defined(HAS_ENGINE_SAVEFILE)
+
+namespace {
+constexpr uint64_t N_EVTS = 200;
+
+std::string write_capture() {
+	char path[] = "/tmp/libsinsp-replay-XXXXXX";
+	int fd = mkstemp(path);
+	if(fd >= 0) {
+		close(fd);
+	}
+
+	scap_synthetic_engine_params params{};
+	params.seed = 42;
+	params.max_evts = N_EVTS;
+	params.n_procs = 4;
+
+	sinsp inspector;
+	inspector.open_synthetic(params);
+	sinsp_dumper dumper;
+	dumper.open(&inspector, path, false);
+	sinsp_evt* evt = nullptr;
+	while(inspector.next(&evt) != SCAP_EOF) {
+		if(evt != nullptr) {
+			dumper.dump(evt);
+		}
+	}
+	dumper.close();
+	inspector.close();
+	return path;
+}
+
+std::vector<uint64_t> consume(sinsp& inspector) {
+	std::vector<uint64_t> ts;
+	sinsp_evt* evt = nullptr;
+	int32_t res;
+	while((res = inspector.next(&evt)) != SCAP_EOF) {
+		EXPECT_TRUE(res == SCAP_SUCCESS || res == SCAP_FILTERED_EVENT) << inspector.getlasterr();
+		if(res == SCAP_SUCCESS) {
+			ts.push_back(evt->get_ts());
+		}
+	}
+	return ts;
+}
+
+uint64_t get_metric(const sinsp& inspector, const char* name) {
+	uint32_t nstats = 0;
+	int32_t rc = 0;
+	auto stats = inspector.get_capture_stats_v2(METRICS_V2_MISC, &nstats, &rc);
+	for(uint32_t i = 0; i < nstats; i++) {
+		if(strcmp(stats[i].name, name) == 0) {
+			return stats[i].value.u64;
+		}
+	}
+	ADD_FAILURE() << "metric " << name << " not found";
+	return 0;
+}
+}  // namespace
+
+TEST(savefile_replay, fixed_rate_with_rebase) {
+	const std::string path = write_capture();
+	const uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+	                                std::chrono::system_clock::now().time_since_epoch())
+	                                .count();
+
+	sinsp inspector;
+	inspector.set_savefile_replay(0, 2000, true);
+	inspector.open_savefile(path);
+	auto start = std::chrono::steady_clock::now();
+	auto ts = consume(inspector);
+	auto elapsed = std::chrono::steady_clock::now() - start;
+
+	ASSERT_FALSE(ts.empty());
+	// 2000 evts/s: the last event can't be delivered before (n - 1) / 2000 s
+	uint64_t n_evts = get_metric(inspector, "savefile_replay_n_evts");
+	ASSERT_GE(n_evts, ts.size());
+	ASSERT_GE(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+	          (int64_t)((n_evts - 1) * 500));
+
+	// timestamps are rebased to the start of the replay and follow the rate
+	ASSERT_GE(ts.front(), now_ns);
+	ASSERT_LT(ts.front(), now_ns + 60ULL * 1000 * 1000 * 1000);
+	for(size_t i = 1; i < ts.size(); i++) {
+		ASSERT_GE(ts[i], ts[i - 1]);
+	}
+	ASSERT_GE(get_metric(inspector, "savefile_replay_jitter_max_ns"),
+	          get_metric(inspector, "savefile_replay_jitter_avg_ns"));
+	get_metric(inspector, "savefile_replay_n_late");
+
+	inspector.close();
+	std::remove(path.c_str());
+}
+
+TEST(savefile_replay, disabled_by_default) {
+	const std::string path = write_capture();
+
+	sinsp original;
+	original.open_savefile(path);
+	auto a = consume(original);
+
+	uint32_t nstats = 0;
+	int32_t rc = 0;
+	original.get_capture_stats_v2(METRICS_V2_MISC, &nstats, &rc);
+	ASSERT_EQ(rc, SCAP_SUCCESS);
+	ASSERT_EQ(nstats, 0);
+	original.close();
+
+	// at a very high speed the stream is the same, only paced
+	sinsp replayed;
+	replayed.set_savefile_replay(1000000.0);
+	replayed.open_savefile(path);
+	auto b = consume(replayed);
+	ASSERT_EQ(a, b);
+	replayed.close();
+
+	std::remove(path.c_str());
+}
+
+#endif
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/sinsp.h>
+#include <libsinsp/scap_open_exception.h>
+#include <libscap/scap_config.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unistd.h>
+
+#if defined(HAS_ENGINE_SHM) && defined(HAS_ENGINE_SYNTHETIC)
+
+namespace {
+std::string shm_name(const char* test) {
+	return "/sinsp_ut_" + std::string(test) + "_" + std::to_string(getpid());
+}
+
+scap_synthetic_engine_params io_params(uint64_t max_evts) {
+	scap_synthetic_engine_params params{};
+	params.seed = 42;
+	params.max_evts = max_evts;
+	params.n_procs = 8;
+	params.n_fds = 4;
+	// only I/O after the bootstrap, so that the first 8 processes stay alive
+	params.mix.read = 1;
+	params.mix.write = 1;
+	return params;
+}
+
+// Publish the events of `producer` until it reaches EOF or `n` events.
+uint64_t publish(sinsp& producer, sinsp_shm_publisher& publisher, uint64_t n = UINT64_MAX) {
+	sinsp_evt* evt = nullptr;
+	uint64_t published = 0;
+	while(published < n && producer.next(&evt) != SCAP_EOF) {
+		publisher.publish(evt);
+		published++;
+	}
+	return published;
+}
+
+// Consume events until the ring is empty, or until EOF.
+uint64_t consume(sinsp& consumer, bool until_eof) {
+	sinsp_evt* evt = nullptr;
+	uint64_t n = 0;
+	while(true) {
+		int32_t res = consumer.next(&evt);
+		if(res == SCAP_EOF || (res == SCAP_TIMEOUT && !until_eof)) {
+			break;
+		}
+		EXPECT_TRUE(res == SCAP_SUCCESS || res == SCAP_FILTERED_EVENT || res == SCAP_TIMEOUT)
+		        << consumer.getlasterr();
+		// The consumer runs in live mode and notifies the users and groups it
+		// discovers with async events of its own: only count the published ones.
+		if((res == SCAP_SUCCESS || res == SCAP_FILTERED_EVENT) &&
+		   evt->get_type() != PPME_USER_ADDED_E && evt->get_type() != PPME_GROUP_ADDED_E) {
+			n++;
+		}
+	}
+	return n;
+}
+}  // namespace
+
+TEST(shm_engine, fan_out) {
+	const auto name = shm_name("fan_out");
+	sinsp producer;
+	producer.open_synthetic(io_params(3000));
+
+	sinsp_shm_publisher publisher;
+	publisher.open(&producer, name);
+
+	sinsp first;
+	first.open_shm(name);
+	sinsp second;
+	second.open_shm(name);
+
+	ASSERT_EQ(publish(producer, publisher), 3000);
+	ASSERT_EQ(publisher.published_events(), 3000);
+	publisher.close();
+
+	ASSERT_EQ(consume(first, true), 3000);
+	ASSERT_EQ(consume(second, true), 3000);
+
+	scap_stats stats{};
+	first.get_capture_stats(&stats);
+	ASSERT_EQ(stats.n_evts, 3000);
+	ASSERT_EQ(stats.n_drops, 0);
+
+	for(int64_t tid = 1000; tid < 1008; tid++) {
+		auto tinfo = first.m_thread_manager->find_thread(tid, true);
+		ASSERT_NE(tinfo, nullptr);
+		ASSERT_FALSE(tinfo->m_comm.empty());
+	}
+}
+
+TEST(shm_engine, late_consumer_gets_state) {
+	const auto name = shm_name("late_consumer");
+	sinsp producer;
+	producer.open_synthetic(io_params(0));
+
+	sinsp_shm_publisher publisher;
+	publisher.open(&producer, name);
+	publish(producer, publisher, 2000);
+	publisher.publish_state();
+
+	// The thread table comes from the snapshot, before reading any event.
+	sinsp consumer;
+	consumer.open_shm(name);
+	for(int64_t tid = 1000; tid < 1008; tid++) {
+		auto expected = producer.m_thread_manager->find_thread(tid, true);
+		auto tinfo = consumer.m_thread_manager->find_thread(tid, true);
+		ASSERT_NE(expected, nullptr);
+		ASSERT_NE(tinfo, nullptr);
+		ASSERT_EQ(tinfo->m_comm, expected->m_comm);
+		ASSERT_EQ(tinfo->m_exepath, expected->m_exepath);
+		ASSERT_EQ(tinfo->m_args, expected->m_args);
+		ASSERT_EQ(tinfo->get_fd_table()->size(), expected->get_fd_table()->size());
+	}
+
+	// Only the events after the snapshot are delivered.
+	ASSERT_EQ(consume(consumer, false), 0);
+	publish(producer, publisher, 100);
+	ASSERT_EQ(consume(consumer, false), 100);
+
+	scap_stats stats{};
+	consumer.get_capture_stats(&stats);
+	ASSERT_EQ(stats.n_drops, 0);
+}
+
+TEST(shm_engine, slow_consumer_drops) {
+	const auto name = shm_name("slow_consumer");
+	sinsp producer;
+	producer.open_synthetic(io_params(20000));
+
+	sinsp_shm_publisher publisher;
+	publisher.open(&producer, name, 64 * 1024);
+
+	sinsp consumer;
+	consumer.open_shm(name);
+
+	// The producer never waits: the consumer keeps up with the small bursts
+	// and is lapped by the large ones.
+	uint64_t n = 0;
+	for(int i = 0; i < 10; i++) {
+		ASSERT_EQ(publish(producer, publisher, 100), 100);
+		n += consume(consumer, false);
+		ASSERT_EQ(publish(producer, publisher, 1900), 1900);
+		n += consume(consumer, false);
+	}
+	publisher.close();
+	n += consume(consumer, true);
+	ASSERT_GE(n, 1000);
+	ASSERT_LT(n, 20000);
+
+	scap_stats stats{};
+	consumer.get_capture_stats(&stats);
+	ASSERT_EQ(stats.n_evts, n);
+	ASSERT_EQ(stats.n_evts + stats.n_drops, 20000);
+}
+
+TEST(shm_engine, missing_shm) {
+	sinsp consumer;
+	ASSERT_THROW(consumer.open_shm(shm_name("missing")), scap_open_exception);
+}
+
+#endif
@@ -35,7 +35,7 @@ TEST_F(sinsp_with_test_input, sinsp_libs_metrics_collector_prometheus) {
 
 	libs_metrics_collector.snapshot();
 	auto metrics_snapshot = libs_metrics_collector.get_metrics();
-	ASSERT_EQ(metrics_snapshot.size(), 26);
+	ASSERT_EQ(metrics_snapshot.size(), 28);
 
 	/* Test prometheus_metrics_converter.convert_metric_to_text_prometheus */
 	std::string prometheus_text;
@@ -77,10 +77,10 @@ testns_falco_memory_rss_bytes )";
 	        "cpu_usage_ratio memory_rss_bytes memory_vsz_bytes memory_pss_bytes "
 	        "container_memory_used_bytes host_cpu_usage_ratio host_memory_used_bytes "
 	        "host_procs_running host_open_fds n_threads n_fds n_noncached_fd_lookups "
-	        "n_cached_fd_lookups n_failed_fd_lookups n_added_fds n_removed_fds n_stored_evts "
-	        "n_store_evts_drops n_retrieved_evts n_retrieve_evts_drops n_noncached_thread_lookups "
-	        "n_cached_thread_lookups n_failed_thread_lookups n_added_threads n_removed_threads "
-	        "n_drops_full_threadtable");
+	        "n_cached_fd_lookups n_failed_fd_lookups n_added_fds n_removed_fds n_evicted_fds "
+	        "n_stored_evts n_store_evts_drops n_retrieved_evts n_retrieve_evts_drops "
+	        "n_noncached_thread_lookups n_cached_thread_lookups n_failed_thread_lookups "
+	        "n_added_threads n_removed_threads n_evicted_threads n_drops_full_threadtable");
 
 	// Test global wrapper base metrics plus test invalid characters sanitization for the metric and
 	// label names (pseudo metrics)
@@ -271,7 +271,7 @@ TEST_F(sinsp_with_test_input, sinsp_libs_metrics_collector_output_rule) {
 	libs_metrics_collector.snapshot();
 	libs_metrics_collector.snapshot();
 	metrics_snapshot = libs_metrics_collector.get_metrics();
-	ASSERT_EQ(metrics_snapshot.size(), 26);
+	ASSERT_EQ(metrics_snapshot.size(), 28);
 
 	/* These names should always be available, note that we currently can't check for the merged
 	 * scap stats metrics here */
@@ -372,13 +372,13 @@ TEST_F(sinsp_with_test_input, sinsp_libs_metrics_collector_output_rule) {
 	libs::metrics::libs_metrics_collector libs_metrics_collector6(&m_inspector, test_metrics_flags);
 	libs_metrics_collector6.snapshot();
 	metrics_snapshot = libs_metrics_collector6.get_metrics();
-	ASSERT_EQ(metrics_snapshot.size(), 17);
+	ASSERT_EQ(metrics_snapshot.size(), 19);
 
 	test_metrics_flags = (METRICS_V2_RESOURCE_UTILIZATION | METRICS_V2_STATE_COUNTERS);
 	libs::metrics::libs_metrics_collector libs_metrics_collector7(&m_inspector, test_metrics_flags);
 	libs_metrics_collector7.snapshot();
 	metrics_snapshot = libs_metrics_collector7.get_metrics();
-	ASSERT_EQ(metrics_snapshot.size(), 26);
+	ASSERT_EQ(metrics_snapshot.size(), 28);
 }
 
 TEST(sinsp_libs_metrics, sinsp_libs_metrics_convert_units) {
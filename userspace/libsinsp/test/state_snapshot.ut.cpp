@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libscap/scap_config.h>
+#include <libsinsp/sinsp.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#if defined(HAS_ENGINE_NODRIVER) && defined(HAS_ENGINE_SAVEFILE)
+
+namespace {
+// Far above the default pid_max, so that it can't be alive.
+constexpr int64_t GHOST_TID = 1 << 30;
+
+std::string snapshot_path(const char* test) {
+	return "/tmp/sinsp_ut_" + std::string(test) + "_" + std::to_string(getpid()) + ".scap";
+}
+
+std::string self_comm() {
+	std::ifstream f("/proc/self/comm");
+	std::string comm;
+	std::getline(f, comm);
+	return comm;
+}
+
+// Threads are added by hand: the /proc scan may not be allowed to read the
+// other processes where the tests run.
+void add_process(sinsp& inspector, int64_t tid, const std::string& comm) {
+	auto tinfo = inspector.get_threadinfo_factory().create();
+	tinfo->m_tid = tid;
+	tinfo->m_pid = tid;
+	tinfo->m_ptid = 1;
+	tinfo->m_comm = comm;
+	tinfo->m_exe = "/usr/bin/" + comm;
+	tinfo->m_exepath = "/usr/bin/" + comm;
+	auto added = inspector.m_thread_manager->add_thread(std::move(tinfo), true);
+
+	auto fdinfo = inspector.get_fdinfo_factory().create();
+	fdinfo->m_type = SCAP_FD_FILE_V2;
+	fdinfo->m_name = "/var/log/" + comm + ".log";
+	added->add_fd(3, std::move(fdinfo));
+}
+}  // namespace
+
+TEST(state_snapshot, save_and_restore) {
+	const auto path = snapshot_path("save_and_restore");
+	const int64_t self = getpid();
+
+	sinsp before;
+	before.open_nodriver(true);
+	add_process(before, self, self_comm());
+	add_process(before, GHOST_TID, "ghost");
+	before.save_state_snapshot(path);
+
+	sinsp after;
+	after.set_state_snapshot_path(path);
+	after.open_nodriver(true);
+	std::remove(path.c_str());
+
+	auto tinfo = after.m_thread_manager->find_thread(self, true);
+	ASSERT_NE(tinfo, nullptr);
+	ASSERT_EQ(tinfo->m_comm, self_comm());
+	ASSERT_EQ(tinfo->m_exepath, "/usr/bin/" + self_comm());
+	auto fdinfo = tinfo->get_fd(3);
+	ASSERT_NE(fdinfo, nullptr);
+	ASSERT_EQ(fdinfo->m_name, "/var/log/" + self_comm() + ".log");
+
+	// The reconciliation with /proc drops the threads that are gone.
+	ASSERT_NE(before.m_thread_manager->find_thread(GHOST_TID, true), nullptr);
+	ASSERT_EQ(after.m_thread_manager->find_thread(GHOST_TID, true), nullptr);
+	ASSERT_EQ(after.m_thread_manager->get_thread_count(),
+	          before.m_thread_manager->get_thread_count() - 1);
+
+	// The users and groups saved as events are replayed, but the restored
+	// state doesn't count as captured events.
+	ASSERT_EQ(after.get_num_events(), 0);
+}
+
+TEST(state_snapshot, missing_snapshot_scans_proc) {
+	sinsp scanned;
+	scanned.open_nodriver(true);
+
+	sinsp inspector;
+	inspector.set_state_snapshot_path(snapshot_path("missing_snapshot"));
+	ASSERT_NO_THROW(inspector.open_nodriver(true));
+	ASSERT_EQ(inspector.m_thread_manager->get_thread_count(),
+	          scanned.m_thread_manager->get_thread_count());
+}
+
+#endif
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+/*
+Copyright (C) 2026 The Falco Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include <libsinsp/sinsp.h>
+#include <libscap/scap_config.h>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#ifdef HAS_ENGINE_SYNTHETIC
+
+namespace {
+struct evt_summary {
+	uint64_t ts;
+	int64_t tid;
+	uint16_t type;
+
+	bool operator==(const evt_summary& o) const {
+		return ts == o.ts && tid == o.tid && type == o.type;
+	}
+};
+
+std::vector<evt_summary> consume(sinsp& inspector) {
+	std::vector<evt_summary> out;
+	sinsp_evt* evt = nullptr;
+	int32_t res;
+	while((res = inspector.next(&evt)) != SCAP_EOF) {
+		EXPECT_TRUE(res == SCAP_SUCCESS || res == SCAP_FILTERED_EVENT) << inspector.getlasterr();
+		if(res == SCAP_SUCCESS) {
+			out.push_back({evt->get_ts(), evt->get_tid(), evt->get_type()});
+		}
+	}
+	return out;
+}
+}  // namespace
+
+TEST(synthetic_engine, deterministic_stream) {
+	scap_synthetic_engine_params params{};
+	params.seed = 1234;
+	params.max_evts = 5000;
+	params.n_procs = 16;
+	params.n_containers = 4;
+
+	sinsp first;
+	first.open_synthetic(params);
+	auto a = consume(first);
+
+	sinsp second;
+	second.open_synthetic(params);
+	auto b = consume(second);
+
+	ASSERT_EQ(a.size(), params.max_evts);
+	ASSERT_TRUE(a == b);
+
+	params.seed = 4321;
+	sinsp third;
+	third.open_synthetic(params);
+	auto c = consume(third);
+	ASSERT_EQ(c.size(), params.max_evts);
+	ASSERT_FALSE(a == c);
+}
+
+TEST(synthetic_engine, builds_state) {
+	scap_synthetic_engine_params params{};
+	params.seed = 1;
+	params.max_evts = 2000;
+	params.n_procs = 8;
+	params.n_fds = 4;
+	params.n_containers = 2;
+	// only I/O after the bootstrap, so that the first 8 processes stay alive
+	params.mix.read = 1;
+	params.mix.write = 1;
+
+	sinsp inspector;
+	inspector.open_synthetic(params);
+	consume(inspector);
+
+	uint32_t n_containers = 0;
+	for(int64_t tid = 1000; tid < 1000 + params.n_procs; tid++) {
+		auto tinfo = inspector.m_thread_manager->find_thread(tid, true);
+		ASSERT_NE(tinfo, nullptr);
+		ASSERT_EQ(tinfo->m_pid, tid);
+		ASSERT_FALSE(tinfo->m_comm.empty());
+		if(tinfo->get_cgroup("cpuset").find("/docker/") != std::string::npos) {
+			n_containers++;
+		}
+		// every read/write opens its fd first, so the fd tables can't be empty
+		ASSERT_GT(tinfo->get_fd_table()->size(), 0);
+	}
+	ASSERT_EQ(n_containers, params.n_procs);
+}
+
+TEST(synthetic_engine, default_mix_has_every_family) {
+	scap_synthetic_engine_params params{};
+	params.seed = 7;
+	params.max_evts = 20000;
+
+	sinsp inspector;
+	inspector.open_synthetic(params);
+	auto evts = consume(inspector);
+
+	std::set<uint16_t> types;
+	for(const auto& e : evts) {
+		types.insert(e.type);
+	}
+	for(auto type : {PPME_SYSCALL_CLONE_20_X,
+	                 PPME_SYSCALL_EXECVE_19_X,
+	                 PPME_SYSCALL_OPEN_X,
+	                 PPME_SYSCALL_READ_X,
+	                 PPME_SYSCALL_WRITE_X,
+	                 PPME_SOCKET_SOCKET_X,
+	                 PPME_SOCKET_CONNECT_X,
+	                 PPME_SYSCALL_CLOSE_X,
+	                 PPME_PROCEXIT_1_E}) {
+		ASSERT_TRUE(types.count(type)) << "missing event type " << type;
+	}
+}
+
+#endif
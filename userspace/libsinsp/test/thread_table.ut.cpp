@@ -41,20 +41,20 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_check_default_tree) {
 	ASSERT_THREAD_INFO_PIDS_IN_CONTAINER(p6_t1_tid, p6_t1_pid, p6_t1_ptid, p6_t1_vtid, p6_t1_vpid);
 
 	/* Check Thread group info */
-	ASSERT_THREAD_GROUP_INFO(INIT_PID, 1, true, 1, 1, INIT_TID);
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, 2, p1_t1_tid, p1_t2_tid);
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, false, 3, 3, p2_t1_tid, p2_t2_tid, p2_t3_tid);
-	ASSERT_THREAD_GROUP_INFO(p3_t1_pid, 1, false, 1, 1, p3_t1_tid);
-	ASSERT_THREAD_GROUP_INFO(p4_t2_pid, 2, true, 2, 2, p4_t1_tid, p4_t2_tid);
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 2, false, 2, 2, p5_t1_tid, p5_t2_tid);
-	ASSERT_THREAD_GROUP_INFO(p6_t1_pid, 1, false, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(INIT_PID, 1, true, 1, INIT_TID);
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, false, 3, p2_t1_tid, p2_t2_tid, p2_t3_tid);
+	ASSERT_THREAD_GROUP_INFO(p3_t1_pid, 1, false, 1, p3_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p4_t2_pid, 2, true, 2, p4_t1_tid, p4_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 2, false, 2, p5_t1_tid, p5_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p6_t1_pid, 1, false, 1, p6_t1_tid);
 
 	/* Check children */
-	ASSERT_THREAD_CHILDREN(INIT_TID, 5, 5, p1_t1_tid, p1_t2_tid, p2_t1_tid, p2_t2_tid, p2_t3_tid);
-	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, 1, p3_t1_tid);
-	ASSERT_THREAD_CHILDREN(p3_t1_tid, 2, 2, p4_t1_tid, p4_t2_tid);
-	ASSERT_THREAD_CHILDREN(p4_t2_tid, 2, 2, p5_t1_tid, p5_t2_tid);
-	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 5, p1_t1_tid, p1_t2_tid, p2_t1_tid, p2_t2_tid, p2_t3_tid);
+	ASSERT_THREAD_CHILDREN(p2_t1_tid, 1, p3_t1_tid);
+	ASSERT_THREAD_CHILDREN(p3_t1_tid, 2, p4_t1_tid, p4_t2_tid);
+	ASSERT_THREAD_CHILDREN(p4_t2_tid, 2, p5_t1_tid, p5_t2_tid);
+	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, p6_t1_tid);
 }
 
 TEST_F(sinsp_with_test_input, THRD_TABLE_missing_init_in_proc) {
@@ -91,7 +91,7 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_check_init_process_creation) {
 	ASSERT_TRUE(tinfo->m_tginfo);
 	ASSERT_EQ(tinfo->m_tginfo->get_thread_count(), 1);
 	ASSERT_EQ(tinfo->m_tginfo->is_reaper(), true);
-	ASSERT_EQ(tinfo->m_tginfo->get_thread_list().front().lock().get(), tinfo);
+	ASSERT_EQ(tinfo->m_tginfo->get_thread_list().front(), tinfo);
 }
 
 TEST_F(sinsp_with_test_input, THRD_TABLE_create_thread_dependencies_after_proc_scan) {
@@ -159,15 +159,15 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_create_thread_dependencies_after_proc_s
 	ASSERT_EQ(8, thread_manager->get_thread_count());
 
 	/* Children */
-	ASSERT_THREAD_CHILDREN(INIT_TID, 2, 2, p1_t1_tid, p1_t2_tid);
-	ASSERT_THREAD_CHILDREN(p1_t1_tid, 1, 1, p2_t1_tid);
-	ASSERT_THREAD_CHILDREN(p1_t3_tid, 0, 0);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_CHILDREN(p1_t1_tid, 1, p2_t1_tid);
+	ASSERT_THREAD_CHILDREN(p1_t3_tid, 0);
 
 	/* Thread group */
-	ASSERT_THREAD_GROUP_INFO(INIT_PID, 3, true, 3, 3, INIT_TID, init_t2_tid, init_t3_tid);
-	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, 2, p1_t1_tid, p1_t2_tid);
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, 1, p2_t1_tid)
-	ASSERT_THREAD_GROUP_INFO(p3_t1_pid, 1, false, 1, 1, p3_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(INIT_PID, 3, true, 3, INIT_TID, init_t2_tid, init_t3_tid);
+	ASSERT_THREAD_GROUP_INFO(p1_t1_pid, 2, false, 2, p1_t1_tid, p1_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 1, p2_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(p3_t1_pid, 1, false, 1, p3_t1_tid)
 
 	auto p1_t3_tinfo = thread_manager->find_thread(p1_t3_tid, true).get();
 	ASSERT_TRUE(p1_t3_tinfo);
@@ -210,7 +210,7 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_remove_inactive_threads) {
 	 */
 	remove_inactive_threads(80, 20);
 	ASSERT_EQ(DEFAULT_TREE_NUM_PROCS - 1, thread_manager->get_thread_count());
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 2, 2, p2_t1_tid, p2_t2_tid);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 1, false, 2, p2_t1_tid, p2_t2_tid);
 
 	/* Calling PRCTL on an unknown thread should generate an invalid thread */
 	int64_t unknown_tid = 61103;
@@ -286,45 +286,45 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_traverse_default_tree) {
 	/*=============================== remove threads ===========================*/
 
 	/* Remove p4_t2 */
-	ASSERT_THREAD_CHILDREN(p4_t1_tid, 0, 0)
+	ASSERT_THREAD_CHILDREN(p4_t1_tid, 0)
 	/* the reaper is the other thread in the group */
 	remove_thread(p4_t2_tid, p4_t1_tid);
-	ASSERT_THREAD_GROUP_INFO(p4_t1_pid, 1, true, 2, 1, p4_t1_tid)
-	ASSERT_THREAD_CHILDREN(p4_t1_tid, 2, 2, p5_t1_tid, p5_t2_tid)
+	ASSERT_THREAD_GROUP_INFO(p4_t1_pid, 1, true, 1, p4_t1_tid)
+	ASSERT_THREAD_CHILDREN(p4_t1_tid, 2, p5_t1_tid, p5_t2_tid)
 
 	/* Remove p5_t2 */
-	ASSERT_THREAD_CHILDREN(p5_t1_tid, 0, 0)
+	ASSERT_THREAD_CHILDREN(p5_t1_tid, 0)
 	remove_thread(p5_t2_tid, p5_t1_tid);
-	ASSERT_THREAD_CHILDREN(p5_t1_tid, 1, 1, p6_t1_tid)
+	ASSERT_THREAD_CHILDREN(p5_t1_tid, 1, p6_t1_tid)
 
 	/* Remove p5_t1 */
 	remove_thread(p5_t1_tid, p4_t1_tid);
 
 	/* Now p6_t1 should be assigned to p4_t1 since it is the reaper */
-	ASSERT_THREAD_CHILDREN(p4_t1_tid, 3, 1, p6_t1_tid)
+	ASSERT_THREAD_CHILDREN(p4_t1_tid, 1, p6_t1_tid)
 
 	/* Set p2_t1 group as reaper, emulate prctl */
 	auto tginfo = thread_manager->get_thread_group_info(p2_t1_pid).get();
 	tginfo->set_reaper(true);
 
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, true, 3, 3, p2_t1_tid, p2_t2_tid, p2_t3_tid)
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, true, 3, p2_t1_tid, p2_t2_tid, p2_t3_tid)
 
 	/* Remove p2_t1 */
-	ASSERT_THREAD_CHILDREN(p2_t2_tid, 0, 0)
+	ASSERT_THREAD_CHILDREN(p2_t2_tid, 0)
 	remove_thread(p2_t1_tid, p2_t2_tid);
-	ASSERT_THREAD_CHILDREN(p2_t2_tid, 1, 1, p3_t1_tid)
+	ASSERT_THREAD_CHILDREN(p2_t2_tid, 1, p3_t1_tid)
 
 	/* Remove p2_t2 */
-	ASSERT_THREAD_CHILDREN(p2_t3_tid, 0, 0)
+	ASSERT_THREAD_CHILDREN(p2_t3_tid, 0)
 	remove_thread(p2_t2_tid, p2_t3_tid);
 	/* Please note that the parent of `p2_t2` is `init` since it was created with
 	 * CLONE_PARENT flag.
 	 */
-	ASSERT_THREAD_CHILDREN(p2_t3_tid, 1, 1, p3_t1_tid)
+	ASSERT_THREAD_CHILDREN(p2_t3_tid, 1, p3_t1_tid)
 
 	/* Remove p3_t1 */
 	remove_thread(p3_t1_tid, p2_t3_tid);
-	ASSERT_THREAD_CHILDREN(p2_t3_tid, 2, 1, p4_t1_tid)
+	ASSERT_THREAD_CHILDREN(p2_t3_tid, 1, p4_t1_tid)
 
 	/*=============================== remove threads ===========================*/
 
@@ -347,7 +347,7 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_remove_thread_group_main_thread_first)
 
 	/* We remove the main thread, but it is only marked as dead */
 	remove_thread(p5_t1_tid, 0);
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, 2, p5_t1_tid, p5_t2_tid)
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, p5_t1_tid, p5_t2_tid)
 
 	/* We remove the secondary thread, and we should remove the whole group */
 	remove_thread(p5_t2_tid, 0);
@@ -362,7 +362,7 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_remove_thread_group_secondary_thread_fi
 
 	/* We remove the secondary thread */
 	remove_thread(p5_t2_tid, 0);
-	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 2, 1, p5_t1_tid)
+	ASSERT_THREAD_GROUP_INFO(p5_t1_pid, 1, false, 1, p5_t1_tid)
 
 	remove_thread(p5_t1_tid, 0);
 
@@ -371,6 +371,56 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_remove_thread_group_secondary_thread_fi
 	ASSERT_MISSING_THREAD_INFO(p5_t2_tid, true)
 }
 
+TEST_F(sinsp_with_test_input, THRD_TABLE_remove_thread_group) {
+	DEFAULT_TREE
+
+	const auto& thread_manager = m_inspector.m_thread_manager;
+
+	/* p5_t2 has a child, p6_t1 */
+	ASSERT_THREAD_CHILDREN(p4_t2_tid, 2, p5_t1_tid, p5_t2_tid);
+	ASSERT_THREAD_CHILDREN(p4_t1_tid, 0);
+
+	/* The whole group goes away at once */
+	thread_manager->remove_thread_group(p5_t1_pid);
+	ASSERT_FALSE(thread_manager->get_thread_group_info(p5_t1_pid));
+	ASSERT_MISSING_THREAD_INFO(p5_t1_tid, true);
+	ASSERT_MISSING_THREAD_INFO(p5_t2_tid, true);
+	ASSERT_EQ(DEFAULT_TREE_NUM_PROCS - 2, thread_manager->get_thread_count());
+
+	/* p6_t1 is reparented to the p4 group since it is a reaper */
+	ASSERT_THREAD_CHILDREN(p4_t2_tid, 0);
+	ASSERT_THREAD_CHILDREN(p4_t1_tid, 1, p6_t1_tid);
+	ASSERT_THREAD_INFO_PIDS_IN_CONTAINER(p6_t1_tid, p6_t1_pid, p4_t1_tid, p6_t1_vtid, p6_t1_vpid);
+}
+
+TEST_F(sinsp_with_test_input, THRD_TABLE_remove_inactive_thread_group) {
+	DEFAULT_TREE
+
+	for(const auto tid : {(int64_t)INIT_TID,
+	                      p1_t1_tid,
+	                      p1_t2_tid,
+	                      p2_t1_tid,
+	                      p2_t2_tid,
+	                      p2_t3_tid,
+	                      p3_t1_tid,
+	                      p4_t1_tid,
+	                      p4_t2_tid,
+	                      p6_t1_tid}) {
+		set_threadinfo_last_access_time(tid, 70);
+	}
+	set_threadinfo_last_access_time(p5_t1_tid, 20);
+	set_threadinfo_last_access_time(p5_t2_tid, 20);
+
+	/* All the threads of p5 are inactive, so the group is torn down as a whole, main thread
+	 * included.
+	 */
+	remove_inactive_threads(80, 20);
+	const auto& thread_manager = m_inspector.m_thread_manager;
+	ASSERT_EQ(DEFAULT_TREE_NUM_PROCS - 2, thread_manager->get_thread_count());
+	ASSERT_FALSE(thread_manager->get_thread_group_info(p5_t1_pid));
+	ASSERT_THREAD_CHILDREN(p4_t1_tid, 1, p6_t1_tid);
+}
+
 TEST_F(sinsp_with_test_input, THRD_TABLE_manage_proc_exit_event_lost) {
 	DEFAULT_TREE
 
@@ -380,8 +430,8 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_manage_proc_exit_event_lost) {
 	m_inspector.m_thread_manager->remove_thread(p5_t2_tid);
 
 	/* Thanks to userspace logic p5_t1 should be the new reaper */
-	ASSERT_THREAD_GROUP_INFO(p5_t1_tid, 1, false, 2, 1);
-	ASSERT_THREAD_CHILDREN(p5_t1_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_GROUP_INFO(p5_t1_tid, 1, false, 1);
+	ASSERT_THREAD_CHILDREN(p5_t1_tid, 1, p6_t1_tid);
 	ASSERT_MISSING_THREAD_INFO(p5_t2_tid, true);
 }
 
@@ -398,7 +448,7 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_ignore_not_existent_reaper) {
 	const auto& thread_manager = m_inspector.m_thread_manager;
 
 	/* p2_t1 is not expired since it is a main thread and the reaper flag should not be set */
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 2, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 2, false, 3);
 	auto p2_t1_tinfo = thread_manager->find_thread(p2_t1_tid, true).get();
 	ASSERT_TRUE(p2_t1_tinfo);
 	ASSERT_EQ(p2_t1_tinfo->m_reaper_tid, p2_t2_tid);
@@ -413,24 +463,24 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_reparenting_in_the_default_tree) {
 	DEFAULT_TREE
 
 	/* p5_t1 has no children, when p5_t2 dies p5_t1 receives p6_t1 as child */
-	ASSERT_THREAD_CHILDREN(p5_t1_tid, 0, 0);
-	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(p5_t1_tid, 0);
+	ASSERT_THREAD_CHILDREN(p5_t2_tid, 1, p6_t1_tid);
 	remove_thread(p5_t2_tid, p5_t1_tid);
-	ASSERT_THREAD_CHILDREN(p5_t1_tid, 1, 1, p6_t1_tid);
+	ASSERT_THREAD_CHILDREN(p5_t1_tid, 1, p6_t1_tid);
 	ASSERT_MISSING_THREAD_INFO(p5_t2_tid, true);
 
 	remove_thread(p4_t2_tid, p4_t1_tid);
-	ASSERT_THREAD_CHILDREN(p4_t1_tid, 1, 1, p5_t1_tid);
+	ASSERT_THREAD_CHILDREN(p4_t1_tid, 1, p5_t1_tid);
 	ASSERT_MISSING_THREAD_INFO(p4_t2_tid, true);
 
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, false, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, false, 3);
 	/* The kernel says that p2_t1 is a new reaper */
 	remove_thread(p4_t1_tid, p2_t1_tid);
-	ASSERT_THREAD_CHILDREN(p2_t1_tid, 2, 2, p5_t1_tid);
+	ASSERT_THREAD_CHILDREN(p2_t1_tid, 2, p5_t1_tid);
 	ASSERT_MISSING_THREAD_INFO(p4_t1_tid, true);
 
 	/* the reaper flag should be set */
-	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, true, 3, 3);
+	ASSERT_THREAD_GROUP_INFO(p2_t1_pid, 3, true, 3);
 }
 
 TEST_F(sinsp_with_test_input, THRD_TABLE_max_table_size) {
@@ -457,7 +507,63 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_max_table_size) {
 	 * `m_max_thread_table_size -1`
 	 */
 	const int64_t thread_group_size = thread_manager->get_max_thread_table_size() - 1;
-	ASSERT_THREAD_GROUP_INFO(pid, thread_group_size, false, thread_group_size, thread_group_size);
+	ASSERT_THREAD_GROUP_INFO(pid, thread_group_size, false, thread_group_size);
+}
+
+TEST_F(sinsp_with_test_input, THRD_TABLE_lru_eviction) {
+	const auto& thread_manager = m_inspector.m_thread_manager;
+	thread_manager->set_max_thread_table_size(100);
+	m_inspector.set_lru_eviction(true);
+
+	add_default_init_thread();
+	open_inspector();
+
+	/* Spawn many more processes than the table can hold, keeping the first one busy. */
+	const int64_t hot_pid = 100;
+	generate_clone_x_event(0, hot_pid, hot_pid, INIT_TID);
+	for(int64_t pid = hot_pid + 1; pid < hot_pid + 300; pid++) {
+		generate_clone_x_event(0, pid, pid, INIT_TID);
+		generate_random_event(hot_pid);
+	}
+
+	/* The table never grows over its limit and the new processes are not dropped: the least
+	 * recently used ones leave room for them.
+	 */
+	ASSERT_LE(thread_manager->get_thread_count(), thread_manager->get_max_thread_table_size());
+	ASSERT_THREAD_INFO_PIDS(hot_pid + 299, hot_pid + 299, INIT_TID);
+	ASSERT_THREAD_INFO_PIDS(hot_pid, hot_pid, INIT_TID);
+	ASSERT_THREAD_INFO_PIDS(INIT_TID, INIT_PID, INIT_PTID);
+	ASSERT_MISSING_THREAD_INFO(hot_pid + 1, true);
+
+	const auto& stats = m_inspector.get_sinsp_stats_v2();
+	ASSERT_GT(stats->m_n_evicted_threads, 0);
+	ASSERT_EQ(stats->m_n_drops_full_threadtable, 0);
+}
+
+TEST_F(sinsp_with_test_input, THRD_TABLE_fdtable_lru_eviction) {
+	m_inspector.set_lru_eviction(true);
+
+	add_default_init_thread();
+	open_inspector();
+
+	/* Open many more fds than the table can hold, keeping the first one busy. */
+	const int64_t hot_fd = 3;
+	const int64_t n_fds = sinsp::s_max_fdtable_size + 100;
+	sinsp_test_input::open_params params;
+	params.fd = hot_fd;
+	generate_open_x_event(params, INIT_TID);
+	const auto init_tinfo = m_inspector.m_thread_manager->find_thread(INIT_TID, true);
+	ASSERT_TRUE(init_tinfo);
+	for(int64_t fd = hot_fd + 1; fd < hot_fd + n_fds; fd++) {
+		params.fd = fd;
+		generate_open_x_event(params, INIT_TID);
+		ASSERT_NE(init_tinfo->get_fd(hot_fd), nullptr);
+	}
+
+	ASSERT_LE(init_tinfo->get_fd_table()->size(), sinsp::s_max_fdtable_size);
+	ASSERT_NE(init_tinfo->get_fd(hot_fd + n_fds - 1), nullptr);
+	ASSERT_EQ(init_tinfo->get_fd(hot_fd + 1), nullptr);
+	ASSERT_GT(m_inspector.get_sinsp_stats_v2()->m_n_evicted_fds, 0);
 }
 
 TEST_F(sinsp_with_test_input, THRD_TABLE_many_threads_in_a_group) {
@@ -474,33 +580,28 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_many_threads_in_a_group) {
 	}
 
 	int64_t thread_group_size = HUGE_THREAD_NUMBER;
-	ASSERT_THREAD_GROUP_INFO(pid, thread_group_size, false, thread_group_size, thread_group_size);
+	ASSERT_THREAD_GROUP_INFO(pid, thread_group_size, false, thread_group_size);
 
-	/* Only `DEFAULT_DEAD_THREADS_THRESHOLD - 1` removal, we need another one */
-	for(auto i = 0; i < (DEFAULT_DEAD_THREADS_THRESHOLD - 1); i++) {
+	/* Remove the first 10 threads, main thread included */
+	int64_t removed_threads = 10;
+	for(auto i = 0; i < removed_threads; i++) {
 		remove_thread(pid + i, 0);
 	}
 
-	/* we have DEFAULT_DEAD_THREADS_THRESHOLD-1 dead threads so we don't try to clean the expired
-	 * ones */
-	int64_t alive_threads = thread_group_size - (DEFAULT_DEAD_THREADS_THRESHOLD - 1);
-	/* Please note that the main thread is not expired so `alive_threads+1` */
-	ASSERT_THREAD_GROUP_INFO(20, alive_threads, false, thread_group_size, alive_threads + 1);
+	/* Removed threads are immediately unlinked from the group, apart from the main thread that
+	 * stays in the table until the group is alive, so `alive_threads+1`.
+	 */
+	int64_t alive_threads = thread_group_size - removed_threads;
+	ASSERT_THREAD_GROUP_INFO(20, alive_threads, false, alive_threads + 1);
 
-	/* remove a random thread and we should clean up the expired ones */
+	/* remove a random thread */
 	remove_thread(145, 0);
 	alive_threads--;
+	ASSERT_THREAD_GROUP_INFO(20, alive_threads, false, alive_threads + 1);
 
-	/* When we call the decrement logic thread 145 is not dead */
-	thread_group_size = alive_threads + 2;
-	ASSERT_THREAD_GROUP_INFO(20, alive_threads, false, thread_group_size, alive_threads + 1);
-
-	/* Now if we remove another thread the logic shouldn't be called. */
 	remove_thread(146, 0);
 	alive_threads--;
-
-	/* thread_group_size doesn't change */
-	ASSERT_THREAD_GROUP_INFO(20, alive_threads, false, thread_group_size, alive_threads + 1);
+	ASSERT_THREAD_GROUP_INFO(20, alive_threads, false, alive_threads + 1);
 
 	/* remove all threads in the group */
 	for(int i = 0; i <= HUGE_THREAD_NUMBER; i++) {
@@ -529,23 +630,8 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_add_and_remove_many_threads_in_a_group)
 		remove_thread(pid + i, 0);
 	}
 
-	/* How many times the logic will be called.
-	 * The first time it is called is after `DEFAULT_DEAD_THREADS_THRESHOLD` dead threads.
-	 * When it is called one thread of the dead ones is still not expired so all the next time
-	 * the logic will be called after `DEFAULT_DEAD_THREADS_THRESHOLD-1` decrement.
-	 * (HUGE_THREAD_NUMBER - DEFAULT_DEAD_THREADS_THRESHOLD -1) here we exclude:
-	 * - `-1` the main thread since it never dies
-	 * - `-DEFAULT_DEAD_THREADS_THRESHOLD` is the first time we call the logic. To compensate
-	 *    this we will do `called_logic++` at the end.
-	 */
-	int called_logic = (HUGE_THREAD_NUMBER - DEFAULT_DEAD_THREADS_THRESHOLD - 1) /
-	                   (DEFAULT_DEAD_THREADS_THRESHOLD - 1);
-	called_logic++;
-	int remaining_threads =
-	        HUGE_THREAD_NUMBER - (called_logic * (DEFAULT_DEAD_THREADS_THRESHOLD - 1));
-
 	/* we should have only the main thread alive */
-	ASSERT_THREAD_GROUP_INFO(20, 1, false, remaining_threads, 1);
+	ASSERT_THREAD_GROUP_INFO(20, 1, false, 1);
 
 	/* main thread + init */
 	ASSERT_EQ(m_inspector.m_thread_manager->get_thread_count(), 2);
@@ -560,50 +646,32 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_many_children) {
 		generate_clone_x_event(0, tid + i, tid + i, INIT_TID);
 	}
 
-	ASSERT_THREAD_CHILDREN(INIT_TID, HUGE_THREAD_NUMBER, HUGE_THREAD_NUMBER);
+	ASSERT_THREAD_CHILDREN(INIT_TID, HUGE_THREAD_NUMBER);
 
-	/* Only `DEFAULT_EXPIRED_CHILDREN_THRESHOLD - 1` removal, we need another one */
-	for(auto i = 0; i < (DEFAULT_EXPIRED_CHILDREN_THRESHOLD - 1); i++) {
+	/* Removed children are immediately unlinked from the parent */
+	int64_t removed_children = 10;
+	for(auto i = 0; i < removed_children; i++) {
 		remove_thread(tid + i, 0);
 	}
 
-	int64_t alive_children = HUGE_THREAD_NUMBER - (DEFAULT_EXPIRED_CHILDREN_THRESHOLD - 1);
-	ASSERT_THREAD_CHILDREN(INIT_TID, HUGE_THREAD_NUMBER, alive_children);
+	int64_t alive_children = HUGE_THREAD_NUMBER - removed_children;
+	ASSERT_THREAD_CHILDREN(INIT_TID, alive_children);
 
-	/* remove random thread */
+	/* remove random threads */
 	remove_thread(145, 0);
 	alive_children--;
+	ASSERT_THREAD_CHILDREN(INIT_TID, alive_children);
 
-	/* When we clean up the current thread is not taken into account
-	 * That's the reason why we need the +1
-	 */
-	ASSERT_THREAD_CHILDREN(INIT_TID, alive_children + 1, alive_children);
-
-	/* Now if we remove another thread the logic shouldn't be called. */
 	remove_thread(146, 0);
 	alive_children--;
-	ASSERT_THREAD_CHILDREN(INIT_TID, alive_children + 2, alive_children);
+	ASSERT_THREAD_CHILDREN(INIT_TID, alive_children);
 
 	/* remove all threads */
 	for(int i = 0; i <= HUGE_THREAD_NUMBER; i++) {
 		remove_thread(tid + i, 0);
 	}
 
-	/* How many times the logic will be called.
-	 * The first time it is called is after `DEFAULT_EXPIRED_CHILDREN_THRESHOLD` dead threads.
-	 * When it is called one thread of the dead ones is still not expired so all the next time
-	 * the logic will be called after `DEFAULT_EXPIRED_CHILDREN_THRESHOLD-1` decrement.
-	 * (HUGE_THREAD_NUMBER - DEFAULT_EXPIRED_CHILDREN_THRESHOLD) here we exclude:
-	 * - `-DEFAULT_EXPIRED_CHILDREN_THRESHOLD` is the first time we call the logic. To compensate
-	 *    this we will do `called_logic++` at the end.
-	 */
-	int called_logic = (HUGE_THREAD_NUMBER - DEFAULT_EXPIRED_CHILDREN_THRESHOLD) /
-	                   (DEFAULT_EXPIRED_CHILDREN_THRESHOLD - 1);
-	called_logic++;
-	int remaining_threads =
-	        HUGE_THREAD_NUMBER - (called_logic * (DEFAULT_EXPIRED_CHILDREN_THRESHOLD - 1));
-
-	ASSERT_THREAD_CHILDREN(INIT_TID, remaining_threads, 0);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 0);
 	/* Only init process */
 	ASSERT_EQ(m_inspector.m_thread_manager->get_thread_count(), 1);
 }
@@ -618,13 +686,7 @@ TEST_F(sinsp_with_test_input, THRD_TABLE_add_and_remove_many_children) {
 		remove_thread(tid + i, 0);
 	}
 
-	int called_logic = (HUGE_THREAD_NUMBER - DEFAULT_EXPIRED_CHILDREN_THRESHOLD) /
-	                   (DEFAULT_EXPIRED_CHILDREN_THRESHOLD - 1);
-	called_logic++;
-	int remaining_threads =
-	        HUGE_THREAD_NUMBER - (called_logic * (DEFAULT_EXPIRED_CHILDREN_THRESHOLD - 1));
-
-	ASSERT_THREAD_CHILDREN(INIT_TID, remaining_threads, 0);
+	ASSERT_THREAD_CHILDREN(INIT_TID, 0);
 	/* Only init process */
 	ASSERT_EQ(m_inspector.m_thread_manager->get_thread_count(), 1);
 }
@@ -16,6 +16,7 @@ limitations under the License.
 
 */
 
+#include <fcntl.h>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <sys/stat.h>
@@ -666,4 +667,54 @@ TEST_F(usergroup_manager_container_parsing_test, delete_container_purges_cache)
 	mgr.delete_container("never-seen-container");
 	ASSERT_EQ(mgr.get_userlist("never-seen-container"), nullptr);
 }
+
+// The parsed files are shared while they don't change, and parsed again when
+// their mtime or size changes.
+TEST(usergroup_db_cache, shared_until_modified) {
+	char pwd_buf[SCAP_MAX_PATH_SIZE];
+	ASSERT_NE(getcwd(pwd_buf, SCAP_MAX_PATH_SIZE), nullptr);
+	const std::string path = std::string(pwd_buf) + "/usergroup_db_cache_passwd";
+	{
+		std::ofstream ofs(path);
+		ofs << "root:x:0:0:root:/root:/bin/sh\n"
+		       "app:x:1000:1000:app:/home/app:/bin/sh\n";
+	}
+
+	sinsp_usergroup_db_cache cache;
+	ASSERT_EQ(cache.get_passwd(path + "_missing"), nullptr);
+
+	auto first = cache.get_passwd(path);
+	ASSERT_NE(first, nullptr);
+	ASSERT_EQ(cache.get_passwd(path), first);
+	ASSERT_EQ(first->size(), 2);
+	ASSERT_EQ(first->at(1000).name, "app");
+	ASSERT_EQ(first->at(1000).home, "/home/app");
+
+	{
+		std::ofstream ofs(path);
+		ofs << "app:x:1000:1000:appuser:/home/appuser:/bin/bash\n";
+	}
+	// Make sure the mtime changes even on filesystems with a coarse resolution.
+	struct timespec times[2] = {{0, UTIME_OMIT}, {time(nullptr) + 10, 0}};
+	ASSERT_EQ(utimensat(AT_FDCWD, path.c_str(), times, 0), 0);
+
+	auto second = cache.get_passwd(path);
+	ASSERT_NE(second, nullptr);
+	ASSERT_NE(second, first);
+	ASSERT_EQ(second->size(), 1);
+	ASSERT_EQ(second->at(1000).name, "app");
+	ASSERT_EQ(second->at(1000).shell, "/bin/bash");
+	ASSERT_EQ(cache.size(), 2);
+
+	// Only the databases still referenced outside of the cache survive.
+	first.reset();
+	cache.prune();
+	ASSERT_EQ(cache.size(), 1);
+	ASSERT_EQ(cache.get_passwd(path), second);
+	second.reset();
+	cache.prune();
+	ASSERT_EQ(cache.size(), 0);
+
+	unlink(path.c_str());
+}
 #endif
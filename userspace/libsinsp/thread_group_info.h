@@ -20,51 +20,32 @@ limitations under the License.
 
 #include <memory>
 #include <stdint.h>
-#include <list>
+#include <vector>
 #include <libsinsp/sinsp_exception.h>
 
 /* Forward declaration */
 class sinsp_threadinfo;
 
-/* Apart from the main thread all other threads when marked as dead should be removed
- * from the thread_table at the next event loop and so become expired. For this reason when we have
- * at least `n` dead threads we can try to clean up expired ones.
+/* New struct that keep information regarding the thread group.
+ *
+ * The membership is intrusive: every thread stores its position in `m_threads`, so that it can
+ * be unlinked in O(1) (swapping it with the last one) as soon as it is removed from the thread
+ * table or destroyed. The list never contains expired threads and can be traversed without
+ * locking weak pointers.
  */
-#define DEFAULT_DEAD_THREADS_THRESHOLD 11
-
-/* New struct that keep information regarding the thread group */
 struct thread_group_info {
 public:
 	thread_group_info(int64_t group_pid,
 	                  bool reaper,
-	                  std::weak_ptr<sinsp_threadinfo> current_thread):
-	        m_pid(group_pid),
-	        m_reaper(reaper) {
-		if(current_thread.expired()) {
-			throw sinsp_exception("we cannot create a thread group info from an expired thread");
-		}
-
-		/* When we create the thread group info the count is 1, because we only have the creator
-		 * thread */
-		m_alive_count = 1;
-		m_threads.push_front(current_thread);
-	};
+	                  const std::weak_ptr<sinsp_threadinfo>& current_thread);
+	~thread_group_info();
+
+	thread_group_info(const thread_group_info&) = delete;
+	thread_group_info& operator=(const thread_group_info&) = delete;
 
 	inline void increment_thread_count() { m_alive_count++; }
 
-	inline void decrement_thread_count() {
-		m_alive_count--;
-
-		/* Clean expired threads if necessary.
-		 * Please note that this is an approximation, `m_threads.size() - m_alive_count` are not the
-		 * real expired threads, they are just the ones marked as dead. For example the main thread
-		 * of the group is marked as dead but it will be never expired until the thread group
-		 * exists.
-		 */
-		if((m_threads.size() - m_alive_count) >= DEFAULT_DEAD_THREADS_THRESHOLD) {
-			clean_expired_threads();
-		}
-	}
+	inline void decrement_thread_count() { m_alive_count--; }
 
 	inline uint64_t get_thread_count() const { return m_alive_count; }
 
@@ -74,43 +55,28 @@ public:
 
 	inline int64_t get_tgroup_pid() const { return m_pid; }
 
-	inline const std::list<std::weak_ptr<sinsp_threadinfo>>& get_thread_list() const {
-		return m_threads;
-	}
+	inline const std::vector<sinsp_threadinfo*>& get_thread_list() const { return m_threads; }
 
-	inline void add_thread_to_group(const std::shared_ptr<sinsp_threadinfo>& thread, bool main) {
-		/* The main thread should always be the first element of the list, if present.
-		 * In this way we can efficiently obtain the main thread.
-		 */
-		if(main) {
-			m_threads.push_front(thread);
-		} else {
-			m_threads.push_back(thread);
-		}
-		/* we are adding a thread so we increment the count */
-		increment_thread_count();
-	}
+	/* The main thread should always be the first element of the list, if present.
+	 * In this way we can efficiently obtain the main thread.
+	 */
+	void add_thread_to_group(const std::shared_ptr<sinsp_threadinfo>& thread, bool main);
 
-	inline void clean_expired_threads() {
-		auto thread = m_threads.begin();
-		while(thread != m_threads.end()) {
-			/* This child is expired */
-			if(thread->expired()) {
-				/* `erase` returns the pointer to the next child
-				 * no need for manual increment.
-				 */
-				thread = m_threads.erase(thread);
-				continue;
-			}
-			thread++;
-		}
-	}
+	/* Unlink the thread from the group, it does nothing if the thread is not in the group.
+	 * Please note that the alive count is not touched, the thread is expected to be already
+	 * marked as dead.
+	 */
+	void remove_thread_from_group(sinsp_threadinfo* thread);
 
-	inline sinsp_threadinfo* get_first_thread() const { return m_threads.front().lock().get(); }
+	inline sinsp_threadinfo* get_first_thread() const {
+		return m_threads.empty() ? nullptr : m_threads.front();
+	}
 
 private:
+	void link_thread(sinsp_threadinfo* thread, bool main);
+
 	int64_t m_pid; /* unsigned if we want to use `-1` as an invalid value */
 	uint64_t m_alive_count;
-	std::list<std::weak_ptr<sinsp_threadinfo>> m_threads;
+	std::vector<sinsp_threadinfo*> m_threads;
 	bool m_reaper;
 };
@@ -106,6 +106,10 @@ static void fd_to_scap(scap_fdinfo& dst, const sinsp_fdinfo& src) {
 
 static const auto s_threadinfo_static_fields = sinsp_threadinfo::get_static_fields();
 
+// When a full table evicts, it drops this fraction of its entries at once, so that the scan for
+// the least recently used threads is amortized over many insertions.
+static constexpr size_t s_lru_eviction_batch_divisor = 16;
+
 sinsp_thread_manager::sinsp_thread_manager(
         const sinsp_threadinfo_factory& threadinfo_factory,
         sinsp_observer* const& observer,
@@ -191,17 +195,18 @@ void sinsp_thread_manager::create_thread_dependencies(
 	tinfo->m_tginfo = tginfo;
 
 	// update fdtable cached pointer for all threads in the group (which includes
-	// the current thread), as their leader might have changed or we simply need
-	// to first initialize it. Then we do the same with the thread's children.
-	for(const auto& thread : tginfo->get_thread_list()) {
-		if(auto thread_ptr = thread.lock().get(); thread_ptr != nullptr) {
-			thread_ptr->update_main_fdtable();
+	// the current thread) if we are their new leader, otherwise we simply need to
+	// first initialize it for the current thread. Then we do the same with the
+	// thread's children.
+	if(tinfo->is_main_thread()) {
+		for(auto thread : tginfo->get_thread_list()) {
+			thread->update_main_fdtable();
 		}
+	} else {
+		tinfo->update_main_fdtable();
 	}
-	for(const auto& thread : tinfo->m_children) {
-		if(auto thread_ptr = thread.lock().get(); thread_ptr != nullptr) {
-			thread_ptr->update_main_fdtable();
-		}
+	for(auto child : tinfo->get_children()) {
+		child->update_main_fdtable();
 	}
 
 	/* init group has no parent */
@@ -224,14 +229,15 @@ void sinsp_thread_manager::create_thread_dependencies(
 		tinfo->update_main_fdtable();
 		return;
 	}
-	parent_thread->add_child(tinfo);
+	parent_thread->add_child(tinfo.get());
 }
 
 const std::shared_ptr<sinsp_threadinfo>& sinsp_thread_manager::add_thread(
         std::unique_ptr<sinsp_threadinfo> threadinfo,
         const bool must_create_thread_dependencies) {
-	/* We have no more space */
-	if(m_threadtable.size() >= m_max_thread_table_size && threadinfo->m_pid != m_sinsp_pid) {
+	/* We have no more space, unless we can evict the least recently used threads */
+	if(m_threadtable.size() >= m_max_thread_table_size && threadinfo->m_pid != m_sinsp_pid &&
+	   (!m_lru_eviction || evict_lru_threads() == 0)) {
 		if(m_sinsp_stats_v2 != nullptr) {
 			// rate limit messages to avoid spamming the logs
 			if(m_sinsp_stats_v2->m_n_drops_full_threadtable % m_max_thread_table_size == 0) {
@@ -272,18 +278,17 @@ const std::shared_ptr<sinsp_threadinfo>& sinsp_thread_manager::add_thread(
 	return m_threadtable.put(tinfo_shared_ptr);
 }
 
-void sinsp_thread_manager::remove_child_from_parent(int64_t ptid) {
-	auto parent = find_thread(ptid, true).get();
-	if(parent == nullptr) {
+void sinsp_thread_manager::unlink_thread(sinsp_threadinfo* tinfo) {
+	if(tinfo == nullptr) {
 		return;
 	}
 
-	parent->m_not_expired_children--;
-
-	/* Clean expired children if necessary. */
-	if((parent->m_children.size() - parent->m_not_expired_children) >=
-	   DEFAULT_EXPIRED_CHILDREN_THRESHOLD) {
-		parent->clean_expired_children();
+	/* Other components could still keep a reference to the thread after it is removed from the
+	 * table, so we don't wait for its destruction to unlink it from its parent and group.
+	 */
+	tinfo->remove_from_parent();
+	if(tinfo->m_tginfo != nullptr) {
+		tinfo->m_tginfo->remove_thread_from_group(tinfo);
 	}
 }
 
@@ -302,11 +307,7 @@ sinsp_threadinfo* sinsp_thread_manager::find_new_reaper(sinsp_threadinfo* tinfo)
 
 	/* First we check in our thread group for alive threads */
 	if(tinfo->m_tginfo != nullptr && tinfo->m_tginfo->get_thread_count() > 0) {
-		for(const auto& thread_weak : tinfo->m_tginfo->get_thread_list()) {
-			if(thread_weak.expired()) {
-				continue;
-			}
-			auto thread = thread_weak.lock().get();
+		for(auto thread : tinfo->m_tginfo->get_thread_list()) {
 			if(!thread->is_dead() && thread != tinfo) {
 				return thread;
 			}
@@ -349,11 +350,7 @@ sinsp_threadinfo* sinsp_thread_manager::find_new_reaper(sinsp_threadinfo* tinfo)
 
 		if(parent_tinfo->m_tginfo != nullptr && parent_tinfo->m_tginfo->is_reaper() &&
 		   parent_tinfo->m_tginfo->get_thread_count() > 0) {
-			for(const auto& thread_weak : parent_tinfo->m_tginfo->get_thread_list()) {
-				if(thread_weak.expired()) {
-					continue;
-				}
-				auto thread = thread_weak.lock().get();
+			for(auto thread : parent_tinfo->m_tginfo->get_thread_list()) {
 				if(!thread->is_dead()) {
 					return thread;
 				}
@@ -414,7 +411,7 @@ void sinsp_thread_manager::remove_thread(int64_t tid) {
 	 * which don't have a group or children.
 	 */
 	if(thread_to_remove->is_invalid() || thread_to_remove->m_tginfo == nullptr) {
-		remove_child_from_parent(thread_to_remove->m_ptid);
+		unlink_thread(thread_to_remove.get());
 		m_threadtable.erase(tid);
 		m_last_tid = -1;
 		m_last_tinfo.reset();
@@ -449,7 +446,7 @@ void sinsp_thread_manager::remove_thread(int64_t tid) {
 	 * So excluding the case in which the kernel sent us a valid reaper we always fallback to
 	 * our userspace logic.
 	 */
-	if(thread_to_remove->m_children.size()) {
+	if(!thread_to_remove->get_children().empty()) {
 		sinsp_threadinfo* reaper_tinfo = nullptr;
 
 		if(thread_to_remove->m_reaper_tid > 0) {
@@ -488,19 +485,12 @@ void sinsp_thread_manager::remove_thread(int64_t tid) {
 		thread_to_remove->assign_children_to_reaper(reaper_tinfo);
 	}
 
-	/* [Remove main thread]
-	 * We remove the main thread if there are no other threads in the group
+	/* [Remove the thread group]
+	 * If this was the last alive thread, we tear down what remains of the group in one pass:
+	 * the current thread, the main thread and any dead thread still in the table.
 	 */
 	if((thread_to_remove->m_tginfo->get_thread_count() == 0)) {
-		remove_main_thread_fdtable(thread_to_remove->get_main_thread());
-
-		/* we remove the main thread and the thread group */
-		/* even if thread_to_remove is not the main thread the parent will be
-		 * the same so it's ok.
-		 */
-		remove_child_from_parent(thread_to_remove->m_ptid);
-		m_thread_groups.erase(thread_to_remove->m_pid);
-		m_threadtable.erase(thread_to_remove->m_pid);
+		remove_thread_group(thread_to_remove->m_tginfo);
 	}
 
 	/* [Remove the current thread]
@@ -508,8 +498,8 @@ void sinsp_thread_manager::remove_thread(int64_t tid) {
 	 * If we are the main thread and it's time to be removed, we are removed
 	 * in the previous `if`.
 	 */
-	if(!thread_to_remove->is_main_thread()) {
-		remove_child_from_parent(thread_to_remove->m_ptid);
+	else if(!thread_to_remove->is_main_thread()) {
+		unlink_thread(thread_to_remove.get());
 		m_threadtable.erase(tid);
 	}
 
@@ -523,6 +513,171 @@ void sinsp_thread_manager::remove_thread(int64_t tid) {
 	}
 }
 
+void sinsp_thread_manager::remove_thread_group(int64_t pid) {
+	const auto tginfo = get_thread_group_info(pid);
+	if(tginfo == nullptr) {
+		remove_thread(pid);
+		return;
+	}
+
+	const auto removed = remove_thread_group(tginfo);
+	if(m_sinsp_stats_v2 != nullptr) {
+		m_sinsp_stats_v2->m_n_removed_threads += removed;
+	}
+}
+
+size_t sinsp_thread_manager::remove_thread_group(std::shared_ptr<thread_group_info> tginfo) {
+	const auto pid = tginfo->get_tgroup_pid();
+
+	/* Keep a reference to all the threads of the group: erasing them from the table could
+	 * destroy them while we still need them. The main thread is included even if we lost its
+	 * group membership.
+	 */
+	std::vector<std::shared_ptr<sinsp_threadinfo>> threads;
+	threads.reserve(tginfo->get_thread_list().size() + 1);
+	bool main_thread_found = false;
+	for(auto thread : tginfo->get_thread_list()) {
+		const auto& thread_ptr = m_threadtable.get_ref(thread->m_tid);
+		if(thread_ptr.get() == thread) {
+			main_thread_found |= thread->is_main_thread();
+			threads.push_back(thread_ptr);
+		}
+	}
+	if(!main_thread_found) {
+		const auto& main_thread = m_threadtable.get_ref(pid);
+		if(main_thread != nullptr && main_thread->m_tginfo == tginfo) {
+			threads.push_back(main_thread);
+		}
+	}
+
+	/* [Mark all the threads as dead] */
+	bool has_children = false;
+	for(const auto& thread : threads) {
+		if(!thread->is_dead()) {
+			tginfo->decrement_thread_count();
+			thread->set_dead();
+		}
+		has_children |= !thread->get_children().empty();
+	}
+
+	/* [Reparent all the children at once]
+	 * The whole group is dying, so the reaper can't be one of its threads. We use the reaper
+	 * sent by the kernel for any of them, if we have it, otherwise our userspace logic.
+	 */
+	if(has_children) {
+		sinsp_threadinfo* reaper_tinfo = nullptr;
+		for(const auto& thread : threads) {
+			if(thread->m_reaper_tid > 0) {
+				reaper_tinfo = get_thread(thread->m_reaper_tid).get();
+				if(reaper_tinfo != nullptr &&
+				   (reaper_tinfo->is_invalid() || reaper_tinfo->m_pid == pid)) {
+					reaper_tinfo = nullptr;
+				}
+				if(reaper_tinfo != nullptr) {
+					break;
+				}
+			}
+		}
+
+		if(reaper_tinfo == nullptr && !threads.empty()) {
+			reaper_tinfo = find_new_reaper(threads.front().get());
+		}
+
+		if(reaper_tinfo != nullptr && reaper_tinfo->m_tginfo) {
+			reaper_tinfo->m_tginfo->set_reaper(true);
+		}
+
+		for(const auto& thread : threads) {
+			if(reaper_tinfo != nullptr) {
+				thread->m_reaper_tid = reaper_tinfo->m_tid;
+			}
+			thread->assign_children_to_reaper(reaper_tinfo);
+		}
+	}
+
+	/* [Remove the threads and the group] */
+	for(const auto& thread : threads) {
+		if(thread->is_main_thread()) {
+			remove_main_thread_fdtable(thread.get());
+		}
+		unlink_thread(thread.get());
+		m_threadtable.erase(thread->m_tid);
+	}
+	if(const auto it = m_thread_groups.find(pid);
+	   it != m_thread_groups.end() && it->second == tginfo) {
+		m_thread_groups.erase(it);
+	}
+
+	m_last_tid = -1;
+	m_last_tinfo.reset();
+	return threads.size();
+}
+
+size_t sinsp_thread_manager::evict_lru_threads() {
+	const size_t n_to_evict =
+	        std::max<size_t>(1, m_max_thread_table_size / s_lru_eviction_batch_divisor);
+
+	std::vector<std::pair<uint64_t, int64_t>> lru;
+	lru.reserve(m_threadtable.size());
+	m_threadtable.const_loop([&](const sinsp_threadinfo& tinfo) {
+		/* We never evict ourselves, init and the cached thread, that is likely the one the
+		 * current event refers to. A main thread owns the fd table of its group, so it is
+		 * evicted only after the other threads of the group.
+		 */
+		if(tinfo.m_pid == m_sinsp_pid || tinfo.m_tid == 1 || tinfo.m_tid == m_last_tid ||
+		   (tinfo.is_main_thread() && tinfo.m_tginfo != nullptr &&
+		    tinfo.m_tginfo->get_thread_list().size() > 1)) {
+			return true;
+		}
+		lru.emplace_back(tinfo.m_lastaccess_ts, tinfo.m_tid);
+		return true;
+	});
+
+	const size_t n = std::min(n_to_evict, lru.size());
+	if(n < lru.size()) {
+		std::nth_element(lru.begin(), lru.begin() + n, lru.end());
+	}
+	for(size_t i = 0; i < n; i++) {
+		evict_thread(lru[i].second);
+	}
+
+	if(n > 0) {
+		libsinsp_logger()->format(sinsp_logger::SEV_DEBUG,
+		                          "Thread table full, evicted %zu least recently used threads",
+		                          n);
+	}
+	if(m_sinsp_stats_v2 != nullptr) {
+		m_sinsp_stats_v2->m_n_evicted_threads += n;
+	}
+	return n;
+}
+
+void sinsp_thread_manager::evict_thread(int64_t tid) {
+	/* Keep the thread alive until we are done with it */
+	const auto tinfo = m_threadtable.get_ref(tid);
+	if(tinfo == nullptr) {
+		return;
+	}
+
+	while(!tinfo->get_children().empty()) {
+		tinfo->get_children().back()->remove_from_parent();
+	}
+
+	const auto tginfo = tinfo->m_tginfo;
+	if(tginfo != nullptr && !tinfo->is_dead()) {
+		tginfo->decrement_thread_count();
+	}
+	unlink_thread(tinfo.get());
+	m_threadtable.erase(tid);
+
+	if(tginfo != nullptr && tginfo->get_thread_list().empty()) {
+		if(const auto it = m_thread_groups.find(tginfo->get_tgroup_pid());
+		   it != m_thread_groups.end() && it->second == tginfo) {
+			m_thread_groups.erase(it);
+		}
+	}
+}
+
 void sinsp_thread_manager::fix_sockets_coming_from_proc(const bool resolve_hostname_and_port) {
 	m_threadtable.loop([&](sinsp_threadinfo& tinfo) {
 		tinfo.fix_sockets_coming_from_proc(m_server_ports, resolve_hostname_and_port);
@@ -539,14 +694,6 @@ void sinsp_thread_manager::clear_thread_pointers(sinsp_threadinfo& tinfo) {
 
 void sinsp_thread_manager::reset_child_dependencies() {
 	m_threadtable.loop([&](sinsp_threadinfo& tinfo) {
-		tinfo.clean_expired_children();
-		/* Little optimization: only the main thread cleans the thread group from expired threads.
-		 * Downside: if the main thread is not present in the thread group because we lost it we
-		 * don't clean the thread group from expired threads.
-		 */
-		if(tinfo.is_main_thread() && tinfo.m_tginfo != nullptr) {
-			tinfo.m_tginfo->clean_expired_threads();
-		}
 		clear_thread_pointers(tinfo);
 		return true;
 	});
@@ -883,12 +1030,92 @@ void sinsp_thread_manager::dump_threads_to_file(scap_dumper_t* dumper) {
 	});
 }
 
+// Concatenate the iovecs into dst, truncating them to dst_size bytes.
+static size_t iovec_to_buf(const struct iovec* iov, int iovcnt, char* dst, size_t dst_size) {
+	size_t len = 0;
+	for(int i = 0; i < iovcnt && len < dst_size; i++) {
+		size_t n = std::min(iov[i].iov_len, dst_size - len);
+		memcpy(dst + len, iov[i].iov_base, n);
+		len += n;
+	}
+	return len;
+}
+
+void sinsp_thread_manager::threads_to_scap(
+        const std::function<bool(const scap_threadinfo&, const std::vector<scap_fdinfo>&)>& cb) {
+	// scap_threadinfo is a few KiB large, use a single heap allocated one.
+	auto sctinfo = std::make_unique<scap_threadinfo>();
+	std::vector<scap_fdinfo> fdinfos;
+
+	m_threadtable.loop([&](sinsp_threadinfo& tinfo) {
+		if(tinfo.m_filtered_out) {
+			return true;
+		}
+
+		struct iovec* iov;
+		int iovcnt;
+		std::string rem;
+
+		memset(sctinfo.get(), 0, sizeof(scap_threadinfo));
+		thread_to_scap(tinfo, sctinfo.get());
+
+		strlcpy(sctinfo->comm, tinfo.m_comm.c_str(), sizeof(sctinfo->comm));
+		strlcpy(sctinfo->exe, tinfo.m_exe.c_str(), sizeof(sctinfo->exe));
+		strlcpy(sctinfo->exepath, tinfo.m_exepath.c_str(), sizeof(sctinfo->exepath));
+		strlcpy(sctinfo->cwd,
+		        tinfo.get_cwd() == "" ? "/" : tinfo.get_cwd().c_str(),
+		        sizeof(sctinfo->cwd));
+		strlcpy(sctinfo->root, tinfo.m_root.c_str(), sizeof(sctinfo->root));
+
+		tinfo.args_to_iovec(&iov, &iovcnt, rem);
+		sctinfo->args_len = iovec_to_buf(iov, iovcnt, sctinfo->args, SCAP_MAX_ARGS_SIZE);
+		free(iov);
+		tinfo.env_to_iovec(&iov, &iovcnt, rem);
+		sctinfo->env_len = iovec_to_buf(iov, iovcnt, sctinfo->env, SCAP_MAX_ENV_SIZE);
+		free(iov);
+		tinfo.cgroups_to_iovec(&iov, &iovcnt, rem, tinfo.cgroups());
+		sctinfo->cgroups.len =
+		        iovec_to_buf(iov, iovcnt, sctinfo->cgroups.path, sizeof(sctinfo->cgroups.path));
+		free(iov);
+
+		sctinfo->exe_writable = tinfo.m_exe_writable;
+		sctinfo->exe_upper_layer = tinfo.m_exe_upper_layer;
+		sctinfo->exe_lower_layer = tinfo.m_exe_lower_layer;
+		sctinfo->exe_from_memfd = tinfo.m_exe_from_memfd;
+		sctinfo->cap_permitted = tinfo.m_cap_permitted;
+		sctinfo->cap_effective = tinfo.m_cap_effective;
+		sctinfo->cap_inheritable = tinfo.m_cap_inheritable;
+		sctinfo->exe_ino = tinfo.m_exe_ino;
+		sctinfo->exe_ino_ctime = tinfo.m_exe_ino_ctime;
+		sctinfo->exe_ino_mtime = tinfo.m_exe_ino_mtime;
+		sctinfo->exe_ino_ctime_duration_clone_ts = tinfo.m_exe_ino_ctime_duration_clone_ts;
+		sctinfo->exe_ino_ctime_duration_pidns_start = tinfo.m_exe_ino_ctime_duration_pidns_start;
+		sctinfo->pidns_init_start_ts = tinfo.m_pidns_init_start_ts;
+		sctinfo->clone_ts = tinfo.m_clone_ts;
+		sctinfo->tty = tinfo.m_tty;
+
+		fdinfos.clear();
+		sinsp_fdtable* fd_table_ptr = tinfo.is_main_thread() ? tinfo.get_fd_table() : nullptr;
+		if(fd_table_ptr != nullptr) {
+			fd_table_ptr->loop([&](int64_t fd, sinsp_fdinfo& info) {
+				scap_fdinfo& scfdinfo = fdinfos.emplace_back();
+				memset(&scfdinfo, 0, sizeof(scfdinfo));
+				fd_to_scap(scfdinfo, info);
+				return true;
+			});
+		}
+
+		return cb(*sctinfo, fdinfos);
+	});
+}
+
 const threadinfo_map_t::ptr_t& sinsp_thread_manager::get_thread(const int64_t tid,
                                                                 const bool lookup_only,
                                                                 const bool main_thread) {
 	const auto& sinsp_proc = find_thread(tid, lookup_only);
 
-	if(!sinsp_proc && (m_threadtable.size() < m_max_thread_table_size || tid == m_sinsp_pid)) {
+	if(!sinsp_proc &&
+	   (m_threadtable.size() < m_max_thread_table_size || m_lru_eviction || tid == m_sinsp_pid)) {
 		// Certain code paths can lead to this point from scap_open() (incomplete example:
 		// scap_proc_scan_proc_dir() -> resolve_container() -> get_env()). Adding a
 		// defensive check here to protect both, callers of get_env and get_thread.
@@ -937,7 +1164,6 @@ const threadinfo_map_t::ptr_t& sinsp_thread_manager::get_thread(const int64_t ti
 			fake_tinfo->m_pid = -1;
 			fake_tinfo->m_ptid = -1;
 			fake_tinfo->m_reaper_tid = -1;
-			fake_tinfo->m_not_expired_children = 0;
 			fake_tinfo->m_comm = "<NA>";
 			fake_tinfo->m_exe = "<NA>";
 			fake_tinfo->m_uid = 0xffffffff;
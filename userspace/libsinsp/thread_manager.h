@@ -18,8 +18,6 @@ limitations under the License.
 
 #pragma once
 
-#define DEFAULT_EXPIRED_CHILDREN_THRESHOLD 10
-
 #include <array>
 #include <functional>
 #include <memory>
@@ -63,6 +61,15 @@ public:
 	sinsp_threadinfo* find_new_reaper(sinsp_threadinfo*);
 	void remove_thread(int64_t tid);
 
+	/*!
+	  \brief Remove all the threads of a thread group in one pass, reparenting all their
+	  children at once. This is used when a whole process goes away, e.g. when the thread
+	  purging logic finds it dead, instead of removing its threads one by one.
+
+	  \param pid the pid of the thread group.
+	*/
+	void remove_thread_group(int64_t pid);
+
 	/*!
 	  \brief Record a TID that was removed due to a procexit event.
 	  This is used to prevent the caller's clone exit handler from
@@ -151,6 +158,14 @@ public:
 
 	void dump_threads_to_file(scap_dumper_t* dumper);
 
+	/*!
+	  \brief Call `cb` for each thread that is not filtered out, with its full
+	  scap representation (array-based fields included) and, for main threads,
+	  the fds of the process. Stops as soon as `cb` returns false.
+	*/
+	void threads_to_scap(
+	        const std::function<bool(const scap_threadinfo&, const std::vector<scap_fdinfo>&)>& cb);
+
 	uint32_t get_thread_count() { return (uint32_t)m_threadtable.size(); }
 
 	threadinfo_map_t* get_threads() { return &m_threadtable; }
@@ -159,6 +174,12 @@ public:
 
 	void set_max_thread_table_size(uint32_t value);
 
+	/*!
+	  \brief If enabled, a full thread table evicts its least recently used threads to make
+	  room for new ones, instead of dropping them.
+	*/
+	void set_lru_eviction(bool enabled) { m_lru_eviction = enabled; }
+
 	int32_t get_m_n_proc_lookups() const { return m_n_proc_lookups; }
 	int32_t get_m_n_main_thread_lookups() const { return m_n_main_thread_lookups; }
 	uint64_t get_m_n_proc_lookups_duration_ns() const { return m_n_proc_lookups_duration_ns; }
@@ -279,8 +300,19 @@ public:
 	                                      bool resolve_hostname_and_port);
 
 private:
-	/* We call it immediately before removing the thread from the thread table. */
-	void remove_child_from_parent(int64_t ptid);
+	/* We call it immediately before removing the thread from the thread table, to unlink it
+	 * from its parent and its thread group. */
+	void unlink_thread(sinsp_threadinfo* tinfo);
+
+	/* Tear down a thread group, returns the number of threads removed from the table. */
+	size_t remove_thread_group(std::shared_ptr<thread_group_info> tginfo);
+
+	/* Evict a batch of the least recently used threads, returns the number of evicted threads. */
+	size_t evict_lru_threads();
+
+	/* Forget about a thread without considering it dead: its children keep their ptid, so that
+	 * the thread can be reloaded from /proc when needed again. */
+	void evict_thread(int64_t tid);
 
 	inline void clear_thread_pointers(sinsp_threadinfo& threadinfo);
 	void free_dump_fdinfos(std::vector<scap_fdinfo*>* fdinfos_to_free);
@@ -312,6 +344,7 @@ private:
 	// possible drops due to full threadtable on more modern servers
 	const uint32_t m_thread_table_default_size = 262144;
 	uint32_t m_max_thread_table_size;
+	bool m_lru_eviction = false;
 	int32_t m_n_proc_lookups = 0;
 	uint64_t m_n_proc_lookups_duration_ns = 0;
 	int32_t m_n_main_thread_lookups = 0;
@@ -41,6 +41,10 @@ sinsp_threadinfo::sinsp_threadinfo(const std::shared_ptr<ctor_params>& params):
         m_params{params},
         m_fdtable{params->fdtable_factory.create()},
         m_main_fdtable(&m_fdtable),
+        m_parent_link(nullptr),
+        m_child_index(0),
+        m_group_link(nullptr),
+        m_group_index(0),
         m_args_table_adapter("args", m_args),
         m_env_table_adapter("env", m_env),
         m_cgroups_table_adapter("cgroups", m_cgroups) {
@@ -149,7 +153,6 @@ void sinsp_threadinfo::init() {
 	m_loginuid = 0xffffffff;
 	set_lastevent_data_validity(false);
 	m_reaper_tid = -1;
-	m_not_expired_children = 0;
 	m_lastevent_type = -1;
 	m_lastevent_ts = 0;
 	m_prevevent_ts = 0;
@@ -190,6 +193,15 @@ sinsp_threadinfo::~sinsp_threadinfo() {
 	if(m_lastevent_data) {
 		free(m_lastevent_data);
 	}
+
+	/* Nobody should keep pointers to this thread after its destruction. */
+	remove_from_parent();
+	if(m_group_link != nullptr) {
+		m_group_link->remove_thread_from_group(this);
+	}
+	for(auto child : m_children) {
+		child->m_parent_link = nullptr;
+	}
 }
 
 void sinsp_threadinfo::fix_sockets_coming_from_proc(const std::set<uint16_t>& ipv4_server_ports,
@@ -356,7 +368,6 @@ void sinsp_threadinfo::init(const scap_threadinfo& pinfo, const bool can_load_en
 
 	/* We cannot obtain the reaper_tid from a /proc scan */
 	m_reaper_tid = -1;
-	m_not_expired_children = 0;
 
 	set_args(pinfo.args, pinfo.args_len);
 	if(is_main_thread()) {
@@ -783,12 +794,37 @@ void sinsp_threadinfo::report_thread_loop(const sinsp_threadinfo& looping_thread
 	}
 }
 
+void sinsp_threadinfo::add_child(sinsp_threadinfo* child) {
+	if(child->m_parent_link != this) {
+		child->remove_from_parent();
+		child->m_parent_link = this;
+		child->m_child_index = m_children.size();
+		m_children.push_back(child);
+	}
+	/* Set current thread as parent */
+	child->m_ptid = m_tid;
+}
+
+void sinsp_threadinfo::remove_from_parent() {
+	auto parent = m_parent_link;
+	if(parent == nullptr) {
+		return;
+	}
+
+	/* Move the last child in our slot */
+	auto last = parent->m_children.back();
+	parent->m_children[m_child_index] = last;
+	last->m_child_index = m_child_index;
+	parent->m_children.pop_back();
+	m_parent_link = nullptr;
+}
+
 /* We should never call this method if we don't have children to reparent
  * if we want to save some clock cycles
  */
 void sinsp_threadinfo::assign_children_to_reaper(sinsp_threadinfo* reaper) {
 	/* We have no children to reparent. */
-	if(m_children.size() == 0) {
+	if(m_children.empty()) {
 		return;
 	}
 
@@ -796,27 +832,79 @@ void sinsp_threadinfo::assign_children_to_reaper(sinsp_threadinfo* reaper) {
 		throw sinsp_exception("the current process is reaper of itself, this should never happen!");
 	}
 
-	auto child = m_children.begin();
-	while(child != m_children.end()) {
-		/* If the child is not expired we move it to the reaper
-		 * and we change its `ptid`.
-		 */
-		if(!child->expired()) {
-			if(reaper == nullptr) {
-				/* we set `0` as the parent for all children */
-				child->lock()->m_ptid = 0;
-			} else {
-				/* Add the child to the reaper list */
-				reaper->add_child(child->lock());
-			}
+	/* We take the whole list at once, so the children don't need to be unlinked one by one. */
+	std::vector<sinsp_threadinfo*> children;
+	children.swap(m_children);
+	for(auto child : children) {
+		child->m_parent_link = nullptr;
+		if(reaper == nullptr) {
+			/* we set `0` as the parent for all children */
+			child->m_ptid = 0;
+		} else {
+			/* Add the child to the reaper list */
+			reaper->add_child(child);
 		}
+	}
+}
 
-		/* In any case (expired or not) we remove the child
-		 * from the list.
-		 */
-		child = m_children.erase(child);
+thread_group_info::thread_group_info(int64_t group_pid,
+                                     bool reaper,
+                                     const std::weak_ptr<sinsp_threadinfo>& current_thread):
+        m_pid(group_pid),
+        m_reaper(reaper) {
+	auto thread = current_thread.lock();
+	if(thread == nullptr) {
+		throw sinsp_exception("we cannot create a thread group info from an expired thread");
 	}
-	m_not_expired_children = 0;
+
+	/* When we create the thread group info the count is 1, because we only have the creator
+	 * thread */
+	m_alive_count = 1;
+	link_thread(thread.get(), true);
+}
+
+thread_group_info::~thread_group_info() {
+	for(auto thread : m_threads) {
+		thread->m_group_link = nullptr;
+	}
+}
+
+void thread_group_info::add_thread_to_group(const std::shared_ptr<sinsp_threadinfo>& thread,
+                                            bool main) {
+	link_thread(thread.get(), main);
+	/* we are adding a thread so we increment the count */
+	increment_thread_count();
+}
+
+void thread_group_info::link_thread(sinsp_threadinfo* thread, bool main) {
+	if(thread->m_group_link != nullptr) {
+		thread->m_group_link->remove_thread_from_group(thread);
+	}
+
+	thread->m_group_link = this;
+	thread->m_group_index = m_threads.size();
+	m_threads.push_back(thread);
+	if(main && thread->m_group_index != 0) {
+		/* Swap with the first one, the order of the other threads doesn't matter */
+		auto first = m_threads.front();
+		m_threads.front() = thread;
+		m_threads.back() = first;
+		first->m_group_index = thread->m_group_index;
+		thread->m_group_index = 0;
+	}
+}
+
+void thread_group_info::remove_thread_from_group(sinsp_threadinfo* thread) {
+	if(thread->m_group_link != this) {
+		return;
+	}
+
+	/* Move the last thread in our slot */
+	auto last = m_threads.back();
+	m_threads[thread->m_group_index] = last;
+	last->m_group_index = thread->m_group_index;
+	m_threads.pop_back();
+	thread->m_group_link = nullptr;
 }
 
 void sinsp_threadinfo::populate_cmdline(std::string& cmdline, const sinsp_threadinfo* tinfo) {
@@ -18,8 +18,6 @@ limitations under the License.
 
 #pragma once
 
-#define DEFAULT_EXPIRED_CHILDREN_THRESHOLD 10
-
 #ifdef _WIN32
 struct iovec {
 	void* iov_base; /* Starting address */
@@ -315,28 +313,21 @@ public:
 
 	void assign_children_to_reaper(sinsp_threadinfo* reaper);
 
-	inline void add_child(const std::shared_ptr<sinsp_threadinfo>& child) {
-		m_children.push_front(child);
-		/* Set current thread as parent */
-		child->m_ptid = m_tid;
-		/* Increment the number of not expired children */
-		m_not_expired_children++;
-	}
+	/*!
+	  \brief Make `child` a child of this thread, moving it away from its previous parent if any.
+	*/
+	void add_child(sinsp_threadinfo* child);
 
-	inline void clean_expired_children() {
-		auto child = m_children.begin();
-		while(child != m_children.end()) {
-			/* This child is expired */
-			if(child->expired()) {
-				/* `erase` returns the pointer to the next child
-				 * no need for manual increment.
-				 */
-				child = m_children.erase(child);
-				continue;
-			}
-			child++;
-		}
-	}
+	/*!
+	  \brief Unlink this thread from the children of its parent, in O(1).
+	*/
+	void remove_from_parent();
+
+	/*!
+	  \brief Return the children of this thread. Children are unlinked as soon as they are
+	  removed from the thread table or destroyed, so all of them are valid.
+	*/
+	inline const std::vector<sinsp_threadinfo*>& get_children() const { return m_children; }
 
 	static void populate_cmdline(std::string& cmdline, const sinsp_threadinfo* tinfo);
 	static void populate_args(std::string& args, const sinsp_threadinfo* tinfo);
@@ -404,8 +395,6 @@ public:
 
 	uint32_t m_tty;  ///< Number of controlling terminal
 	std::shared_ptr<thread_group_info> m_tginfo;
-	std::list<std::weak_ptr<sinsp_threadinfo>> m_children;
-	uint64_t m_not_expired_children;
 	std::string m_cmd_line;
 	bool m_filtered_out;  ///< True if this thread is filtered out by the inspector filter from
 	                      ///< saving to a capture
@@ -519,6 +508,8 @@ protected:
 	const std::shared_ptr<ctor_params> m_params;
 
 private:
+	friend struct thread_group_info;
+
 	sinsp_threadinfo* get_cwd_root();
 	bool set_env_from_proc();
 	size_t strvec_len(const std::vector<std::string>& strs) const;
@@ -547,6 +538,17 @@ private:
 	uint16_t m_lastevent_cpuid;
 	sinsp_evt::category m_lastevent_category;
 	bool m_parent_loop_detected;
+
+	//
+	// Intrusive parent/children and thread group memberships: each thread stores the position it
+	// has in the list of its parent and of its thread group so that it can be unlinked in O(1).
+	//
+	std::vector<sinsp_threadinfo*> m_children;
+	sinsp_threadinfo* m_parent_link;  // The thread whose `m_children` contains this thread
+	size_t m_child_index;             // Position in `m_parent_link->m_children`
+	thread_group_info* m_group_link;  // The thread group whose thread list contains this thread
+	size_t m_group_index;             // Position in the thread list of `m_group_link`
+
 	libsinsp::state::stl_container_table_adapter<decltype(m_args)> m_args_table_adapter;
 	libsinsp::state::stl_container_table_adapter<decltype(m_env)> m_env_table_adapter;
 	libsinsp::state::stl_container_table_adapter<decltype(m_cgroups)> m_cgroups_table_adapter;
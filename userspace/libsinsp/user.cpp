@@ -23,6 +23,7 @@ limitations under the License.
 #include <libsinsp/sinsp.h>
 #include <libscap/strl.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <charconv>
 #include <cstdint>
 #include <cstring>
@@ -82,6 +83,106 @@ bool parse_uint32(std::string_view s, uint32_t &out) {
 
 }  // namespace
 
+size_t sinsp_usergroup_db_cache::file_key_hash::operator()(const file_key &key) const {
+	size_t h = std::hash<uint64_t>{}(key.ino);
+	h ^= std::hash<uint64_t>{}(key.dev) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= std::hash<int64_t>{}(key.mtime_ns) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	return h;
+}
+
+bool sinsp_usergroup_db_cache::get_file_key(const std::string &path, file_key &key) {
+	struct stat st;
+	if(stat(path.c_str(), &st) != 0) {
+		return false;
+	}
+	key.dev = st.st_dev;
+	key.ino = st.st_ino;
+#ifdef __linux__
+	key.mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#else
+	key.mtime_ns = (int64_t)st.st_mtime * 1000000000;
+#endif
+	key.size = st.st_size;
+	return true;
+}
+
+std::shared_ptr<const sinsp_usergroup_db_cache::passwd_db> sinsp_usergroup_db_cache::get_passwd(
+        const std::string &path) {
+	// The file is identified before being read: if it changes meanwhile, the
+	// next lookup sees a new key and parses it again.
+	file_key key;
+	if(!get_file_key(path, key)) {
+		return nullptr;
+	}
+	if(auto it = m_passwd.find(key); it != m_passwd.end()) {
+		return it->second;
+	}
+
+	std::ifstream f(path);
+	if(!f) {
+		return nullptr;
+	}
+	auto db = std::make_shared<passwd_db>();
+	std::string line;
+	while(std::getline(f, line)) {
+		// name:passwd:uid:gid:gecos:home:shell
+		std::string_view fields[7];
+		if(split_fields(line, fields, 7) < 7) {
+			continue;  // skip malformed lines
+		}
+		uint32_t uid;
+		uint32_t gid;
+		if(!parse_uint32(fields[2], uid) || !parse_uint32(fields[3], gid)) {
+			continue;  // skip lines with a non-numeric uid/gid
+		}
+		// The last entry of a duplicated uid wins
+		(*db)[uid] = {gid, std::string(fields[0]), std::string(fields[5]), std::string(fields[6])};
+	}
+	m_passwd.emplace(key, db);
+	return db;
+}
+
+std::shared_ptr<const sinsp_usergroup_db_cache::group_db> sinsp_usergroup_db_cache::get_group(
+        const std::string &path) {
+	file_key key;
+	if(!get_file_key(path, key)) {
+		return nullptr;
+	}
+	if(auto it = m_group.find(key); it != m_group.end()) {
+		return it->second;
+	}
+
+	std::ifstream f(path);
+	if(!f) {
+		return nullptr;
+	}
+	auto db = std::make_shared<group_db>();
+	std::string line;
+	while(std::getline(f, line)) {
+		// name:passwd:gid:members
+		std::string_view fields[3];
+		if(split_fields(line, fields, 3) < 3) {
+			continue;  // skip malformed lines
+		}
+		uint32_t gid;
+		if(!parse_uint32(fields[2], gid)) {
+			continue;  // skip lines with a non-numeric gid
+		}
+		(*db)[gid] = {std::string(fields[0])};
+	}
+	m_group.emplace(key, db);
+	return db;
+}
+
+void sinsp_usergroup_db_cache::prune() {
+	for(auto it = m_passwd.begin(); it != m_passwd.end();) {
+		it = it->second.use_count() == 1 ? m_passwd.erase(it) : std::next(it);
+	}
+	for(auto it = m_group.begin(); it != m_group.end();) {
+		it = it->second.use_count() == 1 ? m_group.erase(it) : std::next(it);
+	}
+}
+
 #ifdef HAVE_PWD_H
 static struct passwd *__getpwuid(uint32_t uid,
                                  const std::string &host_root,
@@ -275,6 +376,9 @@ void sinsp_usergroup_manager::delete_container(const std::string &container_id)
 
 	m_userlist.erase(container_id);
 	m_grouplist.erase(container_id);
+	m_container_passwd.erase(container_id);
+	m_container_group.erase(container_id);
+	m_db_cache.prune();
 }
 
 scap_userinfo *sinsp_usergroup_manager::userinfo_map_insert(userinfo_map &map,
@@ -424,45 +528,59 @@ scap_userinfo *sinsp_usergroup_manager::add_container_user(const std::string &co
 		return retval;
 	}
 
-	std::string path = m_ns_helper->get_pid_root(pid) + "/etc/passwd";
-	std::ifstream pwd_file(path);
-	if(pwd_file) {
-		auto &userlist = m_userlist[container_id];
-		std::string line;
-		while(std::getline(pwd_file, line)) {
-			// name:passwd:uid:gid:gecos:home:shell
-			std::string_view fields[7];
-			if(split_fields(line, fields, 7) < 7) {
-				continue;  // skip malformed lines
-			}
-			uint32_t u_uid;
-			uint32_t u_gid;
-			if(!parse_uint32(fields[2], u_uid) || !parse_uint32(fields[3], u_gid)) {
-				continue;  // skip lines with a non-numeric uid/gid
-			}
-			// Here we cache all container users. Compare against whatever
-			// was previously cached for this uid (if anything) *before*
-			// the insert overwrites it in place, so we can tell a
-			// genuinely new entry or a changed one (e.g. a rename) apart
-			// from a no-op rescan of an already-known, unchanged entry.
-			const auto existing_it = userlist.find(u_uid);
-			const scap_userinfo *previous =
-			        existing_it != userlist.end() ? &existing_it->second : nullptr;
-			const bool changed = !previous || previous->gid != u_gid ||
-			                     fields[0] != previous->name || fields[5] != previous->homedir ||
-			                     fields[6] != previous->shell;
-
-			auto *usr =
-			        userinfo_map_insert(userlist, u_uid, u_gid, fields[0], fields[5], fields[6]);
-
-			if(notify && changed) {
-				notify_user_changed(usr, container_id);
-			}
+	auto db = m_db_cache.get_passwd(m_ns_helper->get_pid_root(pid) + "/etc/passwd");
+	if(db == nullptr) {
+		return retval;
+	}
 
-			if(uid == u_uid) {
-				retval = usr;
+	auto &userlist = m_userlist[container_id];
+	auto &bound_db = m_container_passwd[container_id];
+	if(bound_db == db) {
+		// The container file didn't change since we cached its users, only
+		// an entry removed in the meantime can be missing.
+		auto entry = db->find(uid);
+		if(entry != db->end()) {
+			retval = userinfo_map_insert(userlist,
+			                             uid,
+			                             entry->second.gid,
+			                             entry->second.name,
+			                             entry->second.home,
+			                             entry->second.shell);
+			if(notify) {
+				notify_user_changed(retval, container_id);
 			}
 		}
+		return retval;
+	}
+	bound_db = db;
+
+	for(const auto &[u_uid, entry] : *db) {
+		// Here we cache all container users. Compare against whatever
+		// was previously cached for this uid (if anything) *before*
+		// the insert overwrites it in place, so we can tell a
+		// genuinely new entry or a changed one (e.g. a rename) apart
+		// from a no-op rescan of an already-known, unchanged entry.
+		const auto existing_it = userlist.find(u_uid);
+		const scap_userinfo *previous =
+		        existing_it != userlist.end() ? &existing_it->second : nullptr;
+		const bool changed = !previous || previous->gid != entry.gid ||
+		                     entry.name != previous->name || entry.home != previous->homedir ||
+		                     entry.shell != previous->shell;
+
+		auto *usr = userinfo_map_insert(userlist,
+		                                u_uid,
+		                                entry.gid,
+		                                entry.name,
+		                                entry.home,
+		                                entry.shell);
+
+		if(notify && changed) {
+			notify_user_changed(usr, container_id);
+		}
+
+		if(uid == u_uid) {
+			retval = usr;
+		}
 	}
 #endif
 
@@ -565,41 +683,47 @@ scap_groupinfo *sinsp_usergroup_manager::add_container_group(const std::string &
 		return retval;
 	}
 
-	std::string path = m_ns_helper->get_pid_root(pid) + "/etc/group";
-	std::ifstream group_file(path);
-	if(group_file) {
-		auto &grouplist = m_grouplist[container_id];
-		std::string line;
-		while(std::getline(group_file, line)) {
-			// name:passwd:gid:members
-			std::string_view fields[3];
-			if(split_fields(line, fields, 3) < 3) {
-				continue;  // skip malformed lines
-			}
-			uint32_t g_gid;
-			if(!parse_uint32(fields[2], g_gid)) {
-				continue;  // skip lines with a non-numeric gid
-			}
-			// Here we cache all container groups. Compare against whatever
-			// was previously cached for this gid (if anything) *before*
-			// the insert overwrites it in place, so we can tell a
-			// genuinely new entry or a changed one (e.g. a rename) apart
-			// from a no-op rescan of an already-known, unchanged entry.
-			const auto existing_it = grouplist.find(g_gid);
-			const scap_groupinfo *previous =
-			        existing_it != grouplist.end() ? &existing_it->second : nullptr;
-			const bool changed = !previous || fields[0] != previous->name;
-
-			auto *gr = groupinfo_map_insert(grouplist, g_gid, fields[0]);
-
-			if(notify && changed) {
-				notify_group_changed(gr, container_id, true);
-			}
+	auto db = m_db_cache.get_group(m_ns_helper->get_pid_root(pid) + "/etc/group");
+	if(db == nullptr) {
+		return retval;
+	}
 
-			if(gid == g_gid) {
-				retval = gr;
+	auto &grouplist = m_grouplist[container_id];
+	auto &bound_db = m_container_group[container_id];
+	if(bound_db == db) {
+		// The container file didn't change since we cached its groups, only
+		// an entry removed in the meantime can be missing.
+		auto entry = db->find(gid);
+		if(entry != db->end()) {
+			retval = groupinfo_map_insert(grouplist, gid, entry->second.name);
+			if(notify) {
+				notify_group_changed(retval, container_id, true);
 			}
 		}
+		return retval;
+	}
+	bound_db = db;
+
+	for(const auto &[g_gid, entry] : *db) {
+		// Here we cache all container groups. Compare against whatever
+		// was previously cached for this gid (if anything) *before*
+		// the insert overwrites it in place, so we can tell a
+		// genuinely new entry or a changed one (e.g. a rename) apart
+		// from a no-op rescan of an already-known, unchanged entry.
+		const auto existing_it = grouplist.find(g_gid);
+		const scap_groupinfo *previous =
+		        existing_it != grouplist.end() ? &existing_it->second : nullptr;
+		const bool changed = !previous || entry.name != previous->name;
+
+		auto *gr = groupinfo_map_insert(grouplist, g_gid, entry.name);
+
+		if(notify && changed) {
+			notify_group_changed(gr, container_id, true);
+		}
+
+		if(gid == g_gid) {
+			retval = gr;
+		}
 	}
 #endif
 
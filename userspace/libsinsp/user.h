@@ -22,6 +22,7 @@ limitations under the License.
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <cstdint>
 #include <libsinsp/procfs_utils.h>
 #include <libsinsp/sinsp.h>
 
@@ -32,6 +33,76 @@ class ns_helper;
 }
 }  // namespace libsinsp
 
+/*!
+  \brief Cache of the parsed /etc/passwd and /etc/group files of the containers.
+
+  Containers created from the same image share the same files, so the parsed
+  databases are keyed by device, inode, mtime and size of the file: each
+  version of a file is parsed once, the first time one of its entries is
+  looked up, and shared by all the containers using it.
+*/
+class sinsp_usergroup_db_cache {
+public:
+	struct user_entry {
+		uint32_t gid;
+		std::string name;
+		std::string home;
+		std::string shell;
+	};
+
+	struct group_entry {
+		std::string name;
+	};
+
+	using passwd_db = std::unordered_map<uint32_t, user_entry>;
+	using group_db = std::unordered_map<uint32_t, group_entry>;
+
+	/*!
+	  \brief Return the parsed passwd file at `path`, indexed by uid, parsing it
+	   if it's the first time this version of the file is seen.
+
+	  \return nullptr if the file can't be read.
+	*/
+	std::shared_ptr<const passwd_db> get_passwd(const std::string &path);
+
+	/*!
+	  \brief Return the parsed group file at `path`, indexed by gid, parsing it
+	   if it's the first time this version of the file is seen.
+
+	  \return nullptr if the file can't be read.
+	*/
+	std::shared_ptr<const group_db> get_group(const std::string &path);
+
+	/*!
+	  \brief Forget the databases not referenced outside of the cache.
+	*/
+	void prune();
+
+	inline size_t size() const { return m_passwd.size() + m_group.size(); }
+
+private:
+	struct file_key {
+		uint64_t dev;
+		uint64_t ino;
+		int64_t mtime_ns;
+		int64_t size;
+
+		inline bool operator==(const file_key &other) const {
+			return dev == other.dev && ino == other.ino && mtime_ns == other.mtime_ns &&
+			       size == other.size;
+		}
+	};
+
+	struct file_key_hash {
+		size_t operator()(const file_key &key) const;
+	};
+
+	static bool get_file_key(const std::string &path, file_key &key);
+
+	std::unordered_map<file_key, std::shared_ptr<const passwd_db>, file_key_hash> m_passwd;
+	std::unordered_map<file_key, std::shared_ptr<const group_db>, file_key_hash> m_group;
+};
+
 /*
  * Basic idea:
  * * when container_manager tries to resolve a threadinfo container, it will update
@@ -42,9 +113,10 @@ class ns_helper;
  * 		If no information can be retrieved, only uid/gid will be stored as informations, with "<NA>"
  * for everything else.
  * * if the thread is on a container, the new user/group will be stored using the container id as
- * key, without additional info (ie: username, homedir etc etc will be left "<NA>") because they
- * cannot be retrieved from a container. Then, a PPME_{USER,GROUP}_ADDED event is emitted, to allow
- * capture files to rebuild the state.
+ * key, together with all the other ones found in the container /etc/passwd and /etc/group
+ * files. The files are parsed through a `sinsp_usergroup_db_cache`, shared by the containers of
+ * the same image, and merged again only when they change. Then, a PPME_{USER,GROUP}_ADDED event
+ * is emitted for the new or changed entries, to allow capture files to rebuild the state.
  *
  * * on PPME_{USER,GROUP}_ADDED, the new user/group is stored in the
  * m_{user,group}_list<container_id>, if not present.
@@ -198,6 +270,13 @@ private:
 
 	std::unordered_map<std::string, userinfo_map> m_userlist;
 	std::unordered_map<std::string, groupinfo_map> m_grouplist;
+
+	// Parsed passwd/group files, and the ones currently used by each container
+	sinsp_usergroup_db_cache m_db_cache;
+	std::unordered_map<std::string, std::shared_ptr<const sinsp_usergroup_db_cache::passwd_db>>
+	        m_container_passwd;
+	std::unordered_map<std::string, std::shared_ptr<const sinsp_usergroup_db_cache::group_db>>
+	        m_container_group;
 	sinsp *m_inspector;
 	const timestamper &m_timestamper;
 
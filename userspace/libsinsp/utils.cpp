@@ -50,7 +50,9 @@ limitations under the License.
 #include <algorithm>
 #include <cerrno>
 #include <functional>
+#include <string_view>
 #include <sys/stat.h>
+#include <unordered_map>
 
 #ifndef PATH_MAX
 #define PATH_MAX 4096
@@ -483,8 +485,7 @@ bool sinsp_utils::sockinfo_to_str(sinsp_sockinfo* sinfo,
 			addr.m_fields.m_dip = sinfo->m_ipv4info.m_fields.m_dip;
 			addr.m_fields.m_dport = sinfo->m_ipv4info.m_fields.m_dport;
 			addr.m_fields.m_l4proto = sinfo->m_ipv4info.m_fields.m_l4proto;
-			std::string straddr = ipv4tuple_to_string(addr, resolve);
-			snprintf(targetbuf, targetbuf_size, "%s", straddr.c_str());
+			ipv4tuple_to_buf(addr, resolve, targetbuf, targetbuf_size);
 		} else if(sinfo->m_ipv4info.m_fields.m_l4proto == SCAP_L4_ICMP ||
 		          sinfo->m_ipv4info.m_fields.m_l4proto == SCAP_L4_RAW) {
 			snprintf(targetbuf,
@@ -516,29 +517,10 @@ bool sinsp_utils::sockinfo_to_str(sinsp_sockinfo* sinfo,
 				memcpy(&addr.m_fields.m_dip, dip, sizeof(uint32_t));
 				addr.m_fields.m_dport = sinfo->m_ipv4info.m_fields.m_dport;
 				addr.m_fields.m_l4proto = sinfo->m_ipv4info.m_fields.m_l4proto;
-				std::string straddr = ipv4tuple_to_string(addr, resolve);
-				snprintf(targetbuf, targetbuf_size, "%s", straddr.c_str());
+				ipv4tuple_to_buf(addr, resolve, targetbuf, targetbuf_size);
+				return true;
+			} else if(ipv6tuple_to_buf(sinfo->m_ipv6info, resolve, targetbuf, targetbuf_size) > 0) {
 				return true;
-			} else {
-				char srcstr[INET6_ADDRSTRLEN];
-				char dststr[INET6_ADDRSTRLEN];
-				if(inet_ntop(AF_INET6, sip6, srcstr, sizeof(srcstr)) &&
-				   inet_ntop(AF_INET6, dip6, dststr, sizeof(dststr))) {
-					snprintf(targetbuf,
-					         targetbuf_size,
-					         "%s:%s->%s:%s",
-					         srcstr,
-					         port_to_string(sinfo->m_ipv6info.m_fields.m_sport,
-					                        sinfo->m_ipv6info.m_fields.m_l4proto,
-					                        resolve)
-					                 .c_str(),
-					         dststr,
-					         port_to_string(sinfo->m_ipv6info.m_fields.m_dport,
-					                        sinfo->m_ipv6info.m_fields.m_l4proto,
-					                        resolve)
-					                 .c_str());
-					return true;
-				}
 			}
 		} else if(sinfo->m_ipv6info.m_fields.m_l4proto == SCAP_L4_ICMP) {
 			if(sinsp_utils::is_ipv4_mapped_ipv6(sip6) && sinsp_utils::is_ipv4_mapped_ipv6(dip6)) {
@@ -737,30 +719,36 @@ bool sinsp_utils::is_ipv4_mapped_ipv6(const uint8_t* paddr) {
 }
 
 const ppm_param_info* sinsp_utils::find_longest_matching_evt_param(std::string_view name) {
-	uint32_t maxlen = 0;
-	const ppm_param_info* res = nullptr;
-	const auto name_len = name.size();
-
-	for(uint32_t j = 0; j < PPM_EVENT_MAX; j++) {
-		const ppm_event_info* ei = &g_infotables.m_event_info[j];
-
-		for(uint32_t k = 0; k < ei->nparams; k++) {
-			const ppm_param_info* pi = &ei->params[k];
-			const char* an = pi->name;
-			const auto alen = strlen(an);
-
-			if(alen > name_len || alen <= maxlen) {
-				continue;
+	// Many events share the same param names, so we index the distinct names once, keeping the
+	// first param (in event order) for each of them.
+	struct param_index {
+		std::unordered_map<std::string_view, const ppm_param_info*> params;
+		size_t max_len = 0;
+	};
+	static const param_index s_index = [] {
+		param_index index;
+		for(uint32_t j = 0; j < PPM_EVENT_MAX; j++) {
+			const ppm_event_info* ei = &g_infotables.m_event_info[j];
+			for(uint32_t k = 0; k < ei->nparams; k++) {
+				const ppm_param_info* pi = &ei->params[k];
+				const std::string_view pname = pi->name;
+				if(pname.empty()) {
+					continue;
+				}
+				index.params.emplace(pname, pi);
+				index.max_len = std::max(index.max_len, pname.size());
 			}
+		}
+		return index;
+	}();
 
-			if(name.compare(0, alen, pi->name) == 0) {
-				res = pi;
-				maxlen = alen;
-			}
+	for(size_t len = std::min(name.size(), s_index.max_len); len > 0; len--) {
+		const auto it = s_index.params.find(name.substr(0, len));
+		if(it != s_index.params.end()) {
+			return it->second;
 		}
 	}
-
-	return res;
+	return nullptr;
 }
 
 uint64_t sinsp_utils::get_current_time_ns() {
@@ -999,77 +987,143 @@ std::string port_to_string(const uint16_t port, const uint8_t l4proto, const boo
 	return ret;
 }
 
-std::string ipv4serveraddr_to_string(const ipv4serverinfo& addr, const bool resolve) {
-	char buf[50];
-	const auto ip = reinterpret_cast<const uint8_t*>(&addr.m_ip);
+namespace {
+// Renders into a fixed, non-empty buffer, truncating the output if it doesn't fit. The result
+// is always NUL-terminated.
+struct buf_writer {
+	char* const m_start;
+	char* m_p;
+	char* const m_end;
 
-	// IP address is in network byte order regardless of host endianness
-	snprintf(buf,
-	         sizeof(buf),
-	         "%d.%d.%d.%d:%s",
-	         ip[0],
-	         ip[1],
-	         ip[2],
-	         ip[3],
-	         port_to_string(addr.m_port, addr.m_l4proto, resolve).c_str());
+	buf_writer(char* buf, size_t len): m_start(buf), m_p(buf), m_end(buf + len - 1) {}
 
-	return std::string(buf);
-}
+	inline void put(char c) {
+		if(m_p < m_end) {
+			*m_p++ = c;
+		}
+	}
 
-std::string ipv4tuple_to_string(const ipv4tuple& tuple, const bool resolve) {
-	ipv4serverinfo info;
+	inline void put(std::string_view s) {
+		const auto n = std::min(s.size(), static_cast<size_t>(m_end - m_p));
+		memcpy(m_p, s.data(), n);
+		m_p += n;
+	}
 
-	info.m_ip = tuple.m_fields.m_sip;
-	info.m_port = tuple.m_fields.m_sport;
-	info.m_l4proto = tuple.m_fields.m_l4proto;
-	const auto source = ipv4serveraddr_to_string(info, resolve);
+	inline void put_uint(uint32_t v) {
+		char tmp[10];
+		size_t n = 0;
+		do {
+			tmp[n++] = static_cast<char>('0' + v % 10);
+			v /= 10;
+		} while(v != 0);
+		while(n > 0) {
+			put(tmp[--n]);
+		}
+	}
 
-	info.m_ip = tuple.m_fields.m_dip;
-	info.m_port = tuple.m_fields.m_dport;
-	info.m_l4proto = tuple.m_fields.m_l4proto;
-	const auto dest = ipv4serveraddr_to_string(info, resolve);
+	// `ip` is in network byte order
+	inline void put_ipv4(const uint8_t* ip) {
+		put_uint(ip[0]);
+		put('.');
+		put_uint(ip[1]);
+		put('.');
+		put_uint(ip[2]);
+		put('.');
+		put_uint(ip[3]);
+	}
 
-	char buf[100];
-	snprintf(buf, sizeof(buf), "%s->%s", source.c_str(), dest.c_str());
-	return std::string(buf);
-}
+	inline bool put_ipv6(const void* ip) {
+		char address[INET6_ADDRSTRLEN];
+		if(!inet_ntop(AF_INET6, ip, address, sizeof(address))) {
+			return false;
+		}
+		put(std::string_view(address));
+		return true;
+	}
 
-std::string ipv6serveraddr_to_string(const ipv6serverinfo& addr, const bool resolve) {
-	char address[INET6_ADDRSTRLEN];
-	if(!inet_ntop(AF_INET6, addr.m_ip.m_b, address, INET6_ADDRSTRLEN)) {
-		return std::string();
+	inline void put_port(uint16_t port, uint8_t l4proto, bool resolve) {
+		if(resolve) {
+			put(port_to_string(port, l4proto, resolve));
+		} else {
+			put_uint(port);
+		}
 	}
 
-	char buf[200];
-	snprintf(buf,
-	         200,
-	         "%s:%s",
-	         address,
-	         port_to_string(addr.m_port, addr.m_l4proto, resolve).c_str());
-	return std::string(buf);
+	inline size_t finish() {
+		*m_p = '\0';
+		return m_p - m_start;
+	}
+
+	inline size_t clear() {
+		m_p = m_start;
+		return finish();
+	}
+};
+}  // namespace
+
+size_t ipv4tuple_to_buf(const ipv4tuple& tuple, const bool resolve, char* buf, size_t len) {
+	buf_writer w(buf, len);
+	w.put_ipv4(reinterpret_cast<const uint8_t*>(&tuple.m_fields.m_sip));
+	w.put(':');
+	w.put_port(tuple.m_fields.m_sport, tuple.m_fields.m_l4proto, resolve);
+	w.put("->");
+	w.put_ipv4(reinterpret_cast<const uint8_t*>(&tuple.m_fields.m_dip));
+	w.put(':');
+	w.put_port(tuple.m_fields.m_dport, tuple.m_fields.m_l4proto, resolve);
+	return w.finish();
 }
 
-std::string ipv6tuple_to_string(const ipv6tuple& tuple, const bool resolve) {
-	char source_address[INET6_ADDRSTRLEN];
-	if(!inet_ntop(AF_INET6, tuple.m_fields.m_sip.m_b, source_address, INET6_ADDRSTRLEN)) {
-		return std::string();
+size_t ipv6tuple_to_buf(const ipv6tuple& tuple, const bool resolve, char* buf, size_t len) {
+	buf_writer w(buf, len);
+	if(!w.put_ipv6(tuple.m_fields.m_sip.m_b)) {
+		return w.clear();
 	}
+	w.put(':');
+	w.put_port(tuple.m_fields.m_sport, tuple.m_fields.m_l4proto, resolve);
+	w.put("->");
+	if(!w.put_ipv6(tuple.m_fields.m_dip.m_b)) {
+		return w.clear();
+	}
+	w.put(':');
+	w.put_port(tuple.m_fields.m_dport, tuple.m_fields.m_l4proto, resolve);
+	return w.finish();
+}
 
-	char destination_address[INET6_ADDRSTRLEN];
-	if(!inet_ntop(AF_INET6, tuple.m_fields.m_dip.m_b, destination_address, INET6_ADDRSTRLEN)) {
+size_t ipv4addr_to_buf(const uint8_t* addr, char* buf, size_t len) {
+	buf_writer w(buf, len);
+	w.put_ipv4(addr);
+	return w.finish();
+}
+
+std::string ipv4serveraddr_to_string(const ipv4serverinfo& addr, const bool resolve) {
+	char buf[50];
+	buf_writer w(buf, sizeof(buf));
+	// IP address is in network byte order regardless of host endianness
+	w.put_ipv4(reinterpret_cast<const uint8_t*>(&addr.m_ip));
+	w.put(':');
+	w.put_port(addr.m_port, addr.m_l4proto, resolve);
+	return std::string(buf, w.finish());
+}
+
+std::string ipv4tuple_to_string(const ipv4tuple& tuple, const bool resolve) {
+	char buf[100];
+	return std::string(buf, ipv4tuple_to_buf(tuple, resolve, buf, sizeof(buf)));
+}
+
+std::string ipv6serveraddr_to_string(const ipv6serverinfo& addr, const bool resolve) {
+	char buf[200];
+	buf_writer w(buf, sizeof(buf));
+	if(!w.put_ipv6(addr.m_ip.m_b)) {
 		return std::string();
 	}
+	w.put(':');
+	w.put_port(addr.m_port, addr.m_l4proto, resolve);
+	return std::string(buf, w.finish());
+}
 
+std::string ipv6tuple_to_string(const ipv6tuple& tuple, const bool resolve) {
 	char buf[200];
-	snprintf(buf,
-	         sizeof(buf),
-	         "%s:%s->%s:%s",
-	         source_address,
-	         port_to_string(tuple.m_fields.m_sport, tuple.m_fields.m_l4proto, resolve).c_str(),
-	         destination_address,
-	         port_to_string(tuple.m_fields.m_dport, tuple.m_fields.m_l4proto, resolve).c_str());
-
-	return std::string(buf);
+	return std::string(buf, ipv6tuple_to_buf(tuple, resolve, buf, sizeof(buf)));
 }
 
 const char* param_type_to_string(ppm_param_type pt) {